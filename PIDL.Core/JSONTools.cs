@@ -195,12 +195,84 @@ namespace PIDL
 						return (T)(object)ret;
 					}
 				}
+				else if (t == Type.String)
+				{
+					DateTime ret;
+					if (isOk = parseDateTime(v.Value, out ret))
+						return (T)(object)ret;
+				}
 			}
 
 			isOk = false;
 			return default(T);
 		}
 
+		private static bool parseDigits(string str, int pos, int count, out int ret)
+		{
+			ret = 0;
+			for (int i = pos; i < pos + count; ++i)
+			{
+				if (str[i] < '0' || str[i] > '9')
+					return false;
+				ret = ret * 10 + (str[i] - '0');
+			}
+			return true;
+		}
+
+		//the compact form of DateTime is 'YYYY-MM-DDThh:mm:ss[.nnnnnnnnn][Z|L]', where 'Z' is utc, 'L' is local and no suffix
+		//is none (see pidlCore/jsontools.h); the fraction is truncated to the 100 ns ticks of DateTime
+		public static bool parseDateTime(string str, out DateTime ret)
+		{
+			ret = default(DateTime);
+			int year, month, day, hour, minute, second;
+			if (str.Length < 19 ||
+				!parseDigits(str, 0, 4, out year) || str[4] != '-' ||
+				!parseDigits(str, 5, 2, out month) || str[7] != '-' ||
+				!parseDigits(str, 8, 2, out day) || str[10] != 'T' ||
+				!parseDigits(str, 11, 2, out hour) || str[13] != ':' ||
+				!parseDigits(str, 14, 2, out minute) || str[16] != ':' ||
+				!parseDigits(str, 17, 2, out second))
+				return false;
+
+			int pos = 19;
+			long nanosecond = 0;
+			if (pos < str.Length && str[pos] == '.')
+			{
+				int digits = 0;
+				for (++pos; pos < str.Length && str[pos] >= '0' && str[pos] <= '9'; ++pos)
+					if (++digits <= 9)
+						nanosecond = nanosecond * 10 + (str[pos] - '0');
+				if (digits == 0 || digits > 9)
+					return false;
+				for (; digits < 9; ++digits)
+					nanosecond *= 10;
+			}
+
+			DateTimeKind kind = DateTimeKind.Unspecified;
+			if (pos < str.Length)
+			{
+				if (str[pos] == 'Z')
+					kind = DateTimeKind.Utc;
+				else if (str[pos] == 'L')
+					kind = DateTimeKind.Local;
+				else
+					return false;
+				++pos;
+			}
+			if (pos != str.Length)
+				return false;
+
+			try
+			{
+				ret = new DateTime(year, month, day, hour, minute, second, kind).AddTicks(nanosecond / 100);
+			}
+			catch (ArgumentOutOfRangeException)
+			{
+				return false;
+			}
+			return true;
+		}
+
 		public static bool getValue<T>(XElement v, out T ret)
 		{
 			bool isOk;
@@ -12,4 +12,4 @@ SUBDIRS += \
 
 pidlBackend.depends += pidlCore
 pidl.depends += pidlBackend pidlCore
-test.depends += pidlCore
+test.depends += pidlCore pidlBackend
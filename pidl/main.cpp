@@ -26,6 +26,7 @@
 
 #include <pidlCore/errorcollector.h>
 #include <pidlBackend/configreader.h>
+#include <pidlBackend/incrementalbuild.h>
 
 using namespace PIDL;
 
@@ -63,9 +64,11 @@ int main(int argc, char **argv)
 
 	enum class Stat
 	{
-        None, File, Config
+        None, File, Config, Incremental
 	} stat = Stat::None;
 
+	std::shared_ptr<IncrementalBuild> incremental;
+
 	for (int i = 1; i < argc; ++i)
 	{
 		std::string a(argv[i]);
@@ -78,6 +81,7 @@ int main(int argc, char **argv)
 				std::cout << "-stdin" << std::endl;
 				std::cout << "-file <filename>" << std::endl;
                 std::cout << "-cfg <varname>=<value>" << std::endl;
+                std::cout << "-incremental <manifest filename>" << std::endl;
                 return 0;
 			}
 			if (a == "-stdin")
@@ -86,6 +90,8 @@ int main(int argc, char **argv)
 				stat = Stat::File;
             else if (a == "-cfg")
                 stat = Stat::Config;
+            else if (a == "-incremental")
+                stat = Stat::Incremental;
             else
 			{
 				ec << "invalid option '" + a + "'";
@@ -114,6 +120,15 @@ int main(int argc, char **argv)
             stat = Stat::None;
         }
             break;
+        case Stat::Incremental:
+            if (!a.length())
+            {
+                ec << "manifest filename is not specified";
+                return 1;
+            }
+            incremental = std::make_shared<IncrementalBuild>(a);
+            stat = Stat::None;
+            break;
         }
 	}
 
@@ -133,7 +148,7 @@ int main(int argc, char **argv)
 
 	std::stringstream ss;
 	ss << in->rdbuf();
-    if (!Job_JSON::build(ss.str(), cr, job, ec))
+    if (!Job_JSON::build(ss.str(), cr, incremental, job, ec))
 		return 1;
 
 	if (!job->run(ec))
@@ -0,0 +1,1136 @@
+/*
+    This file is part of pidlBackend.
+
+    pidlBackend is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlBackend is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlBackend.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "include/pidlBackend/binary_stl_codegen.h"
+#include "include/pidlBackend/language.h"
+
+#include <functional>
+#include <map>
+
+namespace PIDL
+{
+
+	struct Binary_STL_CodeGen::Priv
+	{
+		Priv(Binary_STL_CodeGen * that, const std::shared_ptr<CPPCodeGenHelper> & helper, const std::set<Flag> & flags) :
+			that(that),
+			helper(helper),
+			flags(flags)
+		{ }
+
+		Binary_STL_CodeGen * that;
+		std::shared_ptr<CPPCodeGenHelper> helper;
+		std::set<Flag> flags;
+
+		bool useOptional() const
+		{
+			return flags.count(Flag::UseOptional);
+		}
+
+		bool hasObjects(Language::Interface * intf)
+		{
+			for (auto & d : intf->definitions())
+			{
+				if (d->kind() == Language::Element::Kind::Object)
+					return true;
+			}
+			return false;
+		}
+
+		//the templated writers are instantiated for interfaces and objects
+		static Language::Interface * asInterface(Language::Interface * intf)
+		{
+			return intf;
+		}
+
+		static Language::Interface * asInterface(Language::Object *)
+		{
+			return nullptr;
+		}
+
+		template<class T>
+		std::string getScope(const T * t)
+		{
+			std::string ret;
+			for (auto & sc : t->scope())
+				ret += sc + "::";
+			return ret;
+		}
+
+		void writeLogging(short code_deepness, CPPCodeGenContext * ctx, const std::string & logger, const std::string & message)
+		{
+			if (helper->logging())
+				helper->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, logger, message);
+		}
+
+		//'values' are read one after the other by '_readValue' of 'p'; the first failure executes 'on_error'
+		void writeRead(short code_deepness, CPPCodeGenContext * ctx, const std::string & p, const char * reader, const char * ec,
+		               const std::vector<std::string> & values, bool at_end, const char * on_error)
+		{
+			std::vector<std::string> conditions;
+			for (auto & v : values)
+				conditions.push_back("!" + p + "->_readValue(" + reader + ", " + v + ", " + ec + ")");
+			if (at_end)
+				conditions.push_back("!" + p + "->_readEnd(" + reader + ", " + ec + ")");
+			if (!conditions.size())
+				return;
+
+			auto & o = ctx->writeTabs(code_deepness) << "if (";
+			for (size_t i = 0; i < conditions.size(); ++i)
+			{
+				if (i)
+					ctx->writeTabs(code_deepness + 1) << "|| ";
+				o << conditions[i];
+				if (i + 1 < conditions.size())
+					o << std::endl;
+			}
+			o << ")" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << on_error << std::endl;
+		}
+
+		//client side: the request is written into '_buffer'
+		void writeRequest(short code_deepness, CPPCodeGenContext * ctx, const std::string & p, const char * object_data, const char * kind,
+		                  const std::string & name, const std::string * variant, const std::vector<std::string> & values)
+		{
+			ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::Buffer _buffer;" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::Writer _w(_buffer);" << std::endl;
+			ctx->writeTabs(code_deepness) << "_w.writeVarUInt(" << PIDL_BINARY_MARSHALLING_VERSION << ");" << std::endl;
+			if (object_data)
+			{
+				ctx->writeTabs(code_deepness) << "_w.writeByte(PIDL::BinaryTools::ObjectCall);" << std::endl;
+				ctx->writeTabs(code_deepness) << p << "->_writeValue(_w, " << object_data << ");" << std::endl;
+				ctx->writeTabs(code_deepness) << "_w.writeByte(PIDL::BinaryTools::" << kind << ");" << std::endl;
+			}
+			else
+				ctx->writeTabs(code_deepness) << "_w.writeByte(PIDL::BinaryTools::FunctionCall);" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::writeValue(_w, \"" << name << "\");" << std::endl;
+			if (variant)
+				ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::writeValue(_w, \"" << *variant << "\");" << std::endl;
+			for (auto & v : values)
+				ctx->writeTabs(code_deepness) << p << "->_writeValue(_w, " << v << ");" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::Buffer _ret;" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (!" << p << "->_invokeCall(_buffer, _ret, _ec))" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
+		}
+
+		std::string handlerName(Language::FunctionVariant * function, size_t idx)
+		{
+			return std::string("_function_") + function->name() + "_" + std::to_string(idx);
+		}
+
+		template<class Class_T>
+		std::vector<Handler> handlers(Class_T * cl)
+		{
+			std::vector<Handler> ret;
+			std::map<std::string, size_t> variant_idx;
+			for (auto & d : cl->definitions())
+			{
+				if (d->kind() == Language::Element::Kind::FunctionVariant || d->kind() == Language::Element::Kind::MethodVariant)
+				{
+					auto function = static_cast<Language::FunctionVariant*>(d.get());
+					ret.push_back({ function->name(), function->variantId(), handlerName(function, variant_idx[function->name()]++) });
+				}
+				else if (d->kind() == Language::Element::Kind::Property)
+				{
+					auto property = static_cast<Language::Property*>(d.get());
+					ret.push_back({ property->name(), "get", std::string("_property_get_") + property->name() });
+					if (!property->readOnly())
+						ret.push_back({ property->name(), "set", std::string("_property_set_") + property->name() });
+				}
+			}
+			auto intf = asInterface(cl);
+			if (intf && hasObjects(intf))
+				ret.push_back({ "_dispose_object", std::string(), "_function__dispose_object" });
+			return ret;
+		}
+
+		template<class Class_T>
+		bool writePrivateMembers(short code_deepness, CPPCodeGenContext * ctx, Class_T * cl, ErrorCollector & ec)
+		{
+			ctx->writeTabs(code_deepness) << "//private members" << std::endl << std::endl;
+
+			switch (ctx->role())
+			{
+			case Role::Server:
+				ctx->writeTabs(code_deepness) << "_invoke_status _callFunction(const std::string & name, const std::string & variant, PIDL::BinaryTools::Reader & r, PIDL::BinaryTools::Writer & ret, _error_collector & ec)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				{
+					auto hs = handlers(cl);
+					if (hs.size())
+						that->writeLookup(code_deepness, ctx, hs,
+							[&](short d, const Handler & h) { ctx->writeTabs(d) << "return " << h.member << "(r, ret, ec);" << std::endl; },
+							[&](short d) {
+								ctx->writeTabs(d) << "ec << \"variant '\" + variant + \"' of function '\" + name + \"'is not found\";" << std::endl;
+								ctx->writeTabs(d) << "return _invoke_status::NotImplemented;" << std::endl;
+							});
+					else
+						ctx->writeTabs(code_deepness) << "(void)variant; (void)r; (void)ret;" << std::endl;
+				}
+				ctx->writeTabs(code_deepness) << "ec << \"function '\" + name + \"'is not found\";" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _invoke_status::NotImplemented;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+				ctx->writeTabs(code_deepness) << "template<class F> _invoke_status _callFunction(F && func, _error_collector & ec)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "try" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "func();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (exception & e)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "e.get(ec); " << std::endl;
+				ctx->writeTabs(code_deepness) << "return _invoke_status::Error;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (std::exception & e)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "ec.add((long)_invoke_status::FatalError, std::string() + \"unhandled exception: '\" + e.what() + \"'\");" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _invoke_status::FatalError;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (...)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "ec.add((long)_invoke_status::FatalError, \"unknown unhandled exception\");" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _invoke_status::FatalError;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _invoke_status::Ok;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+				if (!writeHandlers(cl, code_deepness, ctx, ec))
+					return false;
+
+				break;
+			case Role::Client:
+				ctx->writeTabs(code_deepness) << "bool _invokeCall(const PIDL::BinaryTools::Buffer & request, PIDL::BinaryTools::Buffer & ret, _error_collector & ec)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				if (cl->kind() == Language::Element::Kind::Object)
+					ctx->writeTabs(code_deepness) << "auto status = _intf->_invoke(request.data(), request.size(), ret, ec);" << std::endl;
+				else
+					ctx->writeTabs(code_deepness) << "auto status = _that->_invoke(request.data(), request.size(), ret, ec);" << std::endl;
+				ctx->writeTabs(code_deepness) << "switch(status)" << std::endl;
+				ctx->writeTabs(code_deepness) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "case _invoke_status::Ok: break;" << std::endl;
+				ctx->writeTabs(code_deepness) << "case _invoke_status::NotImplemented:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"function is not implemented\"); return false;" << std::endl;
+				ctx->writeTabs(code_deepness) << "case _invoke_status::Error:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"error while executing server function\"); return false;" << std::endl;
+				ctx->writeTabs(code_deepness) << "case _invoke_status::FatalError:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"fatal error while executing server function\"); return false;" << std::endl;
+				ctx->writeTabs(code_deepness) << "case _invoke_status::MarshallingError:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"error while marshalling of function call\"); return false;" << std::endl;
+				ctx->writeTabs(code_deepness) << "case _invoke_status::NotSupportedMarshallingVersion:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"not supported marshalling version\"); return false;" << std::endl;
+				ctx->writeTabs(code_deepness) << "}" << std::endl << std::endl;
+				ctx->writeTabs(code_deepness) << "return true;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				break;
+			}
+
+			if (auto intf = asInterface(cl))
+				writeMarshalers(code_deepness, ctx, intf);
+
+			return true;
+		}
+
+		void writeMarshalers(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf)
+		{
+			ctx->writeTabs(code_deepness) << "//marshalers" << std::endl;
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::BinaryTools::Writer & w, const T & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ PIDL::BinaryTools::writeValue(w, v); }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::BinaryTools::Writer & w, const array<T> & values)" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "w.writeVarUInt(values.size());" << std::endl;
+			ctx->writeTabs(code_deepness) << "for (auto & _v : values)" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "_writeValue(w, _v);" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::BinaryTools::Writer & w, const nullable<T> & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ w.writeByte(v ? 1 : 0); if (v) _writeValue(w, *v); }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::BinaryTools::Writer & w, const nullable_const_ref<T> & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ w.writeByte(v ? 1 : 0); if (v) _writeValue(w, *v); }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "void _writeValue(PIDL::BinaryTools::Writer & w, const blob & data)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ PIDL::BinaryTools::writeValue(w, data); }" << std::endl << std::endl;
+
+			//tuple
+			ctx->writeTabs(code_deepness) << "struct _tuple_writeValue_functor" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "_tuple_writeValue_functor(_Priv * priv_, PIDL::BinaryTools::Writer & w_) : priv(priv_), w(w_) { }" << std::endl;
+			ctx->writeTabs(code_deepness) << "_Priv * priv;" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::Writer & w;" << std::endl;
+			ctx->writeTabs(code_deepness) << "template<typename T> void operator () (const T & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ priv->_writeValue(w, v); }" << std::endl;
+			ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename ...T> void _writeValue(PIDL::BinaryTools::Writer & w, const tuple<T...> & values)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ _tuple_writeValue_functor f(this, w); PIDL::BinaryTools::for_each_in_tuple(values, f); }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> bool _readValue(PIDL::BinaryTools::Reader & r, T & ret, _error_collector & ec)" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (!PIDL::BinaryTools::readValue(r, ret))" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ ec << \"value is invalid\"; return false; }" << std::endl;
+			ctx->writeTabs(code_deepness) << "return true;" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> bool _readValue(PIDL::BinaryTools::Reader & r, array<T> & ret, _error_collector & ec)" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "size_t size;" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (!PIDL::BinaryTools::readSize(r, size))" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ ec << \"value is not array\"; return false; }" << std::endl;
+			ctx->writeTabs(code_deepness) << "ret.resize(size);" << std::endl;
+			ctx->writeTabs(code_deepness) << "for (auto & _v : ret)" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "if (!_readValue(r, _v, ec)) return false;" << std::endl;
+			ctx->writeTabs(code_deepness) << "return true;" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> bool _readValue(PIDL::BinaryTools::Reader & r, nullable<T> & ret, _error_collector & ec)" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "bool not_null;" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (!_readValue(r, not_null, ec))" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "return false;" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (!not_null)" << std::endl;
+			if (useOptional())
+				ctx->writeTabs(code_deepness) << "{ ret.reset(); return true; }" << std::endl;
+			else
+				ctx->writeTabs(code_deepness) << "{ ret.setNull(); return true; }" << std::endl;
+			ctx->writeTabs(code_deepness) << "return _readValue(r, ret.emplace(), ec);" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "bool _readValue(PIDL::BinaryTools::Reader & r, blob & ret, _error_collector & ec)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ return _readValue<blob>(r, ret, ec); }" << std::endl << std::endl;
+
+			//tuple
+			ctx->writeTabs(code_deepness) << "struct _tuple_readValue_functor" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "_tuple_readValue_functor(_Priv * priv_, PIDL::BinaryTools::Reader & r_, _error_collector & ec_) : priv(priv_), r(r_), ec(ec_) { }" << std::endl;
+			ctx->writeTabs(code_deepness) << "_Priv * priv;" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::Reader & r;" << std::endl;
+			ctx->writeTabs(code_deepness) << "_error_collector & ec;" << std::endl;
+			ctx->writeTabs(code_deepness) << "bool ok = true;" << std::endl;
+			ctx->writeTabs(code_deepness) << "template<typename T> void operator () (T & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ ok = ok && priv->_readValue(r, v, ec); }" << std::endl;
+			ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename ...T> bool _readValue(PIDL::BinaryTools::Reader & r, tuple<T...> & ret, _error_collector & ec)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ _tuple_readValue_functor f(this, r, ec); PIDL::BinaryTools::for_each_in_tuple(ret, f); return f.ok; }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "bool _readEnd(PIDL::BinaryTools::Reader & r, _error_collector & ec)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ if (!r.atEnd()) { ec << \"unexpected data at the end of the message\"; return false; } return true; }" << std::endl << std::endl;
+
+			std::function<void(Language::DefinitionProvider * cl)> add_marshalers = [&](Language::DefinitionProvider * cl) {
+				for (auto & d : cl->definitions())
+				{
+					if (d->kind() == Language::Element::Kind::TypeDefinition)
+					{
+						auto td = static_cast<Language::TypeDefinition*>(d.get());
+						if (td->type()->kind() == Language::Element::Kind::Structure)
+						{
+							auto s = static_cast<Language::Structure*>(td->type().get());
+							auto & members = s->members();
+							ctx->writeTabs(code_deepness) << "void _writeValue(PIDL::BinaryTools::Writer & w, const " << getScope(td) << td->name() << " & in)" << std::endl;
+							ctx->writeTabs(code_deepness++) << "{" << std::endl;
+							if (!members.size())
+								ctx->writeTabs(code_deepness) << "(void)w; (void)in;" << std::endl;
+							for (auto & m : members)
+								ctx->writeTabs(code_deepness) << "_writeValue(w, in." << m->name() << ");" << std::endl;
+							ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+							ctx->writeTabs(code_deepness) << "bool _readValue(PIDL::BinaryTools::Reader & r, " << getScope(td) << td->name() << " & ret, _error_collector & ec)" << std::endl;
+							ctx->writeTabs(code_deepness++) << "{" << std::endl;
+							if (members.size())
+							{
+								ctx->writeTabs(code_deepness) << "return" << std::endl;
+								bool is_first = true;
+								for (auto & m : members)
+								{
+									ctx->writeTabs(code_deepness + 1) << (is_first ? "   " : "&& ") << "_readValue(r, ret." << m->name() << ", ec)" << std::endl;
+									is_first = false;
+								}
+								ctx->writeTabs(code_deepness) << ";" << std::endl;
+							}
+							else
+							{
+								ctx->writeTabs(code_deepness) << "(void)r; (void)ret; (void)ec;" << std::endl;
+								ctx->writeTabs(code_deepness) << "return true;" << std::endl;
+							}
+							ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+						}
+					}
+					else if (d->kind() == Language::Element::Kind::Object)
+					{
+						auto obj = static_cast<Language::Object*>(d.get());
+						auto obj_type = getScope(obj) + obj->name();
+						ctx->writeTabs(code_deepness) << "void _writeValue(PIDL::BinaryTools::Writer & w, const ptr<" << obj_type << "> & in)" << std::endl;
+						ctx->writeTabs(code_deepness) << "{ w.writeByte(in ? 1 : 0); if (in) PIDL::BinaryTools::writeValue(w, in->_data()); }" << std::endl << std::endl;
+
+						ctx->writeTabs(code_deepness) << "bool _readValue(PIDL::BinaryTools::Reader & r, ptr<" << obj_type << "> & ret, _error_collector & ec)" << std::endl;
+						ctx->writeTabs(code_deepness++) << "{" << std::endl;
+						ctx->writeTabs(code_deepness) << "nullable<std::string> object_data;" << std::endl;
+						ctx->writeTabs(code_deepness) << "if (!_readValue(r, object_data, ec))" << std::endl;
+						ctx->writeTabs(code_deepness + 1) << "return false;" << std::endl;
+						ctx->writeTabs(code_deepness) << "if (!object_data)" << std::endl;
+						ctx->writeTabs(code_deepness) << "{ ret.reset(); return true; }" << std::endl;
+						switch (ctx->role())
+						{
+						case Role::Client:
+							ctx->writeTabs(code_deepness) << "ret = std::make_shared<" << obj_type << ">(_that, *object_data);" << std::endl;
+							ctx->writeTabs(code_deepness) << "return true;" << std::endl;
+							break;
+						case Role::Server:
+							ctx->writeTabs(code_deepness) << "return (bool)(ret = _intf->_get_object<" << obj_type << ">(*object_data, ec));" << std::endl;
+							break;
+						}
+						ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+						add_marshalers(obj);
+					}
+				}
+			};
+
+			add_marshalers(intf);
+		}
+
+		//the functions, methods and properties are served by members of '_Priv' (see 'handlers()')
+		template<class Class_T>
+		bool writeHandlers(Class_T * cl, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+		{
+			std::map<std::string, size_t> variant_idx;
+			auto write_privs = [&](bool is_object) {
+				if (is_object)
+					switch (ctx->mode())
+					{
+						case Mode::AllInOne:
+							ctx->writeTabs(code_deepness) << "auto _intf_p = _intf;" << std::endl;
+							break;
+						case Mode::Declaration:
+							break;
+						case Mode::Implementatinon:
+							ctx->writeTabs(code_deepness) << "auto _intf_p = _intf->_priv;" << std::endl;
+							break;
+					}
+				else
+					ctx->writeTabs(code_deepness) << "auto _intf_p = this;" << std::endl;
+			};
+
+			for (auto & d : cl->definitions())
+			{
+				if (d->kind() == Language::Element::Kind::FunctionVariant || d->kind() == Language::Element::Kind::MethodVariant)
+				{
+					auto function = static_cast<Language::FunctionVariant*>(d.get());
+					bool is_method = function->kind() == Language::Element::Kind::MethodVariant;
+					ctx->writeTabs(code_deepness) << "_invoke_status " << handlerName(function, variant_idx[function->name()]++) << "(PIDL::BinaryTools::Reader & r, PIDL::BinaryTools::Writer & ret, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					write_privs(is_method);
+
+					writeLogging(code_deepness, ctx, "_logger", std::string() + "\"" + (is_method ? "method: '" : "function: '") +
+						function->name() + "' variant: '" + function->variantId() + "'\"");
+
+					for (auto & a : function->arguments())
+					{
+						auto & o = ctx->writeTabs(code_deepness);
+						if (!that->writeType(a->type().get(), code_deepness, ctx, ec))
+							return false;
+						o << " _arg_" << a->name() << ";" << std::endl;
+					}
+
+					std::vector<std::string> in_args;
+					for (auto & a : function->in_arguments())
+						in_args.push_back(std::string("_arg_") + a->name());
+					writeRead(code_deepness, ctx, "_intf_p", "r", "ec", in_args, true, "return _invoke_status::MarshallingError;");
+
+					auto ret_type = function->returnType().get();
+					if (ret_type->kind() == Language::Element::Kind::Void)
+						ret_type = nullptr;
+					if (ret_type)
+					{
+						ctx->writeTabs(code_deepness);
+						if (!that->writeType(ret_type, code_deepness, ctx, ec))
+							return false;
+						*ctx << " retval;" << std::endl;
+					}
+
+					auto & o = ctx->writeTabs(code_deepness);
+					o << "auto stat = _callFunction([&](){";
+					if (ret_type)
+						o << " retval =";
+					o << " _that->" << function->name() << "(";
+					bool is_first = true;
+					for (auto & a : function->arguments())
+					{
+						if (!is_first)
+							o << ", ";
+						is_first = false;
+						o << "_arg_" << a->name();
+					}
+					o << "); }, ec);" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (stat != _invoke_status::Ok)" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "return stat;" << std::endl;
+
+					if (ret_type)
+						ctx->writeTabs(code_deepness) << "_intf_p->_writeValue(ret, retval);" << std::endl;
+					for (auto & a : function->out_arguments())
+						ctx->writeTabs(code_deepness) << "_intf_p->_writeValue(ret, _arg_" << a->name() << ");" << std::endl;
+					if (!ret_type && !function->out_arguments().size())
+						ctx->writeTabs(code_deepness) << "(void)ret;" << std::endl;
+
+					ctx->writeTabs(code_deepness) << "return _invoke_status::Ok;" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				}
+				else if (d->kind() == Language::Element::Kind::Property)
+				{
+					auto property = static_cast<Language::Property*>(d.get());
+				//getter
+					ctx->writeTabs(code_deepness) << "_invoke_status _property_get_" << property->name() << "(PIDL::BinaryTools::Reader & r, PIDL::BinaryTools::Writer & ret, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					write_privs(true);
+
+					writeLogging(code_deepness, ctx, "_logger", "\"property getter: '" + std::string(property->name()) + "'\"");
+
+					writeRead(code_deepness, ctx, "_intf_p", "r", "ec", { }, true, "return _invoke_status::MarshallingError;");
+
+					ctx->writeTabs(code_deepness);
+					if (!that->writeType(property->type().get(), code_deepness, ctx, ec))
+						return false;
+					*ctx << " retval;" << std::endl;
+
+					ctx->writeTabs(code_deepness) << "auto stat = _callFunction([&](){ retval = _that->get_" << property->name() << "(); }, ec);" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (stat != _invoke_status::Ok)" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "return stat;" << std::endl;
+					ctx->writeTabs(code_deepness) << "_intf_p->_writeValue(ret, retval);" << std::endl;
+					ctx->writeTabs(code_deepness) << "return _invoke_status::Ok;" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+				//setter
+					if (!property->readOnly())
+					{
+						ctx->writeTabs(code_deepness) << "_invoke_status _property_set_" << property->name() << "(PIDL::BinaryTools::Reader & r, PIDL::BinaryTools::Writer & ret, _error_collector & ec)" << std::endl;
+						ctx->writeTabs(code_deepness++) << "{" << std::endl;
+						write_privs(true);
+						ctx->writeTabs(code_deepness) << "(void)ret;" << std::endl;
+
+						writeLogging(code_deepness, ctx, "_logger", "\"property setter: '" + std::string(property->name()) + "'\"");
+
+						ctx->writeTabs(code_deepness);
+						if (!that->writeType(property->type().get(), code_deepness, ctx, ec))
+							return false;
+						*ctx << " value;" << std::endl;
+						writeRead(code_deepness, ctx, "_intf_p", "r", "ec", { "value" }, true, "return _invoke_status::MarshallingError;");
+						ctx->writeTabs(code_deepness) << "return _callFunction([&](){ _that->set_" << property->name() << "(value); }, ec);" << std::endl;
+						ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+					}
+				}
+			}
+
+			auto intf = asInterface(cl);
+			if (intf && hasObjects(intf))
+			{
+				ctx->writeTabs(code_deepness) << "_invoke_status _function__dispose_object(PIDL::BinaryTools::Reader & r, PIDL::BinaryTools::Writer & ret, _error_collector & ec)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				write_privs(false);
+				ctx->writeTabs(code_deepness) << "(void)ret;" << std::endl;
+
+				writeLogging(code_deepness, ctx, "_logger", "\"embedded function: '_dispose_object'\"");
+
+				ctx->writeTabs(code_deepness) << "std::string _arg_object_data;" << std::endl;
+				writeRead(code_deepness, ctx, "_intf_p", "r", "ec", { "_arg_object_data" }, true, "return _invoke_status::MarshallingError;");
+				ctx->writeTabs(code_deepness) << "return _callFunction([&]() { _that->_dispose_object(_arg_object_data); }, ec);" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+			}
+
+			return true;
+		}
+
+		//client side: reads the return value, the output arguments and the state of the object from '_ret'
+		bool writeResponse(short code_deepness, CPPCodeGenContext * ctx, Language::Type * ret_type, const std::vector<std::string> & out_args, bool object_data, ErrorCollector & ec)
+		{
+			std::vector<std::string> values;
+			if (ret_type)
+			{
+				ctx->writeTabs(code_deepness);
+				if (!that->writeType(ret_type, code_deepness, ctx, ec))
+					return false;
+				*ctx << " _retval;" << std::endl;
+				values.push_back("_retval");
+			}
+			values.insert(values.end(), out_args.begin(), out_args.end());
+			if (object_data)
+				values.push_back("_p->__data");
+
+			if (values.size())
+			{
+				ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::Reader _r(_ret.data(), _ret.size());" << std::endl;
+				writeRead(code_deepness, ctx, "_intf_p", "_r", "_ec", values, false, "_ec.throwException();");
+			}
+
+			if (ret_type)
+				ctx->writeTabs(code_deepness) << "return _retval;" << std::endl;
+			return true;
+		}
+	};
+
+	Binary_STL_CodeGen::Binary_STL_CodeGen(const std::shared_ptr<CPPCodeGenHelper> & helper, const std::set<Flag> & flags) :
+		CPPCodeGen(),
+		priv(new Priv(this, helper, flags))
+	{ }
+
+	Binary_STL_CodeGen::Binary_STL_CodeGen() :
+		CPPCodeGen(),
+		priv(new Priv(this, std::make_shared<CPPBasicCodeGenHelper>(), std::set<Flag>()))
+	{ }
+
+	Binary_STL_CodeGen::~Binary_STL_CodeGen()
+	{
+		delete priv;
+	}
+
+	CPPCodeGenHelper * Binary_STL_CodeGen::helper() const
+	{
+		return priv->helper.get();
+	}
+
+	bool Binary_STL_CodeGen::writeIncludes(short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		auto core_path = helper()->coreIncludePath();
+		auto core_include = [&](const char * name) {
+			return std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/" + name : std::string(name));
+		};
+		switch (ctx->mode())
+		{
+		case Mode::AllInOne:
+		case Mode::Implementatinon:
+			if (!writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "cstring"), ec))
+				return false;
+			break;
+		case Mode::Declaration:
+			break;
+		}
+		return
+			writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "vector"), ec) &&
+			writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "tuple"), ec) &&
+			writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "string"), ec) &&
+			writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "memory"), ec) &&
+			writeInclude(code_deepness, ctx, core_include("datetime.h"), ec) &&
+			writeInclude(code_deepness, ctx, core_include("exception.h"), ec) &&
+			writeInclude(code_deepness, ctx, priv->useOptional() ? std::make_pair(IncludeType::GLobal, std::string("optional")) : core_include("nullable.h"), ec) &&
+			writeInclude(code_deepness, ctx, core_include("binarytools.h"), ec) &&
+			writeInclude(code_deepness, ctx, core_include("basictypes.h"), ec) &&
+			writeInclude(code_deepness, ctx, core_include("errorcollector.h"), ec);
+	}
+
+	bool Binary_STL_CodeGen::writeAliases(short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		(void)ec;
+		if (priv->useOptional())
+		{
+			ctx->writeTabs(code_deepness) << "template<typename T> using nullable = std::optional<T>;" << std::endl;
+			ctx->writeTabs(code_deepness) << "template<typename T> using nullable_const_ref = std::optional<const T &>;" << std::endl;
+		}
+		else
+		{
+			ctx->writeTabs(code_deepness) << "template<typename T> using nullable = PIDL::Nullable<T>;" << std::endl;
+			ctx->writeTabs(code_deepness) << "template<typename T> using nullable_const_ref = PIDL::NullableConstRef<T>;" << std::endl;
+		}
+		ctx->writeTabs(code_deepness) << "template<typename T> using array = std::vector<T>;" << std::endl;
+		ctx->writeTabs(code_deepness) << "template<typename ...T> using tuple = std::tuple<T...>;" << std::endl;
+		ctx->writeTabs(code_deepness) << "template<typename T> using ptr = std::shared_ptr<T>;" << std::endl;
+		ctx->writeTabs(code_deepness) << "using string = std::string;" << std::endl;
+		ctx->writeTabs(code_deepness) << "using datetime = PIDL::DateTime;" << std::endl;
+		ctx->writeTabs(code_deepness) << "using blob = std::vector<char>;" << std::endl;
+		ctx->writeTabs(code_deepness) << "using exception = PIDL::Exception;" << std::endl;
+		ctx->writeTabs(code_deepness) << "using _error_collector = PIDL::ErrorCollector;" << std::endl;
+		ctx->writeTabs(code_deepness) << "using _invoke_status = PIDL::InvokeStatus;" << std::endl << std::endl;
+
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writePrivateMembers(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
+	{
+		return priv->writePrivateMembers(code_deepness, ctx, intf, ec);
+	}
+
+	bool Binary_STL_CodeGen::writeInvoke(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
+	{
+		(void)ec;
+		switch (ctx->role())
+		{
+		case Role::Server:
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "_invoke_status _invoke(const char * request, size_t length, PIDL::BinaryTools::Buffer & ret, _error_collector & ec)";
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "_invoke_status " << intf->name() << "::_invoke(const char * request, size_t length, PIDL::BinaryTools::Buffer & ret, _error_collector & ec)";
+				break;
+			}
+
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+				*ctx << ";" << std::endl;
+				break;
+			case Mode::AllInOne:
+			case Mode::Implementatinon:
+				ctx->stream() << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				switch (ctx->mode())
+				{
+				case Mode::Declaration:
+					break;
+				case Mode::AllInOne:
+					ctx->writeTabs(code_deepness) << "auto * _p = this;" << std::endl << std::endl;
+					break;
+				case Mode::Implementatinon:
+					ctx->writeTabs(code_deepness) << "auto * _p = _priv;" << std::endl << std::endl;
+					break;
+				}
+
+				ctx->writeTabs(code_deepness) << "ret.clear();" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::Reader r(request, length);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::BinaryTools::Writer w(ret);" << std::endl << std::endl;
+
+				ctx->writeTabs(code_deepness) << "unsigned long long version;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!r.readVarUInt(version))" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ ec << \"could not detect mashalling version\"; return _invoke_status::MarshallingError; }" << std::endl << std::endl;
+				ctx->writeTabs(code_deepness) << "if (version != " << PIDL_BINARY_MARSHALLING_VERSION << ")" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ ec << \"unsupported mashalling version detected\"; return _invoke_status::NotSupportedMarshallingVersion; }" << std::endl << std::endl;
+
+				ctx->writeTabs(code_deepness) << "unsigned char call;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!r.readByte(call))" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ ec << \"invalid request\"; return _invoke_status::MarshallingError; }" << std::endl << std::endl;
+
+				ctx->writeTabs(code_deepness) << "if (call == PIDL::BinaryTools::FunctionCall)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "std::string name, variant;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!_p->_readValue(r, name, ec) || !_p->_readValue(r, variant, ec))" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+				ctx->writeTabs(code_deepness) << "ec.clear();" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _p->_callFunction(name, variant, r, w, ec);" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+
+				if (priv->hasObjects(intf))
+				{
+					ctx->writeTabs(code_deepness) << "else if (call == PIDL::BinaryTools::ObjectCall)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					ctx->writeTabs(code_deepness) << "std::string object_data;" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!_p->_readValue(r, object_data, ec))" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto obj = _get_object(object_data, ec);" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!obj)" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "return _invoke_status::Error;" << std::endl;
+					ctx->writeTabs(code_deepness) << "return obj->_invoke(r, w, ec);" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				}
+
+				ctx->writeTabs(code_deepness) << "ec << \"invalid request\";" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _invoke_status::MarshallingError;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				break;
+			}
+			break;
+		case Role::Client:
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "virtual _invoke_status _invoke(const char * request, size_t length, PIDL::BinaryTools::Buffer & ret, _error_collector & ec) = 0;" << std::endl;
+				break;
+			case Mode::Implementatinon:
+				break;
+			}
+			break;
+		}
+
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writeFunctionBody(Language::Interface * intf, Language::FunctionVariant * function, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		(void)intf;
+		switch (ctx->role())
+		{
+		case Role::Client:
+		{
+			bool is_method = function->kind() == Language::Element::Kind::MethodVariant;
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "auto _p = this;" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto _intf_p = " << (is_method ? "_p->_intf" : "this") << ";" << std::endl << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "auto _p = _priv;" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto _intf_p = " << (is_method ? "_p->_intf->_priv" : "_p") << ";" << std::endl << std::endl;
+				break;
+			case Mode::Declaration:
+				break;
+			}
+
+			priv->writeLogging(code_deepness, ctx, "_p->_logger", std::string() + "\"" + (is_method ? "method" : "function") + ": '" +
+				function->name() + "' variant: '" + function->variantId() + "'\"");
+
+			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
+
+			std::vector<std::string> in_args, out_args;
+			for (auto & a : function->in_arguments())
+				in_args.push_back(a->name());
+			for (auto & a : function->out_arguments())
+				out_args.push_back(a->name());
+
+			std::string variant = function->variantId();
+			priv->writeRequest(code_deepness, ctx, "_intf_p", is_method ? "_p->__data" : nullptr, "MethodCall", function->name(), &variant, in_args);
+
+			auto ret_type = function->returnType().get();
+			if (ret_type->kind() == Language::Element::Kind::Void)
+				ret_type = nullptr;
+			return priv->writeResponse(code_deepness, ctx, ret_type, out_args, is_method, ec);
+		}
+		case Role::Server:
+			break;
+		}
+
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writeConstructorBody(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		//nothing is registered at construction, calls are dispatched by the generated '_callFunction'
+		(void)intf; (void)code_deepness; (void)ctx; (void)ec;
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writeInvoke(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Object * object, ErrorCollector & ec)
+	{
+		(void)intf;
+		(void)ec;
+		switch (ctx->role())
+		{
+		case Role::Server:
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "_invoke_status _invoke(PIDL::BinaryTools::Reader & r, PIDL::BinaryTools::Writer & ret, _error_collector & ec)";
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness)
+					<< "_invoke_status " << priv->getScope(object) << object->name()
+					<< "::_invoke(PIDL::BinaryTools::Reader & r, PIDL::BinaryTools::Writer & ret, _error_collector & ec)";
+				break;
+			}
+
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+				*ctx << ";" << std::endl;
+				break;
+			case Mode::AllInOne:
+			case Mode::Implementatinon:
+				ctx->stream() << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				switch (ctx->mode())
+				{
+				case Mode::Declaration:
+					break;
+				case Mode::AllInOne:
+					ctx->writeTabs(code_deepness) << "auto * _p = this;" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto * _intf_p = _p->_intf;" << std::endl << std::endl;
+					break;
+				case Mode::Implementatinon:
+					ctx->writeTabs(code_deepness) << "auto * _p = _priv;" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto * _intf_p = _p->_intf->_priv;" << std::endl << std::endl;
+					break;
+				}
+
+				ctx->writeTabs(code_deepness) << "unsigned char kind;" << std::endl;
+				ctx->writeTabs(code_deepness) << "std::string name, variant;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!r.readByte(kind) || !_intf_p->_readValue(r, name, ec))" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+				ctx->writeTabs(code_deepness) << "_invoke_status stat;" << std::endl;
+				ctx->writeTabs(code_deepness) << "switch (kind)" << std::endl;
+				ctx->writeTabs(code_deepness) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "case PIDL::BinaryTools::MethodCall:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "if (!_intf_p->_readValue(r, variant, ec))" << std::endl;
+				ctx->writeTabs(code_deepness + 2) << "return _invoke_status::MarshallingError;" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec.clear();" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "stat = _p->_callFunction(name, variant, r, ret, ec);" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "break;" << std::endl;
+				ctx->writeTabs(code_deepness) << "case PIDL::BinaryTools::PropertyGet:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec.clear();" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "stat = _p->_callFunction(name, \"get\", r, ret, ec);" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "break;" << std::endl;
+				ctx->writeTabs(code_deepness) << "case PIDL::BinaryTools::PropertySet:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec.clear();" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "stat = _p->_callFunction(name, \"set\", r, ret, ec);" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "break;" << std::endl;
+				ctx->writeTabs(code_deepness) << "default:" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ec << \"invalid object call\";" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+				ctx->writeTabs(code_deepness) << "}" << std::endl;
+				//the state of the object is sent back with the response of every object call
+				ctx->writeTabs(code_deepness) << "if (stat == _invoke_status::Ok)" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_intf_p->_writeValue(ret, _data());" << std::endl;
+				ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				break;
+			}
+			break;
+		case Role::Client:
+			break;
+		}
+
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writePrivateMembers(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Object * object, ErrorCollector & ec)
+	{
+		(void)intf;
+		return priv->writePrivateMembers(code_deepness, ctx, object, ec);
+	}
+
+	bool Binary_STL_CodeGen::writePropertyGetterBody(Language::Interface * intf, Language::Property * property, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		(void)intf;
+		switch (ctx->role())
+		{
+		case Role::Client:
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "auto _p = this;" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto * _intf_p = _p->_intf;" << std::endl << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "auto _p = _priv;" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto * _intf_p = _p->_intf->_priv;" << std::endl << std::endl;
+				break;
+			case Mode::Declaration:
+				break;
+			}
+
+			priv->writeLogging(code_deepness, ctx, "_p->_logger", "\"property getter: '" + std::string(property->name()) + "'\"");
+
+			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
+			priv->writeRequest(code_deepness, ctx, "_intf_p", "_p->__data", "PropertyGet", property->name(), nullptr, { });
+			return priv->writeResponse(code_deepness, ctx, property->type().get(), { }, true, ec);
+		case Role::Server:
+			break;
+		}
+
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writePropertySetterBody(Language::Interface * intf, Language::Property * property, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		(void)intf;
+		switch (ctx->role())
+		{
+		case Role::Client:
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "auto _p = this;" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto * _intf_p = _p->_intf;" << std::endl << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "auto _p = _priv;" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto * _intf_p = _p->_intf->_priv;" << std::endl << std::endl;
+				break;
+			case Mode::Declaration:
+				break;
+			}
+
+			priv->writeLogging(code_deepness, ctx, "_p->_logger", "\"property setter: '" + std::string(property->name()) + "'\"");
+
+			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
+			priv->writeRequest(code_deepness, ctx, "_intf_p", "_p->__data", "PropertySet", property->name(), nullptr, { "value" });
+			return priv->writeResponse(code_deepness, ctx, nullptr, { }, true, ec);
+		case Role::Server:
+			break;
+		}
+
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writeConstructorBody(Language::Interface * intf, Language::Object * object, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		(void)intf; (void)object; (void)code_deepness; (void)ctx; (void)ec;
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writeObjectBase(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		(void)ec;
+		if (priv->hasObjects(intf))
+		{
+			ctx->writeTabs(code_deepness) << "class _Object" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness - 1) << "public:" << std::endl;
+			ctx->writeTabs(code_deepness) << "typedef ptr<_Object> Ptr;" << std::endl;
+			ctx->writeTabs(code_deepness) << "virtual ~_Object() = default;" << std::endl;
+			switch (ctx->role())
+			{
+			case Role::Client:
+				break;
+			case Role::Server:
+				ctx->writeTabs(code_deepness) << "virtual _invoke_status _invoke(PIDL::BinaryTools::Reader & r, PIDL::BinaryTools::Writer & ret, _error_collector & ec) = 0;" << std::endl;
+				break;
+			}
+			ctx->writeTabs(code_deepness) << "virtual std::string _data() = 0;" << std::endl;
+			ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
+		}
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writeProtectedSection(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
+	{
+		if (!CPPCodeGen::writeProtectedSection(code_deepness, ctx, intf, ec))
+			return false;
+		switch (ctx->mode())
+		{
+		case Mode::AllInOne:
+		case Mode::Declaration:
+			switch (ctx->role())
+			{
+			case Role::Client:
+				break;
+			case Role::Server:
+				if (priv->hasObjects(intf))
+				{
+					ctx->writeTabs(code_deepness) << "virtual ptr<_Object> _get_object(const std::string & object_data, _error_collector & ec) = 0;" << std::endl;
+					ctx->writeTabs(code_deepness) << "template<class Object_T> ptr<Object_T> _get_object(const std::string & object_data, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto o = _get_object(object_data, ec);" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!o) return nullptr;" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto ret = std::dynamic_pointer_cast<Object_T, _Object>(o);" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!ret) ec.add(-1, \"unexpected: invalid object type for data '\" + object_data + \"'\");" << std::endl;
+					ctx->writeTabs(code_deepness) << "return ret;" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl;
+					ctx->writeTabs(code_deepness) << "virtual void _dispose_object(const std::string & object_data) = 0;" << std::endl;
+				}
+				break;
+			}
+			break;
+		case Mode::Implementatinon:
+			break;
+		}
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writePublicSection(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
+	{
+		if (!CPPCodeGen::writePublicSection(code_deepness, ctx, intf, ec))
+			return false;
+		if (ctx->role() != Role::Client || !priv->hasObjects(intf))
+			return true;
+
+		switch (ctx->mode())
+		{
+		case Mode::AllInOne:
+		case Mode::Declaration:
+			ctx->writeTabs(code_deepness) << "void _dispose_object(const std::string & object_data)";
+			break;
+		case Mode::Implementatinon:
+			ctx->writeTabs(code_deepness) << "void " << priv->getScope(intf) << intf->name() << "::_dispose_object(const std::string & object_data)";
+			break;
+		}
+		switch (ctx->mode())
+		{
+		case Mode::Declaration:
+			*ctx << ";" << std::endl;
+			break;
+		case Mode::AllInOne:
+		case Mode::Implementatinon:
+			ctx->stream() << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "auto _p = this;" << std::endl << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "auto _p = _priv;" << std::endl << std::endl;
+				break;
+			}
+
+			priv->writeLogging(code_deepness, ctx, "_p->_logger", "\"embedded function: '_dispose_object'\"");
+
+			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
+			std::string variant;
+			priv->writeRequest(code_deepness, ctx, "_p", nullptr, nullptr, "_dispose_object", &variant, { "object_data" });
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+			break;
+		}
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writePublicSection(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Object * obj, ErrorCollector & ec)
+	{
+		if (!CPPCodeGen::writePublicSection(intf, code_deepness, ctx, obj, ec))
+			return false;
+
+		switch (ctx->role())
+		{
+		case Role::Client:
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "virtual std::string _data() override" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ return __data; }" << std::endl << std::endl;
+				break;
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "virtual std::string _data() override;" << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "std::string " << priv->getScope(obj) << obj->name() << "::_data()" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ return _priv->__data; }" << std::endl << std::endl;
+				break;
+			}
+			break;
+		case Role::Server:
+			break;
+		}
+
+		return true;
+	}
+
+	bool Binary_STL_CodeGen::writeDestructorBody(Language::Interface * intf, Language::Object * object, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+	{
+		switch (ctx->role())
+		{
+		case Role::Client:
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "try { _intf->_dispose_object(_data()); } catch(...) { }" << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "try { _intf->_dispose_object(_that->_data()); } catch(...) { }" << std::endl;
+				break;
+			case Mode::Declaration:
+				break;
+			}
+			break;
+		case Role::Server:
+			break;
+		}
+		return CPPCodeGen::writeDestructorBody(intf, object, code_deepness, ctx, ec);
+	}
+
+}
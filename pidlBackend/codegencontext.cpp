@@ -17,21 +17,91 @@ along with pidlBackend.  If not, see <http://www.gnu.org/licenses/>
 
 #include "include/pidlBackend/codegencontext.h"
 
+#include <string>
+#include <vector>
+
 namespace PIDL
 {
 
 	struct CodeGenContext::Priv
 	{
+		//growing put area; sync() (i.e. std::endl) does not reach the target unless the threshold is exceeded
+		class Buffer : public std::streambuf
+		{
+			std::ostream & target;
+			std::vector<char> data;
+		public:
+			size_t threshold;
+
+			Buffer(std::ostream & target_, size_t threshold_) :
+				target(target_),
+				data(64 * 1024),
+				threshold(threshold_)
+			{
+				setp(data.data(), data.data() + data.size());
+			}
+
+			size_t size() const
+			{
+				return (size_t)(pptr() - pbase());
+			}
+
+			void drain()
+			{
+				target.write(pbase(), (std::streamsize)size());
+				setp(data.data(), data.data() + data.size());
+			}
+
+		protected:
+			virtual int_type overflow(int_type c) override
+			{
+				if (traits_type::eq_int_type(c, traits_type::eof()))
+					return traits_type::not_eof(c);
+
+				if (threshold && size() >= threshold)
+					drain();
+				else
+				{
+					auto used = size();
+					data.resize(data.size() * 2);
+					setp(data.data(), data.data() + data.size());
+					pbump((int)used);
+				}
+				*pptr() = traits_type::to_char_type(c);
+				pbump(1);
+				return c;
+			}
+
+			virtual int sync() override
+			{
+				if (threshold && size() >= threshold)
+					drain();
+				return 0;
+			}
+		};
+
 		Priv(short tab_length_, char tab_char_, std::ostream & o_, Role role_) :
-			o(o_),
+			buffer(o_, PIDL_CODEGEN_FLUSH_THRESHOLD),
+			o(&buffer),
+			target(o_),
 			role(role_),
+			tabs(tab_length_ > 0 ? 32 * (size_t)tab_length_ : 0, tab_char_),
 			tab_length(tab_length_),
 			tab_char(tab_char_)
 		{ }
 
-		std::ostream & o;
+		void flush()
+		{
+			buffer.drain();
+			target.flush();
+		}
+
+		Buffer buffer;
+		std::ostream o;
+		std::ostream & target;
 		Role role;
 
+		std::string tabs;
 		short tab_length;
 		char tab_char;
 	};
@@ -42,6 +112,7 @@ namespace PIDL
 
 	CodeGenContext::~CodeGenContext()
 	{
+		priv->flush();
 		delete priv;
 	}
 
@@ -62,9 +133,22 @@ namespace PIDL
 
 	std::ostream & CodeGenContext::writeTabs(short code_deepness)
 	{
-		for (short i = 0, l = code_deepness * priv->tab_length; i < l; ++i)
-			priv->o << priv->tab_char;
-		return priv->o;
+		int l = code_deepness * priv->tab_length;
+		if (l <= 0)
+			return priv->o;
+		if ((size_t)l > priv->tabs.length())
+			priv->tabs.assign(2 * (size_t)l, priv->tab_char);
+		return priv->o.write(priv->tabs.data(), l);
+	}
+
+	void CodeGenContext::setFlushThreshold(size_t bytes)
+	{
+		priv->buffer.threshold = bytes;
+	}
+
+	void CodeGenContext::flush()
+	{
+		priv->flush();
 	}
 
 	//virtual 
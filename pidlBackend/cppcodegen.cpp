@@ -23,6 +23,8 @@
 
 #include <sstream>
 #include <algorithm>
+#include <map>
+#include <set>
 
 namespace PIDL
 {
@@ -57,6 +59,47 @@ namespace PIDL
 	CPPCodeGenLogging::CPPCodeGenLogging() : priv(nullptr){ }
 	CPPCodeGenLogging::~CPPCodeGenLogging() = default;
 
+	std::string CPPCodeGenLogging::levelMacro() const { return "PIDL_LOGGING_LEVEL"; }
+	std::string CPPCodeGenLogging::loggingEnabled(const std::string & logger, Level level) const { (void)logger; (void)level; return std::string(); }
+
+	void CPPCodeGenLogging::writeLogging(short code_deepness, CPPCodeGenContext * ctx, Level level, const std::string & logger, const std::string & message) const
+	{
+		std::string statement;
+		switch (level)
+		{
+		case Level::Trace: statement = loggingTrace(logger, message); break;
+		case Level::Debug: statement = loggingDebug(logger, message); break;
+		case Level::Info: statement = loggingInfo(logger, message); break;
+		case Level::Warning: statement = loggingWarning(logger, message); break;
+		case Level::Error: statement = loggingError(logger, message); break;
+		case Level::Fatal: statement = loggingFatal(logger, message); break;
+		}
+		auto starter = loggingStart(logger);
+		if (!starter.length() && !statement.length())
+			return;
+
+		auto macro = levelMacro();
+		if (macro.length())
+			*ctx << "#if !defined(" << macro << ") || " << macro << " <= " << (int)level << std::endl;
+
+		if (starter.length())
+			ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
+		if (statement.length())
+		{
+			auto enabled = loggingEnabled(logger, level);
+			if (enabled.length())
+			{
+				ctx->writeTabs(code_deepness) << "if (" << enabled << ")" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << statement << ";" << std::endl;
+			}
+			else
+				ctx->writeTabs(code_deepness) << statement << ";" << std::endl;
+		}
+
+		if (macro.length())
+			*ctx << "#endif" << std::endl;
+	}
+
 	CPPVoidLogging::CPPVoidLogging() : priv(nullptr)
 	{ }
 
@@ -80,6 +123,11 @@ namespace PIDL
 
 	CPPCodeGenHelper::~CPPCodeGenHelper() = default;
 
+	std::string CPPCodeGenHelper::instrumentationRegistry() const
+	{
+		return "PIDL::Instrumentation::Registry::global()";
+	}
+
 
 	struct CPPBasicCodeGenHelper::Priv
 	{
@@ -201,8 +249,8 @@ namespace PIDL
 			ctx->writeTabs(code_deepness) << "struct " << structure->name() << std::endl;
 			ctx->writeTabs(code_deepness++) << "{" << std::endl;
 
-			auto struct_type = dynamic_cast<Language::Structure*>(structure->type().get());
-			assert(struct_type);
+			assert(structure->type()->kind() == Language::Element::Kind::Structure);
+			auto struct_type = static_cast<Language::Structure*>(structure->type().get());
 
 			if (!addStructureBudy(code_deepness, ctx, struct_type, ec))
 				return false;
@@ -231,12 +279,13 @@ namespace PIDL
 		bool addGeneric(short code_deepness, CPPCodeGenContext * ctx, Language::Generic * generic, ErrorCollector & ec)
 		{
 			auto & o = ctx->stream();
-			if (dynamic_cast<Language::Nullable*>(generic))
-				o << "nullable<";
-			else if (dynamic_cast<Language::Array*>(generic))
-				o << "array<";
-			else if (dynamic_cast<Language::Tuple*>(generic))
-				o << "tuple<";
+			switch (generic->kind())
+			{
+			case Language::Element::Kind::Nullable: o << "nullable<"; break;
+			case Language::Element::Kind::Array: o << "array<"; break;
+			case Language::Element::Kind::Tuple: o << "tuple<"; break;
+			default: break;
+			}
 
 			bool is_first = true;
 			for (auto & t : generic->types())
@@ -257,12 +306,13 @@ namespace PIDL
 		{
             (void)ec;
             auto & o = ctx->stream();
-			if (dynamic_cast<Language::Integer*>(native))
-				o << "long long";
-			else if (dynamic_cast<Language::Float*>(native))
-				o << "double";
-			else if (dynamic_cast<Language::Boolean*>(native))
-				o << "bool";
+			switch (native->kind())
+			{
+			case Language::Element::Kind::Integer: o << "long long"; break;
+			case Language::Element::Kind::Float: o << "double"; break;
+			case Language::Element::Kind::Boolean: o << "bool"; break;
+			default: break;
+			}
 			return true;
 		}
 
@@ -270,12 +320,13 @@ namespace PIDL
 		{
             (void)ec;
             auto & o = ctx->stream();
-			if (dynamic_cast<Language::String*>(embedded))
-				o << "string";
-			else if (dynamic_cast<Language::DateTime*>(embedded))
-				o << "datetime";
-			else if (dynamic_cast<Language::Blob*>(embedded))
-				o << "blob";
+			switch (embedded->kind())
+			{
+			case Language::Element::Kind::String: o << "string"; break;
+			case Language::Element::Kind::DateTime: o << "datetime"; break;
+			case Language::Element::Kind::Blob: o << "blob"; break;
+			default: break;
+			}
 
 			return true;
         }
@@ -289,37 +340,28 @@ namespace PIDL
 
 		bool addType(short code_deepness, CPPCodeGenContext * ctx, Language::Type * type, ErrorCollector & ec)
 		{
-			if (dynamic_cast<Language::Generic*>(type))
-			{
-				if (!addGeneric(code_deepness, ctx, dynamic_cast<Language::Generic*>(type), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::NativeType*>(type))
-			{
-				if (!addNative(ctx, dynamic_cast<Language::NativeType*>(type), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::EmbeddedType*>(type))
-			{
-				if (!addEmbedded(ctx, dynamic_cast<Language::EmbeddedType*>(type), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::Structure*>(type))
-			{
-				if (!addStructure(code_deepness, ctx, dynamic_cast<Language::Structure*>(type), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::Object*>(type))
-			{
-				if (!addObject(ctx, dynamic_cast<Language::Object*>(type), ec))
-					return false;
-			}
-			else
+			switch (type->kind())
 			{
+			case Language::Element::Kind::Nullable:
+			case Language::Element::Kind::Array:
+			case Language::Element::Kind::Tuple:
+				return addGeneric(code_deepness, ctx, static_cast<Language::Generic*>(type), ec);
+			case Language::Element::Kind::Integer:
+			case Language::Element::Kind::Float:
+			case Language::Element::Kind::Boolean:
+				return addNative(ctx, static_cast<Language::NativeType*>(type), ec);
+			case Language::Element::Kind::String:
+			case Language::Element::Kind::DateTime:
+			case Language::Element::Kind::Blob:
+				return addEmbedded(ctx, static_cast<Language::EmbeddedType*>(type), ec);
+			case Language::Element::Kind::Structure:
+				return addStructure(code_deepness, ctx, static_cast<Language::Structure*>(type), ec);
+			case Language::Element::Kind::Object:
+				return addObject(ctx, static_cast<Language::Object*>(type), ec);
+			default:
 				*ctx << getScope(type) << type->name();
+				return true;
 			}
-
-			return true;
 		}
 
 		bool writeTypeDefinition(short code_deepness, CPPCodeGenContext * ctx, Language::TypeDefinition * type_definition, ErrorCollector & ec)
@@ -330,7 +372,7 @@ namespace PIDL
 			case Mode::Declaration:
 				{
 					auto type = type_definition->type().get();
-					if (dynamic_cast<Language::Structure*>(type))
+					if (type->kind() == Language::Element::Kind::Structure)
 					{
 						if (!addStructure(code_deepness, ctx, type_definition, ec))
 							return false;
@@ -827,39 +869,37 @@ namespace PIDL
 		
 		bool writeObjectDefinition(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Definition * definition, ErrorCollector & ec)
 		{
-			if (dynamic_cast<Language::Property*>(definition))
+			switch (definition->kind())
 			{
-				if (!writeProperty(intf, code_deepness, ctx, dynamic_cast<Language::Property*>(definition), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::Method*>(definition))
-			{
-				for (auto &v : dynamic_cast<Language::Method*>(definition)->variants())
-				if (!writeFunction(intf, code_deepness, ctx, v.second.get(), ec))
-					return false;
+			case Language::Element::Kind::Property:
+				return writeProperty(intf, code_deepness, ctx, static_cast<Language::Property*>(definition), ec);
+			case Language::Element::Kind::Method:
+				for (auto &v : static_cast<Language::Method*>(definition)->variants())
+					if (!writeFunction(intf, code_deepness, ctx, v.second.get(), ec))
+						return false;
+				return true;
+			default:
+				return true;
 			}
-			return true;
 		}
 
 		bool writeDefinition(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Definition * definition, ErrorCollector & ec)
 		{
-			if (dynamic_cast<Language::TypeDefinition*>(definition))
+			switch (definition->kind())
 			{
-				if (!writeTypeDefinition(code_deepness, ctx, dynamic_cast<Language::TypeDefinition*>(definition), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::Function*>(definition))
-			{
-				for (auto &v : dynamic_cast<Language::Function*>(definition)->variants())
+			case Language::Element::Kind::TypeDefinition:
+				return writeTypeDefinition(code_deepness, ctx, static_cast<Language::TypeDefinition*>(definition), ec);
+			case Language::Element::Kind::Function:
+			case Language::Element::Kind::Method:
+				for (auto &v : static_cast<Language::Function*>(definition)->variants())
 					if (!writeFunction(intf, code_deepness, ctx, v.second.get(), ec))
 						return false;
+				return true;
+			case Language::Element::Kind::Object:
+				return writeObject(intf, code_deepness, ctx, static_cast<Language::Object*>(definition), ec);
+			default:
+				return true;
 			}
-			else if (dynamic_cast<Language::Object*>(definition))
-			{
-				if (!writeObject(intf, code_deepness, ctx, dynamic_cast<Language::Object*>(definition), ec))
-					return false;
-			}
-			return true;
 		}
 
 		bool writeDefinitions(Language::Interface *, short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
@@ -873,8 +913,8 @@ namespace PIDL
 
                 //write predeclarations of objects
                 for (auto & definition : intf->definitions())
-                    if (auto o = dynamic_cast<Language::Object*>(definition.get()))
-                        ctx->writeTabs(code_deepness) << "class " << o->name() << ";" << std::endl;
+                    if (definition->kind() == Language::Element::Kind::Object)
+                        ctx->writeTabs(code_deepness) << "class " << static_cast<Language::Object*>(definition.get())->name() << ";" << std::endl;
 
                 break;
 			case Mode::Implementatinon:
@@ -882,20 +922,23 @@ namespace PIDL
 			}
 
             for (auto & definition : intf->definitions())
-                if (auto o = dynamic_cast<Language::TypeDefinition*>(definition.get()))
+                switch (definition->kind())
 				{
-                    if (!writeTypeDefinition(code_deepness, ctx, o, ec))
+				case Language::Element::Kind::TypeDefinition:
+                    if (!writeTypeDefinition(code_deepness, ctx, static_cast<Language::TypeDefinition*>(definition.get()), ec))
 						return false;
-				}
-                else if (auto o = dynamic_cast<Language::FunctionVariant*>(definition.get()))
-				{
-                    if (!writeFunction(intf, code_deepness, ctx, o, ec))
+					break;
+				case Language::Element::Kind::FunctionVariant:
+				case Language::Element::Kind::MethodVariant:
+                    if (!writeFunction(intf, code_deepness, ctx, static_cast<Language::FunctionVariant*>(definition.get()), ec))
 						return false;
-				}
-                else if (auto o = dynamic_cast<Language::Object*>(definition.get()))
-				{
-                    if (!writeObject(intf, code_deepness, ctx, o, ec))
+					break;
+				case Language::Element::Kind::Object:
+                    if (!writeObject(intf, code_deepness, ctx, static_cast<Language::Object*>(definition.get()), ec))
 						return false;
+					break;
+				default:
+					break;
 				}
 
 			return true;
@@ -904,26 +947,27 @@ namespace PIDL
 		bool writeDefinitions(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Object * obj, ErrorCollector & ec)
 		{
 			for (auto & definition : obj->definitions())
-                if (auto o = dynamic_cast<Language::TypeDefinition*>(definition.get()))
+                switch (definition->kind())
                 {
-                    if (!writeTypeDefinition(code_deepness, ctx, o, ec))
+                case Language::Element::Kind::TypeDefinition:
+                    if (!writeTypeDefinition(code_deepness, ctx, static_cast<Language::TypeDefinition*>(definition.get()), ec))
                         return false;
-                }
-                else if (auto o = dynamic_cast<Language::Object*>(definition.get()))
-                {
-                    if (!writeObject(intf, code_deepness, ctx, o, ec))
+                    break;
+                case Language::Element::Kind::Object:
+                    if (!writeObject(intf, code_deepness, ctx, static_cast<Language::Object*>(definition.get()), ec))
                         return false;
-                }
-                else if (auto o = dynamic_cast<Language::Property*>(definition.get()))
-				{
-                    if (!writeProperty(intf, code_deepness, ctx, o, ec))
+                    break;
+                case Language::Element::Kind::Property:
+                    if (!writeProperty(intf, code_deepness, ctx, static_cast<Language::Property*>(definition.get()), ec))
 						return false;
-				}
-                else if (auto o = dynamic_cast<Language::MethodVariant*>(definition.get()))
-				{
-                    if (!writeFunction(intf, code_deepness, ctx, o, ec))
+                    break;
+                case Language::Element::Kind::MethodVariant:
+                    if (!writeFunction(intf, code_deepness, ctx, static_cast<Language::MethodVariant*>(definition.get()), ec))
 						return false;
-				}
+                    break;
+                default:
+                    break;
+                }
 
 			return true;
 		}
@@ -1085,7 +1129,7 @@ namespace PIDL
 			case Mode::Declaration:
                 for(auto & e : module->elements())
                 {
-                    if(std::dynamic_pointer_cast<Language::Interface>(e))
+                    if(e->kind() == Language::Element::Kind::Interface)
                     {
                         if (!that->writeAliases(code_deepness, ctx, ec))
                             return false;
@@ -1122,12 +1166,15 @@ namespace PIDL
 
 		bool writeTopLevel(short code_deepness, CPPCodeGenContext * ctx, Language::TopLevel * top_level, ErrorCollector & ec)
 		{
-			if (dynamic_cast<Language::Interface*>(top_level))
-				return writeInterface(code_deepness, ctx, dynamic_cast<Language::Interface*>(top_level), ec);
-			if (dynamic_cast<Language::Module*>(top_level))
-				return writeModule(code_deepness, ctx, dynamic_cast<Language::Module*>(top_level), ec);
-
-			return true;
+			switch (top_level->kind())
+			{
+			case Language::Element::Kind::Interface:
+				return writeInterface(code_deepness, ctx, static_cast<Language::Interface*>(top_level), ec);
+			case Language::Element::Kind::Module:
+				return writeModule(code_deepness, ctx, static_cast<Language::Module*>(top_level), ec);
+			default:
+				return true;
+			}
 		}
 
         bool writePriv(Language::Interface *intf, short code_deepness, CPPCodeGenContext * ctx, Language::Interface * cl, ErrorCollector & ec)
@@ -1423,4 +1470,75 @@ namespace PIDL
 		return priv->addType(code_deepness, ctx, type, ec);
 	}
 
+	void CPPCodeGen::writeLookup(short code_deepness, CPPCodeGenContext * ctx, const std::vector<Handler> & hs,
+		const std::function<void(short, const Handler &)> & found, const std::function<void(short)> & variant_not_found)
+	{
+		std::map<size_t, std::map<std::string, std::vector<const Handler *>>> by_length;
+		for (auto & h : hs)
+			by_length[h.name.length()][h.name].push_back(&h);
+
+		auto write_name = [&](short d, const std::string & name, const std::vector<const Handler *> & variants) {
+			ctx->writeTabs(d) << "if (memcmp(name.data(), \"" << name << "\", " << name.length() << ") == 0)" << std::endl;
+			ctx->writeTabs(d++) << "{" << std::endl;
+			for (auto h : variants)
+			{
+				auto & o = ctx->writeTabs(d) << "if (";
+				if (h->variant.empty())
+					o << "!variant.length()";
+				else
+				{
+					bool single = variants.size() == 1;
+					if (single)
+						o << "!variant.length() || (";
+					o << "variant.length() == " << h->variant.length() << " && memcmp(variant.data(), \"" << h->variant << "\", " << h->variant.length() << ") == 0";
+					if (single)
+						o << ")";
+				}
+				o << ")" << std::endl;
+				found(d + 1, *h);
+			}
+			variant_not_found(d);
+			ctx->writeTabs(--d) << "}" << std::endl;
+		};
+
+		ctx->writeTabs(code_deepness) << "switch (name.length())" << std::endl;
+		ctx->writeTabs(code_deepness) << "{" << std::endl;
+		for (auto & l : by_length)
+		{
+			ctx->writeTabs(code_deepness) << "case " << l.first << ":" << std::endl;
+			auto & names = l.second;
+
+			//the first position where all the names of this length differ
+			size_t pos = l.first;
+			for (size_t i = 0; names.size() > 1 && i < l.first && pos == l.first; ++i)
+			{
+				std::set<char> chars;
+				for (auto & n : names)
+					chars.insert(n.first[i]);
+				if (chars.size() == names.size())
+					pos = i;
+			}
+
+			if (pos < l.first)
+			{
+				ctx->writeTabs(code_deepness + 1) << "switch (name[" << pos << "])" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "{" << std::endl;
+				for (auto & n : names)
+				{
+					ctx->writeTabs(code_deepness + 1) << "case '" << n.first[pos] << "':" << std::endl;
+					write_name(code_deepness + 2, n.first, n.second);
+					ctx->writeTabs(code_deepness + 2) << "break;" << std::endl;
+				}
+				ctx->writeTabs(code_deepness + 1) << "}" << std::endl;
+			}
+			else
+			{
+				for (auto & n : names)
+					write_name(code_deepness + 1, n.first, n.second);
+			}
+			ctx->writeTabs(code_deepness + 1) << "break;" << std::endl;
+		}
+		ctx->writeTabs(code_deepness) << "}" << std::endl;
+	}
+
 }
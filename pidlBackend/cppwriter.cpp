@@ -62,14 +62,14 @@ namespace PIDL {
 				std::replace(guard.begin(), guard.end(), '/', '_');
 				std::replace(guard.begin(), guard.end(), '\\', '_');
 				guard = "__" + guard + "__";
-				(*priv->o) << "#ifndef " << guard << std::endl;
-				(*priv->o) << "#define " << guard << std::endl;
-
 				std::unique_ptr<CPPCodeGenContext> ctx(priv->codegen->createContext(1, '\t', (*priv->o), (CPPCodeGenContext::Role)priv->role, CPPCodeGenContext::Mode::Declaration));
+				ctx->stream() << "#ifndef " << guard << std::endl;
+				ctx->stream() << "#define " << guard << std::endl;
+
 				if (!priv->codegen->generateIncludes(0, ctx.get(), ec))
 					return false;
 
-				(*priv->o) << std::endl;
+				ctx->stream() << std::endl;
 
 				for (const auto & top_level : reader->topLevels())
 				{
@@ -77,7 +77,8 @@ namespace PIDL {
 						return false;
 				}
 
-				(*priv->o) << "#endif // " << guard << std::endl;
+				ctx->stream() << "#endif // " << guard << std::endl;
+				ctx->flush();
 			}
 			break;
 		case Mode::Source:
@@ -95,13 +96,14 @@ namespace PIDL {
 					return false;
 
 
-				(*priv->o) << std::endl;
+				ctx->stream() << std::endl;
 
 				for (const auto & top_level : reader->topLevels())
 				{
 					if (!priv->codegen->generateCode(top_level.get(), 0, ctx.get(), ec))
 						return false;
 				}
+				ctx->flush();
 			}
 			break;
 		case Mode::Combo:
@@ -110,13 +112,14 @@ namespace PIDL {
 				if (!priv->codegen->generateIncludes(0, ctx.get(), ec))
 					return false;
 
-				(*priv->o) << std::endl;
+				ctx->stream() << std::endl;
 
 				for (const auto & top_level : reader->topLevels())
 				{
 					if (!priv->codegen->generateCode(top_level.get(), 0, ctx.get(), ec))
 						return false;
 				}
+				ctx->flush();
 				break;
 			}
 		}
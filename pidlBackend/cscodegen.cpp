@@ -150,8 +150,8 @@ namespace PIDL {
 
 			ctx->writeTabs(code_deepness++) << "{" << std::endl;
 
-			auto struct_type = dynamic_cast<Language::Structure*>(structure->type()->finalType().get());
-			assert(struct_type);
+			assert(structure->type()->finalType()->kind() == Language::Element::Kind::Structure);
+			auto struct_type = static_cast<Language::Structure*>(structure->type()->finalType().get());
 
 			if (!writeStructureBody(code_deepness, ctx, struct_type, ec))
 				return false;
@@ -179,32 +179,34 @@ namespace PIDL {
 
 		bool addGeneric(short code_deepness, CSCodeGenContext * ctx, Language::Generic * generic, ErrorCollector & ec)
 		{
-			if (dynamic_cast<Language::Array*>(generic))
+			switch (generic->kind())
 			{
+			case Language::Element::Kind::Array:
 				if (!addType(code_deepness, ctx, generic->types().front().get(), ec))
 					return false;
 				*ctx << "[]";
-			}
-			else if (dynamic_cast<Language::Nullable*>(generic))
-			{
-				auto fn_type = generic->types().front()->finalType().get();
-				if (dynamic_cast<Language::NativeType*>(fn_type) ||
-					dynamic_cast<Language::DateTime*>(fn_type) ||
-					dynamic_cast<Language::Structure*>(fn_type))
+				break;
+			case Language::Element::Kind::Nullable:
+				switch (generic->types().front()->finalType()->kind())
 				{
+				case Language::Element::Kind::Integer:
+				case Language::Element::Kind::Float:
+				case Language::Element::Kind::Boolean:
+				case Language::Element::Kind::DateTime:
+				case Language::Element::Kind::Structure:
 					*ctx << "Nullable<";
 					if (!addType(code_deepness, ctx, generic->types().front().get(), ec))
 						return false;
 					*ctx << ">";
-				}
-				else
-				{
+					break;
+				default:
 					*ctx << "/*nullable*/ ";
 					if (!addType(code_deepness, ctx, generic->types().front().get(), ec))
 						return false;
+					break;
 				}
-			}
-			else if (dynamic_cast<Language::Tuple *>(generic)) 
+				break;
+			case Language::Element::Kind::Tuple:
 			{
 				*ctx << "System.Tuple<";
 				bool is_first = true;
@@ -218,6 +220,10 @@ namespace PIDL {
 				}
 				*ctx << ">";
 			}
+				break;
+			default:
+				break;
+			}
 
 			return true;
 		}
@@ -226,12 +232,13 @@ namespace PIDL {
 		{
             (void)ec;
             auto & o = ctx->stream();
-			if (dynamic_cast<Language::Integer*>(native))
-				o << "long";
-			else if (dynamic_cast<Language::Float*>(native))
-				o << "double";
-			else if (dynamic_cast<Language::Boolean*>(native))
-				o << "bool";
+			switch (native->kind())
+			{
+			case Language::Element::Kind::Integer: o << "long"; break;
+			case Language::Element::Kind::Float: o << "double"; break;
+			case Language::Element::Kind::Boolean: o << "bool"; break;
+			default: break;
+			}
 			return true;
 		}
 
@@ -239,49 +246,52 @@ namespace PIDL {
 		{
             (void)ec;
             auto & o = ctx->stream();
-			if (dynamic_cast<Language::String*>(embedded))
-				o << "string";
-			else if (dynamic_cast<Language::DateTime*>(embedded))
-				o << "DateTime";
-			else if (dynamic_cast<Language::Blob*>(embedded))
-				o << "byte[]";
+			switch (embedded->kind())
+			{
+			case Language::Element::Kind::String: o << "string"; break;
+			case Language::Element::Kind::DateTime: o << "DateTime"; break;
+			case Language::Element::Kind::Blob: o << "byte[]"; break;
+			default: break;
+			}
 
 			return true;
 		}
 
 		bool addType(short code_deepness, CSCodeGenContext * ctx, Language::Type * type_, ErrorCollector & ec)
 		{
-			if (dynamic_cast<Language::Generic*>(type_))
-				return addGeneric(code_deepness, ctx, dynamic_cast<Language::Generic*>(type_), ec);
-
-			Language::Type * type = dynamic_cast<Language::Structure*>(type_->finalType().get()) ? type_ : type_->finalType().get();
-			if (dynamic_cast<Language::NativeType*>(type))
-			{
-				if (!addNative(ctx, dynamic_cast<Language::NativeType*>(type), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::EmbeddedType*>(type))
-			{
-				if (!addEmbedded(ctx, dynamic_cast<Language::EmbeddedType*>(type), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::Structure*>(type))
+			switch (type_->kind())
 			{
-				if (!addStructure(code_deepness, ctx, dynamic_cast<Language::Structure*>(type), ec))
-					return false;
+			case Language::Element::Kind::Nullable:
+			case Language::Element::Kind::Array:
+			case Language::Element::Kind::Tuple:
+				return addGeneric(code_deepness, ctx, static_cast<Language::Generic*>(type_), ec);
+			default:
+				break;
 			}
-			else
+
+			Language::Type * type = type_->finalType()->kind() == Language::Element::Kind::Structure ? type_ : type_->finalType().get();
+			switch (type->kind())
 			{
+			case Language::Element::Kind::Integer:
+			case Language::Element::Kind::Float:
+			case Language::Element::Kind::Boolean:
+				return addNative(ctx, static_cast<Language::NativeType*>(type), ec);
+			case Language::Element::Kind::String:
+			case Language::Element::Kind::DateTime:
+			case Language::Element::Kind::Blob:
+				return addEmbedded(ctx, static_cast<Language::EmbeddedType*>(type), ec);
+			case Language::Element::Kind::Structure:
+				return addStructure(code_deepness, ctx, static_cast<Language::Structure*>(type), ec);
+			default:
 				*ctx << type->name();
+				return true;
 			}
-
-			return true;
 		}
 
 		bool writeTypeDefinition(short code_deepness, CSCodeGenContext * ctx, Language::TypeDefinition * type_definition, ErrorCollector & ec)
 		{
 			auto type = type_definition->type()->finalType().get();
-			if (dynamic_cast<Language::Structure*>(type))
+			if (type->kind() == Language::Element::Kind::Structure)
 			{
 				if (!writeStructure(code_deepness, ctx, type_definition, ec))
 					return false;
@@ -493,40 +503,38 @@ namespace PIDL {
 
 		bool writeDefinition(short code_deepness, CSCodeGenContext * ctx, Language::Interface * intf, Language::Definition * definition, ErrorCollector & ec)
 		{
-			if (dynamic_cast<Language::TypeDefinition*>(definition))
-			{
-				if (!writeTypeDefinition(code_deepness, ctx, dynamic_cast<Language::TypeDefinition*>(definition), ec))
-					return false;
-			}
-			else if (dynamic_cast<Language::Function*>(definition))
+			switch (definition->kind())
 			{
-				for (auto & v : dynamic_cast<Language::Function*>(definition)->variants())
+			case Language::Element::Kind::TypeDefinition:
+				return writeTypeDefinition(code_deepness, ctx, static_cast<Language::TypeDefinition*>(definition), ec);
+			case Language::Element::Kind::Function:
+			case Language::Element::Kind::Method:
+				for (auto & v : static_cast<Language::Function*>(definition)->variants())
 					if (!writeFunction(intf, code_deepness, ctx, v.second.get(), ec))
 						return false;
+				return true;
+			case Language::Element::Kind::Object:
+				return writeObject(code_deepness, ctx, intf, static_cast<Language::Object*>(definition), ec);
+			default:
+				return true;
 			}
-			else if (dynamic_cast<Language::Object*>(definition))
-			{
-				if (!writeObject(code_deepness, ctx, intf, dynamic_cast<Language::Object*>(definition), ec))
-					return false;
-			}
-			return true;
 		}
 
 		bool writeDefinition(Language::Interface * intf, short code_deepness, CSCodeGenContext * ctx, Language::Object * obj, Language::Definition * definition, ErrorCollector & ec)
 		{
             (void)obj;
-            if (dynamic_cast<Language::Method*>(definition))
+            switch (definition->kind())
 			{
-				for (auto & v : dynamic_cast<Language::Method*>(definition)->variants())
+			case Language::Element::Kind::Method:
+				for (auto & v : static_cast<Language::Method*>(definition)->variants())
 					if (!writeFunction(intf, code_deepness, ctx, v.second.get(), ec))
 						return false;
+				return true;
+			case Language::Element::Kind::Property:
+				return writeProperty(intf, code_deepness, ctx, static_cast<Language::Property*>(definition), ec);
+			default:
+				return true;
 			}
-			else if (dynamic_cast<Language::Property*>(definition))
-			{
-				if (!writeProperty(intf, code_deepness, ctx, dynamic_cast<Language::Property*>(definition), ec))
-					return false;
-			}
-			return true;
 		}
 
 		bool writeDefinitions(short code_deepness, CSCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
@@ -549,20 +557,23 @@ namespace PIDL {
 			}
 
 			for (auto & definition : intf->definitions())
-				if (dynamic_cast<Language::TypeDefinition*>(definition.get()))
+				switch (definition->kind())
 				{
-					if (!writeTypeDefinition(code_deepness, ctx, dynamic_cast<Language::TypeDefinition*>(definition.get()), ec))
+				case Language::Element::Kind::TypeDefinition:
+					if (!writeTypeDefinition(code_deepness, ctx, static_cast<Language::TypeDefinition*>(definition.get()), ec))
 						return false;
-				}
-				else if (dynamic_cast<Language::FunctionVariant*>(definition.get()))
-				{
-					if (!writeFunction(intf, code_deepness, ctx, dynamic_cast<Language::FunctionVariant*>(definition.get()), ec))
+					break;
+				case Language::Element::Kind::FunctionVariant:
+				case Language::Element::Kind::MethodVariant:
+					if (!writeFunction(intf, code_deepness, ctx, static_cast<Language::FunctionVariant*>(definition.get()), ec))
 						return false;
-				}
-				else if (dynamic_cast<Language::Object*>(definition.get()))
-				{
-					if (!writeObject(code_deepness, ctx, intf, dynamic_cast<Language::Object*>(definition.get()), ec))
+					break;
+				case Language::Element::Kind::Object:
+					if (!writeObject(code_deepness, ctx, intf, static_cast<Language::Object*>(definition.get()), ec))
 						return false;
+					break;
+				default:
+					break;
 				}
 
 			return true;
@@ -571,15 +582,18 @@ namespace PIDL {
 		bool writeDefinitions(Language::Interface * intf, short code_deepness, CSCodeGenContext * ctx, Language::Object * obj, ErrorCollector & ec)
 		{
 			for (auto & definition : obj->definitions())
-				if (dynamic_cast<Language::MethodVariant*>(definition.get()))
+				switch (definition->kind())
 				{
-					if (!writeFunction(intf, code_deepness, ctx, dynamic_cast<Language::MethodVariant*>(definition.get()), ec))
+				case Language::Element::Kind::MethodVariant:
+					if (!writeFunction(intf, code_deepness, ctx, static_cast<Language::MethodVariant*>(definition.get()), ec))
 						return false;
-				}
-				else if (dynamic_cast<Language::Property*>(definition.get()))
-				{
-					if (!writeProperty(intf, code_deepness, ctx, dynamic_cast<Language::Property*>(definition.get()), ec))
+					break;
+				case Language::Element::Kind::Property:
+					if (!writeProperty(intf, code_deepness, ctx, static_cast<Language::Property*>(definition.get()), ec))
 						return false;
+					break;
+				default:
+					break;
 				}
 
             return true;
@@ -712,12 +726,15 @@ namespace PIDL {
 
 		bool writeTopLevel(short code_deepness, CSCodeGenContext * ctx, Language::TopLevel * top_level, ErrorCollector & ec)
 		{
-			if (dynamic_cast<Language::Interface*>(top_level))
-				return writeInterface(code_deepness, ctx, dynamic_cast<Language::Interface*>(top_level), ec);
-			if (dynamic_cast<Language::Module*>(top_level))
-				return writeModule(code_deepness, ctx, dynamic_cast<Language::Module*>(top_level), ec);
-
-			return true;
+			switch (top_level->kind())
+			{
+			case Language::Element::Kind::Interface:
+				return writeInterface(code_deepness, ctx, static_cast<Language::Interface*>(top_level), ec);
+			case Language::Element::Kind::Module:
+				return writeModule(code_deepness, ctx, static_cast<Language::Module*>(top_level), ec);
+			default:
+				return true;
+			}
 		}
 	};
 
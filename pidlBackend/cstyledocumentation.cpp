@@ -122,7 +122,7 @@ namespace PIDL
 		switch (place)
 		{
 		case Place::Before:
-			if (!dynamic_cast<Language::FunctionVariant::Argument*>(docprov))
+			if (docprov->kind() != Language::Element::Kind::FunctionArgument)
 			{
 				**ctx << std::endl;
 				ctx->writeTabs(code_deepness) << "/*" << std::endl;
@@ -133,7 +133,7 @@ namespace PIDL
 				if (doc.details.count(Language::DocumentationProvider::Documentation::Description))
                     writeLines("\n", split(doc.details.at(Language::DocumentationProvider::Documentation::Description), '\n'));
 
-				if (dynamic_cast<Language::Function*>(docprov) &&
+				if ((docprov->kind() == Language::Element::Kind::Function || docprov->kind() == Language::Element::Kind::Method) &&
 					doc.details.count(Language::DocumentationProvider::Documentation::Return))
                     writeLines("\nReturn:", split(doc.details.at(Language::DocumentationProvider::Documentation::Return), '\n'));
 
@@ -143,7 +143,7 @@ namespace PIDL
 			}
 			break;
 		case Place::After:
-			if (dynamic_cast<Language::FunctionVariant::Argument*>(docprov))
+			if (docprov->kind() == Language::Element::Kind::FunctionArgument)
 			{
                 *ctx << " // " << clear(replace(doc.brief, '\n', ' ')) << std::endl;
 				ctx->writeTabs(code_deepness + 1);
@@ -175,7 +175,7 @@ namespace PIDL
 		switch (place)
 		{
 		case Place::Before:
-			if (!dynamic_cast<Language::FunctionVariant::Argument*>(docprov))
+			if (docprov->kind() != Language::Element::Kind::FunctionArgument)
 			{
 				**ctx << std::endl;
 
@@ -193,7 +193,7 @@ namespace PIDL
 					ctx->writeTabs(code_deepness) << "/// </remarks>" << std::endl;
 				}
 
-				if (dynamic_cast<Language::FunctionVariant*>(docprov))
+				if (docprov->kind() == Language::Element::Kind::FunctionVariant || docprov->kind() == Language::Element::Kind::MethodVariant)
 				{
 					if (doc.details.count(Language::DocumentationProvider::Documentation::Return))
 					{
@@ -202,7 +202,7 @@ namespace PIDL
 						ctx->writeTabs(code_deepness) << "/// </returns>" << std::endl;
 					}
 
-					for (auto & arg : dynamic_cast<Language::FunctionVariant*>(docprov)->arguments())
+					for (auto & arg : static_cast<Language::FunctionVariant*>(docprov)->arguments())
 					{
                         if (static_cast<long>(arg->documentation().brief.find("\n")) == -1)
 						{
@@ -256,7 +256,7 @@ namespace PIDL
 		switch (place)
 		{
 		case Place::Before:
-			if (!dynamic_cast<Language::FunctionVariant::Argument*>(docprov))
+			if (docprov->kind() != Language::Element::Kind::FunctionArgument)
 			{
 				**ctx << std::endl;
                 ctx->writeTabs(code_deepness) << "/*!";
@@ -272,14 +272,14 @@ namespace PIDL
 				if (doc.details.count(Language::DocumentationProvider::Documentation::Description))
 					writeLines(split(doc.details.at(Language::DocumentationProvider::Documentation::Description), '\n'));
 
-                if (dynamic_cast<Language::FunctionVariant*>(docprov))
+                if (docprov->kind() == Language::Element::Kind::FunctionVariant || docprov->kind() == Language::Element::Kind::MethodVariant)
 				{
 					if (doc.details.count(Language::DocumentationProvider::Documentation::Return))
 					{
                         ctx->writeTabs(code_deepness) << " * @return " << clear(replace(doc.details.at(Language::DocumentationProvider::Documentation::Return), '\n', ' ')) << std::endl;
 					}
 
-					for (auto & arg : dynamic_cast<Language::FunctionVariant*>(docprov)->arguments())
+					for (auto & arg : static_cast<Language::FunctionVariant*>(docprov)->arguments())
 					{
 						auto & doc = arg->documentation();
 						ctx->writeTabs(code_deepness) << " * @param[";
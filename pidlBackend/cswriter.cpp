@@ -61,13 +61,14 @@ namespace PIDL {
 		if (!priv->codegen->generateUsings(0, ctx.get(), ec))
 			return false;
 
-		(*priv->o) << std::endl;
+		ctx->stream() << std::endl;
 
 		for (auto & top_level : reader->topLevels())
 		{
 			if (!priv->codegen->generateCode(top_level.get(), 0, ctx.get(), ec))
 				return false;
 		}
+		ctx->flush();
 
 		return true;
 	}
@@ -0,0 +1,70 @@
+/*
+    This file is part of pidlBackend.
+
+    pidlBackend is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlBackend is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlBackend.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef pidlBackend__binary_stl_codegen_H
+#define pidlBackend__binary_stl_codegen_H
+
+#include "cppcodegen.h"
+#include <set>
+
+namespace PIDL
+{
+	// stubs over the compact binary format of pidlCore/binarytools.h; same interface as the ones of JSON_STL_CodeGen
+	class PIDL_BACKEND__CLASS Binary_STL_CodeGen : public CPPCodeGen
+	{
+		PIDL_COPY_PROTECTOR(Binary_STL_CodeGen)
+		struct Priv;
+		Priv * priv;
+	public:
+		enum class Flag {
+			UseOptional
+		};
+
+		Binary_STL_CodeGen(const std::shared_ptr<CPPCodeGenHelper> & helper, const std::set<Flag> & flags);
+		Binary_STL_CodeGen();
+		virtual ~Binary_STL_CodeGen() override;
+
+	protected:
+		using Role = CPPCodeGenContext::Role;
+		using Mode = CPPCodeGenContext::Mode;
+
+		virtual CPPCodeGenHelper * helper() const override;
+
+		virtual bool writePublicSection(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec) override;
+		virtual bool writePublicSection(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Object * obj, ErrorCollector & ec) override;
+		virtual bool writeProtectedSection(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec) override;
+
+		virtual bool writeIncludes(short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+		virtual bool writeAliases(short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+		virtual bool writePrivateMembers(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec) override;
+		virtual bool writeInvoke(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec) override;
+		virtual bool writeFunctionBody(Language::Interface * intf, Language::FunctionVariant * function, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+		virtual bool writeConstructorBody(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+
+		virtual bool writeInvoke(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Object * object, ErrorCollector & ec) override;
+		virtual bool writePrivateMembers(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Object * object, ErrorCollector & ec) override;
+		virtual bool writePropertyGetterBody(Language::Interface * intf, Language::Property * property, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+		virtual bool writePropertySetterBody(Language::Interface * intf, Language::Property * property, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+		virtual bool writeConstructorBody(Language::Interface * intf, Language::Object * object, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+		virtual bool writeDestructorBody(Language::Interface * intf, Language::Object * object, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+
+		virtual bool writeObjectBase(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) override;
+	};
+
+}
+
+#endif // pidlBackend__binary_stl_codegen_H
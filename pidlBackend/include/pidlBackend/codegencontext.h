@@ -19,6 +19,7 @@ along with pidlBackend.  If not, see <http://www.gnu.org/licenses/>
 #define pidlBackend__codegencontext_h
 
 #include "config.h"
+#include <cstddef>
 #include <memory>
 #include <ostream>
 
@@ -58,6 +59,11 @@ namespace PIDL {
 
 		std::ostream & writeTabs(short code_deepness);
 
+		//the output is buffered: newlines do not flush, the buffer is passed to the target stream
+		//when it exceeds the threshold (0: never), by flush() and on destruction
+		void setFlushThreshold(size_t bytes);
+		void flush();
+
 		virtual bool prebuild(Language::TopLevel *tl, ErrorCollector & ec);
 
 	protected:
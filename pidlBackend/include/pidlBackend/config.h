@@ -34,5 +34,14 @@
 #endif
 
 #define PIDL_JSON_MARSHALLING_VERSION 2
+#define PIDL_BINARY_MARSHALLING_VERSION 1
+
+//to be increased whenever the generated code changes; outputs of incremental builds depend on it
+#define PIDL_GENERATOR_VERSION 1
+
+//generated code is collected in memory and handed over to the output stream once it reaches this size (or at the end of the writer)
+#ifndef PIDL_CODEGEN_FLUSH_THRESHOLD
+#  define PIDL_CODEGEN_FLUSH_THRESHOLD (1024 * 1024)
+#endif
 
 #endif // pidlBackend__config_h
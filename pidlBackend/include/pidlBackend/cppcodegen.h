@@ -19,6 +19,7 @@
 #define pidlBackend__cppcodegen_h
 
 #include "config.h"
+#include <functional>
 #include <memory>
 #include <ostream>
 #include <vector>
@@ -94,6 +95,20 @@ namespace PIDL {
 		virtual std::string loggingWarning(const std::string & logger, const std::string & message) const = 0;
 		virtual std::string loggingError(const std::string & logger, const std::string & message) const = 0;
 		virtual std::string loggingFatal(const std::string & logger, const std::string & message) const = 0;
+
+		enum class Level
+		{
+			Trace, Debug, Info, Warning, Error, Fatal
+		};
+
+		//preprocessor symbol of the lowest level compiled into the generated code (0: Trace ... 5: Fatal, all when undefined);
+		//the statements of the lower levels are left out together with their 'loggingStart'. Empty: no guard.
+		virtual std::string levelMacro() const;
+		//run-time check of 'level' on 'logger'; when not empty, the message is built and logged only if it holds
+		virtual std::string loggingEnabled(const std::string & logger, Level level) const;
+
+		//writes 'loggingStart' and the statement of 'level', guarded by the above
+		void writeLogging(short code_deepness, CPPCodeGenContext * ctx, Level level, const std::string & logger, const std::string & message) const;
 	};
 
 	class PIDL_BACKEND__CLASS CPPVoidLogging : public CPPCodeGenLogging
@@ -140,6 +155,9 @@ namespace PIDL {
 		virtual Include coreIncludePath() const = 0;
 
 		virtual std::string getName(const Language::TopLevel * e) const = 0;
+
+		//expression of the PIDL::Instrumentation::Registry the instrumented servers record into
+		virtual std::string instrumentationRegistry() const;
 	};
 
 	class PIDL_BACKEND__CLASS CPPBasicCodeGenHelper : public CPPCodeGenHelper
@@ -215,6 +233,18 @@ namespace PIDL {
 		virtual bool writeObjectBase(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec) = 0;
 
 		bool writeType(Language::Type * type, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec);
+
+		//a server side entry point, selected by the name and the variant of the call
+		struct Handler
+		{
+			std::string name;
+			std::string variant;
+			std::string member;
+		};
+
+		//the set of functions is known here, so the lookup is a switch over the length and a distinguishing character of 'name'
+		void writeLookup(short code_deepness, CPPCodeGenContext * ctx, const std::vector<Handler> & hs,
+			const std::function<void(short, const Handler &)> & found, const std::function<void(short)> & variant_not_found);
 	};
 
 }
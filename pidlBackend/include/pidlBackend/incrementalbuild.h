@@ -0,0 +1,56 @@
+/*
+    This file is part of pidlBackend.
+
+    pidlBackend is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlBackend is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlBackend.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef pidlBackend__incrementalbuild_h
+#define pidlBackend__incrementalbuild_h
+
+#include "config.h"
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace PIDL {
+
+	class ErrorCollector;
+
+	//keeps the outputs of a job in memory and replaces only the files whose content has changed;
+	//the manifest records the hash of the inputs, so an unchanged job can be skipped as a whole
+	class PIDL_BACKEND__CLASS IncrementalBuild
+	{
+		PIDL_COPY_PROTECTOR(IncrementalBuild)
+		struct Priv;
+		Priv * priv;
+	public:
+		IncrementalBuild(const std::string & manifest);
+		~IncrementalBuild();
+
+		//job description, IDL data, configuration values: anything the outputs depend on
+		void addInput(const std::string & data);
+
+		std::shared_ptr<std::ostream> output(const std::string & filename);
+
+		//the manifest matches the inputs and all the recorded outputs exist
+		bool upToDate(ErrorCollector & ec) const;
+
+		//writes the changed outputs, then the manifest
+		bool commit(ErrorCollector & ec);
+	};
+
+}
+
+#endif // pidlBackend__incrementalbuild_h
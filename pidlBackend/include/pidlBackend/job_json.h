@@ -31,6 +31,7 @@ namespace PIDL {
 	class ErrorCollector;
 	class ObjectFactoryRegistry_JSON;
     class ConfigReader;
+	class IncrementalBuild;
 
 	class PIDL_BACKEND__CLASS Job_JSON : public Operation
 	{
@@ -40,7 +41,7 @@ namespace PIDL {
 	public:
 		Job_JSON();
         Job_JSON(const std::shared_ptr<Operation> & op, const std::shared_ptr<ConfigReader> & cr);
-        Job_JSON(const std::shared_ptr<ConfigReader> & cr);
+        Job_JSON(const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental = nullptr);
 
         virtual ~Job_JSON() override;
 
@@ -52,6 +53,8 @@ namespace PIDL {
 
         static bool build(const std::string & json_data, const std::shared_ptr<ConfigReader> & cr, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec);
         static bool build(const rapidjson::Value & root, const std::shared_ptr<ConfigReader> & cr, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec);
+        static bool build(const std::string & json_data, const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec);
+        static bool build(const rapidjson::Value & root, const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec);
 	};
 
 }
@@ -19,6 +19,7 @@
 #define pidlBackend__json_cscodegen_h
 
 #include "cscodegen.h"
+#include <set>
 
 namespace PIDL
 {
@@ -28,7 +29,13 @@ namespace PIDL
 		struct Priv;
 		Priv * priv;
 	public:
-		JSON_CSCodeGen(const std::shared_ptr<CSCodeGenHelper> & helper);
+		enum class Flag {
+			// the calls are identified by their numeric id (see Language::DefinitionProvider::callId()) instead of
+			// their name and variant; the servers accept both
+			FunctionIds
+		};
+
+		JSON_CSCodeGen(const std::shared_ptr<CSCodeGenHelper> & helper, const std::set<Flag> & flags = std::set<Flag>());
 		JSON_CSCodeGen();
 		virtual ~JSON_CSCodeGen();
 
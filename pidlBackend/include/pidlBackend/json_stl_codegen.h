@@ -23,6 +23,8 @@
 
 namespace PIDL
 {
+	// The generated server dispatch keeps no state of its own: '_invoke' can be called concurrently on one
+	// instance, as long as the implementation of the functions and '_get_object' are thread-safe.
 	class PIDL_BACKEND__CLASS JSON_STL_CodeGen : public CPPCodeGen
 	{
 		PIDL_COPY_PROTECTOR(JSON_STL_CodeGen)
@@ -30,7 +32,42 @@ namespace PIDL
 		Priv * priv;
 	public:
         enum class Flag {
-            UseOptional
+            UseOptional,
+            // server side: function calls are decoded by rapidjson SAX events straight into the arguments
+            SAXUnmarshalling,
+            // messages are streamed by rapidjson::Writer into an output buffer instead of building a rapidjson::Document
+            WriterMarshalling,
+            // the rapidjson::Document objects of the generated code are taken from PIDL::JSONTools::PooledDocument
+            DocumentPool,
+            // server side: an '_invoke' overload that runs the call on a PIDL::WorkerPool
+            WorkerPool,
+            // server side: the functions record their timings, payload sizes and statuses into the
+            // PIDL::Instrumentation::Registry named by the helper (see pidlCore/instrumentation.h)
+            Instrumentation,
+            // the calls are identified by their numeric id (see Language::DefinitionProvider::callId()) instead of
+            // their name and variant; the servers accept both
+            FunctionIds,
+            // client side: '_Batch' queues the function calls of the interface and sends them in one request;
+            // server side: such requests are accepted (see PIDL::JSONTools::Batch)
+            BatchCalls,
+            // client side: a '<function>_async' variant of the functions of the interface, returning a std::future of the
+            // return value and the output arguments; sent by the virtual '_invoke_async' (calls '_invoke' by default).
+            // An override gets a request that is valid only during the call, may call 'done' from any thread, and the
+            // interface has to outlive every pending future
+            AsyncCalls,
+            // server side: the objects are kept in a PIDL::ObjectTable of the interface and their object data is
+            // their handle there; '_data', '_get_object' and '_dispose_object' are generated
+            ObjectTable,
+            // server side: 'object_data' is sent back only when it differs from the one of the request, the clients keep
+            // their previous one otherwise
+            ObjectDataChanges,
+            // client side: the disposed objects are queued by '_dispose_object' and released in one request by
+            // '_dispose_objects', which has to be called before the interface is destroyed; server side: such
+            // requests are accepted
+            DeferredDisposal,
+            // the DateTime values are sent in their compact string form (see PIDL::JSONTools::formatDateTime); both
+            // forms are accepted anyway, by the C# runtime (PIDL.JSONTools.parseDateTime) as well
+            CompactDateTime
         };
 
         JSON_STL_CodeGen(const std::shared_ptr<CPPCodeGenHelper> & helper, const std::set<Flag> & flags);
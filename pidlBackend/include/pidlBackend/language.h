@@ -28,6 +28,8 @@
 
 namespace PIDL { namespace Language {
 
+	class Visitor;
+
 	class PIDL_BACKEND__CLASS Element
 	{
 		PIDL_COPY_PROTECTOR(Element)
@@ -35,8 +37,30 @@ namespace PIDL { namespace Language {
 		Priv * priv;
 	public:
 		typedef std::shared_ptr<Element> Ptr;
+
+		//the concrete class of the element, so that it can be classified without RTTI
+		enum class Kind
+		{
+			TypeDefinition,
+			Nullable, Array, Tuple,
+			Structure, StructureMember,
+			Integer, Float, Boolean,
+			String, DateTime, Blob,
+			Void,
+			Variable,
+			FunctionVariant, FunctionArgument, Function,
+			MethodVariant, Method,
+			Property,
+			Object,
+			Interface,
+			Module
+		};
+
 		Element();
 		virtual ~Element();
+
+		virtual Kind kind() const = 0;
+		virtual void accept(Visitor & visitor) const = 0;
 	};
 
 	class PIDL_BACKEND__CLASS DocumentationProvider
@@ -56,6 +80,9 @@ namespace PIDL { namespace Language {
 		};
 
 		virtual const Documentation & documentation() const = 0;
+
+		//implemented by the documented element
+		virtual Element::Kind kind() const = 0;
 	};
 
 	class PIDL_BACKEND__CLASS Definition : public Element
@@ -91,6 +118,8 @@ namespace PIDL { namespace Language {
 	public:
 		Variable(const std::shared_ptr<Type> & type, const std::string & name);
 		virtual ~Variable();
+		virtual Kind kind() const override { return Kind::Variable; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const;
 		Type::Ptr type() const;
@@ -105,6 +134,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<TypeDefinition> Ptr;
 		TypeDefinition(const std::string & name, const std::shared_ptr<Type> & type, const std::vector<std::string> & scope, const Documentation & doc);
 		virtual ~TypeDefinition();
+		virtual Kind kind() const override { return Kind::TypeDefinition; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const override;
 		virtual Type::Ptr type() const;
@@ -148,6 +179,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<Nullable> Ptr;
 		Nullable(const Type::Ptr & type);
 		virtual ~Nullable();
+		virtual Kind kind() const override { return Kind::Nullable; }
+		virtual void accept(Visitor & visitor) const override;
 		virtual const char * name() const override { return "nullable"; }
 	};
 
@@ -159,6 +192,8 @@ namespace PIDL { namespace Language {
 	public:
 		Array(const Type::Ptr & type);
 		virtual ~Array();
+		virtual Kind kind() const override { return Kind::Array; }
+		virtual void accept(Visitor & visitor) const override;
 		virtual const char * name() const override { return "array"; }
 	};
 
@@ -170,6 +205,8 @@ namespace PIDL { namespace Language {
 	public:
 		Tuple(const std::vector<Type::Ptr> & type);
 		virtual ~Tuple();
+		virtual Kind kind() const override { return Kind::Tuple; }
+		virtual void accept(Visitor & visitor) const override;
 		virtual const char * name() const override { return "tuple"; }
 	};
 
@@ -189,6 +226,8 @@ namespace PIDL { namespace Language {
 			typedef std::shared_ptr<Member> Ptr;
 			Member(const Type::Ptr & type, const std::string & name, const Documentation & doc);
 			virtual ~Member();
+			virtual Kind kind() const override { return Kind::StructureMember; }
+			virtual void accept(Visitor & visitor) const override;
 
 			virtual const Documentation & documentation() const override;
 		};
@@ -196,6 +235,8 @@ namespace PIDL { namespace Language {
 		Structure(const std::vector<Member::Ptr> & members);
 		Structure(const std::list<Member::Ptr> & members);
 		virtual ~Structure();
+		virtual Kind kind() const override { return Kind::Structure; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const override { return "structure"; }
 		const std::vector<Member::Ptr> & members() const;
@@ -220,6 +261,8 @@ namespace PIDL { namespace Language {
 	public:
 		Integer();
 		virtual ~Integer();
+		virtual Kind kind() const override { return Kind::Integer; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const override { return "integer"; }
 	};
@@ -233,6 +276,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<Float> Ptr;
 		Float();
 		virtual ~Float();
+		virtual Kind kind() const override { return Kind::Float; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const override { return "float"; }
 	};
@@ -246,6 +291,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<Boolean> Ptr;
 		Boolean();
 		virtual ~Boolean();
+		virtual Kind kind() const override { return Kind::Boolean; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const override { return "boolean"; }
 	};
@@ -270,6 +317,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<String> Ptr;
 		String();
 		virtual ~String();
+		virtual Kind kind() const override { return Kind::String; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const override { return "string"; }
 	};
@@ -283,6 +332,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<DateTime> Ptr;
 		DateTime();
 		virtual ~DateTime();
+		virtual Kind kind() const override { return Kind::DateTime; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const override { return "datetime"; }
 	};
@@ -296,6 +347,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<Blob> Ptr;
 		Blob();
 		virtual ~Blob();
+		virtual Kind kind() const override { return Kind::Blob; }
+		virtual void accept(Visitor & visitor) const override;
 		virtual const char * name() const override { return "blob"; }
 	};
 
@@ -308,6 +361,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<Void> Ptr;
 		Void();
 		virtual ~Void();
+		virtual Kind kind() const override { return Kind::Void; }
+		virtual void accept(Visitor & visitor) const override;
 		virtual const char * name() const override { return "void"; }
 	};
 
@@ -334,6 +389,8 @@ namespace PIDL { namespace Language {
 
 			Argument(const Type::Ptr & type, const std::string & name, Direction direction, const Documentation & doc);
 			virtual ~Argument();
+			virtual Kind kind() const override { return Kind::FunctionArgument; }
+			virtual void accept(Visitor & visitor) const override;
 
 			Direction direction() const;
 
@@ -343,6 +400,8 @@ namespace PIDL { namespace Language {
 		FunctionVariant(const std::shared_ptr<Function> & function, const Type::Ptr & returnType, const std::string & name, const std::vector<Argument::Ptr> & arguments, const Documentation & doc);
 		FunctionVariant(const std::shared_ptr<Function> & function, const Type::Ptr & returnType, const std::string & name, const std::list<Argument::Ptr> & arguments, const Documentation & doc);
 		virtual ~FunctionVariant();
+		virtual Kind kind() const override { return Kind::FunctionVariant; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const;
 		const std::shared_ptr<Function> & function() const;
@@ -366,6 +425,8 @@ namespace PIDL { namespace Language {
 
 		Function(const std::vector<std::string> & scope, const std::string & name);
 		virtual ~Function();
+		virtual Kind kind() const override { return Kind::Function; }
+		virtual void accept(Visitor & visitor) const override;
 
 		virtual const char * name() const;
 		const std::vector<std::string> & scope() const;
@@ -405,6 +466,21 @@ namespace PIDL { namespace Language {
 		DefinitionProvider();
 		virtual ~DefinitionProvider();
 		virtual const std::vector<Definition::Ptr> & definitions() const = 0;
+
+		struct Call
+		{
+			const Element * element; //function variant or property; nullptr for '_dispose_object'
+			std::string name;
+			std::string variant;
+		};
+
+		//the calls accepted by the interface or object: the function variants in order of definition,
+		//the getter then the setter of the properties, finally '_dispose_object' of the interfaces having objects
+		std::vector<Call> calls() const;
+
+		//the numeric id of a call on the wire; it depends only on the name and the variant of the call,
+		//so adding, removing or reordering the other definitions does not change it
+		static int callId(const std::string & name, const std::string & variant);
 	};
 
 	class PIDL_BACKEND__CLASS Interface : public TopLevel, public DefinitionProvider, public DocumentationProvider
@@ -417,6 +493,8 @@ namespace PIDL { namespace Language {
         Interface(const std::string & name, const std::vector<std::shared_ptr<Definition>> & definitions, const std::vector<std::string> & scope, const Documentation & doc, const std::string & loggerName);
         Interface(const std::string & name, const std::list<std::shared_ptr<Definition>> & definitions, const std::vector<std::string> & scope, const Documentation & doc, const std::string & loggerName);
 		virtual ~Interface();
+		virtual Kind kind() const override { return Kind::Interface; }
+		virtual void accept(Visitor & visitor) const override;
 		const std::vector<Definition::Ptr> & definitions() const override;
 		virtual const char * name() const override;
 		virtual const std::vector<std::string> & scope() const override;
@@ -436,6 +514,8 @@ namespace PIDL { namespace Language {
 		MethodVariant(const std::shared_ptr<Method> & function, const Type::Ptr & returnType, const std::string & name, const std::vector<Argument::Ptr> & arguments, const Documentation & doc);
 		MethodVariant(const std::shared_ptr<Method> & function, const Type::Ptr & returnType, const std::string & name, const std::list<Argument::Ptr> & arguments, const Documentation & doc);
 		virtual ~MethodVariant();
+		virtual Kind kind() const override { return Kind::MethodVariant; }
+		virtual void accept(Visitor & visitor) const override;
 	};
 
 	class PIDL_BACKEND__CLASS Method : public Function
@@ -449,6 +529,8 @@ namespace PIDL { namespace Language {
 
 		Method(const std::vector<std::string> & scope, const std::string & name);
 		virtual ~Method();
+		virtual Kind kind() const override { return Kind::Method; }
+		virtual void accept(Visitor & visitor) const override;
 	};
 
 	class PIDL_BACKEND__CLASS Property : public Definition, public DocumentationProvider
@@ -460,6 +542,8 @@ namespace PIDL { namespace Language {
 		typedef std::shared_ptr<Property> Ptr;
 		Property(const Type::Ptr & type, const std::vector<std::string> & scope, const std::string & name, bool readOnly, const Documentation & doc);
 		virtual ~Property();
+		virtual Kind kind() const override { return Kind::Property; }
+		virtual void accept(Visitor & visitor) const override;
 		Type::Ptr type() const;
 		const std::vector<std::string> & scope() const;
 		bool readOnly() const;
@@ -479,6 +563,8 @@ namespace PIDL { namespace Language {
         Object(const std::string & name, const std::vector<std::string> & scope, const Documentation & doc, const std::string & loggerName);
         Object(const std::string & name);
         virtual ~Object() override;
+        virtual Kind kind() const override { return Kind::Object; }
+        virtual void accept(Visitor & visitor) const override;
         void init(const std::vector<std::string> & scope, const Documentation & doc, const std::string & loggerName);
         bool initialized() const;
         void setDefinitions(const std::vector<Definition::Ptr> & definitions);
@@ -500,12 +586,45 @@ namespace PIDL { namespace Language {
 		Module(const std::string & name, const std::vector<TopLevel::Ptr> & elements, const Documentation & doc, const Info & info);
 		Module(const std::string & name, const std::vector<TopLevel::Ptr> & elements, const Documentation & doc);
 		virtual ~Module();
+		virtual Kind kind() const override { return Kind::Module; }
+		virtual void accept(Visitor & visitor) const override;
 		virtual const char * name() const override;
 		const std::vector<TopLevel::Ptr> & elements() const;
 
 		virtual const Documentation & documentation() const override;
 	};
 
+	//double dispatch over the concrete elements; every visit does nothing by default
+	class PIDL_BACKEND__CLASS Visitor
+	{
+	public:
+		virtual ~Visitor();
+
+		virtual void visit(const TypeDefinition & e);
+		virtual void visit(const Nullable & e);
+		virtual void visit(const Array & e);
+		virtual void visit(const Tuple & e);
+		virtual void visit(const Structure & e);
+		virtual void visit(const Structure::Member & e);
+		virtual void visit(const Integer & e);
+		virtual void visit(const Float & e);
+		virtual void visit(const Boolean & e);
+		virtual void visit(const String & e);
+		virtual void visit(const DateTime & e);
+		virtual void visit(const Blob & e);
+		virtual void visit(const Void & e);
+		virtual void visit(const Variable & e);
+		virtual void visit(const FunctionVariant & e);
+		virtual void visit(const FunctionVariant::Argument & e);
+		virtual void visit(const Function & e);
+		virtual void visit(const MethodVariant & e);
+		virtual void visit(const Method & e);
+		virtual void visit(const Property & e);
+		virtual void visit(const Object & e);
+		virtual void visit(const Interface & e);
+		virtual void visit(const Module & e);
+	};
+
 }}
 
 #endif // pidlBackend__language_h
@@ -30,6 +30,7 @@ namespace PIDL {
 
 	class ErrorCollector;
     class ConfigReader;
+	class IncrementalBuild;
 
 	class PIDL_BACKEND__CLASS ObjectFactory_JSON : public ObjectFactory
 	{
@@ -69,7 +70,7 @@ namespace PIDL {
 			return std::dynamic_pointer_cast<FAC_T>(_getValid(type, root));
 		}
 
-        static std::shared_ptr<ObjectFactoryRegistry_JSON> build(const std::shared_ptr<ObjectRegistry> & objreg, const std::shared_ptr<ConfigReader> & cr);
+        static std::shared_ptr<ObjectFactoryRegistry_JSON> build(const std::shared_ptr<ObjectRegistry> & objreg, const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental = nullptr);
 
 	private:
 		const std::list<std::shared_ptr<ObjectFactory_JSON>> & _get(const char * type) const;
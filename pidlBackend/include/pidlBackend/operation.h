@@ -65,6 +65,20 @@ namespace PIDL {
 		virtual bool run(ErrorCollector & ec) override;
 	};
 
+	//runs the read operations first, then the rest of the operations concurrently on a worker pool
+	class PIDL_BACKEND__CLASS ParallelOperationGroup : public Operation
+	{
+		PIDL_COPY_PROTECTOR(ParallelOperationGroup)
+		struct Priv;
+		Priv * priv;
+	public:
+		ParallelOperationGroup(const std::vector<std::shared_ptr<Operation>> & ops, size_t threads = 0);
+
+		virtual ~ParallelOperationGroup();
+
+		virtual bool run(ErrorCollector & ec) override;
+	};
+
 	class PIDL_BACKEND__CLASS Read : public Operation
 	{
 		PIDL_COPY_PROTECTOR(Read)
@@ -77,7 +91,10 @@ namespace PIDL {
 
 		std::shared_ptr<Reader> reader() const;
 
+		//reads only once, the result is kept until invalidate() is called
 		virtual bool run(ErrorCollector & ec) override;
+
+		void invalidate();
 	};
 
 	class PIDL_BACKEND__CLASS Write : public Operation
@@ -90,6 +107,11 @@ namespace PIDL {
 
 		virtual ~Write();
 
+		std::shared_ptr<Read> readOperation() const;
+
+		//runs the writer only, without the read operation
+		bool write(ErrorCollector & ec);
+
 		virtual bool run(ErrorCollector & ec) override;
 	};
 
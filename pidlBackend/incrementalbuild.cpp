@@ -0,0 +1,167 @@
+/*
+    This file is part of pidlBackend.
+
+    pidlBackend is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlBackend is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlBackend.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "include/pidlBackend/incrementalbuild.h"
+#include "include/pidlBackend/reader.h"
+
+#include <pidlCore/errorcollector.h>
+#include <pidlCore/jsontools.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#if PIDL_OS == PIDL_OS_WINDOWS
+#  include <windows.h>
+#endif
+
+namespace PIDL {
+
+	struct IncrementalBuild::Priv
+	{
+		Priv(const std::string & manifest_) : manifest(manifest_), hash(14695981039346656037ull)
+		{
+			std::stringstream ss;
+			ss << PIDL_GENERATOR_VERSION << '.' << PIDL_JSON_MARSHALLING_VERSION << '.' << PIDL_BINARY_MARSHALLING_VERSION;
+			add(ss.str());
+		}
+
+		std::string manifest;
+		unsigned long long hash;
+		std::vector<std::pair<std::string, std::shared_ptr<std::stringstream>>> outputs;
+
+		//FNV-1a over the length prefixed inputs
+		void add(const std::string & data)
+		{
+			auto size = std::to_string(data.size()) + ':';
+			for (auto c : size + data)
+			{
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 1099511628211ull;
+			}
+		}
+
+		std::string hashString() const
+		{
+			char buffer[17];
+			snprintf(buffer, sizeof(buffer), "%016llx", hash);
+			return buffer;
+		}
+
+		static bool exists(const std::string & filename)
+		{
+			return std::ifstream(filename).good();
+		}
+
+		static bool replace(const std::string & filename, const std::string & data, ErrorCollector & ec)
+		{
+			auto tmp_filename = filename + ".pidl-tmp";
+			{
+				std::ofstream file(tmp_filename, std::ios::binary);
+				if (!file.write(data.data(), data.size()) || !file.flush())
+				{
+					ec << "could not write file '" + tmp_filename + "'";
+					return false;
+				}
+			}
+#if PIDL_OS == PIDL_OS_WINDOWS
+			if (!MoveFileExA(tmp_filename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING))
+#else
+			if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+#endif
+			{
+				std::remove(tmp_filename.c_str());
+				ec << "could not replace file '" + filename + "'";
+				return false;
+			}
+			return true;
+		}
+	};
+
+	IncrementalBuild::IncrementalBuild(const std::string & manifest) : priv(new Priv(manifest))
+	{ }
+
+	IncrementalBuild::~IncrementalBuild()
+	{
+		delete priv;
+	}
+
+	void IncrementalBuild::addInput(const std::string & data)
+	{
+		priv->add(data);
+	}
+
+	std::shared_ptr<std::ostream> IncrementalBuild::output(const std::string & filename)
+	{
+		auto ret = std::make_shared<std::stringstream>();
+		priv->outputs.push_back(std::make_pair(filename, ret));
+		return ret;
+	}
+
+	bool IncrementalBuild::upToDate(ErrorCollector & ec) const
+	{
+		std::string data;
+		if (!Priv::exists(priv->manifest) || !Reader::readFromFile(priv->manifest, data, ec))
+			return false;
+
+		rapidjson::Document doc;
+		std::string hash;
+		rapidjson::Value * outputs_v;
+		if (doc.Parse(data.c_str()).HasParseError() || !JSONTools::getValue(doc, "hash", hash) || hash != priv->hashString() ||
+			!JSONTools::getValue(doc, "outputs", outputs_v) || !outputs_v->IsArray())
+			return false;
+
+		for (auto & v : outputs_v->GetArray())
+			if (!v.IsString() || !Priv::exists(v.GetString()))
+				return false;
+
+		return true;
+	}
+
+	bool IncrementalBuild::commit(ErrorCollector & ec)
+	{
+		bool has_error = false;
+		for (auto & o : priv->outputs)
+		{
+			auto data = o.second->str();
+			std::string current;
+			if (Priv::exists(o.first) && Reader::readFromFile(o.first, current, ec) && current == data)
+				continue;
+			if (!Priv::replace(o.first, data, ec))
+				has_error = true;
+		}
+		if (has_error)
+			return false;
+
+		rapidjson::Document doc;
+		doc.SetObject();
+		JSONTools::addValue(doc, doc, "hash", priv->hashString());
+		rapidjson::Value outputs_v(rapidjson::kArrayType);
+		for (auto & o : priv->outputs)
+			outputs_v.PushBack(rapidjson::Value(o.first.c_str(), doc.GetAllocator()), doc.GetAllocator());
+		doc.AddMember("outputs", outputs_v, doc.GetAllocator());
+
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		doc.Accept(writer);
+
+		return Priv::replace(priv->manifest, std::string(buffer.GetString(), buffer.GetSize()), ec);
+	}
+
+}
@@ -29,6 +29,7 @@
 #include "include/pidlBackend/json_cscodegen.h"
 #include "include/pidlBackend/language.h"
 #include "include/pidlBackend/operationfactory_json.h"
+#include "include/pidlBackend/incrementalbuild.h"
 
 #include <rapidjson/document.h>
 
@@ -40,26 +41,28 @@ namespace PIDL {
 
 	struct Job_JSON::Priv
 	{
-        Priv(std::shared_ptr<Operation> op, const std::shared_ptr<ConfigReader> & cr) :
-            op(op)
+        Priv(std::shared_ptr<Operation> op, const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental) :
+            op(op),
+            incremental(incremental)
         {
-            facreg = ObjectFactoryRegistry_JSON::build(std::shared_ptr<ObjectRegistry>(&objreg, [](void*) {}), cr);
+            facreg = ObjectFactoryRegistry_JSON::build(std::shared_ptr<ObjectRegistry>(&objreg, [](void*) {}), cr, incremental);
         }
 
 		std::shared_ptr<Operation> op;
+		std::shared_ptr<IncrementalBuild> incremental;
 
 		std::shared_ptr<ObjectFactoryRegistry_JSON> facreg;
 		ObjectRegistry objreg;
 
 	};
 
-    Job_JSON::Job_JSON() : priv(new Priv(std::shared_ptr<Operation>(), nullptr))
+    Job_JSON::Job_JSON() : priv(new Priv(std::shared_ptr<Operation>(), nullptr, nullptr))
 	{ }
 
-    Job_JSON::Job_JSON(const std::shared_ptr<Operation> & op, const std::shared_ptr<ConfigReader> & cr) : priv(new Priv(op, cr))
+    Job_JSON::Job_JSON(const std::shared_ptr<Operation> & op, const std::shared_ptr<ConfigReader> & cr) : priv(new Priv(op, cr, nullptr))
 	{ }
 
-    Job_JSON::Job_JSON(const std::shared_ptr<ConfigReader> & cr) : priv(new Priv(std::shared_ptr<Operation>(), cr))
+    Job_JSON::Job_JSON(const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental) : priv(new Priv(std::shared_ptr<Operation>(), cr, incremental))
     { }
 
 	Job_JSON::~Job_JSON()
@@ -74,7 +77,15 @@ namespace PIDL {
 			ec << "no operation is specified";
 			return false;
 		}
-		return priv->op->run(ec);
+
+		if (!priv->incremental)
+			return priv->op->run(ec);
+
+		// nothing is read or generated when the inputs are the same as at the last run
+		if (priv->incremental->upToDate(ec))
+			return true;
+
+		return priv->op->run(ec) && priv->incremental->commit(ec);
 	}
 
 	ObjectFactoryRegistry_JSON * Job_JSON::factoryRegistry() const
@@ -86,6 +97,14 @@ namespace PIDL {
 	{
 		rapidjson::Value * tmp;
 		const rapidjson::Value * pidl_root = JSONTools::getValue(root, "pidl", tmp) ? tmp : &root;
+		if (priv->incremental)
+		{
+			rapidjson::StringBuffer buffer;
+			rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+			pidl_root->Accept(writer);
+			priv->incremental->addInput(std::string(buffer.GetString(), buffer.GetSize()));
+		}
+
 		auto fac = priv->facreg->getValid<OperationFactory_JSON>(PIDL_OBJECT_TYPE__OPERATION, *pidl_root);
 		if (!fac)
 			return false;
@@ -94,6 +113,18 @@ namespace PIDL {
 
 	//static
     bool Job_JSON::build(const std::string & json_data, const std::shared_ptr<ConfigReader> & cr, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec)
+	{
+        return build(json_data, cr, nullptr, ret, ec);
+	}
+
+	//static
+    bool Job_JSON::build(const rapidjson::Value & root, const std::shared_ptr<ConfigReader> & cr, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec)
+	{
+        return build(root, cr, nullptr, ret, ec);
+	}
+
+	//static
+    bool Job_JSON::build(const std::string & json_data, const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec)
 	{
 		std::vector<char> buffer(json_data.length() + 1);
 		memcpy(buffer.data(), json_data.c_str(), json_data.length());
@@ -106,13 +137,13 @@ namespace PIDL {
 			return false;
 		}
 
-        return build(doc, cr, ret, ec);
+        return build(doc, cr, incremental, ret, ec);
 	}
 
 	//static
-    bool Job_JSON::build(const rapidjson::Value & root, const std::shared_ptr<ConfigReader> & cr, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec)
+    bool Job_JSON::build(const rapidjson::Value & root, const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental, std::shared_ptr<Job_JSON> & ret, ErrorCollector & ec)
 	{
-        ret = std::shared_ptr<Job_JSON>(new Job_JSON(cr));
+        ret = std::shared_ptr<Job_JSON>(new Job_JSON(cr, incremental));
 		return ret->build(root, ec);
 	}
 
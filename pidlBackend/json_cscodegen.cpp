@@ -20,6 +20,7 @@
 #include <pidlCore/errorcollector.h>
 
 #include <functional>
+#include <map>
 #include <assert.h>
 
 #define MAX_DOTNET_TUPLE_ARG_NUM 7
@@ -61,26 +62,33 @@ namespace PIDL
 						ret += ",";
 
 					auto ft = t->finalType().get();
-					if (dynamic_cast<Language::Generic*>(ft))
+					switch (ft->kind())
+					{
+					case Language::Element::Kind::Nullable:
+					case Language::Element::Kind::Array:
+					case Language::Element::Kind::Tuple:
 					{
 						std::string _str;
-						for (auto & t : dynamic_cast<Language::Generic*>(ft)->types())
+						for (auto & t : static_cast<Language::Generic*>(ft)->types())
 							_calculateHash_str(t.get(), _str);
 						ret += std::string(ft->name()) + "<" + _str + ">";
 					}
-					else if (dynamic_cast<Language::TypeDefinition*>(t) && dynamic_cast<Language::Structure*>(ft))
-					{
-						ret += t->name();
-					}
-					else if (dynamic_cast<Language::Structure*>(ft))
-					{
-						std::string _str;
-						for (auto & m : dynamic_cast<Language::Structure*>(ft)->members())
-							_calculateHash_str(m->type().get(), _str);
-						ret += std::string(ft->name()) + "{" + _str + "}";
-					}
-					else
+						break;
+					case Language::Element::Kind::Structure:
+						if (t->kind() == Language::Element::Kind::TypeDefinition)
+							ret += t->name();
+						else
+						{
+							std::string _str;
+							for (auto & m : static_cast<Language::Structure*>(ft)->members())
+								_calculateHash_str(m->type().get(), _str);
+							ret += std::string(ft->name()) + "{" + _str + "}";
+						}
+						break;
+					default:
 						ret += ft->name();
+						break;
+					}
 				};
 
 				std::string hash_str;
@@ -104,21 +112,24 @@ namespace PIDL
 				{
 					auto ft = t->finalType().get();
 
-					if (dynamic_cast<Language::Structure*>(ft))
+					switch (ft->kind())
 					{
+					case Language::Element::Kind::Structure:
 						_addPrebuiltType(ft);
-						for (auto & m : dynamic_cast<Language::Structure*>(ft)->members())
+						for (auto & m : static_cast<Language::Structure*>(ft)->members())
 							_handleType(m->type().get());
-					}
-					if (dynamic_cast<Language::TypeDefinition*>(t) && dynamic_cast<Language::Structure*>(ft))
-					{
-						_addPrebuiltType(t);
-					}
-					else if (dynamic_cast<Language::Generic*>(ft))
-					{
+						if (t->kind() == Language::Element::Kind::TypeDefinition)
+							_addPrebuiltType(t);
+						break;
+					case Language::Element::Kind::Nullable:
+					case Language::Element::Kind::Array:
+					case Language::Element::Kind::Tuple:
 						_addPrebuiltType(ft);
-						for (auto & t : dynamic_cast<Language::Generic*>(ft)->types())
+						for (auto & t : static_cast<Language::Generic*>(ft)->types())
 							_handleType(t.get());
+						break;
+					default:
+						break;
 					}
 				};
 
@@ -127,19 +138,25 @@ namespace PIDL
 				{
 					for (auto & d : dp->definitions())
 					{
-						if (std::dynamic_pointer_cast<Language::TypeDefinition>(d))
+						switch (d->kind())
 						{
-							_handleType(std::dynamic_pointer_cast<Language::TypeDefinition>(d)->type().get());
-						}
-						else if (std::dynamic_pointer_cast<Language::FunctionVariant>(d))
+						case Language::Element::Kind::TypeDefinition:
+							_handleType(static_cast<Language::TypeDefinition*>(d.get())->type().get());
+							break;
+						case Language::Element::Kind::FunctionVariant:
+						case Language::Element::Kind::MethodVariant:
 						{
-							for (auto & a : std::dynamic_pointer_cast<Language::FunctionVariant>(d)->arguments())
+							auto function = static_cast<Language::FunctionVariant*>(d.get());
+							for (auto & a : function->arguments())
 								_handleType(a->type().get());
-							_handleType(std::dynamic_pointer_cast<Language::FunctionVariant>(d)->returnType().get());
+							_handleType(function->returnType().get());
 						}
-						else if (std::dynamic_pointer_cast<Language::DefinitionProvider>(d))
-						{
-							_handleDefinitions(std::dynamic_pointer_cast<Language::DefinitionProvider>(d).get());
+							break;
+						case Language::Element::Kind::Object:
+							_handleDefinitions(static_cast<Language::Object*>(d.get()));
+							break;
+						default:
+							break;
 						}
 					}
 				};
@@ -150,15 +167,19 @@ namespace PIDL
 			virtual bool prebuild(Language::TopLevel *tl, ErrorCollector & ec) final override
 			{
 				bool has_error = false;
-				if (dynamic_cast<Language::Module*>(tl))
+				switch (tl->kind())
 				{
-					auto m = dynamic_cast<Language::Module*>(tl);
-					for (auto e : m->elements())
-						if (!prebuild(dynamic_cast<Language::TopLevel*>(e.get()), ec)) 
+				case Language::Element::Kind::Module:
+					for (auto e : static_cast<Language::Module*>(tl)->elements())
+						if (!prebuild(e.get(), ec))
 							has_error = true;
+					break;
+				case Language::Element::Kind::Interface:
+					prebuild(static_cast<Language::Interface*>(tl));
+					break;
+				default:
+					break;
 				}
-				else if (dynamic_cast<Language::Interface*>(tl))
-					prebuild(dynamic_cast<Language::Interface*>(tl));
 				return !has_error;
 			}
 
@@ -181,17 +202,105 @@ namespace PIDL
 
 		};
 
-		Priv(JSON_CSCodeGen * that_, const std::shared_ptr<CSCodeGenHelper> & helper_) : that(that_), helper(helper_)
+		Priv(JSON_CSCodeGen * that_, const std::shared_ptr<CSCodeGenHelper> & helper_, const std::set<Flag> & flags_) : that(that_), helper(helper_), flags(flags_)
 		{ }
 
 		JSON_CSCodeGen * that;
 		std::shared_ptr<CSCodeGenHelper> helper;
+		std::set<Flag> flags;
+
+		bool functionIds() const
+		{
+			return flags.count(Flag::FunctionIds) > 0;
+		}
+
+		//numeric id of the call of 'element' ('_dispose_object' for nullptr) in 'cl' or in one of its objects; -1 if not found
+		int callId(const Language::DefinitionProvider * cl, const Language::Element * element, const std::string & variant)
+		{
+			for (auto & c : cl->calls())
+				if (c.element == element && c.variant == variant)
+					return Language::DefinitionProvider::callId(c.name, c.variant);
+			for (auto & d : cl->definitions())
+				if (d->kind() == Language::Element::Kind::Object)
+				{
+					auto id = callId(static_cast<Language::Object*>(d.get()), element, variant);
+					if (id >= 0)
+						return id;
+				}
+			return -1;
+		}
+
+		//client side: the members identifying the call in '_v'
+		void writeCallFields(short code_deepness, CSCodeGenContext * ctx, const char * p, Language::Interface * intf, const Language::Element * element,
+		                     const std::string & name, const std::string & variant, bool has_variant)
+		{
+			if (functionIds())
+			{
+				ctx->writeTabs(code_deepness) << p << "_addValue(_v, \"id\", " << callId(intf, element, variant) << ");" << std::endl;
+				return;
+			}
+			ctx->writeTabs(code_deepness) << p << "_addValue(_v, \"name\", \"" << name << "\");" << std::endl;
+			if (has_variant)
+				ctx->writeTabs(code_deepness) << p << "_addValue(_v, \"variant\", \"" << variant << "\");" << std::endl;
+		}
+
+		//server side: with numeric ids, 'v' is dispatched by its 'id' when it has one
+		void writeIdDispatch(short code_deepness, CSCodeGenContext * ctx, bool is_object, bool may_be_empty)
+		{
+			if (!functionIds())
+				return;
+			ctx->writeTabs(code_deepness) << "int id;" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (PIDL.JSONTools.getValue(v, \"id\", out id))" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "ec.Clear();" << std::endl;
+			if (is_object)
+			{
+				ctx->writeTabs(code_deepness) << "var stat = _callFunction(id, v, out ret, ec);" << std::endl;
+				if (may_be_empty)
+					ctx->writeTabs(code_deepness) << "if (ret == null) ret = PIDL.JSONTools.createValue(\"root\", PIDL.JSONTools.Type.Object);" << std::endl;
+				ctx->writeTabs(code_deepness) << "_intf._addValue(ret, \"object_data\", _data);" << std::endl;
+				ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+			}
+			else
+				ctx->writeTabs(code_deepness) << "return _callFunction(id, v, out ret, ec);" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl;
+		}
+
+		//the ids of the calls of 'cl' have to be distinct
+		template<class Class_T>
+		bool checkCallIds(Class_T * cl, ErrorCollector & ec)
+		{
+			std::map<int, Language::DefinitionProvider::Call> ids;
+			for (auto & c : cl->calls())
+			{
+				auto res = ids.insert({ Language::DefinitionProvider::callId(c.name, c.variant), c });
+				if (!res.second)
+				{
+					auto & o = res.first->second;
+					ec << "numeric id of function '" + c.name + "' (variant '" + c.variant + "') collides with the one of function '" + o.name + "' (variant '" + o.variant + "') in '" + cl->name() + "'";
+					return false;
+				}
+			}
+			return true;
+		}
+
+		//server side: the handlers registered by name keyed by their ids
+		template<class Class_T>
+		void writeFunctionsById(short code_deepness, CSCodeGenContext * ctx, Class_T * cl)
+		{
+			if (!functionIds())
+				return;
+			ctx->writeTabs(code_deepness) << "_functionsById = new Dictionary<int, Func<XElement, PIDL.IPIDLErrorCollector, _FunctionRet>> {" << std::endl;
+			for (auto & c : cl->calls())
+				ctx->writeTabs(code_deepness + 1) << "{ " << Language::DefinitionProvider::callId(c.name, c.variant) << ", _functions[\"" << c.name << "\"][" << (c.variant.length() ? "\"" + c.variant + "\"" : std::string("string.Empty")) << "] }," << std::endl;
+			ctx->writeTabs(code_deepness) << "};" << std::endl;
+		}
 
 		bool hasObjects(Language::Interface * intf)
 		{
 			for (auto & d : intf->definitions())
 			{
-				if (std::dynamic_pointer_cast<Language::Object>(d))
+				if (d->kind() == Language::Element::Kind::Object)
 					return true;
 			}
 			return false;
@@ -201,7 +310,8 @@ namespace PIDL
 		bool writeMembers(Language::Interface * intf, short code_deepness, Context * ctx, Class_T * cl, ErrorCollector & ec)
 		{
             (void)intf;
-            (void)ec;
+			if (functionIds() && !checkCallIds(cl, ec))
+				return false;
             switch (ctx->role())
 			{
 			case Role::Server:
@@ -219,6 +329,18 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "var retval_ = func[variant](root, ec); ret = retval_.ret; return retval_.status;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 
+				if (functionIds())
+				{
+					ctx->writeTabs(code_deepness) << "Dictionary<int, Func<XElement, PIDL.IPIDLErrorCollector, _FunctionRet>> _functionsById;" << std::endl;
+					ctx->writeTabs(code_deepness) << "_InvokeStatus _callFunction(int id, XElement root, out XElement ret, PIDL.IPIDLErrorCollector ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					ctx->writeTabs(code_deepness) << "Func<XElement, PIDL.IPIDLErrorCollector, _FunctionRet> func;" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!_functionsById.TryGetValue(id, out func))" << std::endl;
+					ctx->writeTabs(code_deepness) << "{ ec.Add(-1, \"function #\" + id + \" is not found\"); ret = null; return _InvokeStatus.NotImplemented; }" << std::endl;
+					ctx->writeTabs(code_deepness) << "var retval = func(root, ec); ret = retval.ret; return retval.status;" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				}
+
 				ctx->writeTabs(code_deepness) << "_InvokeStatus _callFunction(Func<object> func, PIDL.IPIDLErrorCollector ec)" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
 				ctx->writeTabs(code_deepness) << "try" << std::endl;
@@ -241,7 +363,7 @@ namespace PIDL
 			case Role::Client:
 				ctx->writeTabs(code_deepness) << "bool _invokeCall(XElement root, out XElement ret, PIDL.IPIDLErrorCollector ec)" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
-				if (dynamic_cast<Language::Interface*>(cl))
+				if (cl->kind() == Language::Element::Kind::Interface)
 					ctx->writeTabs(code_deepness) << "var _intf = this;" << std::endl;
 				ctx->writeTabs(code_deepness) << "var status = _intf._invoke(root, out ret, ec);" << std::endl;
 				ctx->writeTabs(code_deepness) << "switch(status)" << std::endl;
@@ -279,13 +401,13 @@ namespace PIDL
 			case Role::Server:
 				for (auto & d : cl->definitions())
 				{
-					if (dynamic_cast<Language::FunctionVariant*>(d.get()))
+					if (d->kind() == Language::Element::Kind::FunctionVariant || d->kind() == Language::Element::Kind::MethodVariant)
 					{
-						auto function = dynamic_cast<Language::FunctionVariant*>(d.get());
+						auto function = static_cast<Language::FunctionVariant*>(d.get());
 						ctx->writeTabs(code_deepness) << "if (!_functions.ContainsKey(\"" << function->name() << "\"))" << std::endl;
 						ctx->writeTabs(code_deepness + 1) << "_functions.Add(\"" << function->name() << "\", new Dictionary<string, Func<XElement, PIDL.IPIDLErrorCollector, _FunctionRet>>());" << std::endl;
 						ctx->writeTabs(code_deepness++) << "_functions[\"" << function->name() << "\"][\"" << function->variantId() << "\"] = (root, ec) => {" << std::endl;
-						if (!dynamic_cast<Language::MethodVariant* > (function))
+						if (function->kind() != Language::Element::Kind::MethodVariant)
 							ctx->writeTabs(code_deepness) << "var _intf = this;" << std::endl;
 						ctx->writeTabs(code_deepness) << "var ret = new _FunctionRet();" << std::endl;
 						for (auto & a : function->arguments())
@@ -321,7 +443,7 @@ namespace PIDL
 						}
 
 						auto ret_type = function->returnType().get();
-						if (dynamic_cast<Language::Void*>(function->returnType().get()))
+						if (function->returnType()->kind() == Language::Element::Kind::Void)
 							ret_type = nullptr;
 						if (ret_type)
 						{
@@ -379,10 +501,10 @@ namespace PIDL
 						ctx->writeTabs(code_deepness) << "return ret;" << std::endl;
 						ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
 					}
-					else if (dynamic_cast<Language::Property*>(d.get()))
+					else if (d->kind() == Language::Element::Kind::Property)
 					{
 					//getter
-						auto property = dynamic_cast<Language::Property*>(d.get());
+						auto property = static_cast<Language::Property*>(d.get());
 						ctx->writeTabs(code_deepness) << "_functions.Add(\"" << property->name() << "\", new Dictionary<string, Func<XElement, PIDL.IPIDLErrorCollector, _FunctionRet>>());" << std::endl;
 						ctx->writeTabs(code_deepness++) << "_functions[\"" << property->name() << "\"][\"get\"] = (root, ec) => {" << std::endl;
 						ctx->writeTabs(code_deepness) << "var ret = new _FunctionRet();" << std::endl;
@@ -447,7 +569,7 @@ namespace PIDL
 
 					ctx->writeTabs(code_deepness) << "PIDL.JSONTools.addValue(_root, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
 
-					if (dynamic_cast<Language::MethodVariant*>(function))
+					if (function->kind() == Language::Element::Kind::MethodVariant)
 					{
 						ctx->writeTabs(code_deepness) << "var _r = PIDL.JSONTools.addValue(_root, \"object_call\", PIDL.JSONTools.Type.Object);" << std::endl;
 						ctx->writeTabs(code_deepness) << "_intf._addValue(_r, \"object_data\", _data);" << std::endl;
@@ -458,8 +580,7 @@ namespace PIDL
 						ctx->writeTabs(code_deepness) << "var _intf = this;" << std::endl;
 						ctx->writeTabs(code_deepness) << "var _v = PIDL.JSONTools.addValue(_root, \"function\", PIDL.JSONTools.Type.Object);" << std::endl;
 					}
-					ctx->writeTabs(code_deepness) << "_intf._addValue(_v, \"name\", \"" << function->name() << "\");" << std::endl;
-					ctx->writeTabs(code_deepness) << "_intf._addValue(_v, \"variant\", \"" << function->variantId() << "\");" << std::endl;
+					writeCallFields(code_deepness, ctx, "_intf.", intf, function, function->name(), function->variantId(), true);
 
 					auto in_args = function->in_arguments();
 					if (in_args.size())
@@ -474,7 +595,7 @@ namespace PIDL
 					ctx->writeTabs(code_deepness + 1) << "_ec.ThrowException();" << std::endl;
 
 					auto ret_type = function->returnType().get();
-					if (!dynamic_cast<Language::Void*>(ret_type))
+					if (ret_type->kind() != Language::Element::Kind::Void)
 					{
 						ctx->writeTabs(code_deepness);
 						if (!that->writeType(ret_type, code_deepness, ctx, ec))
@@ -520,13 +641,13 @@ namespace PIDL
 						ctx->writeTabs(--code_deepness) << ") _ec.ThrowException();" << std::endl;
 					}
 
-					if (dynamic_cast<Language::MethodVariant*>(function))
+					if (function->kind() == Language::Element::Kind::MethodVariant)
 					{
 						ctx->writeTabs(code_deepness) << "string _tmp_object_data;" << std::endl;
 						ctx->writeTabs(code_deepness) << "if (PIDL.JSONTools.getValue(_ret, \"object_data\", out _tmp_object_data)) _data = _tmp_object_data;" << std::endl;
 					}
 
-					if (!dynamic_cast<Language::Void*>(ret_type))
+					if (ret_type->kind() != Language::Element::Kind::Void)
 						ctx->writeTabs(code_deepness) << "return _retval;" << std::endl;
 				}
 				break;
@@ -551,7 +672,7 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "var _r = PIDL.JSONTools.addValue(_root, \"object_call\", PIDL.JSONTools.Type.Object);" << std::endl;
 				ctx->writeTabs(code_deepness) << "_intf._addValue(_r, \"object_data\", _data);" << std::endl;
 				ctx->writeTabs(code_deepness) << "var _v = PIDL.JSONTools.addValue(_r, \"property_get\", PIDL.JSONTools.Type.Object);" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf._addValue(_v, \"name\", \"" << prop->name() << "\");" << std::endl;
+				writeCallFields(code_deepness, ctx, "_intf.", intf, prop, prop->name(), "get", false);
 
 				ctx->writeTabs(code_deepness) << "XElement _ret;" << std::endl;
 				ctx->writeTabs(code_deepness) << "if (!_intf._invokeCall(_root, out _ret, _ec))" << std::endl;
@@ -592,7 +713,7 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "var _r = PIDL.JSONTools.addValue(_root, \"object_call\", PIDL.JSONTools.Type.Object);" << std::endl;
 				ctx->writeTabs(code_deepness) << "_intf._addValue(_r, \"object_data\", _data);" << std::endl;
 				ctx->writeTabs(code_deepness) << "var _v = PIDL.JSONTools.addValue(_r, \"property_set\", PIDL.JSONTools.Type.Object);" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf._addValue(_v, \"name\", \"" << prop->name() << "\");" << std::endl;
+				writeCallFields(code_deepness, ctx, "_intf.", intf, prop, prop->name(), "set", false);
 
 				ctx->writeTabs(code_deepness) << "_intf." << ctx->addValue_str(intf, prop->type().get()) << "(_v, \"value\", value);" << std::endl;
 
@@ -612,14 +733,14 @@ namespace PIDL
 
 	};
 
-	JSON_CSCodeGen::JSON_CSCodeGen(const std::shared_ptr<CSCodeGenHelper> & helper) :
+	JSON_CSCodeGen::JSON_CSCodeGen(const std::shared_ptr<CSCodeGenHelper> & helper, const std::set<Flag> & flags) :
 		CSCodeGen(),
-		priv(new Priv(this, helper))
+		priv(new Priv(this, helper, flags))
 	{ }
 
 	JSON_CSCodeGen::JSON_CSCodeGen() :
 		CSCodeGen(),
-		priv(new Priv(this, std::make_shared<CSBasicCodeGenHelper>()))
+		priv(new Priv(this, std::make_shared<CSBasicCodeGenHelper>(), std::set<Flag>()))
 	{ }
 
 	JSON_CSCodeGen::~JSON_CSCodeGen()
@@ -663,12 +784,12 @@ namespace PIDL
 
 		for (auto & d : intf->definitions())
 		{
-			if (dynamic_cast<Language::TypeDefinition*>(d.get()))
+			if (d->kind() == Language::Element::Kind::TypeDefinition)
 			{
 			} 
-			else if (dynamic_cast<Language::Object*>(d.get()))
+			else if (d->kind() == Language::Element::Kind::Object)
 			{
-				auto object = dynamic_cast<Language::Object*>(d.get());
+				auto object = static_cast<Language::Object*>(d.get());
 				switch (ctx->role())
 				{
 				case Role::Client:
@@ -731,12 +852,12 @@ namespace PIDL
 		bool is_first = true;
 		for (auto & d : intf->definitions())
 		{
-			if (dynamic_cast<Language::TypeDefinition*>(d.get()))
+			if (d->kind() == Language::Element::Kind::TypeDefinition)
 			{
 			}
-			else if (dynamic_cast<Language::Object*>(d.get()))
+			else if (d->kind() == Language::Element::Kind::Object)
 			{
-				auto object = dynamic_cast<Language::Object*>(d.get());
+				auto object = static_cast<Language::Object*>(d.get());
 				if (is_first)
 				{
 					is_first = false;
@@ -765,12 +886,12 @@ namespace PIDL
 		ctx->writeTabs(code_deepness++) << "{" << std::endl;
 		for (auto & d : intf->definitions())
 		{
-			if (dynamic_cast<Language::TypeDefinition*>(d.get()))
+			if (d->kind() == Language::Element::Kind::TypeDefinition)
 			{
 			}
-			else if (dynamic_cast<Language::Object*>(d.get()))
+			else if (d->kind() == Language::Element::Kind::Object)
 			{
-				auto object = dynamic_cast<Language::Object*>(d.get());
+				auto object = static_cast<Language::Object*>(d.get());
 				ctx->writeTabs(code_deepness) << "if (typeof(T) == typeof(" << object->name() << "))" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
 				ctx->writeTabs(code_deepness) << "bool isOk;" << std::endl;
@@ -816,9 +937,9 @@ namespace PIDL
 		//getter for prebuilt types
 		for (auto & ct : ctx->prebuilt_types(intf))
 		{
-			if (dynamic_cast<Language::Tuple*>(ct.second))
+			if (ct.second->kind() == Language::Element::Kind::Tuple)
 			{
-				auto tt = dynamic_cast<Language::Tuple*>(ct.second);
+				auto tt = static_cast<Language::Tuple*>(ct.second);
 				ctx->writeTabs(code_deepness) << "bool _getValue_" << ct.first << "(XElement r, string name, out ";
 				if (!writeType(tt, code_deepness, ctx, ec))
 					return false;
@@ -886,9 +1007,9 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "return true;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 			}
-			else if (dynamic_cast<Language::Nullable*>(ct.second))
+			else if (ct.second->kind() == Language::Element::Kind::Nullable)
 			{
-				auto nt = dynamic_cast<Language::Nullable*>(ct.second);
+				auto nt = static_cast<Language::Nullable*>(ct.second);
 				ctx->writeTabs(code_deepness) << "bool _getValue_" << ct.first << "(XElement r, string name, out ";
 				if (!writeType(nt, code_deepness, ctx, ec))
 					return false;
@@ -915,10 +1036,10 @@ namespace PIDL
 				ctx->writeTabs(code_deepness + 1) << "return true;" << std::endl;
 				ctx->writeTabs(code_deepness);
 				auto t = nt->types().front().get();
-				auto fn_type = t->finalType().get();
-				if (dynamic_cast<Language::NativeType*>(fn_type) ||
-					dynamic_cast<Language::DateTime*>(fn_type) ||
-					dynamic_cast<Language::Structure*>(fn_type))
+				auto fn_kind = t->finalType()->kind();
+				if (fn_kind == Language::Element::Kind::Integer || fn_kind == Language::Element::Kind::Float || fn_kind == Language::Element::Kind::Boolean ||
+					fn_kind == Language::Element::Kind::DateTime ||
+					fn_kind == Language::Element::Kind::Structure)
 				{
 					if (!writeType(nt->types().front().get(), code_deepness, ctx, ec))
 						return false;
@@ -935,9 +1056,9 @@ namespace PIDL
 
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 			}
-			else if (dynamic_cast<Language::Array*>(ct.second))
+			else if (ct.second->kind() == Language::Element::Kind::Array)
 			{
-				auto at = dynamic_cast<Language::Array*>(ct.second);
+				auto at = static_cast<Language::Array*>(ct.second);
 				ctx->writeTabs(code_deepness) << "bool _getValue_" << ct.first << "(XElement r, string name, out ";
 				if (!writeType(at, code_deepness, ctx, ec))
 					return false;
@@ -976,10 +1097,10 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "return !has_error;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 			}
-			else if (dynamic_cast<Language::TypeDefinition*>(ct.second))
+			else if (ct.second->kind() == Language::Element::Kind::TypeDefinition)
 			{
-				auto td = dynamic_cast<Language::TypeDefinition*>(ct.second);
-				auto s = dynamic_cast<Language::Structure*>(td->type().get());
+				auto td = static_cast<Language::TypeDefinition*>(ct.second);
+				auto s = td->type()->kind() == Language::Element::Kind::Structure ? static_cast<Language::Structure*>(td->type().get()) : nullptr;
 				if (s)
 				{
 					ctx->writeTabs(code_deepness) << "bool _getValue_" << ct.first << "(XElement r, string name, out ";
@@ -1047,12 +1168,12 @@ namespace PIDL
 		is_first = true;
 		for (auto & d : intf->definitions())
 		{
-			if (dynamic_cast<Language::TypeDefinition*>(d.get()))
+			if (d->kind() == Language::Element::Kind::TypeDefinition)
 			{
 			}
-			else if (dynamic_cast<Language::Object*>(d.get()))
+			else if (d->kind() == Language::Element::Kind::Object)
 			{
-				auto object = dynamic_cast<Language::Object*>(d.get());
+				auto object = static_cast<Language::Object*>(d.get());
 
 				if (is_first)
 				{
@@ -1100,9 +1221,9 @@ namespace PIDL
 		//setters for prebuilt types
 		for (auto & ct : ctx->prebuilt_types(intf))
 		{
-			if (dynamic_cast<Language::Tuple*>(ct.second))
+			if (ct.second->kind() == Language::Element::Kind::Tuple)
 			{
-				auto tt = dynamic_cast<Language::Tuple*>(ct.second);
+				auto tt = static_cast<Language::Tuple*>(ct.second);
 				ctx->writeTabs(code_deepness) << "void _addValue_" << ct.first << "(XElement r, string name, ";
 				if (!writeType(tt, code_deepness, ctx, ec))
 					return false;
@@ -1116,9 +1237,9 @@ namespace PIDL
 					ctx->writeTabs(code_deepness) << ctx->addValue_str(intf, t.get()) << "(v, \"item\", val.Item" << ++i << ");" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 			}
-			else if (dynamic_cast<Language::Nullable*>(ct.second))
+			else if (ct.second->kind() == Language::Element::Kind::Nullable)
 			{
-				auto nt = dynamic_cast<Language::Nullable*>(ct.second);
+				auto nt = static_cast<Language::Nullable*>(ct.second);
 				ctx->writeTabs(code_deepness) << "void _addValue_" << ct.first << "(XElement r, string name, ";
 				if (!writeType(nt, code_deepness, ctx, ec))
 					return false;
@@ -1130,9 +1251,9 @@ namespace PIDL
 				ctx->writeTabs(code_deepness + 1) << ctx->addValue_str(intf, nt->types().front().get()) << "(r, name, val);" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 			}
-			else if (dynamic_cast<Language::Array*>(ct.second))
+			else if (ct.second->kind() == Language::Element::Kind::Array)
 			{
-				auto at = dynamic_cast<Language::Array*>(ct.second);
+				auto at = static_cast<Language::Array*>(ct.second);
 				ctx->writeTabs(code_deepness) << "void _addValue_" << ct.first << "(XElement r, string name, ";
 				if (!writeType(at, code_deepness, ctx, ec))
 					return false;
@@ -1145,10 +1266,10 @@ namespace PIDL
 				ctx->writeTabs(code_deepness + 1) << ctx->addValue_str(intf, at->types().front().get()) << "(v, \"item\", it);" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 			}
-			else if (dynamic_cast<Language::TypeDefinition*>(ct.second))
+			else if (ct.second->kind() == Language::Element::Kind::TypeDefinition)
 			{
-				auto td = dynamic_cast<Language::TypeDefinition*>(ct.second);
-				auto s = dynamic_cast<Language::Structure*>(td->type().get());
+				auto td = static_cast<Language::TypeDefinition*>(ct.second);
+				auto s = td->type()->kind() == Language::Element::Kind::Structure ? static_cast<Language::Structure*>(td->type().get()) : nullptr;
 				if (s)
 				{
 					ctx->writeTabs(code_deepness) << "void _addValue_" << ct.first << "(XElement r, string name, ";
@@ -1184,7 +1305,7 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "PIDL.JSONTools.addValue(_root, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
 
 				ctx->writeTabs(code_deepness) << "var _v = PIDL.JSONTools.addValue(_root, \"function\", PIDL.JSONTools.Type.Object);" << std::endl;
-				ctx->writeTabs(code_deepness) << "_addValue(_v, \"name\", \"_dispose_object\");" << std::endl;
+				priv->writeCallFields(code_deepness, ctx, "", intf, nullptr, "_dispose_object", std::string(), false);
 				ctx->writeTabs(code_deepness) << "var _aa = PIDL.JSONTools.addValue(_v, \"arguments\", PIDL.JSONTools.Type.Object);" << std::endl;
 				ctx->writeTabs(code_deepness) << "_addValue(_aa, \"object_data\", object_data);" << std::endl;
 				ctx->writeTabs(code_deepness) << "XElement _ret;" << std::endl;
@@ -1217,6 +1338,7 @@ namespace PIDL
 
 			ctx->writeTabs(code_deepness) << "if (PIDL.JSONTools.getValue(root, \"function\", out v) && PIDL.JSONTools.checkType(v, PIDL.JSONTools.Type.Object))" << std::endl;
 			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			priv->writeIdDispatch(code_deepness, ctx, false, false);
 			ctx->writeTabs(code_deepness) << "string name, variant;" << std::endl;
 			ctx->writeTabs(code_deepness) << "if (!_getValue(v, \"name\", out name, ec))" << std::endl;
 			ctx->writeTabs(code_deepness) << "{ ret = null; return _InvokeStatus.MarshallingError; }" << std::endl;
@@ -1301,6 +1423,7 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "return ret;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
 			}
+			priv->writeFunctionsById(code_deepness, ctx, intf);
 			break;
 		}
 
@@ -1318,7 +1441,11 @@ namespace PIDL
 	{
 		auto ctx = dynamic_cast<Priv::Context*>(_ctx);
 		assert(ctx);
-		return priv->writeConstructorBody(intf, obj, code_deepness, ctx, ec);
+		if (!priv->writeConstructorBody(intf, obj, code_deepness, ctx, ec))
+			return false;
+		if (ctx->role() == Role::Server)
+			priv->writeFunctionsById(code_deepness, ctx, obj);
+		return true;
 	}
 
 	bool JSON_CSCodeGen::writeDestructorBody(Language::Interface * intf, Language::Object * obj, short code_deepness, CSCodeGenContext * ctx, ErrorCollector & ec)
@@ -1352,6 +1479,7 @@ namespace PIDL
 
 			ctx->writeTabs(code_deepness) << "if (PIDL.JSONTools.getValue(root, \"method\", out v) && PIDL.JSONTools.checkType(v, PIDL.JSONTools.Type.Object))" << std::endl;
 			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			priv->writeIdDispatch(code_deepness, ctx, true, false);
 			ctx->writeTabs(code_deepness) << "string name, variant;" << std::endl;
 			ctx->writeTabs(code_deepness) << "if (!_intf._getValue(v, \"name\", out name, ec))" << std::endl;
 			ctx->writeTabs(code_deepness) << "{ ret = null; return _InvokeStatus.MarshallingError; }" << std::endl << std::endl;
@@ -1364,6 +1492,7 @@ namespace PIDL
 
 			ctx->writeTabs(code_deepness) << "else if (PIDL.JSONTools.getValue(root, \"property_get\", out v) && PIDL.JSONTools.checkType(v, PIDL.JSONTools.Type.Object))" << std::endl;
 			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			priv->writeIdDispatch(code_deepness, ctx, true, false);
 			ctx->writeTabs(code_deepness) << "string name;" << std::endl;
 			ctx->writeTabs(code_deepness) << "if (!_intf._getValue(v, \"name\", out name, ec))" << std::endl;
 			ctx->writeTabs(code_deepness) << "{ ret = null; return _InvokeStatus.MarshallingError; }" << std::endl << std::endl;
@@ -1375,6 +1504,7 @@ namespace PIDL
 
 			ctx->writeTabs(code_deepness) << "else if (PIDL.JSONTools.getValue(root, \"property_set\", out v) && PIDL.JSONTools.checkType(v, PIDL.JSONTools.Type.Object))" << std::endl;
 			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			priv->writeIdDispatch(code_deepness, ctx, true, true);
 			ctx->writeTabs(code_deepness) << "string name;" << std::endl;
 			ctx->writeTabs(code_deepness) << "if (!_intf._getValue(v, \"name\", out name, ec))" << std::endl;
 			ctx->writeTabs(code_deepness) << "{ ret = null; return _InvokeStatus.MarshallingError; }" << std::endl << std::endl;
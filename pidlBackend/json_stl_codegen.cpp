@@ -17,9 +17,12 @@
 
 #include "include/pidlBackend/json_stl_codegen.h"
 #include "include/pidlBackend/language.h"
+#include <pidlCore/errorcollector.h>
 
 #include <assert.h>
+#include <cstring>
 #include <functional>
+#include <map>
 
 namespace PIDL
 {
@@ -41,6 +44,131 @@ namespace PIDL
             return flags.count(Flag::UseOptional);
         }
 
+        bool saxUnmarshalling() const
+        {
+            return flags.count(Flag::SAXUnmarshalling);
+        }
+
+        bool writerMarshalling() const
+        {
+            return flags.count(Flag::WriterMarshalling);
+        }
+
+        bool documentPool() const
+        {
+            return flags.count(Flag::DocumentPool);
+        }
+
+        bool workerPool() const
+        {
+            return flags.count(Flag::WorkerPool);
+        }
+
+        bool instrumentation() const
+        {
+            return flags.count(Flag::Instrumentation);
+        }
+
+        bool functionIds() const
+        {
+            return flags.count(Flag::FunctionIds);
+        }
+
+        bool batchCalls() const
+        {
+            return flags.count(Flag::BatchCalls);
+        }
+
+        bool asyncCalls() const
+        {
+            return flags.count(Flag::AsyncCalls);
+        }
+
+        bool objectTable() const
+        {
+            return flags.count(Flag::ObjectTable);
+        }
+
+        bool objectDataChanges() const
+        {
+            return flags.count(Flag::ObjectDataChanges);
+        }
+
+        bool deferredDisposal() const
+        {
+            return flags.count(Flag::DeferredDisposal);
+        }
+
+        bool compactDateTime() const
+        {
+            return flags.count(Flag::CompactDateTime);
+        }
+
+        //server side: the object data of the objects of the interface
+        std::string objectData(CPPCodeGenContext * ctx, const char * object)
+        {
+            if (objectTable() && ctx->role() == Role::Server)
+                return std::string("_intf->_object_data(") + object + ")";
+            return std::string(object) + "->_data()";
+        }
+
+		//numeric id of the call of 'element' ('_dispose_object' for nullptr) in 'cl' or in one of its objects; -1 if not found
+		int callId(const Language::DefinitionProvider * cl, const Language::Element * element, const std::string & variant)
+		{
+			for (auto & c : cl->calls())
+				if (c.element == element && c.variant == variant)
+					return Language::DefinitionProvider::callId(c.name, c.variant);
+			for (auto & d : cl->definitions())
+				if (d->kind() == Language::Element::Kind::Object)
+				{
+					auto id = callId(static_cast<Language::Object*>(d.get()), element, variant);
+					if (id >= 0)
+						return id;
+				}
+			return -1;
+		}
+
+		int callId(const Handler & h)
+		{
+			return Language::DefinitionProvider::callId(h.name, h.variant);
+		}
+
+		//the ids of the calls of 'cl' have to be distinct
+		template<class Class_T>
+		bool checkCallIds(Class_T * cl, ErrorCollector & ec)
+		{
+			std::map<int, const Handler*> ids;
+			auto hs = handlers(cl, false);
+			for (auto & h : hs)
+			{
+				auto res = ids.insert({ callId(h), &h });
+				if (!res.second)
+				{
+					auto & o = *res.first->second;
+					ec << "numeric id of function '" + h.name + "' (variant '" + h.variant + "') collides with the one of function '" + o.name + "' (variant '" + o.variant + "') in '" + cl->name() + "'";
+					return false;
+				}
+			}
+			return true;
+		}
+
+        void writeDocument(short code_deepness, CPPCodeGenContext * ctx, const char * name)
+        {
+            if (documentPool())
+            {
+                ctx->writeTabs(code_deepness) << "PIDL::JSONTools::PooledDocument " << name << "_pooled;" << std::endl;
+                ctx->writeTabs(code_deepness) << "rapidjson::Document & " << name << " = " << name << "_pooled.document();" << std::endl;
+            }
+            else
+                ctx->writeTabs(code_deepness) << "rapidjson::Document " << name << ";" << std::endl;
+        }
+
+        //type of the response of the server side functions
+        const char * retType() const
+        {
+            return writerMarshalling() ? "PIDL::JSONTools::Writer" : "rapidjson::Document";
+        }
+
 		std::string privLogger()
 		{
 			return "priv->logger";
@@ -50,47 +178,1302 @@ namespace PIDL
 		{
 			for (auto & d : intf->definitions())
 			{
-				if (std::dynamic_pointer_cast<Language::Object>(d))
+				if (d->kind() == Language::Element::Kind::Object)
 					return true;
 			}
 			return false;
 		}
 
-		template<class T>
-		std::string getScope(const T * t)
-		{
-			std::string ret;
-			for (auto & sc : t->scope())
-				ret += sc + "::";
-			return ret;
+		//server side with object table: the type of 'obj' among the objects of the interface, checked by '_get_object<Object_T>'
+		int objectTypeId(Language::Interface * intf, Language::Object * obj)
+		{
+			int id = 0;
+			for (auto & d : intf->definitions())
+			{
+				if (d.get() == obj)
+					return id;
+				if (d->kind() == Language::Element::Kind::Object)
+					++id;
+			}
+			return -1;
+		}
+
+		//the templated writers are instantiated for interfaces and objects
+		static Language::Interface * asInterface(Language::Interface * intf)
+		{
+			return intf;
+		}
+
+		static Language::Interface * asInterface(Language::Object *)
+		{
+			return nullptr;
+		}
+
+		template<class T>
+		std::string getScope(const T * t)
+		{
+			std::string ret;
+			for (auto & sc : t->scope())
+				ret += sc + "::";
+			return ret;
+		}
+
+		//server side: the state of the object is sent back with the response of every object call, or only when it has
+		//changed during the call
+		void writeObjectData(short code_deepness, CPPCodeGenContext * ctx, bool may_be_empty)
+		{
+			if (writerMarshalling())
+			{
+				ctx->writeTabs(code_deepness) << "if (stat == _invoke_status::Ok)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				if (objectDataChanges())
+				{
+					ctx->writeTabs(code_deepness) << "auto _object_data = _data();" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!PIDL::JSONTools::equals(root, \"object_data\", _object_data))" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "_intf_p->_writeValue(ret, \"object_data\", _object_data);" << std::endl;
+				}
+				else
+					ctx->writeTabs(code_deepness) << "_intf_p->_writeValue(ret, \"object_data\", _data());" << std::endl;
+				ctx->writeTabs(code_deepness) << "ret.EndObject();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+			}
+			else
+			{
+				if (may_be_empty)
+					ctx->writeTabs(code_deepness) << "if (!ret.IsObject()) ret.SetObject();" << std::endl;
+				if (objectDataChanges())
+				{
+					ctx->writeTabs(code_deepness) << "auto _object_data = _data();" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!PIDL::JSONTools::equals(root, \"object_data\", _object_data))" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "_intf_p->_addValue(ret, ret, \"object_data\", _object_data);" << std::endl;
+				}
+				else
+					ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, ret, \"object_data\", _data());" << std::endl;
+			}
+		}
+
+		//marshalling straight into the output buffer (see PIDL::JSONTools::Writer)
+		void writeWriterMembers(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf)
+		{
+			ctx->writeTabs(code_deepness) << "//writers" << std::endl;
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::JSONTools::Writer & w, const T & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ PIDL::JSONTools::writeValue(w, v); }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::JSONTools::Writer & w, const char * name, const T & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ w.Key(name); _writeValue(w, v); }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::JSONTools::Writer & w, const array<T> & values)" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "w.StartArray();" << std::endl;
+			ctx->writeTabs(code_deepness) << "for (auto & _v : values)" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "_writeValue(w, _v);" << std::endl;
+			ctx->writeTabs(code_deepness) << "w.EndArray();" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::JSONTools::Writer & w, const nullable<T> & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ if (!v) w.Null(); else _writeValue(w, *v); }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> void _writeValue(PIDL::JSONTools::Writer & w, const nullable_const_ref<T> & v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ if (!v) w.Null(); else _writeValue(w, *v); }" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "void _writeValue(PIDL::JSONTools::Writer & w, const blob & data)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ PIDL::JSONTools::writeValue(w, data); }" << std::endl << std::endl;
+
+			if (compactDateTime())
+			{
+				ctx->writeTabs(code_deepness) << "void _writeValue(PIDL::JSONTools::Writer & w, const datetime & t)" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ PIDL::JSONTools::writeCompactValue(w, t); }" << std::endl << std::endl;
+			}
+
+			//tuple
+			ctx->writeTabs(code_deepness) << "struct _tuple_writeValue_functor" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "_tuple_writeValue_functor(_Priv * priv_, PIDL::JSONTools::Writer & w_) : priv(priv_), w(w_) { }" << std::endl;
+			ctx->writeTabs(code_deepness) << "_Priv * priv;" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::Writer & w;" << std::endl;
+			ctx->writeTabs(code_deepness) << "template<typename T> void operator () (T && v)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ priv->_writeValue(w, v); }" << std::endl;
+			ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename ...T> void _writeValue(PIDL::JSONTools::Writer & w, const tuple<T...> & values)" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "w.StartArray();" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::for_each_in_tuple(values, _tuple_writeValue_functor(this, w));" << std::endl;
+			ctx->writeTabs(code_deepness) << "w.EndArray();" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+			std::function<void(Language::DefinitionProvider * cl)> add_writeValue = [&](Language::DefinitionProvider * cl) {
+				for (auto & d : cl->definitions())
+				{
+					if (d->kind() == Language::Element::Kind::TypeDefinition)
+					{
+						auto td = static_cast<Language::TypeDefinition*>(d.get());
+						if (td->type()->kind() == Language::Element::Kind::Structure)
+						{
+							auto s = static_cast<Language::Structure*>(td->type().get());
+							ctx->writeTabs(code_deepness) << "void _writeValue(PIDL::JSONTools::Writer & w, const " << getScope(td) << td->name() << " & in)" << std::endl;
+							ctx->writeTabs(code_deepness++) << "{" << std::endl;
+							ctx->writeTabs(code_deepness) << "w.StartObject();" << std::endl;
+							for (auto & m : s->members())
+								ctx->writeTabs(code_deepness) << "_writeValue(w, \"" << m->name() << "\", in." << m->name() << ");" << std::endl;
+							ctx->writeTabs(code_deepness) << "w.EndObject();" << std::endl;
+							ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+						}
+					}
+					else if (d->kind() == Language::Element::Kind::Object)
+					{
+						auto obj = static_cast<Language::Object*>(d.get());
+						ctx->writeTabs(code_deepness) << "void _writeValue(PIDL::JSONTools::Writer & w, const ptr<" << getScope(obj) << obj->name() << "> & in)" << std::endl;
+						ctx->writeTabs(code_deepness) << "{ if (in) PIDL::JSONTools::writeValue(w, " << objectData(ctx, "in") << "); else w.Null(); }" << std::endl << std::endl;
+
+						add_writeValue(obj);
+					}
+				}
+			};
+
+			add_writeValue(intf);
+		}
+
+		std::string requestName() const
+		{
+			return writerMarshalling() ? "_buffer" : "_doc";
+		}
+
+		//client side: the members identifying the call in the request
+		std::vector<std::pair<std::string, std::string>> callFields(Language::Interface * intf, const Language::Element * element,
+		                                                            const std::string & name, const std::string & variant, bool has_variant)
+		{
+			if (functionIds())
+				return { { "id", std::to_string(callId(intf, element, variant)) } };
+			std::vector<std::pair<std::string, std::string>> ret = { { "name", "\"" + name + "\"" } };
+			if (has_variant)
+				ret.push_back({ "variant", "\"" + variant + "\"" });
+			return ret;
+		}
+
+		std::vector<std::pair<std::string, std::string>> callFields(Language::Interface * intf, Language::FunctionVariant * function)
+		{
+			return callFields(intf, function, function->name(), function->variantId(), true);
+		}
+
+		std::vector<std::pair<std::string, std::string>> disposeObjectsFields()
+		{
+			if (functionIds())
+				return { { "id", std::to_string(Language::DefinitionProvider::callId("_dispose_objects", std::string())) } };
+			return { { "name", "\"_dispose_objects\"" } };
+		}
+
+		//server side: with numeric ids, '*v' is dispatched by its 'id' when it has one
+		void writeIdDispatch(short code_deepness, CPPCodeGenContext * ctx, bool is_object, bool may_be_empty)
+		{
+			if (!functionIds())
+				return;
+			ctx->writeTabs(code_deepness) << "int id;" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (PIDL::JSONTools::getValue(*v, \"id\", id))" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "ec.clear();" << std::endl;
+			if (is_object)
+			{
+				ctx->writeTabs(code_deepness) << "auto stat = _p->_callFunction(id, *v, ret, ec);" << std::endl;
+				writeObjectData(code_deepness, ctx, may_be_empty);
+				ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+			}
+			else if (writerMarshalling())
+			{
+				ctx->writeTabs(code_deepness) << "auto stat = _p->_callFunction(id, *v, ret, ec);" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (stat == _invoke_status::Ok)" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "ret.EndObject();" << std::endl;
+				ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+			}
+			else
+				ctx->writeTabs(code_deepness) << "return _p->_callFunction(id, *v, ret, ec);" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl;
+		}
+
+		std::vector<std::string> argumentNames(Language::FunctionVariant * function)
+		{
+			std::vector<std::string> ret;
+			for (auto & a : function->in_arguments())
+				ret.push_back(a->name());
+			return ret;
+		}
+
+		//client side: 'status' of '_invoke' is reported into 'ec'
+		void writeStatusCheck(short code_deepness, CPPCodeGenContext * ctx)
+		{
+			ctx->writeTabs(code_deepness) << "switch(status)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "case _invoke_status::Ok: break;" << std::endl;
+			ctx->writeTabs(code_deepness) << "case _invoke_status::NotImplemented:" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"function is not implemented\"); return false;" << std::endl;
+			ctx->writeTabs(code_deepness) << "case _invoke_status::Error:" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"error while executing server function\"); return false;" << std::endl;
+			ctx->writeTabs(code_deepness) << "case _invoke_status::FatalError:" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"fatal error while executing server function\"); return false;" << std::endl;
+			ctx->writeTabs(code_deepness) << "case _invoke_status::MarshallingError:" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"error while marshalling of function call\"); return false;" << std::endl;
+			ctx->writeTabs(code_deepness) << "case _invoke_status::NotSupportedMarshallingVersion:" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"not supported marshalling version\"); return false;" << std::endl;
+			ctx->writeTabs(code_deepness) << "}" << std::endl << std::endl;
+			ctx->writeTabs(code_deepness) << "return true;" << std::endl;
+		}
+
+		//client side: the request is written into '_buffer' by '_w' and sent by '_invokeCall'
+		void writeRequest(short code_deepness, CPPCodeGenContext * ctx, const std::string & p, const char * object_data, const char * call,
+		                  const std::vector<std::pair<std::string, std::string>> & fields, const std::vector<std::string> * arguments)
+		{
+			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::OutputBuffer _buffer;" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::Writer _w(_buffer.buffer());" << std::endl;
+			writeRequestObject(code_deepness, ctx, p, object_data, call, fields, arguments);
+		}
+
+		void writeRequestObject(short code_deepness, CPPCodeGenContext * ctx, const std::string & p, const char * object_data, const char * call,
+		                        const std::vector<std::pair<std::string, std::string>> & fields, const std::vector<std::string> * arguments)
+		{
+			ctx->writeTabs(code_deepness) << "_w.StartObject();" << std::endl;
+			ctx->writeTabs(code_deepness) << p << "->_writeValue(_w, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
+			if (object_data)
+			{
+				ctx->writeTabs(code_deepness) << "_w.Key(\"object_call\");" << std::endl;
+				ctx->writeTabs(code_deepness) << "_w.StartObject();" << std::endl;
+				ctx->writeTabs(code_deepness) << p << "->_writeValue(_w, \"object_data\", " << object_data << ");" << std::endl;
+			}
+			ctx->writeTabs(code_deepness) << "_w.Key(\"" << call << "\");" << std::endl;
+			ctx->writeTabs(code_deepness) << "_w.StartObject();" << std::endl;
+			for (auto & f : fields)
+				ctx->writeTabs(code_deepness) << p << "->_writeValue(_w, \"" << f.first << "\", " << f.second << ");" << std::endl;
+			if (arguments)
+			{
+				ctx->writeTabs(code_deepness) << "_w.Key(\"arguments\");" << std::endl;
+				ctx->writeTabs(code_deepness) << "_w.StartObject();" << std::endl;
+				for (auto & a : *arguments)
+					ctx->writeTabs(code_deepness) << p << "->_writeValue(_w, \"" << a << "\", " << a << ");" << std::endl;
+				ctx->writeTabs(code_deepness) << "_w.EndObject();" << std::endl;
+			}
+			ctx->writeTabs(code_deepness) << "_w.EndObject();" << std::endl;
+			if (object_data)
+				ctx->writeTabs(code_deepness) << "_w.EndObject();" << std::endl;
+			ctx->writeTabs(code_deepness) << "_w.EndObject();" << std::endl;
+		}
+
+		//client side: the request of 'function' is built into 'root' (allocated by '_doc')
+		void writeFunctionDocument(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, Language::FunctionVariant * function, const char * root)
+		{
+			ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, " << root << ", \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
+
+			ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
+			for (auto & f : callFields(intf, function))
+				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"" << f.first << "\", " << f.second << ");" << std::endl;
+			ctx->writeTabs(code_deepness) << "rapidjson::Value _aa(rapidjson::kObjectType);" << std::endl;
+
+			for (auto & a : function->in_arguments())
+				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _aa, \"" << a->name() << "\", " << a->name() << ");" << std::endl;
+
+			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _v, \"arguments\", _aa);" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, " << root << ", \"function\", _v);" << std::endl;
+		}
+
+		//client side: '_retval' and the output arguments are read from the response '_ret'
+		bool writeResponse(short code_deepness, CPPCodeGenContext * ctx, Language::FunctionVariant * function, ErrorCollector & ec)
+		{
+			auto ret_type = function->returnType().get();
+			if (ret_type->kind() != Language::Element::Kind::Void)
+			{
+				ctx->writeTabs(code_deepness);
+				if (!that->writeType(ret_type, code_deepness, ctx, ec))
+					return false;
+				*ctx << " _retval;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(_ret, \"retval\", _retval, _ec))" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
+			}
+
+			const auto & out_args = function->out_arguments();
+			if (out_args.size())
+			{
+				ctx->writeTabs(code_deepness) << "rapidjson::Value * _out_v;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(_ret, \"output\", rapidjson::kObjectType, _out_v, _ec))" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
+
+				auto & o = ctx->writeTabs(code_deepness++) << "if (" << std::endl;
+
+				bool is_first = true;
+				for (auto & a : out_args)
+				{
+					ctx->writeTabs(code_deepness);
+					if (!is_first)
+						o << "| ";
+					is_first = false;
+					o << "!_intf_p->_getValue(*_out_v, \"" << a->name() << "\", " << a->name() << ", _ec)" << std::endl;
+				}
+				ctx->writeTabs(--code_deepness) << ")" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
+			}
+			return true;
+		}
+
+		bool writeFuture(short code_deepness, CPPCodeGenContext * ctx, Language::FunctionVariant * function, ErrorCollector & ec)
+		{
+			*ctx << "std::future<";
+			if (!that->writeType(function->returnType().get(), code_deepness, ctx, ec))
+				return false;
+			*ctx << ">";
+			return true;
+		}
+
+		//server side: '_get_object', '_dispose_object' and '_object_data' on the PIDL::ObjectTable of the interface; an object
+		//is added when it is sent first, and stays there until the client disposes it
+		void writeObjectTable(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf)
+		{
+			std::string scope = ctx->mode() == Mode::Implementatinon ? getScope(intf) + intf->name() + "::" : std::string();
+			auto write_head = [&](bool is_virtual, const std::string & head) -> bool {
+				switch (ctx->mode())
+				{
+				case Mode::Declaration:
+					ctx->writeTabs(code_deepness) << (is_virtual ? "virtual " : "") << head << ";" << std::endl;
+					return false;
+				case Mode::AllInOne:
+					ctx->writeTabs(code_deepness) << (is_virtual ? "virtual " : "") << head << std::endl;
+					break;
+				case Mode::Implementatinon:
+					ctx->writeTabs(code_deepness) << head << std::endl;
+					break;
+				}
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << (ctx->mode() == Mode::Implementatinon ? "auto _p = _priv;" : "auto _p = this;") << std::endl;
+				return true;
+			};
+			auto write_tail = [&]() {
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				if (ctx->mode() == Mode::Implementatinon)
+					ctx->stream() << std::endl;
+			};
+
+			if (write_head(true, "ptr<" + scope + "_Object> " + scope + "_get_object(const std::string & object_data, _error_collector & ec)"))
+			{
+				ctx->writeTabs(code_deepness) << "auto o = std::static_pointer_cast<_Object>(_p->_objects.get(PIDL::ObjectTable::fromString(object_data)));" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!o) ec.add(-1, \"object is not found for data '\" + object_data + \"'\");" << std::endl;
+				ctx->writeTabs(code_deepness) << "return o;" << std::endl;
+				write_tail();
+			}
+
+			if (write_head(true, "void " + scope + "_dispose_object(const std::string & object_data)"))
+			{
+				ctx->writeTabs(code_deepness) << "auto handle = PIDL::ObjectTable::fromString(object_data);" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto o = std::static_pointer_cast<_Object>(_p->_objects.get(handle));" << std::endl;
+				//the handle of the object is cleared first, so '_object_data' does not send the handle being removed but adds the object again
+				ctx->writeTabs(code_deepness) << "auto expected = handle;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (o && o->_handle.compare_exchange_strong(expected, 0))" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_p->_objects.remove(handle);" << std::endl;
+				write_tail();
+			}
+
+			if (write_head(false, "std::string " + scope + "_object_data(const ptr<_Object> & object)"))
+			{
+				ctx->writeTabs(code_deepness) << "auto handle = object->_handle.load();" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!handle)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto h = _p->_objects.add(object);" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (object->_handle.compare_exchange_strong(handle, h))" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "handle = h;" << std::endl;
+				ctx->writeTabs(code_deepness) << "else" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_p->_objects.remove(h);" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "return PIDL::ObjectTable::toString(handle);" << std::endl;
+				write_tail();
+			}
+		}
+
+		//client side: the request of the embedded '_dispose_object' or '_dispose_objects'; 'object_data' is sent as argument
+		void writeDisposeCall(short code_deepness, CPPCodeGenContext * ctx, const char * name, const std::vector<std::pair<std::string, std::string>> & fields)
+		{
+			if(helper->logging())
+				helper->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_p->_logger", std::string("\"embedded function: '") + name + "'\"");
+
+			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
+			if (writerMarshalling())
+			{
+				std::vector<std::string> args = { "object_data" };
+				writeRequest(code_deepness, ctx, "_p", nullptr, "function", fields, &args);
+			}
+			else
+			{
+				writeDocument(code_deepness, ctx, "_doc");
+				ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
+
+				ctx->writeTabs(code_deepness) << "_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
+
+				ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
+				for (auto & f : fields)
+					ctx->writeTabs(code_deepness) << "_p->_addValue(_doc, _v, \"" << f.first << "\", " << f.second << ");" << std::endl;
+				ctx->writeTabs(code_deepness) << "rapidjson::Value _aa(rapidjson::kObjectType);" << std::endl;
+				ctx->writeTabs(code_deepness) << "_p->_addValue(_doc, _aa, \"object_data\", object_data);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _v, \"arguments\", _aa);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"function\", _v);" << std::endl;
+			}
+			writeDocument(code_deepness, ctx, "_ret");
+			ctx->writeTabs(code_deepness) << "if (!_p->_invokeCall(" << requestName() << ", _ret, _ec)) _ec.throwException();" << std::endl;
+		}
+
+		//client side: '_dispose_object' queues the object data, '_dispose_objects' sends the queue in one request. The queue is
+		//sent when it reaches the count or its first entry the age set by '_set_dispose_thresholds'; the age is checked only
+		//when an object is queued, there is no timer. The queue of a failed request is restored. The destructor of the interface
+		//cannot send the queue (the transport '_invoke' is gone by then), the implementation has to call '_dispose_objects'.
+		void writeDeferredDisposal(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf)
+		{
+			std::string scope = ctx->mode() == Mode::Implementatinon ? getScope(intf) + intf->name() + "::" : std::string();
+			auto write_head = [&](const std::string & head) -> bool {
+				if (ctx->mode() == Mode::Declaration)
+				{
+					ctx->writeTabs(code_deepness) << head << ";" << std::endl;
+					return false;
+				}
+				ctx->writeTabs(code_deepness) << head << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << (ctx->mode() == Mode::Implementatinon ? "auto _p = _priv;" : "auto _p = this;") << std::endl;
+				return true;
+			};
+			auto write_tail = [&]() {
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+			};
+
+			if (write_head("void " + scope + "_dispose_object(const std::string & object_data)"))
+			{
+				ctx->writeTabs(code_deepness) << "bool flush;" << std::endl;
+				ctx->writeTabs(code_deepness) << "{" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "std::lock_guard<std::mutex> lock(_p->_dispose_mutex);" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "auto now = std::chrono::steady_clock::now();" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "if (_p->_dispose_queue.empty())" << std::endl;
+				ctx->writeTabs(code_deepness + 2) << "_p->_dispose_since = now;" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_p->_dispose_queue.insert(object_data);" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "flush = _p->_dispose_queue.size() >= _p->_dispose_max_count || now - _p->_dispose_since >= _p->_dispose_max_delay;" << std::endl;
+				ctx->writeTabs(code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (flush)" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_dispose_objects();" << std::endl;
+				write_tail();
+			}
+
+			if (ctx->mode() != Mode::Implementatinon)
+				ctx->writeTabs(code_deepness) << "//sends the queued disposals; to be called before the interface is destroyed, its destructor cannot send them" << std::endl;
+			if (write_head("void " + scope + "_dispose_objects()"))
+			{
+				ctx->writeTabs(code_deepness) << "array<string> object_data;" << std::endl;
+				ctx->writeTabs(code_deepness) << "std::chrono::steady_clock::time_point since;" << std::endl;
+				ctx->writeTabs(code_deepness) << "{" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "std::lock_guard<std::mutex> lock(_p->_dispose_mutex);" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "object_data.assign(_p->_dispose_queue.begin(), _p->_dispose_queue.end());" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_p->_dispose_queue.clear();" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "since = _p->_dispose_since;" << std::endl;
+				ctx->writeTabs(code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (object_data.empty())" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "return;" << std::endl << std::endl;
+				ctx->writeTabs(code_deepness) << "try" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				writeDisposeCall(code_deepness, ctx, "_dispose_objects", disposeObjectsFields());
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (...)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "std::lock_guard<std::mutex> lock(_p->_dispose_mutex);" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (_p->_dispose_queue.empty() || since < _p->_dispose_since)" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_p->_dispose_since = since;" << std::endl;
+				ctx->writeTabs(code_deepness) << "_p->_dispose_queue.insert(object_data.begin(), object_data.end());" << std::endl;
+				ctx->writeTabs(code_deepness) << "throw;" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				write_tail();
+			}
+
+			if (write_head("void " + scope + "_set_dispose_thresholds(size_t max_count, std::chrono::milliseconds max_delay)"))
+			{
+				ctx->writeTabs(code_deepness) << "std::lock_guard<std::mutex> lock(_p->_dispose_mutex);" << std::endl;
+				ctx->writeTabs(code_deepness) << "_p->_dispose_max_count = max_count;" << std::endl;
+				ctx->writeTabs(code_deepness) << "_p->_dispose_max_delay = max_delay;" << std::endl;
+				write_tail();
+			}
+		}
+
+		//client side: the transport of '<function>_async'; the request is valid only during the call, 'done' may be called
+		//later from any thread, and the interface has to outlive every pending future.
+		//By default the call is made synchronously by '_invoke'.
+		void writeInvokeAsync(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf)
+		{
+			const char * request = writerMarshalling() ? "const char * request, size_t length" : "const rapidjson::Value & root";
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "//transport of the '_async' functions, calls '_invoke' by default. When overridden:" << std::endl;
+				ctx->writeTabs(code_deepness) << "// - '" << (writerMarshalling() ? "request" : "root") << "' is valid only during the call, copy it to send it later" << std::endl;
+				ctx->writeTabs(code_deepness) << "// - 'done' may be called from any thread, once" << std::endl;
+				ctx->writeTabs(code_deepness) << "// - 'done' uses this interface, it has to outlive every pending future" << std::endl;
+				ctx->writeTabs(code_deepness) << "typedef std::function<void(_invoke_status status, rapidjson::Document & ret, const std::list<PIDL::Exception::Error> & errors)> _invoke_done;" << std::endl;
+				break;
+			case Mode::Implementatinon:
+				break;
+			}
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "virtual void _invoke_async(" << request << ", const _invoke_done & done);" << std::endl;
+				return;
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "virtual void _invoke_async(" << request << ", const _invoke_done & done)" << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "void " << getScope(intf) << intf->name() << "::_invoke_async(" << request << ", const _invoke_done & done)" << std::endl;
+				break;
+			}
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> ec;" << std::endl;
+			writeDocument(code_deepness, ctx, "ret");
+			ctx->writeTabs(code_deepness) << "auto status = _invoke(" << (writerMarshalling() ? "request, length" : "root") << ", ret, ec);" << std::endl;
+			ctx->writeTabs(code_deepness) << "done(status, ret, ec.errors());" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+		}
+
+		//client side: result of '<function>_async'; the return value, or a tuple of it and the output arguments
+		bool writeAsyncResult(short code_deepness, CPPCodeGenContext * ctx, Language::FunctionVariant * function, ErrorCollector & ec)
+		{
+			const auto & out_args = function->out_arguments();
+			if (!out_args.size())
+				return that->writeType(function->returnType().get(), code_deepness, ctx, ec);
+
+			*ctx << "std::tuple<";
+			bool is_first = true;
+			if (function->returnType()->kind() != Language::Element::Kind::Void)
+			{
+				if (!that->writeType(function->returnType().get(), code_deepness, ctx, ec))
+					return false;
+				is_first = false;
+			}
+			for (auto & a : out_args)
+			{
+				if (!is_first)
+					*ctx << ", ";
+				is_first = false;
+				if (!that->writeType(a->type().get(), code_deepness, ctx, ec))
+					return false;
+			}
+			*ctx << ">";
+			return true;
+		}
+
+		//client side: '<function>_async' of the functions of the interface; the request is sent by '_invoke_async',
+		//the response is read by its callback. The client has to outlive the pending calls.
+		bool writeAsync(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
+		{
+			for (auto & d : intf->definitions())
+			{
+				if (d->kind() != Language::Element::Kind::FunctionVariant)
+					continue;
+				auto function = static_cast<Language::FunctionVariant*>(d.get());
+				const auto & out_args = function->out_arguments();
+				bool has_retval = function->returnType()->kind() != Language::Element::Kind::Void;
+
+				ctx->writeTabs(code_deepness) << "std::future<";
+				if (!writeAsyncResult(code_deepness, ctx, function, ec))
+					return false;
+				*ctx << "> " << (ctx->mode() == Mode::Implementatinon ? getScope(intf) + intf->name() + "::" : std::string()) << function->name() << "_async(";
+				bool is_first = true;
+				for (auto & arg : function->arguments())
+				{
+					if (arg->direction() == Language::FunctionVariant::Argument::Direction::Out)
+						continue;
+					if (!is_first)
+						*ctx << ", ";
+					is_first = false;
+					*ctx << "const ";
+					if (!that->writeType(arg->type().get(), code_deepness, ctx, ec))
+						return false;
+					*ctx << " & " << arg->name();
+				}
+				*ctx << ")";
+				if (ctx->mode() == Mode::Declaration)
+				{
+					*ctx << ";" << std::endl;
+					continue;
+				}
+				ctx->stream() << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				switch (ctx->mode())
+				{
+				case Mode::AllInOne:
+					ctx->writeTabs(code_deepness) << "auto _p = this;" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto _intf_p = this;" << std::endl << std::endl;
+					break;
+				case Mode::Implementatinon:
+					ctx->writeTabs(code_deepness) << "auto _p = _priv;" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto _intf_p = _p;" << std::endl << std::endl;
+					break;
+				case Mode::Declaration:
+					break;
+				}
+
+				if (helper->logging())
+					helper->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_p->_logger", "\"async function: '" + std::string(function->name()) + "' variant: '" + function->variantId() + "'\"");
+
+				if (writerMarshalling())
+				{
+					auto args = argumentNames(function);
+					writeRequest(code_deepness, ctx, "_intf_p", nullptr, "function", callFields(intf, function), &args);
+				}
+				else
+				{
+					writeDocument(code_deepness, ctx, "_doc");
+					ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
+					writeFunctionDocument(code_deepness, ctx, intf, function, "_doc");
+				}
+
+				ctx->writeTabs(code_deepness) << "auto _promise = std::make_shared<std::promise<";
+				if (!writeAsyncResult(code_deepness, ctx, function, ec))
+					return false;
+				*ctx << ">>();" << std::endl;
+				ctx->writeTabs(code_deepness) << "_invoke_async(" << (writerMarshalling() ? "_buffer.data(), _buffer.size()" : "_doc")
+					<< ", [_intf_p, _promise](_invoke_status _status, rapidjson::Document & " << (has_retval || out_args.size() ? "_ret" : "/*_ret*/")
+					<< ", const std::list<PIDL::Exception::Error> & _errors)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "try" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!_intf_p->_invokeDone(_status, _errors, _ec))" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
+				for (auto & a : out_args)
+				{
+					ctx->writeTabs(code_deepness);
+					if (!that->writeType(a->type().get(), code_deepness, ctx, ec))
+						return false;
+					*ctx << " " << a->name() << ";" << std::endl;
+				}
+				if (!writeResponse(code_deepness, ctx, function, ec))
+					return false;
+				if (out_args.size())
+				{
+					ctx->writeTabs(code_deepness) << "_promise->set_value(std::make_tuple(";
+					is_first = true;
+					if (has_retval)
+					{
+						*ctx << "std::move(_retval)";
+						is_first = false;
+					}
+					for (auto & a : out_args)
+					{
+						if (!is_first)
+							*ctx << ", ";
+						is_first = false;
+						*ctx << "std::move(" << a->name() << ")";
+					}
+					*ctx << "));" << std::endl;
+				}
+				else if (has_retval)
+					ctx->writeTabs(code_deepness) << "_promise->set_value(std::move(_retval));" << std::endl;
+				else
+					ctx->writeTabs(code_deepness) << "_promise->set_value();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (...)" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ _promise->set_exception(std::current_exception()); }" << std::endl;
+				ctx->writeTabs(--code_deepness) << "});" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _promise->get_future();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+			}
+			return true;
+		}
+
+		//client side: '_Batch' of the interface; its functions queue the calls and return futures, '_flush' sends them in one
+		//request. The output arguments are set by '_flush', so they have to outlive it.
+		bool writeBatch(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
+		{
+			std::vector<Language::FunctionVariant*> functions;
+			for (auto & d : intf->definitions())
+				if (d->kind() == Language::Element::Kind::FunctionVariant)
+					functions.push_back(static_cast<Language::FunctionVariant*>(d.get()));
+
+			auto write_state = [&](short code_deepness) {
+				ctx->writeTabs(code_deepness) << intf->name() << " * _intf;" << std::endl;
+				if (writerMarshalling())
+				{
+					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::OutputBuffer _buffer;" << std::endl;
+					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::Writer _w;" << std::endl;
+				}
+				else
+				{
+					ctx->writeTabs(code_deepness) << "rapidjson::Document _doc;" << std::endl;
+					ctx->writeTabs(code_deepness) << "rapidjson::Value _calls;" << std::endl;
+				}
+				ctx->writeTabs(code_deepness) << "std::vector<std::function<void(const rapidjson::Value * _ret, PIDL::ExceptionErrorCollector<_error_collector> & _ec)>> _results;" << std::endl << std::endl;
+
+				//the envelope of the next calls
+				ctx->writeTabs(code_deepness) << "void _start()" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				if (writerMarshalling())
+				{
+					ctx->writeTabs(code_deepness) << "_buffer.buffer().Clear();" << std::endl;
+					ctx->writeTabs(code_deepness) << "_w.Reset(_buffer.buffer());" << std::endl;
+					ctx->writeTabs(code_deepness) << "_w.StartObject();" << std::endl;
+					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::writeValue(_w, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
+					ctx->writeTabs(code_deepness) << "_w.Key(\"batch\");" << std::endl;
+					ctx->writeTabs(code_deepness) << "_w.StartArray();" << std::endl;
+				}
+				else
+				{
+					ctx->writeTabs(code_deepness) << "_doc.SetNull();" << std::endl;
+					ctx->writeTabs(code_deepness) << "_doc.GetAllocator().Clear();" << std::endl;
+					ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
+					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
+					ctx->writeTabs(code_deepness) << "_calls.SetArray();" << std::endl;
+				}
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+			};
+
+			std::string scope = getScope(intf) + intf->name() + "::_Batch::";
+			const char * ctor_init = writerMarshalling() ? " : _intf(intf), _w(_buffer.buffer())" : " : _intf(intf)";
+
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "class _Batch" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "struct _Priv;" << std::endl;
+				ctx->writeTabs(code_deepness) << "_Priv * _priv;" << std::endl;
+				ctx->writeTabs(code_deepness - 1) << "public:" << std::endl;
+				ctx->writeTabs(code_deepness) << "_Batch(" << intf->name() << " * intf);" << std::endl;
+				ctx->writeTabs(code_deepness) << "~_Batch();" << std::endl;
+				break;
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "class _Batch" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				write_state(code_deepness);
+				ctx->writeTabs(code_deepness - 1) << "public:" << std::endl;
+				ctx->writeTabs(code_deepness) << "_Batch(" << intf->name() << " * intf)" << ctor_init << std::endl;
+				ctx->writeTabs(code_deepness) << "{ _start(); }" << std::endl << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "struct " << scope << "_Priv" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "_Priv(" << intf->name() << " * intf)" << ctor_init << std::endl;
+				ctx->writeTabs(code_deepness) << "{ _start(); }" << std::endl << std::endl;
+				write_state(code_deepness);
+				ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
+
+				ctx->writeTabs(code_deepness) << scope << "_Batch(" << intf->name() << " * intf) : _priv(new _Priv(intf))" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ }" << std::endl << std::endl;
+				ctx->writeTabs(code_deepness) << scope << "~_Batch()" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ delete _priv; }" << std::endl << std::endl;
+				break;
+			}
+
+			auto write_p = [&](short code_deepness) {
+				switch (ctx->mode())
+				{
+				case Mode::AllInOne:
+					ctx->writeTabs(code_deepness) << "auto _p = this;" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto _intf_p = _p->_intf;" << std::endl << std::endl;
+					break;
+				case Mode::Implementatinon:
+					ctx->writeTabs(code_deepness) << "auto _p = _priv;" << std::endl;
+					ctx->writeTabs(code_deepness) << "auto _intf_p = _p->_intf->_priv;" << std::endl << std::endl;
+					break;
+				case Mode::Declaration:
+					break;
+				}
+			};
+
+			for (auto function : functions)
+			{
+				ctx->writeTabs(code_deepness);
+				if (!writeFuture(code_deepness, ctx, function, ec))
+					return false;
+				*ctx << " " << (ctx->mode() == Mode::Implementatinon ? scope : std::string()) << function->name() << "(";
+				size_t args_i = 0;
+				for (auto & arg : function->arguments())
+				{
+					switch (arg->direction())
+					{
+					case Language::FunctionVariant::Argument::Direction::In:
+						*ctx << "const ";
+						break;
+					case Language::FunctionVariant::Argument::Direction::InOut:
+						*ctx << "/*in-out*/ ";
+						break;
+					case Language::FunctionVariant::Argument::Direction::Out:
+						*ctx << "/*out*/ ";
+						break;
+					}
+					if (!that->writeType(arg->type().get(), code_deepness, ctx, ec))
+						return false;
+					*ctx << " & " << arg->name();
+					if (++args_i != function->arguments().size())
+						*ctx << ", ";
+				}
+				*ctx << ")";
+				if (ctx->mode() == Mode::Declaration)
+				{
+					*ctx << ";" << std::endl;
+					continue;
+				}
+				ctx->stream() << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				write_p(code_deepness);
+
+				if (writerMarshalling())
+				{
+					ctx->writeTabs(code_deepness) << "auto & _w = _p->_w;" << std::endl;
+					auto args = argumentNames(function);
+					writeRequestObject(code_deepness, ctx, "_intf_p", nullptr, "function", callFields(intf, function), &args);
+				}
+				else
+				{
+					ctx->writeTabs(code_deepness) << "auto & _doc = _p->_doc;" << std::endl;
+					ctx->writeTabs(code_deepness) << "rapidjson::Value _rq(rapidjson::kObjectType);" << std::endl;
+					writeFunctionDocument(code_deepness, ctx, intf, function, "_rq");
+					ctx->writeTabs(code_deepness) << "_p->_calls.PushBack(_rq, _doc.GetAllocator());" << std::endl;
+				}
+
+				ctx->writeTabs(code_deepness) << "auto _promise = std::make_shared<std::promise<";
+				if (!that->writeType(function->returnType().get(), code_deepness, ctx, ec))
+					return false;
+				*ctx << ">>();" << std::endl;
+				bool has_response = function->returnType()->kind() != Language::Element::Kind::Void || function->out_arguments().size();
+				ctx->writeTabs(code_deepness) << "_p->_results.push_back([" << (has_response ? "_intf_p, " : "") << "_promise";
+				for (auto & a : function->out_arguments())
+					*ctx << ", &" << a->name();
+				*ctx << "](const rapidjson::Value * _ret_v, PIDL::ExceptionErrorCollector<_error_collector> & _ec)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "try" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!_ret_v)" << std::endl;
+				ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
+				if (has_response)
+					ctx->writeTabs(code_deepness) << "auto & _ret = *_ret_v;" << std::endl;
+				if (!writeResponse(code_deepness, ctx, function, ec))
+					return false;
+				if (function->returnType()->kind() != Language::Element::Kind::Void)
+					ctx->writeTabs(code_deepness) << "_promise->set_value(_retval);" << std::endl;
+				else
+					ctx->writeTabs(code_deepness) << "_promise->set_value();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (...)" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ _promise->set_exception(std::current_exception()); }" << std::endl;
+				ctx->writeTabs(--code_deepness) << "});" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _promise->get_future();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+			}
+
+			//_flush
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "void _flush();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
+				return true;
+			case Mode::AllInOne:
+				ctx->writeTabs(code_deepness) << "void _flush()" << std::endl;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "void " << scope << "_flush()" << std::endl;
+				break;
+			}
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			write_p(code_deepness);
+			ctx->writeTabs(code_deepness) << "if (_p->_results.empty())" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "return;" << std::endl;
+			ctx->writeTabs(code_deepness) << "auto _results = std::move(_p->_results);" << std::endl;
+			ctx->writeTabs(code_deepness) << "_p->_results.clear();" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
+			writeDocument(code_deepness, ctx, "_ret");
+			if (writerMarshalling())
+			{
+				ctx->writeTabs(code_deepness) << "_p->_w.EndArray();" << std::endl;
+				ctx->writeTabs(code_deepness) << "_p->_w.EndObject();" << std::endl;
+				ctx->writeTabs(code_deepness) << "bool _ok = _intf_p->_invokeCall(_p->_buffer, _ret, _ec);" << std::endl;
+			}
+			else
+			{
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_p->_doc, _p->_doc, \"batch\", _p->_calls);" << std::endl;
+				ctx->writeTabs(code_deepness) << "bool _ok = _intf_p->_invokeCall(_p->_doc, _ret, _ec);" << std::endl;
+			}
+			ctx->writeTabs(code_deepness) << "_p->_start();" << std::endl;
+			ctx->writeTabs(code_deepness) << "rapidjson::Value * _batch_v = nullptr;" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (_ok && (!PIDL::JSONTools::getValue(_ret, \"batch\", _batch_v) || !_batch_v->IsArray() || _batch_v->Size() != _results.size()))" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ _ec << \"invalid response of batched calls\"; _ok = false; }" << std::endl;
+			ctx->writeTabs(code_deepness) << "for (rapidjson::SizeType _i = 0; _i < _results.size(); ++_i)" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (!_ok)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ _results[_i](nullptr, _ec); continue; }" << std::endl;
+			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _c_ec;" << std::endl;
+			ctx->writeTabs(code_deepness) << "_results[_i](PIDL::JSONTools::Batch::getResult((*_batch_v)[_i], _c_ec), _c_ec);" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl;
+			ctx->writeTabs(code_deepness) << "if (!_ok)" << std::endl;
+			ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl;
+			if (ctx->mode() == Mode::AllInOne)
+				ctx->writeTabs(--code_deepness) << "};" << std::endl;
+			ctx->stream() << std::endl;
+			return true;
+		}
+
+		//server side: the calls of a batch are invoked one by one, the failed ones do not stop the others
+		void writeBatchInvoke(short code_deepness, CPPCodeGenContext * ctx)
+		{
+			ctx->writeTabs(code_deepness) << "if (PIDL::JSONTools::getValue(root, \"batch\", v) && v->IsArray())" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			if (writerMarshalling())
+			{
+				ctx->writeTabs(code_deepness) << "ret.StartObject();" << std::endl;
+				ctx->writeTabs(code_deepness) << "ret.Key(\"batch\");" << std::endl;
+				ctx->writeTabs(code_deepness) << "ret.StartArray();" << std::endl;
+				ctx->writeTabs(code_deepness) << "for (auto & c : v->GetArray())" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> c_ec;" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::OutputBuffer c_buffer;" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::Writer c_ret(c_buffer.buffer());" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto stat = _invoke(c, c_ret, c_ec);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::Batch::writeResult(ret, stat, c_buffer.data(), c_buffer.size(), c_ec.errors());" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "ret.EndArray();" << std::endl;
+				ctx->writeTabs(code_deepness) << "ret.EndObject();" << std::endl;
+			}
+			else
+			{
+				ctx->writeTabs(code_deepness) << "ret.SetObject();" << std::endl;
+				ctx->writeTabs(code_deepness) << "rapidjson::Value results(rapidjson::kArrayType);" << std::endl;
+				ctx->writeTabs(code_deepness) << "for (auto & c : v->GetArray())" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> c_ec;" << std::endl;
+				//the responses are built by the allocator of 'ret', so they are moved into it without copying
+				ctx->writeTabs(code_deepness) << "rapidjson::Document c_ret(&ret.GetAllocator());" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto stat = _invoke(c, c_ret, c_ec);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::Batch::addResult(ret, results, stat, c_ret, c_ec.errors());" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(ret, ret, \"batch\", results);" << std::endl;
+			}
+			ctx->writeTabs(code_deepness) << "return _invoke_status::Ok;" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl;
+		}
+
+		std::string handlerName(Language::FunctionVariant * function, size_t idx, bool sax)
+		{
+			return std::string(sax ? "_saxFunction_" : "_function_") + function->name() + "_" + std::to_string(idx);
+		}
+
+		template<class Class_T>
+		std::vector<Handler> handlers(Class_T * cl, bool sax)
+		{
+			std::vector<Handler> ret;
+			std::map<std::string, size_t> variant_idx;
+			for (auto & d : cl->definitions())
+			{
+				if (d->kind() == Language::Element::Kind::FunctionVariant || d->kind() == Language::Element::Kind::MethodVariant)
+				{
+					auto function = static_cast<Language::FunctionVariant*>(d.get());
+					auto idx = variant_idx[function->name()]++;
+					if (!sax || function->kind() != Language::Element::Kind::MethodVariant)
+						ret.push_back({ function->name(), function->variantId(), handlerName(function, idx, sax) });
+				}
+				else if (d->kind() == Language::Element::Kind::Property)
+				{
+					auto property = static_cast<Language::Property*>(d.get());
+					if (sax)
+						continue;
+					ret.push_back({ property->name(), "get", std::string("_property_get_") + property->name() });
+					if (!property->readOnly())
+						ret.push_back({ property->name(), "set", std::string("_property_set_") + property->name() });
+				}
+			}
+			auto intf = asInterface(cl);
+			if (!sax && intf && hasObjects(intf))
+				ret.push_back({ "_dispose_object", std::string(), "_function__dispose_object" });
+			if (!sax && intf && hasObjects(intf) && deferredDisposal())
+				ret.push_back({ "_dispose_objects", std::string(), "_function__dispose_objects" });
+			return ret;
+		}
+
+		//streaming unmarshalling of function calls (see pidlCore/jsonsax.h)
+		void writeSAXMembers(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf)
+		{
+			ctx->writeTabs(code_deepness) << "//SAX unmarshalers" << std::endl;
+			//false: the function is not known, the request has to be handled by the DOM based '_invoke'
+			ctx->writeTabs(code_deepness) << "bool _callSAXFunction(PIDL::JSONTools::SAX::Request & rq, " << retType() << " & ret, _invoke_status & stat, _error_collector & ec)" << std::endl;
+			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			auto sax_handlers = handlers(intf, true);
+			if (sax_handlers.size())
+			{
+				if (functionIds())
+				{
+					ctx->writeTabs(code_deepness) << "if (rq.hasId())" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					ctx->writeTabs(code_deepness) << "switch (rq.id())" << std::endl;
+					ctx->writeTabs(code_deepness) << "{" << std::endl;
+					for (auto & h : sax_handlers)
+						ctx->writeTabs(code_deepness) << "case " << callId(h) << ": { ec.clear(); stat = " << h.member << "(rq, ret, ec); return true; }" << std::endl;
+					ctx->writeTabs(code_deepness) << "}" << std::endl;
+					ctx->writeTabs(code_deepness) << "return false;" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				}
+				ctx->writeTabs(code_deepness) << "auto & name = rq.name();" << std::endl;
+				ctx->writeTabs(code_deepness) << "auto & variant = rq.variant();" << std::endl;
+				that->writeLookup(code_deepness, ctx, sax_handlers,
+					[&](short d, const Handler & h) { ctx->writeTabs(d) << "{ ec.clear(); stat = " << h.member << "(rq, ret, ec); return true; }" << std::endl; },
+					[&](short d) { ctx->writeTabs(d) << "return false;" << std::endl; });
+			}
+			else
+				ctx->writeTabs(code_deepness) << "(void)rq; (void)ret; (void)stat; (void)ec;" << std::endl;
+			ctx->writeTabs(code_deepness) << "return false;" << std::endl;
+			ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+			ctx->writeTabs(code_deepness) << "template<typename T> PIDL::JSONTools::SAX::Slot _slot(T & ret)" << std::endl;
+			ctx->writeTabs(code_deepness) << "{ return PIDL::JSONTools::SAX::slot(ret, this); }" << std::endl << std::endl;
+
+			if (hasObjects(intf))
+			{
+				ctx->writeTabs(code_deepness) << "template<typename T> bool _getObject(ptr<T> & ret, const std::string & object_data, _error_collector & ec)" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ return (bool)(ret = _intf->_get_object<T>(object_data, ec)); }" << std::endl << std::endl;
+			}
+
+			std::function<void(Language::DefinitionProvider * cl)> add_slot = [&](Language::DefinitionProvider * cl) {
+				for (auto & d : cl->definitions())
+				{
+					if (d->kind() == Language::Element::Kind::TypeDefinition)
+					{
+						auto td = static_cast<Language::TypeDefinition*>(d.get());
+						if (td->type()->kind() == Language::Element::Kind::Structure)
+						{
+							auto s = static_cast<Language::Structure*>(td->type().get());
+							auto & members = s->members();
+							ctx->writeTabs(code_deepness) << "PIDL::JSONTools::SAX::Slot _slot(" << getScope(td) << td->name() << " & ret)" << std::endl;
+							ctx->writeTabs(code_deepness++) << "{" << std::endl;
+							ctx->writeTabs(code_deepness) << "static const PIDL::JSONTools::SAX::StructureBinder<" << getScope(td) << td->name() << ", _Priv> binder(\"" << td->name() << "\", " << members.size() << ", &_Priv::_member);" << std::endl;
+							ctx->writeTabs(code_deepness) << "return binder.slot(ret, this);" << std::endl;
+							ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+							ctx->writeTabs(code_deepness) << "PIDL::JSONTools::SAX::Slot _member(" << getScope(td) << td->name() << " & ret, const char * key, rapidjson::SizeType length, size_t & index)" << std::endl;
+							ctx->writeTabs(code_deepness++) << "{" << std::endl;
+							if (!members.size())
+								ctx->writeTabs(code_deepness) << "(void)ret; (void)key; (void)length; (void)index;" << std::endl;
+							size_t idx = 0;
+							for (auto & m : members)
+							{
+								ctx->writeTabs(code_deepness) << "if (PIDL::JSONTools::SAX::isKey(key, length, \"" << m->name() << "\", " << strlen(m->name()) << "))" << std::endl;
+								ctx->writeTabs(code_deepness) << "{ index = " << idx++ << "; return _slot(ret." << m->name() << "); }" << std::endl;
+							}
+							ctx->writeTabs(code_deepness) << "return PIDL::JSONTools::SAX::Slot::skip();" << std::endl;
+							ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+						}
+					}
+					else if (d->kind() == Language::Element::Kind::Object)
+						add_slot(static_cast<Language::Object*>(d.get()));
+				}
+			};
+
+			add_slot(intf);
+		}
+
+		//server side: '_invoke' run by a worker of 'pool'; the response is serialized and handed over to 'done' on the worker thread
+		void writePoolInvoke(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf)
+		{
+			const char * args = "(PIDL::WorkerPool & pool, const std::string & request, const std::function<void(_invoke_status status, const std::string & response, const std::list<PIDL::Exception::Error> & errors)> & done)";
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "void _invoke" << args;
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "void " << intf->name() << "::_invoke" << args;
+				break;
+			}
+
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+				*ctx << ";" << std::endl;
+				break;
+			case Mode::AllInOne:
+			case Mode::Implementatinon:
+				ctx->stream() << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness++) << "pool.post([this, request, done]() {" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> ec;" << std::endl;
+				ctx->writeTabs(code_deepness) << "_invoke_status status;" << std::endl;
+				ctx->writeTabs(code_deepness) << "std::string response;" << std::endl;
+				//nothing escapes to the worker, 'done' is called once on every path
+				ctx->writeTabs(code_deepness) << "try" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				if (instrumentation())
+					ctx->writeTabs(code_deepness) << "PIDL::Instrumentation::Payload _payload(request.length());" << std::endl;
+				if (!saxUnmarshalling())
+				{
+					writeDocument(code_deepness, ctx, "root");
+					ctx->writeTabs(code_deepness) << "root.Parse(request.data(), request.length());" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (root.HasParseError())" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					ctx->writeTabs(code_deepness) << "ec << std::string() + \"could not parse request: \" + PIDL::JSONTools::getErrorText(root.GetParseError());" << std::endl;
+					ctx->writeTabs(code_deepness) << "status = _invoke_status::MarshallingError;" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl;
+					ctx->writeTabs(code_deepness) << "else" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				}
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::OutputBuffer buffer;" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::Writer w(buffer.buffer());" << std::endl;
+				const char * in = saxUnmarshalling() ? "request.data(), request.length()" : "root";
+				if (writerMarshalling())
+					ctx->writeTabs(code_deepness) << "status = _invoke(" << in << ", w, ec);" << std::endl;
+				else
+				{
+					writeDocument(code_deepness, ctx, "ret");
+					ctx->writeTabs(code_deepness) << "status = _invoke(" << in << ", ret, ec);" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!ret.IsNull())" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "ret.Accept(w);" << std::endl;
+				}
+				if (instrumentation())
+					ctx->writeTabs(code_deepness) << "_payload.response(buffer.size());" << std::endl;
+				ctx->writeTabs(code_deepness) << "response.assign(buffer.data(), buffer.size());" << std::endl;
+				if (!saxUnmarshalling())
+					ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (exception & e)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "e.get(ec);" << std::endl;
+				ctx->writeTabs(code_deepness) << "status = _invoke_status::FatalError;" << std::endl;
+				ctx->writeTabs(code_deepness) << "response.clear();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (std::exception & e)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "ec.add((long)_invoke_status::FatalError, std::string() + \"unhandled exception: '\" + e.what() + \"'\");" << std::endl;
+				ctx->writeTabs(code_deepness) << "status = _invoke_status::FatalError;" << std::endl;
+				ctx->writeTabs(code_deepness) << "response.clear();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "catch (...)" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "ec.add((long)_invoke_status::FatalError, \"unknown unhandled exception\");" << std::endl;
+				ctx->writeTabs(code_deepness) << "status = _invoke_status::FatalError;" << std::endl;
+				ctx->writeTabs(code_deepness) << "response.clear();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(code_deepness) << "done(status, response, ec.errors());" << std::endl;
+				ctx->writeTabs(--code_deepness) << "});" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				break;
+			}
+		}
+
+		//raw entry point: canonical function calls are unmarshalled by SAX, anything else goes through the DOM based '_invoke'
+		void writeSAXInvoke(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf)
+		{
+			switch (ctx->mode())
+			{
+			case Mode::AllInOne:
+			case Mode::Declaration:
+				ctx->writeTabs(code_deepness) << "_invoke_status _invoke(const char * json, size_t length, " << retType() << " & ret, _error_collector & ec)";
+				break;
+			case Mode::Implementatinon:
+				ctx->writeTabs(code_deepness) << "_invoke_status " << intf->name() << "::_invoke(const char * json, size_t length, " << retType() << " & ret, _error_collector & ec)";
+				break;
+			}
+
+			switch (ctx->mode())
+			{
+			case Mode::Declaration:
+				*ctx << ";" << std::endl;
+				break;
+			case Mode::AllInOne:
+			case Mode::Implementatinon:
+				ctx->stream() << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				switch (ctx->mode())
+				{
+				case Mode::Declaration:
+					break;
+				case Mode::AllInOne:
+					ctx->writeTabs(code_deepness) << "auto * _p = this;" << std::endl << std::endl;
+					break;
+				case Mode::Implementatinon:
+					ctx->writeTabs(code_deepness) << "auto * _p = _priv;" << std::endl << std::endl;
+					break;
+				}
+
+				if (instrumentation())
+					ctx->writeTabs(code_deepness) << "PIDL::Instrumentation::Payload _payload(length);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::SAX::Request rq(json, length);" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (rq.isFunctionCall())" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (rq.version() != " << PIDL_JSON_MARSHALLING_VERSION << ")" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ ec << \"unsupported mashalling version detected\"; return _invoke_status::NotSupportedMarshallingVersion; }" << std::endl;
+				ctx->writeTabs(code_deepness) << "_invoke_status stat;" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (_p->_callSAXFunction(rq, ret, stat, ec))" << std::endl;
+				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!rq.isFallback())" << std::endl;
+				if (writerMarshalling())
+				{
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (stat == _invoke_status::Ok)" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "ret.EndObject();" << std::endl;
+					ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				}
+				else
+					ctx->writeTabs(code_deepness + 1) << "return stat;" << std::endl;
+				ctx->writeTabs(code_deepness) << "ec.clear();" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+				writeDocument(code_deepness, ctx, "root");
+				ctx->writeTabs(code_deepness) << "root.Parse(json, length);" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (root.HasParseError())" << std::endl;
+				ctx->writeTabs(code_deepness) << "{ ec << std::string() + \"could not parse request: \" + PIDL::JSONTools::getErrorText(root.GetParseError()); return _invoke_status::MarshallingError; }" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _invoke(root, ret, ec);" << std::endl;
+				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				break;
+			}
 		}
 
 		template<class Class_T>
 		bool writePrivateMembers(short code_deepness, CPPCodeGenContext * ctx, Class_T * cl, ErrorCollector & ec)
 		{
-            (void)ec;
+			if (functionIds() && !checkCallIds(cl, ec))
+				return false;
+
             ctx->writeTabs(code_deepness) << "//private members" << std::endl << std::endl;
 
 			switch (ctx->role())
 			{
 			case Role::Server:
                 //ctx->writeTabs(code_deepness) << "std::map<std::string, ptr<_Object> _objects;" << std::endl;
-				ctx->writeTabs(code_deepness) << "typedef std::function<_invoke_status(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)> _Function;" << std::endl;
-				ctx->writeTabs(code_deepness) << "struct _Variants { std::map<std::string, _Function> data; };" << std::endl;
-				ctx->writeTabs(code_deepness) << "std::map<std::string, _Variants> _functions;" << std::endl;
-				ctx->writeTabs(code_deepness) << "_invoke_status _callFunction(const std::string & name, const std::string & variant, const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)" << std::endl;
+				ctx->writeTabs(code_deepness) << "_invoke_status _callFunction(const std::string & name, const std::string & variant, const rapidjson::Value & root, " << retType() << " & ret, _error_collector & ec)" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
-				ctx->writeTabs(code_deepness) << "if (!_functions.count(name))" << std::endl;
-				ctx->writeTabs(code_deepness) << "{ ec << \"function '\" + name + \"'is not found\"; return _invoke_status::NotImplemented; }" << std::endl;
-				ctx->writeTabs(code_deepness) << "auto & vars = _functions[name].data;" << std::endl;
-				ctx->writeTabs(code_deepness) << "if (!variant.length() && vars.size() == 1)" << std::endl;
-				ctx->writeTabs(code_deepness + 1) << "return vars.begin()->second(root, ret, ec);" << std::endl;
-				ctx->writeTabs(code_deepness) << "if (!vars.count(variant))" << std::endl;
-				ctx->writeTabs(code_deepness) << "{ ec << \"variant '\" + variant + \"' of function '\" + name + \"'is not found\"; return _invoke_status::NotImplemented; }" << std::endl;
-				ctx->writeTabs(code_deepness) << "return vars[variant](root, ret, ec);" << std::endl;
+				{
+					auto dom_handlers = handlers(cl, false);
+					if (dom_handlers.size())
+						that->writeLookup(code_deepness, ctx, dom_handlers,
+							[&](short d, const Handler & h) { ctx->writeTabs(d) << "return " << h.member << "(root, ret, ec);" << std::endl; },
+							[&](short d) {
+								ctx->writeTabs(d) << "ec << \"variant '\" + variant + \"' of function '\" + name + \"'is not found\";" << std::endl;
+								ctx->writeTabs(d) << "return _invoke_status::NotImplemented;" << std::endl;
+							});
+					else
+						ctx->writeTabs(code_deepness) << "(void)variant; (void)root; (void)ret;" << std::endl;
+				}
+				ctx->writeTabs(code_deepness) << "ec << \"function '\" + name + \"'is not found\";" << std::endl;
+				ctx->writeTabs(code_deepness) << "return _invoke_status::NotImplemented;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 
-				ctx->writeTabs(code_deepness) << "_invoke_status _callFunction(std::function<void(void)> func, _error_collector & ec)" << std::endl;
+				if (functionIds())
+				{
+					ctx->writeTabs(code_deepness) << "_invoke_status _callFunction(int id, const rapidjson::Value & root, " << retType() << " & ret, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					auto dom_handlers = handlers(cl, false);
+					if (dom_handlers.size())
+					{
+						ctx->writeTabs(code_deepness) << "switch (id)" << std::endl;
+						ctx->writeTabs(code_deepness) << "{" << std::endl;
+						for (auto & h : dom_handlers)
+							ctx->writeTabs(code_deepness) << "case " << callId(h) << ": return " << h.member << "(root, ret, ec);" << std::endl;
+						ctx->writeTabs(code_deepness) << "}" << std::endl;
+					}
+					else
+						ctx->writeTabs(code_deepness) << "(void)root; (void)ret;" << std::endl;
+					ctx->writeTabs(code_deepness) << "ec << \"function #\" + std::to_string(id) + \" is not found\";" << std::endl;
+					ctx->writeTabs(code_deepness) << "return _invoke_status::NotImplemented;" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				}
+
+				ctx->writeTabs(code_deepness) << "template<class F> _invoke_status _callFunction(F && func, _error_collector & ec)" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
 				ctx->writeTabs(code_deepness) << "try" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
@@ -114,35 +1497,68 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "return _invoke_status::Ok;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 
+				if (!writeHandlers(cl, code_deepness, ctx, ec))
+					return false;
+
 				break;
 			case Role::Client:
-				ctx->writeTabs(code_deepness) << "bool _invokeCall(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)" << std::endl;
-				ctx->writeTabs(code_deepness++) << "{" << std::endl;
-				if (dynamic_cast<Language::Object*>(cl))
-					ctx->writeTabs(code_deepness) << "auto status = _intf->_invoke(root, ret, ec);" << std::endl;
+				if (writerMarshalling())
+				{
+					ctx->writeTabs(code_deepness) << "bool _invokeCall(const PIDL::JSONTools::OutputBuffer & request, rapidjson::Document & ret, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					if (cl->kind() == Language::Element::Kind::Object)
+						ctx->writeTabs(code_deepness) << "auto status = _intf->_invoke(request.data(), request.size(), ret, ec);" << std::endl;
+					else
+						ctx->writeTabs(code_deepness) << "auto status = _that->_invoke(request.data(), request.size(), ret, ec);" << std::endl;
+				}
 				else
-					ctx->writeTabs(code_deepness) << "auto status = _that->_invoke(root, ret, ec);" << std::endl;
-				ctx->writeTabs(code_deepness) << "switch(status)" << std::endl;
-				ctx->writeTabs(code_deepness) << "{" << std::endl;
-				ctx->writeTabs(code_deepness) << "case _invoke_status::Ok: break;" << std::endl;
-				ctx->writeTabs(code_deepness) << "case _invoke_status::NotImplemented:" << std::endl;
-				ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"function is not implemented\"); return false;" << std::endl;
-				ctx->writeTabs(code_deepness) << "case _invoke_status::Error:" << std::endl;
-				ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"error while executing server function\"); return false;" << std::endl;
-				ctx->writeTabs(code_deepness) << "case _invoke_status::FatalError:" << std::endl;
-				ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"fatal error while executing server function\"); return false;" << std::endl;
-				ctx->writeTabs(code_deepness) << "case _invoke_status::MarshallingError:" << std::endl;
-                ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"error while marshalling of function call\"); return false;" << std::endl;
-                ctx->writeTabs(code_deepness) << "case _invoke_status::NotSupportedMarshallingVersion:" << std::endl;
-                ctx->writeTabs(code_deepness + 1) << "ec.add((long)status, \"not supported marshalling version\"); return false;" << std::endl;
-				ctx->writeTabs(code_deepness) << "}" << std::endl << std::endl;
-				ctx->writeTabs(code_deepness) << "return true;" << std::endl;
+				{
+					ctx->writeTabs(code_deepness) << "bool _invokeCall(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					if (cl->kind() == Language::Element::Kind::Object)
+						ctx->writeTabs(code_deepness) << "auto status = _intf->_invoke(root, ret, ec);" << std::endl;
+					else
+						ctx->writeTabs(code_deepness) << "auto status = _that->_invoke(root, ret, ec);" << std::endl;
+				}
+				writeStatusCheck(code_deepness, ctx);
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+
+				if (asyncCalls() && cl->kind() == Language::Element::Kind::Interface)
+				{
+					//the response of '_invoke_async'
+					ctx->writeTabs(code_deepness) << "bool _invokeDone(_invoke_status status, const std::list<PIDL::Exception::Error> & errors, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					ctx->writeTabs(code_deepness) << "for (auto & e : errors)" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "ec.add(e.first, e.second);" << std::endl;
+					writeStatusCheck(code_deepness, ctx);
+					ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				}
 				break;
 			}
 
-            if(auto intf = dynamic_cast<Language::Interface*>(cl))
+            if(auto intf = asInterface(cl))
             {
+                if (objectTable() && ctx->role() == Role::Server && hasObjects(intf))
+                    ctx->writeTabs(code_deepness) << "PIDL::ObjectTable _objects;" << std::endl << std::endl;
+
+                if (deferredDisposal() && ctx->role() == Role::Client && hasObjects(intf))
+                {
+                    ctx->writeTabs(code_deepness) << "std::mutex _dispose_mutex;" << std::endl;
+                    ctx->writeTabs(code_deepness) << "std::unordered_multiset<std::string> _dispose_queue;" << std::endl;
+                    ctx->writeTabs(code_deepness) << "std::chrono::steady_clock::time_point _dispose_since;" << std::endl;
+                    ctx->writeTabs(code_deepness) << "size_t _dispose_max_count = 256;" << std::endl;
+                    ctx->writeTabs(code_deepness) << "std::chrono::steady_clock::duration _dispose_max_delay = std::chrono::seconds(1);" << std::endl << std::endl;
+
+                    //an object sent again by the server is not disposed
+                    ctx->writeTabs(code_deepness) << "void _undispose(const std::string & object_data)" << std::endl;
+                    ctx->writeTabs(code_deepness++) << "{" << std::endl;
+                    ctx->writeTabs(code_deepness) << "std::lock_guard<std::mutex> lock(_dispose_mutex);" << std::endl;
+                    ctx->writeTabs(code_deepness) << "auto it = _dispose_queue.find(object_data);" << std::endl;
+                    ctx->writeTabs(code_deepness) << "if (it != _dispose_queue.end())" << std::endl;
+                    ctx->writeTabs(code_deepness + 1) << "_dispose_queue.erase(it);" << std::endl;
+                    ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+                }
+
                 //_getValue
                 ctx->writeTabs(code_deepness) << "//marshalers" << std::endl;
                 ctx->writeTabs(code_deepness) << "bool _getValue(const rapidjson::Value & v, const char * name, rapidjson::Type type, rapidjson::Value *& ret, _error_collector & ec)" << std::endl;
@@ -265,10 +1681,12 @@ namespace PIDL
 
                     for (auto & d : cl->definitions())
                     {
-                        if (auto td = dynamic_cast<Language::TypeDefinition*>(d.get()))
+                        if (d->kind() == Language::Element::Kind::TypeDefinition)
                         {
-                            if (auto s = dynamic_cast<Language::Structure*>(td->type().get()))
+                            auto td = static_cast<Language::TypeDefinition*>(d.get());
+                            if (td->type()->kind() == Language::Element::Kind::Structure)
                             {
+                                auto s = static_cast<Language::Structure*>(td->type().get());
                                 ctx->writeTabs(code_deepness) << "bool _getValue(const rapidjson::Value & v, " << getScope(td) << td->name() << " & ret, _error_collector & ec)" << std::endl;
                                 ctx->writeTabs(code_deepness++) << "{" << std::endl;
                                 ctx->writeTabs(code_deepness) << "if (!v.IsObject())" << std::endl;
@@ -297,8 +1715,9 @@ namespace PIDL
                                 ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
                             }
                         }
-                        else if (auto obj = dynamic_cast<Language::Object*>(d.get()))
+                        else if (d->kind() == Language::Element::Kind::Object)
                         {
+                            auto obj = static_cast<Language::Object*>(d.get());
                             switch (ctx->role())
                             {
                             case Role::Client:
@@ -309,6 +1728,8 @@ namespace PIDL
                                 ctx->writeTabs(code_deepness + 1) << "return false;" << std::endl;
                                 ctx->writeTabs(code_deepness) << "if (!object_data)" << std::endl;
                                 ctx->writeTabs(code_deepness) << "{ ret.reset(); return true; }" << std::endl;
+                                if (deferredDisposal())
+                                    ctx->writeTabs(code_deepness) << "_undispose(*object_data);" << std::endl;
                                 ctx->writeTabs(code_deepness) << "ret = std::make_shared<" << getScope(obj) << obj->name() << ">(_that, *object_data);" << std::endl;
                                 ctx->writeTabs(code_deepness) << "return true;" << std::endl;
                                 ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
@@ -346,10 +1767,12 @@ namespace PIDL
                     //_createValue
                     for (auto & d : cl->definitions())
                     {
-                        if (auto td = dynamic_cast<Language::TypeDefinition*>(d.get()))
+                        if (d->kind() == Language::Element::Kind::TypeDefinition)
                         {
-                            if (auto s = dynamic_cast<Language::Structure*>(td->type().get()))
+                            auto td = static_cast<Language::TypeDefinition*>(d.get());
+                            if (td->type()->kind() == Language::Element::Kind::Structure)
                             {
+                                auto s = static_cast<Language::Structure*>(td->type().get());
                                 ctx->writeTabs(code_deepness) << "rapidjson::Value _createValue(rapidjson::Document & doc, const " << getScope(td) << td->name() << " & in)" << std::endl;
                                 ctx->writeTabs(code_deepness++) << "{" << std::endl;
                                 ctx->writeTabs(code_deepness) << "rapidjson::Value v(rapidjson::kObjectType);" << std::endl;
@@ -361,10 +1784,11 @@ namespace PIDL
                                 ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
                             }
                         }
-                        else if (auto obj = dynamic_cast<Language::Object*>(d.get()))
+                        else if (d->kind() == Language::Element::Kind::Object)
                         {
+                            auto obj = static_cast<Language::Object*>(d.get());
                             ctx->writeTabs(code_deepness) << "rapidjson::Value _createValue(rapidjson::Document & doc, const ptr<" << getScope(obj) << obj->name() << "> & in)" << std::endl;
-                            ctx->writeTabs(code_deepness) << "{ return in ? PIDL::JSONTools::createValue(doc, in->_data()) : rapidjson::Value(rapidjson::kNullType); }" << std::endl << std::endl;
+                            ctx->writeTabs(code_deepness) << "{ return in ? PIDL::JSONTools::createValue(doc, " << objectData(ctx, "in") << ") : rapidjson::Value(rapidjson::kNullType); }" << std::endl << std::endl;
 
                             add_createValue(obj);
                         }
@@ -394,6 +1818,12 @@ namespace PIDL
                 ctx->writeTabs(code_deepness) << "rapidjson::Value _createValue(rapidjson::Document & doc, const blob & data)" << std::endl;
                 ctx->writeTabs(code_deepness) << "{ return PIDL::JSONTools::createValue(doc, data); }" << std::endl << std::endl;
 
+                if (compactDateTime())
+                {
+                    ctx->writeTabs(code_deepness) << "rapidjson::Value _createValue(rapidjson::Document & doc, const datetime & t)" << std::endl;
+                    ctx->writeTabs(code_deepness) << "{ return PIDL::JSONTools::createCompactValue(doc, t); }" << std::endl << std::endl;
+                }
+
                 //_addValue
                 ctx->writeTabs(code_deepness) << "template<typename T> void _addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const T & v)" << std::endl;
                 ctx->writeTabs(code_deepness) << "{ auto tmp = _createValue(doc, v); PIDL::JSONTools::addValue(doc, r, name, tmp); }" << std::endl << std::endl;
@@ -436,14 +1866,22 @@ namespace PIDL
 
                 ctx->writeTabs(code_deepness) << "template<typename ...T> void _addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const tuple<T...> & values)" << std::endl;
                 ctx->writeTabs(code_deepness) << "{ auto tmp = _createValue(doc, values); PIDL::JSONTools::addValue(doc, r, name, tmp); }" << std::endl << std::endl;
+
+                if (writerMarshalling())
+                    writeWriterMembers(code_deepness, ctx, intf);
+
+                if (ctx->role() == Role::Server && saxUnmarshalling())
+                    writeSAXMembers(code_deepness, ctx, intf);
             }
 
             return true;
 		}
 
+		//the functions, methods and properties are served by members of '_Priv' (see 'handlers()')
 		template<class Class_T>
-		bool writeConstructorBody(Class_T * cl, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
+		bool writeHandlers(Class_T * cl, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
 		{
+			std::map<std::string, size_t> variant_idx;
 			auto write_privs = [&](bool is_object) {
 				if (is_object)
 					switch (ctx->mode())
@@ -468,126 +1906,169 @@ namespace PIDL
 			case Role::Server:
 				for (auto & d : cl->definitions())
 				{
-					if (dynamic_cast<Language::FunctionVariant*>(d.get()))
+					if (d->kind() == Language::Element::Kind::FunctionVariant || d->kind() == Language::Element::Kind::MethodVariant)
 					{
-						auto function = dynamic_cast<Language::FunctionVariant*>(d.get());
-						ctx->writeTabs(code_deepness++) << "_functions[\"" << function->name() << "\"].data[\"" << function->variantId() << "\"] = [&](const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)->_invoke_status {" << std::endl;
-                        write_privs(dynamic_cast<Language::MethodVariant*>(d.get()) != nullptr);
+						auto function = static_cast<Language::FunctionVariant*>(d.get());
+						bool is_method = d->kind() == Language::Element::Kind::MethodVariant;
+						auto idx = variant_idx[function->name()]++;
+						for (bool sax : { false, true })
+						{
+							if (sax && (is_method || !saxUnmarshalling()))
+								continue;
+							if (sax)
+								ctx->writeTabs(code_deepness) << "_invoke_status " << handlerName(function, idx, true) << "(PIDL::JSONTools::SAX::Request & rq, " << retType() << " & ret, _error_collector & ec)" << std::endl;
+							else
+								ctx->writeTabs(code_deepness) << "_invoke_status " << handlerName(function, idx, false) << "(const rapidjson::Value & r, " << retType() << " & ret, _error_collector & ec)" << std::endl;
+							ctx->writeTabs(code_deepness++) << "{" << std::endl;
+                            write_privs(is_method);
 
 
 
-                        if(helper->logging())
-                        {
-                            auto starter = helper->logging()->loggingStart("_logger");
-                            if(starter.length())
-                                ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                            auto debug = helper->logging()->loggingDebug("_logger", std::string() + "\"" + (dynamic_cast<Language::MethodVariant*>(d.get()) ? "method: " : "function: '") +
-                                                                         std::string(function->name()) + "' variant: '" + function->variantId() + "'\"");
-                            if(debug.length())
-                                ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-                        }
+                            if(helper->logging())
+                                helper->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_logger", std::string() + "\"" + (d->kind() == Language::Element::Kind::MethodVariant ? "method: " : "function: '") +
+                                                                   std::string(function->name()) + "' variant: '" + function->variantId() + "'\"");
 
-						for (auto & a : function->arguments())
-						{
-							auto & o = ctx->writeTabs(code_deepness);
-							if (!that->writeType(a->type().get(), code_deepness, ctx, ec))
-								return false;
-							o << " _arg_" << a->name() << ";" << std::endl;
-						}
+							if (instrumentation())
+							{
+								std::string scope;
+								for (auto & sc : function->function()->scope())
+									scope += (scope.length() ? "::" : "") + sc;
+								ctx->writeTabs(code_deepness) << "static auto * _stats = " << helper->instrumentationRegistry() << ".function(\"" << scope << "\", \"" << function->name() << "\", \"" << function->variantId() << "\");" << std::endl;
+								ctx->writeTabs(code_deepness) << "PIDL::Instrumentation::Call _call(_stats);" << std::endl;
+							}
 
-						auto in_args = function->in_arguments();
-						if (in_args.size())
-						{
-							ctx->writeTabs(code_deepness) << "rapidjson::Value * aa;" << std::endl;
-							ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(r, \"arguments\", rapidjson::kObjectType, aa, ec))" << std::endl;
-							ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+							for (auto & a : function->arguments())
+							{
+								auto & o = ctx->writeTabs(code_deepness);
+								if (!that->writeType(a->type().get(), code_deepness, ctx, ec))
+									return false;
+								o << " _arg_" << a->name() << ";" << std::endl;
+							}
 
-							auto & o = ctx->writeTabs(code_deepness++) << "if (" << std::endl;
-							bool is_first = true;
-							for (auto & a : in_args)
+							auto in_args = function->in_arguments();
+							if (sax)
+							{
+								if (in_args.size())
+								{
+									ctx->writeTabs(code_deepness++) << "PIDL::JSONTools::SAX::Member _args[] = {" << std::endl;
+									for (auto & a : in_args)
+										ctx->writeTabs(code_deepness) << "{ \"" << a->name() << "\", " << strlen(a->name()) << ", _intf_p->_slot(_arg_" << a->name() << ") }," << std::endl;
+									ctx->writeTabs(--code_deepness) << "};" << std::endl;
+									ctx->writeTabs(code_deepness) << "if (!rq.readArguments(_args, " << in_args.size() << ", ec))" << std::endl;
+								}
+								else
+									ctx->writeTabs(code_deepness) << "if (!rq.readArguments(nullptr, 0, ec))" << std::endl;
+								ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+							}
+							else if (in_args.size())
+							{
+								ctx->writeTabs(code_deepness) << "rapidjson::Value * aa;" << std::endl;
+								ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(r, \"arguments\", rapidjson::kObjectType, aa, ec))" << std::endl;
+								ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+
+								auto & o = ctx->writeTabs(code_deepness++) << "if (" << std::endl;
+								bool is_first = true;
+								for (auto & a : in_args)
+								{
+									ctx->writeTabs(code_deepness);
+									if (!is_first)
+										o << "| ";
+									is_first = false;
+									o << "!_intf_p->_getValue(*aa, \"" << a->name() << "\", _arg_" << a->name() << ", ec)" << std::endl;
+								}
+								ctx->writeTabs(--code_deepness) << ")" << std::endl;
+								ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+                            } else {
+                                ctx->writeTabs(code_deepness) << "(void)r;" << std::endl;
+                            }
+							if (instrumentation())
+								ctx->writeTabs(code_deepness) << "_call.unmarshalled();" << std::endl;
+
+							auto ret_type = function->returnType().get();
+							if (function->returnType()->kind() == Language::Element::Kind::Void)
+								ret_type = nullptr;
+							if (ret_type)
 							{
 								ctx->writeTabs(code_deepness);
+								if (!that->writeType(ret_type, code_deepness, ctx, ec))
+									return false;
+								*ctx << " retval;" << std::endl;
+							}
+
+							auto & o = ctx->writeTabs(code_deepness);
+							o << "auto stat = _callFunction([&](){";
+							if (ret_type)
+								o << "retval =";
+							o << " _that->" << function->name() << "(";
+							bool is_first = true;
+							for (auto & a : function->arguments())
+							{
 								if (!is_first)
-									o << "| ";
+									o << ", ";
 								is_first = false;
-								o << "!_intf_p->_getValue(*aa, \"" << a->name() << "\", _arg_" << a->name() << ", ec)" << std::endl;
+								o << "_arg_" << a->name();
+							}
+							o << "); }, ec);" << std::endl;
+							if (instrumentation())
+								ctx->writeTabs(code_deepness) << "_call.called(stat);" << std::endl;
+							ctx->writeTabs(code_deepness) << "if (stat != _invoke_status::Ok)" << std::endl;
+							ctx->writeTabs(code_deepness + 1) << "return stat;" << std::endl;
+
+							const auto & out_args = function->out_arguments();
+							if (writerMarshalling())
+							{
+								//the response object is closed by '_invoke'
+								ctx->writeTabs(code_deepness) << "ret.StartObject();" << std::endl;
+
+								if (ret_type)
+									ctx->writeTabs(code_deepness) << "_intf_p->_writeValue(ret, \"retval\", retval);" << std::endl;
+
+								if (out_args.size())
+								{
+									ctx->writeTabs(code_deepness) << "ret.Key(\"output\");" << std::endl;
+									ctx->writeTabs(code_deepness) << "ret.StartObject();" << std::endl;
+									for (auto & a : out_args)
+										ctx->writeTabs(code_deepness) << "_intf_p->_writeValue(ret, \"" << a->name() << "\", _arg_" << a->name() << ");" << std::endl;
+									ctx->writeTabs(code_deepness) << "ret.EndObject();" << std::endl;
+								}
+							}
+							else
+							{
+								ctx->writeTabs(code_deepness) << "ret.SetObject();" << std::endl;
+
+								if (ret_type)
+									ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, ret, \"retval\", retval);" << std::endl;
+
+								if (out_args.size())
+								{
+									ctx->writeTabs(code_deepness) << "rapidjson::Value out_v(rapidjson::kObjectType);" << std::endl;
+									for (auto & a : out_args)
+										ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, out_v, \"" << a->name() << "\", _arg_" << a->name() << ");" << std::endl;
+									ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(ret, ret, \"output\", out_v);" << std::endl;
+								}
 							}
-							ctx->writeTabs(--code_deepness) << ")" << std::endl;
-							ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
-                        } else {
-                            ctx->writeTabs(code_deepness) << "(void)r;" << std::endl;
-                        }
-
-						auto ret_type = function->returnType().get();
-						if (dynamic_cast<Language::Void*>(function->returnType().get()))
-							ret_type = nullptr;
-						if (ret_type)
-						{
-							ctx->writeTabs(code_deepness);
-							if (!that->writeType(ret_type, code_deepness, ctx, ec))
-								return false;
-							*ctx << " retval;" << std::endl;
-						}
-
-						auto & o = ctx->writeTabs(code_deepness);
-						o << "auto stat = _callFunction([&](){";
-						if (ret_type)
-							o << "retval =";
-						o << " _that->" << function->name() << "(";
-						bool is_first = true;
-						for (auto & a : function->arguments())
-						{
-							if (!is_first)
-								o << ", ";
-							is_first = false;
-							o << "_arg_" << a->name();
-						}
-						o << "); }, ec);" << std::endl;
-						ctx->writeTabs(code_deepness) << "if (stat != _invoke_status::Ok)" << std::endl;
-						ctx->writeTabs(code_deepness + 1) << "return stat;" << std::endl;
-
-						ctx->writeTabs(code_deepness) << "ret.SetObject();" << std::endl;
 
-						if (ret_type)
-							ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, ret, \"retval\", retval);" << std::endl;
+                            if(!in_args.size() && !ret_type && !out_args.size()) {
+                                ctx->writeTabs(code_deepness) << "(void)_intf_p;" << std::endl;
+                            }
 
-						const auto & out_args = function->out_arguments();
-						if (out_args.size())
-						{
-							ctx->writeTabs(code_deepness) << "rapidjson::Value out_v(rapidjson::kObjectType);" << std::endl;
-							for (auto & a : out_args)
-								ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, out_v, \"" << a->name() << "\", _arg_" << a->name() << ");" << std::endl;
-							ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(ret, ret, \"output\", out_v);" << std::endl;
+							ctx->writeTabs(code_deepness) << "return _invoke_status::Ok;" << std::endl;
+							ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 						}
-
-                        if(!in_args.size() && !ret_type && !out_args.size()) {
-                            ctx->writeTabs(code_deepness) << "(void)_intf_p;" << std::endl;
-                        }
-
-						ctx->writeTabs(code_deepness) << "return _invoke_status::Ok;" << std::endl;
-						ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
 					}
-					else if (dynamic_cast<Language::Property*>(d.get()))
+					else if (d->kind() == Language::Element::Kind::Property)
 					{
-						auto property = dynamic_cast<Language::Property*>(d.get());
+						auto property = static_cast<Language::Property*>(d.get());
 
 					//getter
-						ctx->writeTabs(code_deepness++) << "_functions[\"" << property->name() << "\"].data[\"get\"] = [&](const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)->_invoke_status {" << std::endl;
+						ctx->writeTabs(code_deepness) << "_invoke_status _property_get_" << property->name() << "(const rapidjson::Value & r, " << retType() << " & ret, _error_collector & ec)" << std::endl;
+						ctx->writeTabs(code_deepness++) << "{" << std::endl;
                         write_privs(true);
 
                         ctx->writeTabs(code_deepness) << "(void)r;" << std::endl;
 
                         if(helper->logging())
-                        {
-                            auto starter = helper->logging()->loggingStart("_logger");
-                            if(starter.length())
-                                ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                            auto debug = helper->logging()->loggingDebug("_logger", "\"property getter: '" + std::string(property->name()) + "'\"");
-                            if(debug.length())
-                                ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-                        }
+                            helper->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_logger", "\"property getter: '" + std::string(property->name()) + "'\"");
 
 						auto ret_type = property->type().get();
 
@@ -600,32 +2081,36 @@ namespace PIDL
 						ctx->writeTabs(code_deepness) << "if (stat != _invoke_status::Ok)" << std::endl;
 						ctx->writeTabs(code_deepness + 1) << "return stat;" << std::endl;
 
-						ctx->writeTabs(code_deepness) << "ret.SetObject();" << std::endl;
+						if (writerMarshalling())
+						{
+							//the response object is closed by '_invoke' of the object
+							ctx->writeTabs(code_deepness) << "ret.StartObject();" << std::endl;
+							if (ret_type)
+								ctx->writeTabs(code_deepness) << "_intf_p->_writeValue(ret, \"retval\", retval);" << std::endl;
+						}
+						else
+						{
+							ctx->writeTabs(code_deepness) << "ret.SetObject();" << std::endl;
 
-						if (ret_type)
-							ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, ret, \"retval\", retval);" << std::endl;
+							if (ret_type)
+								ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, ret, \"retval\", retval);" << std::endl;
+						}
 
 						ctx->writeTabs(code_deepness) << "return _invoke_status::Ok;" << std::endl;
-						ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
+						ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 
                     //setter
 						if (!property->readOnly())
 						{
-							ctx->writeTabs(code_deepness++) << "_functions[\"" << property->name() << "\"].data[\"set\"] = [&](const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)->_invoke_status {" << std::endl;
+							ctx->writeTabs(code_deepness) << "_invoke_status _property_set_" << property->name() << "(const rapidjson::Value & r, " << retType() << " & ret, _error_collector & ec)" << std::endl;
+							ctx->writeTabs(code_deepness++) << "{" << std::endl;
                             write_privs(true);
 
-                            ctx->writeTabs(code_deepness) << "(void)ret;" << std::endl;
+                            if (!writerMarshalling())
+                                ctx->writeTabs(code_deepness) << "(void)ret;" << std::endl;
 
                             if(helper->logging())
-                            {
-                                auto starter = helper->logging()->loggingStart("_logger");
-                                if(starter.length())
-                                    ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                                auto debug = helper->logging()->loggingDebug("_logger", "\"property setter: '" + std::string(property->name()) + "'\"");
-                                if(debug.length())
-                                    ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-                            }
+                                helper->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_logger", "\"property setter: '" + std::string(property->name()) + "'\"");
 
 							auto type = property->type().get();
 							ctx->writeTabs(code_deepness);
@@ -635,28 +2120,30 @@ namespace PIDL
 							ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(r, \"value\", value, ec))" << std::endl;
 							ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
 
-							ctx->writeTabs(code_deepness) << "return _callFunction([&](){ _that->set_" << property->name() << "(value); }, ec);" << std::endl;
-							ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
+							if (writerMarshalling())
+							{
+								ctx->writeTabs(code_deepness) << "auto stat = _callFunction([&](){ _that->set_" << property->name() << "(value); }, ec);" << std::endl;
+								ctx->writeTabs(code_deepness) << "if (stat == _invoke_status::Ok)" << std::endl;
+								ctx->writeTabs(code_deepness + 1) << "ret.StartObject();" << std::endl;
+								ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+							}
+							else
+								ctx->writeTabs(code_deepness) << "return _callFunction([&](){ _that->set_" << property->name() << "(value); }, ec);" << std::endl;
+							ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 						}
 					}
 				}
-				if (dynamic_cast<Language::Interface*>(cl) && hasObjects(dynamic_cast<Language::Interface*>(cl)))
+				if (asInterface(cl) && hasObjects(asInterface(cl)))
 				{
-					ctx->writeTabs(code_deepness++) << "_functions[\"_dispose_object\"].data[std::string()] = [&](const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)->_invoke_status {" << std::endl;
+					ctx->writeTabs(code_deepness) << "_invoke_status _function__dispose_object(const rapidjson::Value & r, " << retType() << " & ret, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
                     write_privs(false);
 
-                    ctx->writeTabs(code_deepness) << "(void)ret;" << std::endl;
+                    if (!writerMarshalling())
+                        ctx->writeTabs(code_deepness) << "(void)ret;" << std::endl;
 
                     if(helper->logging())
-                    {
-                        auto starter = helper->logging()->loggingStart("_logger");
-                        if(starter.length())
-                            ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                        auto debug = helper->logging()->loggingDebug("_logger", "\"embedded function: '_dispose_object'\"");
-                        if(debug.length())
-                            ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-                    }
+                        helper->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_logger", "\"embedded function: '_dispose_object'\"");
 
 					ctx->writeTabs(code_deepness) << "std::string _arg_object_data;" << std::endl;
 					ctx->writeTabs(code_deepness) << "nullable<string> _arg_comment;" << std::endl;
@@ -665,8 +2152,45 @@ namespace PIDL
 					ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
 					ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(*aa, \"object_data\", _arg_object_data, ec))" << std::endl;
 					ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
-					ctx->writeTabs(code_deepness) << "return  _callFunction([&]() { _that->_dispose_object(_arg_object_data); }, ec);" << std::endl;
-					ctx->writeTabs(--code_deepness) << "};" << std::endl;
+					if (writerMarshalling())
+					{
+						ctx->writeTabs(code_deepness) << "auto stat = _callFunction([&]() { _that->_dispose_object(_arg_object_data); }, ec);" << std::endl;
+						ctx->writeTabs(code_deepness) << "if (stat == _invoke_status::Ok)" << std::endl;
+						ctx->writeTabs(code_deepness + 1) << "ret.StartObject();" << std::endl;
+						ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+					}
+					else
+						ctx->writeTabs(code_deepness) << "return  _callFunction([&]() { _that->_dispose_object(_arg_object_data); }, ec);" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
+				}
+				if (asInterface(cl) && hasObjects(asInterface(cl)) && deferredDisposal())
+				{
+					ctx->writeTabs(code_deepness) << "_invoke_status _function__dispose_objects(const rapidjson::Value & r, " << retType() << " & ret, _error_collector & ec)" << std::endl;
+					ctx->writeTabs(code_deepness++) << "{" << std::endl;
+					write_privs(false);
+
+					if (!writerMarshalling())
+						ctx->writeTabs(code_deepness) << "(void)ret;" << std::endl;
+
+					if(helper->logging())
+						helper->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_logger", "\"embedded function: '_dispose_objects'\"");
+
+					ctx->writeTabs(code_deepness) << "array<string> _arg_object_data;" << std::endl;
+					ctx->writeTabs(code_deepness) << "rapidjson::Value * aa;" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(r, \"arguments\", rapidjson::kObjectType, aa, ec))" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(*aa, \"object_data\", _arg_object_data, ec))" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
+					if (writerMarshalling())
+					{
+						ctx->writeTabs(code_deepness) << "auto stat = _callFunction([&]() { for (auto & d : _arg_object_data) _that->_dispose_object(d); }, ec);" << std::endl;
+						ctx->writeTabs(code_deepness) << "if (stat == _invoke_status::Ok)" << std::endl;
+						ctx->writeTabs(code_deepness + 1) << "ret.StartObject();" << std::endl;
+						ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+					}
+					else
+						ctx->writeTabs(code_deepness) << "return _callFunction([&]() { for (auto & d : _arg_object_data) _that->_dispose_object(d); }, ec);" << std::endl;
+					ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 				}
 
 				break;
@@ -703,7 +2227,8 @@ namespace PIDL
 		case Mode::AllInOne:
 		case Mode::Implementatinon:
             if (!writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "map"), ec) ||
-                !writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "functional"), ec))
+                !writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "functional"), ec) ||
+                !writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "cstring"), ec))
 				return false;
 			break;
 		case Mode::Declaration:
@@ -721,7 +2246,28 @@ namespace PIDL
                              std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/nullable.h" : "nullable.h"), ec) &&
             writeInclude(code_deepness, ctx, std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/jsontools.h" : "jsontools.h"), ec) &&
             writeInclude(code_deepness, ctx, std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/basictypes.h" : "basictypes.h"), ec) &&
-            writeInclude(code_deepness, ctx, std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/errorcollector.h" : "errorcollector.h"), ec);
+            writeInclude(code_deepness, ctx, std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/errorcollector.h" : "errorcollector.h"), ec) &&
+            (!priv->saxUnmarshalling() || ctx->role() != Role::Server ||
+             writeInclude(code_deepness, ctx, std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/jsonsax.h" : "jsonsax.h"), ec)) &&
+            (!priv->workerPool() || ctx->role() != Role::Server ||
+             (writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "functional"), ec) &&
+              writeInclude(code_deepness, ctx, std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/workerpool.h" : "workerpool.h"), ec))) &&
+            (!priv->instrumentation() || ctx->role() != Role::Server ||
+             writeInclude(code_deepness, ctx, std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/instrumentation.h" : "instrumentation.h"), ec)) &&
+            (!priv->batchCalls() || ctx->role() != Role::Client ||
+             (writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "functional"), ec) &&
+              writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "future"), ec))) &&
+            (!priv->objectTable() || ctx->role() != Role::Server ||
+             (writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "atomic"), ec) &&
+              writeInclude(code_deepness, ctx, std::make_pair(core_path.first, core_path.second.length() ? core_path.second + "/objecttable.h" : "objecttable.h"), ec))) &&
+            (!priv->asyncCalls() || ctx->role() != Role::Client ||
+             (writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "functional"), ec) &&
+              writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "future"), ec) &&
+              writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "list"), ec))) &&
+            (!priv->deferredDisposal() || ctx->role() != Role::Client ||
+             (writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "chrono"), ec) &&
+              writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "mutex"), ec) &&
+              writeInclude(code_deepness, ctx, std::make_pair(IncludeType::GLobal, "unordered_set"), ec)));
 	}
 
 	bool JSON_STL_CodeGen::writeAliases(short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
@@ -758,7 +2304,7 @@ namespace PIDL
 	bool JSON_STL_CodeGen::writeInvoke(short code_deepness, CPPCodeGenContext * ctx, Language::Interface * intf, ErrorCollector & ec)
 	{
         (void)ec;
-        if (ctx->role() == Role::Client && ctx->mode() == Mode::Implementatinon)
+        if (ctx->role() == Role::Client && ctx->mode() == Mode::Implementatinon && !priv->asyncCalls())
 			return true;
 
 		switch (ctx->role())
@@ -768,10 +2314,10 @@ namespace PIDL
 			{
 			case Mode::AllInOne:
 			case Mode::Declaration:
-				ctx->writeTabs(code_deepness) << "_invoke_status _invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)";
+				ctx->writeTabs(code_deepness) << "_invoke_status _invoke(const rapidjson::Value & root, " << priv->retType() << " & ret, _error_collector & ec)";
 				break;
 			case Mode::Implementatinon:
-				ctx->writeTabs(code_deepness) << "_invoke_status " << intf->name() << "::_invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)";
+				ctx->writeTabs(code_deepness) << "_invoke_status " << intf->name() << "::_invoke(const rapidjson::Value & root, " << priv->retType() << " & ret, _error_collector & ec)";
 				break;
 			}
 
@@ -803,14 +2349,25 @@ namespace PIDL
                 ctx->writeTabs(code_deepness) << "{ ec << \"unsupported mashalling version detected\"; return _invoke_status::NotSupportedMarshallingVersion; }" << std::endl << std::endl;
 
 				ctx->writeTabs(code_deepness) << "rapidjson::Value * v;" << std::endl;
-				ctx->writeTabs(code_deepness) << "if (PIDL::JSONTools::getValue(root, \"function\", v) && v->IsObject())" << std::endl;
+				if (priv->batchCalls())
+					priv->writeBatchInvoke(code_deepness, ctx);
+				ctx->writeTabs(code_deepness) << (priv->batchCalls() ? "else if" : "if") << " (PIDL::JSONTools::getValue(root, \"function\", v) && v->IsObject())" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				priv->writeIdDispatch(code_deepness, ctx, false, false);
 				ctx->writeTabs(code_deepness) << "std::string name, variant;" << std::endl;
 				ctx->writeTabs(code_deepness) << "if (!_p->_getValue(*v, \"name\", name, ec))" << std::endl;
 				ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
 				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::getValue(*v, \"variant\", variant);" << std::endl;
 				ctx->writeTabs(code_deepness) << "ec.clear();" << std::endl;
-				ctx->writeTabs(code_deepness) << "return _p->_callFunction(name, variant, *v, ret, ec);" << std::endl;
+				if (priv->writerMarshalling())
+				{
+					ctx->writeTabs(code_deepness) << "auto stat = _p->_callFunction(name, variant, *v, ret, ec);" << std::endl;
+					ctx->writeTabs(code_deepness) << "if (stat == _invoke_status::Ok)" << std::endl;
+					ctx->writeTabs(code_deepness + 1) << "ret.EndObject();" << std::endl;
+					ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
+				}
+				else
+					ctx->writeTabs(code_deepness) << "return _p->_callFunction(name, variant, *v, ret, ec);" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl;
 
 				if (priv->hasObjects(intf))
@@ -831,17 +2388,27 @@ namespace PIDL
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 				break;
 			}
+
+			if (priv->saxUnmarshalling())
+				priv->writeSAXInvoke(code_deepness, ctx, intf);
+			if (priv->workerPool())
+				priv->writePoolInvoke(code_deepness, ctx, intf);
 			break;
 		case Role::Client:
 			switch (ctx->mode())
 			{
 			case Mode::AllInOne:
 			case Mode::Declaration:
-				ctx->writeTabs(code_deepness) << "virtual _invoke_status _invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec) = 0;" << std::endl;
+				if (priv->writerMarshalling())
+					ctx->writeTabs(code_deepness) << "virtual _invoke_status _invoke(const char * request, size_t length, rapidjson::Document & ret, _error_collector & ec) = 0;" << std::endl;
+				else
+					ctx->writeTabs(code_deepness) << "virtual _invoke_status _invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec) = 0;" << std::endl;
 				break;
 			case Mode::Implementatinon:
 				break;
 			}
+			if (priv->asyncCalls())
+				priv->writeInvokeAsync(code_deepness, ctx, intf);
 			break;
 		}
 
@@ -854,7 +2421,7 @@ namespace PIDL
         switch (ctx->role())
 		{
 		case Role::Client:
-			if (dynamic_cast<Language::MethodVariant*>(function))
+			if (function->kind() == Language::Element::Kind::MethodVariant)
 			{
 				switch (ctx->mode())
 				{
@@ -871,36 +2438,36 @@ namespace PIDL
 				}
 
                 if(helper()->logging())
-                {
-                    auto starter = helper()->logging()->loggingStart("_p->_logger");
-                    if(starter.length())
-                        ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                    auto debug = helper()->logging()->loggingDebug("_p->_logger", "\"method: '"+std::string(function->name())+"' variant: '"+function->variantId()+"'\"");
-                    if(debug.length())
-                        ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-                }
+                    helper()->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_p->_logger", "\"method: '"+std::string(function->name())+"' variant: '"+function->variantId()+"'\"");
 
 				ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
-				ctx->writeTabs(code_deepness) << "rapidjson::Document _doc;" << std::endl;
-				ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
+				if (priv->writerMarshalling())
+				{
+					auto args = priv->argumentNames(function);
+					priv->writeRequest(code_deepness, ctx, "_intf_p", "_p->__data", "method", priv->callFields(intf, function), &args);
+				}
+				else
+				{
+					priv->writeDocument(code_deepness, ctx, "_doc");
+					ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
 
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
+					ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
 
-				ctx->writeTabs(code_deepness) << "rapidjson::Value _r(rapidjson::kObjectType);" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _r, \"object_data\", _p->__data);" << std::endl;
-				ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"name\", \"" << function->name() << "\");" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"variant\", \"" << function->variantId() << "\");" << std::endl;
-				ctx->writeTabs(code_deepness) << "rapidjson::Value _aa(rapidjson::kObjectType);" << std::endl;
+					ctx->writeTabs(code_deepness) << "rapidjson::Value _r(rapidjson::kObjectType);" << std::endl;
+					ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _r, \"object_data\", _p->__data);" << std::endl;
+					ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
+					for (auto & f : priv->callFields(intf, function))
+						ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"" << f.first << "\", " << f.second << ");" << std::endl;
+					ctx->writeTabs(code_deepness) << "rapidjson::Value _aa(rapidjson::kObjectType);" << std::endl;
 
-				for (auto & a : function->in_arguments())
-					ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _aa, \"" << a->name() << "\", " << a->name() << ");" << std::endl;
+					for (auto & a : function->in_arguments())
+						ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _aa, \"" << a->name() << "\", " << a->name() << ");" << std::endl;
 
-				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _v, \"arguments\", _aa);" << std::endl;
-				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _r, \"method\", _v);" << std::endl;
-				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"object_call\", _r);" << std::endl;
-				ctx->writeTabs(code_deepness) << "rapidjson::Document _ret;" << std::endl;
+					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _v, \"arguments\", _aa);" << std::endl;
+					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _r, \"method\", _v);" << std::endl;
+					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"object_call\", _r);" << std::endl;
+				}
+				priv->writeDocument(code_deepness, ctx, "_ret");
 			}
 			else
 			{
@@ -919,76 +2486,37 @@ namespace PIDL
 				}
 
                 if(helper()->logging())
-                {
-                    auto starter = helper()->logging()->loggingStart("_p->_logger");
-                    if(starter.length())
-                        ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                    auto debug = helper()->logging()->loggingDebug("_p->_logger", "\"function: '"+std::string(function->name())+"' variant: '"+function->variantId()+"'\"");
-                    if(debug.length())
-                        ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-                }
+                    helper()->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_p->_logger", "\"function: '"+std::string(function->name())+"' variant: '"+function->variantId()+"'\"");
 
 				ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
-				ctx->writeTabs(code_deepness) << "rapidjson::Document _doc;" << std::endl;
-				ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
-
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
-
-				ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"name\", \"" << function->name() << "\");" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"variant\", \"" << function->variantId() << "\");" << std::endl;
-				ctx->writeTabs(code_deepness) << "rapidjson::Value _aa(rapidjson::kObjectType);" << std::endl;
-
-				for (auto & a : function->in_arguments())
-					ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _aa, \"" << a->name() << "\", " << a->name() << ");" << std::endl;
+				if (priv->writerMarshalling())
+				{
+					auto args = priv->argumentNames(function);
+					priv->writeRequest(code_deepness, ctx, "_intf_p", nullptr, "function", priv->callFields(intf, function), &args);
+				}
+				else
+				{
+					priv->writeDocument(code_deepness, ctx, "_doc");
+					ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
 
-				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _v, \"arguments\", _aa);" << std::endl;
-				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"function\", _v);" << std::endl;
-				ctx->writeTabs(code_deepness) << "rapidjson::Document _ret;" << std::endl;
+					priv->writeFunctionDocument(code_deepness, ctx, intf, function, "_doc");
+				}
+				priv->writeDocument(code_deepness, ctx, "_ret");
 			}
 
 			{
-				ctx->writeTabs(code_deepness) << "if (!_intf_p->_invokeCall(_doc, _ret, _ec))" << std::endl;
+				ctx->writeTabs(code_deepness) << "if (!_intf_p->_invokeCall(" << priv->requestName() << ", _ret, _ec))" << std::endl;
 				ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
 
-				auto ret_type = function->returnType().get();
-				if (!dynamic_cast<Language::Void*>(ret_type))
-				{
-					ctx->writeTabs(code_deepness);
-					if (!writeType(ret_type, code_deepness, ctx, ec))
-						return false;
-					*ctx << " _retval;" << std::endl;
-					ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(_ret, \"retval\", _retval, _ec))" << std::endl;
-					ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
-				}
-
-				const auto & out_args = function->out_arguments();
-				if (out_args.size())
-				{
-					ctx->writeTabs(code_deepness) << "rapidjson::Value * _out_v;" << std::endl;
-					ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(_ret, \"output\", rapidjson::kObjectType, _out_v, _ec))" << std::endl;
-					ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
-
-					auto & o = ctx->writeTabs(code_deepness++) << "if (" << std::endl;
+				if (!priv->writeResponse(code_deepness, ctx, function, ec))
+					return false;
 
-					bool is_first = true;
-					for (auto & a : out_args)
-					{
-						ctx->writeTabs(code_deepness);
-						if (!is_first)
-							o << "| ";
-						is_first = false;
-						o << "!_intf_p->_getValue(*_out_v, \"" << a->name() << "\", " << a->name() << ", _ec)" << std::endl;
-					}
-					ctx->writeTabs(--code_deepness) << ")" << std::endl;
-					ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
-				}
+				auto ret_type = function->returnType().get();
 
-				if (dynamic_cast<Language::MethodVariant*>(function))
+				if (function->kind() == Language::Element::Kind::MethodVariant)
 					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::getValue(_ret, \"object_data\", _p->__data);" << std::endl;
 
-				if (!dynamic_cast<Language::Void*>(ret_type))
+				if (ret_type->kind() != Language::Element::Kind::Void)
 					ctx->writeTabs(code_deepness) << "return _retval;" << std::endl;
 			}
 			break;
@@ -1001,7 +2529,9 @@ namespace PIDL
 
 	bool JSON_STL_CodeGen::writeConstructorBody(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
 	{
-		return priv->writeConstructorBody(intf, code_deepness, ctx, ec);
+		//nothing is registered at construction, calls are dispatched by the generated '_callFunction'
+		(void)intf; (void)code_deepness; (void)ctx; (void)ec;
+		return true;
 	}
 
 	bool JSON_STL_CodeGen::writeInvoke(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, Language::Object * object, ErrorCollector & ec)
@@ -1018,12 +2548,12 @@ namespace PIDL
 			{
 			case Mode::AllInOne:
 			case Mode::Declaration:
-				ctx->writeTabs(code_deepness) << "_invoke_status _invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)";
+				ctx->writeTabs(code_deepness) << "_invoke_status _invoke(const rapidjson::Value & root, " << priv->retType() << " & ret, _error_collector & ec)";
 				break;
 			case Mode::Implementatinon:
 				ctx->writeTabs(code_deepness)
 					<< "_invoke_status " << priv->getScope(object) << object->name()
-					<< "::_invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)";
+					<< "::_invoke(const rapidjson::Value & root, " << priv->retType() << " & ret, _error_collector & ec)";
 				break;
 			}
 
@@ -1053,36 +2583,38 @@ namespace PIDL
 				ctx->writeTabs(code_deepness) << "rapidjson::Value * v;" << std::endl;
 				ctx->writeTabs(code_deepness) << "if (_intf_p->_getValue(root, \"method\", rapidjson::kObjectType, v, ec))" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				priv->writeIdDispatch(code_deepness, ctx, true, false);
 				ctx->writeTabs(code_deepness) << "std::string name, variant;" << std::endl;
 				ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(*v, \"name\", name, ec))" << std::endl;
 				ctx->writeTabs(code_deepness+1) << "return _invoke_status::MarshallingError;" << std::endl;
 				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::getValue(*v, \"variant\", variant);" << std::endl;
 				ctx->writeTabs(code_deepness) << "ec.clear();" << std::endl;
 				ctx->writeTabs(code_deepness) << "auto stat = _p->_callFunction(name, variant, *v, ret, ec);" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, ret, \"object_data\", _data());" << std::endl;
+				priv->writeObjectData(code_deepness, ctx, false);
 				ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl;
 
 				ctx->writeTabs(code_deepness) << "else if (_intf_p->_getValue(root, \"property_get\", rapidjson::kObjectType, v, ec))" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				priv->writeIdDispatch(code_deepness, ctx, true, false);
 				ctx->writeTabs(code_deepness) << "std::string name;" << std::endl;
 				ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(*v, \"name\", name, ec))" << std::endl;
 				ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
 				ctx->writeTabs(code_deepness) << "ec.clear();" << std::endl;
 				ctx->writeTabs(code_deepness) << "auto stat = _p->_callFunction(name, \"get\", *v, ret, ec);" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, ret, \"object_data\", _data());" << std::endl;
+				priv->writeObjectData(code_deepness, ctx, false);
 				ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl;
 
 				ctx->writeTabs(code_deepness) << "else if (_intf_p->_getValue(root, \"property_set\", rapidjson::kObjectType, v, ec))" << std::endl;
 				ctx->writeTabs(code_deepness++) << "{" << std::endl;
+				priv->writeIdDispatch(code_deepness, ctx, true, true);
 				ctx->writeTabs(code_deepness) << "std::string name;" << std::endl;
 				ctx->writeTabs(code_deepness) << "if (!_intf_p->_getValue(*v, \"name\", name, ec))" << std::endl;
 				ctx->writeTabs(code_deepness + 1) << "return _invoke_status::MarshallingError;" << std::endl;
 				ctx->writeTabs(code_deepness) << "ec.clear();" << std::endl;
 				ctx->writeTabs(code_deepness) << "auto stat = _p->_callFunction(name, \"set\", *v, ret, ec);" << std::endl;
-				ctx->writeTabs(code_deepness) << "if (!ret.IsObject()) ret.SetObject();" << std::endl;
-				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(ret, ret, \"object_data\", _data());" << std::endl;
+				priv->writeObjectData(code_deepness, ctx, true);
 				ctx->writeTabs(code_deepness) << "return stat;" << std::endl;
 				ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 
@@ -1128,32 +2660,30 @@ namespace PIDL
 		case Role::Client:
 		{
             if(helper()->logging())
-            {
-                auto starter = helper()->logging()->loggingStart("_p->_logger");
-                if(starter.length())
-                    ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                auto debug = helper()->logging()->loggingDebug("_p->_logger", "\"property getter: '"+std::string(property->name())+"'\"");
-                if(debug.length())
-                    ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-            }
+                helper()->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_p->_logger", "\"property getter: '"+std::string(property->name())+"'\"");
 
             ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
-			ctx->writeTabs(code_deepness) << "rapidjson::Document _doc;" << std::endl;
-			ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
+			if (priv->writerMarshalling())
+				priv->writeRequest(code_deepness, ctx, "_intf_p", "_p->__data", "property_get", priv->callFields(intf, property, property->name(), "get", false), nullptr);
+			else
+			{
+				priv->writeDocument(code_deepness, ctx, "_doc");
+				ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
 
-			ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
+				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
 
-			ctx->writeTabs(code_deepness) << "rapidjson::Value _r(rapidjson::kObjectType);" << std::endl;
-			ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _r, \"object_data\", _p->__data);" << std::endl;
+				ctx->writeTabs(code_deepness) << "rapidjson::Value _r(rapidjson::kObjectType);" << std::endl;
+				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _r, \"object_data\", _p->__data);" << std::endl;
 
-			ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
-			ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"name\", \"" << property->name() << "\");" << std::endl;
-			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _r, \"property_get\", _v);" << std::endl;
-			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"object_call\", _r);" << std::endl;
+				ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
+				for (auto & f : priv->callFields(intf, property, property->name(), "get", false))
+					ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"" << f.first << "\", " << f.second << ");" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _r, \"property_get\", _v);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"object_call\", _r);" << std::endl;
+			}
 
-			ctx->writeTabs(code_deepness) << "rapidjson::Document _ret;" << std::endl;
-			ctx->writeTabs(code_deepness) << "if (!_intf_p->_invokeCall(_doc, _ret, _ec))" << std::endl;
+			priv->writeDocument(code_deepness, ctx, "_ret");
+			ctx->writeTabs(code_deepness) << "if (!_intf_p->_invokeCall(" << priv->requestName() << ", _ret, _ec))" << std::endl;
 			ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
 
 			auto ret_type = property->type().get();
@@ -1166,7 +2696,7 @@ namespace PIDL
 
 			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::getValue(_ret, \"object_data\", _p->__data);" << std::endl;
 
-			if (!dynamic_cast<Language::Void*>(ret_type))
+			if (ret_type->kind() != Language::Element::Kind::Void)
 				ctx->writeTabs(code_deepness) << "return _retval;" << std::endl;
 		}
 		break;
@@ -1200,33 +2730,35 @@ namespace PIDL
 		case Role::Client:
 		{
             if(helper()->logging())
-            {
-                auto starter = helper()->logging()->loggingStart("_p->_logger");
-                if(starter.length())
-                    ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                auto debug = helper()->logging()->loggingDebug("_p->_logger", "\"property setter: '"+std::string(property->name())+"'\"");
-                if(debug.length())
-                    ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-            }
+                helper()->logging()->writeLogging(code_deepness, ctx, CPPCodeGenLogging::Level::Debug, "_p->_logger", "\"property setter: '"+std::string(property->name())+"'\"");
 
 			ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
-			ctx->writeTabs(code_deepness) << "rapidjson::Document _doc;" << std::endl;
-			ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
+			if (priv->writerMarshalling())
+			{
+				auto fields = priv->callFields(intf, property, property->name(), "set", false);
+				fields.push_back({ "value", "value" });
+				priv->writeRequest(code_deepness, ctx, "_intf_p", "_p->_that->_data()", "property_set", fields, nullptr);
+			}
+			else
+			{
+				priv->writeDocument(code_deepness, ctx, "_doc");
+				ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
 
-			ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
+				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
 
-			ctx->writeTabs(code_deepness) << "rapidjson::Value _r(rapidjson::kObjectType);" << std::endl;
-			ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _r, \"object_data\", _p->_that->_data());" << std::endl;
+				ctx->writeTabs(code_deepness) << "rapidjson::Value _r(rapidjson::kObjectType);" << std::endl;
+				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _r, \"object_data\", _p->_that->_data());" << std::endl;
 
-			ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
-			ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"name\", \"" << property->name() << "\");" << std::endl;
-			ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"value\", value);" << std::endl;
-			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _r, \"property_set\", _v);" << std::endl;
-			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"object_call\", _r);" << std::endl;
+				ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
+				for (auto & f : priv->callFields(intf, property, property->name(), "set", false))
+					ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"" << f.first << "\", " << f.second << ");" << std::endl;
+				ctx->writeTabs(code_deepness) << "_intf_p->_addValue(_doc, _v, \"value\", value);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _r, \"property_set\", _v);" << std::endl;
+				ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"object_call\", _r);" << std::endl;
+			}
 
-			ctx->writeTabs(code_deepness) << "rapidjson::Document _ret;" << std::endl;
-			ctx->writeTabs(code_deepness) << "if (!_intf_p->_invokeCall(_doc, _ret, _ec))" << std::endl;
+			priv->writeDocument(code_deepness, ctx, "_ret");
+			ctx->writeTabs(code_deepness) << "if (!_intf_p->_invokeCall(" << priv->requestName() << ", _ret, _ec))" << std::endl;
 			ctx->writeTabs(code_deepness + 1) << "_ec.throwException();" << std::endl;
 
 			ctx->writeTabs(code_deepness) << "PIDL::JSONTools::getValue(_ret, \"object_data\", _p->__data);" << std::endl;
@@ -1241,8 +2773,8 @@ namespace PIDL
 
 	bool JSON_STL_CodeGen::writeConstructorBody(Language::Interface * intf, Language::Object * object, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
 	{
-        (void)intf;
-        return priv->writeConstructorBody(object, code_deepness, ctx, ec);
+		(void)intf; (void)object; (void)code_deepness; (void)ctx; (void)ec;
+		return true;
 	}
 
 	bool JSON_STL_CodeGen::writeObjectBase(Language::Interface * intf, short code_deepness, CPPCodeGenContext * ctx, ErrorCollector & ec)
@@ -1250,20 +2782,34 @@ namespace PIDL
         (void)ec;
         if (priv->hasObjects(intf))
 		{
+			bool table = priv->objectTable() && ctx->role() == Role::Server;
 			ctx->writeTabs(code_deepness) << "class _Object" << std::endl;
 			ctx->writeTabs(code_deepness++) << "{" << std::endl;
+			if (table)
+			{
+				ctx->writeTabs(code_deepness) << "friend class " << intf->name() << ";" << std::endl;
+				ctx->writeTabs(code_deepness) << "std::atomic<PIDL::ObjectTable::Handle> _handle;" << std::endl;
+			}
 			ctx->writeTabs(code_deepness - 1) << "public:" << std::endl;
             ctx->writeTabs(code_deepness) << "typedef ptr<_Object> Ptr;" << std::endl;
+			if (table)
+				ctx->writeTabs(code_deepness) << "_Object() : _handle(0) { }" << std::endl;
             ctx->writeTabs(code_deepness) << "virtual ~_Object() = default;" << std::endl;
 			switch (ctx->role())
 			{
 			case Role::Client:
 				break;
 			case Role::Server:
-				ctx->writeTabs(code_deepness) << "virtual _invoke_status _invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec) = 0;" << std::endl;
+				ctx->writeTabs(code_deepness) << "virtual _invoke_status _invoke(const rapidjson::Value & root, " << priv->retType() << " & ret, _error_collector & ec) = 0;" << std::endl;
 				break;
 			}
-			ctx->writeTabs(code_deepness) << "virtual std::string _data() = 0;" << std::endl;
+			if (table)
+			{
+				ctx->writeTabs(code_deepness) << "virtual std::string _data() { return PIDL::ObjectTable::toString(_handle); }" << std::endl;
+				ctx->writeTabs(code_deepness) << "virtual int _type() const = 0;" << std::endl;
+			}
+			else
+				ctx->writeTabs(code_deepness) << "virtual std::string _data() = 0;" << std::endl;
 			ctx->writeTabs(--code_deepness) << "};" << std::endl << std::endl;
 		}
 		return true;
@@ -1284,21 +2830,38 @@ namespace PIDL
 			case Role::Server:
 				if (priv->hasObjects(intf))
 				{
-                    ctx->writeTabs(code_deepness) << "virtual ptr<_Object> _get_object(const std::string & object_data, _error_collector & ec) = 0;" << std::endl;
+					if (priv->objectTable())
+						priv->writeObjectTable(code_deepness, ctx, intf);
+					else
+						ctx->writeTabs(code_deepness) << "virtual ptr<_Object> _get_object(const std::string & object_data, _error_collector & ec) = 0;" << std::endl;
                     ctx->writeTabs(code_deepness) << "template<class Object_T> ptr<Object_T> _get_object(const std::string & object_data, _error_collector & ec)" << std::endl; //**
 					ctx->writeTabs(code_deepness++) << "{" << std::endl;
 					ctx->writeTabs(code_deepness) << "auto o = _get_object(object_data, ec);" << std::endl;
 					ctx->writeTabs(code_deepness) << "if (!o) return nullptr;" << std::endl;
-					ctx->writeTabs(code_deepness) << "auto ret = std::dynamic_pointer_cast<Object_T, _Object>(o);" << std::endl;
-					ctx->writeTabs(code_deepness) << "if (!ret) ec.add(-1, \"unexpected: invalid object type for data '\" + object_data + \"'\");" << std::endl;
-					ctx->writeTabs(code_deepness) << "return ret;" << std::endl;
+					if (priv->objectTable())
+					{
+						//the objects of the table are of the generated classes, their type is known without RTTI
+						ctx->writeTabs(code_deepness) << "if (o->_type() == Object_T::_type_id)" << std::endl;
+						ctx->writeTabs(code_deepness + 1) << "return std::static_pointer_cast<Object_T>(o);" << std::endl;
+						ctx->writeTabs(code_deepness) << "ec.add(-1, \"unexpected: invalid object type for data '\" + object_data + \"'\");" << std::endl;
+						ctx->writeTabs(code_deepness) << "return nullptr;" << std::endl;
+					}
+					else
+					{
+						ctx->writeTabs(code_deepness) << "auto ret = std::dynamic_pointer_cast<Object_T, _Object>(o);" << std::endl;
+						ctx->writeTabs(code_deepness) << "if (!ret) ec.add(-1, \"unexpected: invalid object type for data '\" + object_data + \"'\");" << std::endl;
+						ctx->writeTabs(code_deepness) << "return ret;" << std::endl;
+					}
 					ctx->writeTabs(--code_deepness) << "}" << std::endl;
-					ctx->writeTabs(code_deepness) << "virtual void _dispose_object(const std::string & object_data) = 0;" << std::endl;
+					if (!priv->objectTable())
+						ctx->writeTabs(code_deepness) << "virtual void _dispose_object(const std::string & object_data) = 0;" << std::endl;
 				}
 				break;
 			}
 			break;
 		case Mode::Implementatinon:
+			if (ctx->role() == Role::Server && priv->hasObjects(intf) && priv->objectTable())
+				priv->writeObjectTable(code_deepness, ctx, intf);
 			break;
 		}
 		return true;
@@ -1311,7 +2874,9 @@ namespace PIDL
 		switch (ctx->role())
 		{
 		case Role::Client:
-			if (priv->hasObjects(intf))
+			if (priv->hasObjects(intf) && priv->deferredDisposal())
+				priv->writeDeferredDisposal(code_deepness, ctx, intf);
+			else if (priv->hasObjects(intf))
 			{
 				switch (ctx->mode())
 				{
@@ -1343,35 +2908,15 @@ namespace PIDL
 						break;
 					}
 
-                    if(helper()->logging())
-                    {
-                        auto starter = helper()->logging()->loggingStart("_p->_logger");
-                        if(starter.length())
-                            ctx->writeTabs(code_deepness) << starter << ";" << std::endl;
-
-                        auto debug = helper()->logging()->loggingDebug("_p->_logger", "\"embedded function: '_dispose_object'\"");
-                        if(starter.length())
-                            ctx->writeTabs(code_deepness) << debug << ";" << std::endl;
-                    }
-
-					ctx->writeTabs(code_deepness) << "PIDL::ExceptionErrorCollector<_error_collector> _ec;" << std::endl;
-					ctx->writeTabs(code_deepness) << "rapidjson::Document _doc;" << std::endl;
-					ctx->writeTabs(code_deepness) << "_doc.SetObject();" << std::endl;
-
-					ctx->writeTabs(code_deepness) << "_p->_addValue(_doc, _doc, \"version\", " << PIDL_JSON_MARSHALLING_VERSION << ");" << std::endl;
-
-					ctx->writeTabs(code_deepness) << "rapidjson::Value _v(rapidjson::kObjectType);" << std::endl;
-					ctx->writeTabs(code_deepness) << "_p->_addValue(_doc, _v, \"name\", \"_dispose_object\");" << std::endl;
-					ctx->writeTabs(code_deepness) << "rapidjson::Value _aa(rapidjson::kObjectType);" << std::endl;
-					ctx->writeTabs(code_deepness) << "_p->_addValue(_doc, _aa, \"object_data\", object_data);" << std::endl;
-					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _v, \"arguments\", _aa);" << std::endl;
-					ctx->writeTabs(code_deepness) << "PIDL::JSONTools::addValue(_doc, _doc, \"function\", _v);" << std::endl;
-					ctx->writeTabs(code_deepness) << "rapidjson::Document _ret;" << std::endl;
-					ctx->writeTabs(code_deepness) << "if (!_p->_invokeCall(_doc, _ret, _ec)) _ec.throwException();" << std::endl;
+					priv->writeDisposeCall(code_deepness, ctx, "_dispose_object", priv->callFields(intf, nullptr, "_dispose_object", std::string(), false));
 					ctx->writeTabs(--code_deepness) << "}" << std::endl << std::endl;
 					break;
 				}
 			}
+			if (priv->batchCalls() && !priv->writeBatch(code_deepness, ctx, intf, ec))
+				return false;
+			if (priv->asyncCalls() && !priv->writeAsync(code_deepness, ctx, intf, ec))
+				return false;
 			break;
 		case Role::Server:
 			break;
@@ -1403,6 +2948,19 @@ namespace PIDL
 			}
 			break;
 		case Role::Server:
+			if (priv->objectTable())
+			{
+				switch (ctx->mode())
+				{
+				case Mode::AllInOne:
+				case Mode::Declaration:
+					ctx->writeTabs(code_deepness) << "enum { _type_id = " << priv->objectTypeId(intf, obj) << " };" << std::endl;
+					ctx->writeTabs(code_deepness) << "virtual int _type() const override final { return _type_id; }" << std::endl;
+					break;
+				case Mode::Implementatinon:
+					break;
+				}
+			}
 			break;
 		}
 
@@ -87,15 +87,21 @@ namespace PIDL
 			JSONTools::addValue(doc, r, "type", v);
 		}
 
-		static rapidjson::Value createType(rapidjson::Document & doc, const Language::Type::Ptr & t)
+		//complex types are written as objects, anything else by its name
+		struct TypeCreator : public Language::Visitor
 		{
-			if (dynamic_cast<Language::Structure*>(t.get()))
+			TypeCreator(rapidjson::Document & doc_, rapidjson::Value & v_) : doc(doc_), v(v_) { }
+
+			rapidjson::Document & doc;
+			rapidjson::Value & v;
+
+			virtual void visit(const Language::Structure & t) override
 			{
-				rapidjson::Value v(rapidjson::kObjectType);
-				addName(doc, v, t->name());
+				v.SetObject();
+				addName(doc, v, t.name());
 
 				rapidjson::Value m(rapidjson::kArrayType);
-				for (auto & memb : dynamic_cast<Language::Structure*>(t.get())->members())
+				for (auto & memb : t.members())
 				{
 					rapidjson::Value e(rapidjson::kObjectType);
 					addName(doc, e, memb->name());
@@ -105,32 +111,36 @@ namespace PIDL
 				}
 
 				JSONTools::addValue(doc, v, "members", m);
-				return v;
 			}
-			else if (dynamic_cast<Language::Array*>(t.get()))
+
+			virtual void visit(const Language::Array & t) override
 			{
-				rapidjson::Value v(rapidjson::kObjectType);
-				addName(doc, v, t->name());
-				addType(doc, v, dynamic_cast<Language::Array*>(t.get())->types().front());
-				return v;
+				v.SetObject();
+				addName(doc, v, t.name());
+				addType(doc, v, t.types().front());
 			}
-			else if (dynamic_cast<Language::Nullable*>(t.get()))
+
+			virtual void visit(const Language::Nullable & t) override
 			{
-				rapidjson::Value v(rapidjson::kObjectType);
-				addName(doc, v, t->name());
-				addType(doc, v, dynamic_cast<Language::Nullable*>(t.get())->types().front());
-				return v;
+				v.SetObject();
+				addName(doc, v, t.name());
+				addType(doc, v, t.types().front());
 			}
-			else if (dynamic_cast<Language::Tuple*>(t.get()))
+
+			virtual void visit(const Language::Tuple & t) override
 			{
-				rapidjson::Value v(rapidjson::kObjectType);
-				addName(doc, v, t->name());
-				addType(doc, v, dynamic_cast<Language::Tuple*>(t.get())->types());
-				return v;
+				v.SetObject();
+				addName(doc, v, t.name());
+				addType(doc, v, t.types());
 			}
+		};
 
+		static rapidjson::Value createType(rapidjson::Document & doc, const Language::Type::Ptr & t)
+		{
 			rapidjson::Value v(rapidjson::kStringType);
 			v.SetString(t->name(), doc.GetAllocator());
+			TypeCreator creator(doc, v);
+			t->accept(creator);
 			return v;
 		}
 
@@ -214,28 +224,28 @@ namespace PIDL
 
 			for (auto & d : o->definitions())
 			{
-                if (dynamic_cast<Language::TypeDefinition*>(d.get()))
+                if (d->kind() == Language::Element::Kind::TypeDefinition)
                 {
                     rapidjson::Value e(rapidjson::kObjectType);
-                    addTypeDefinition(doc, e, std::dynamic_pointer_cast<Language::TypeDefinition>(d));
+                    addTypeDefinition(doc, e, std::static_pointer_cast<Language::TypeDefinition>(d));
                     b.PushBack(e, doc.GetAllocator());
                 }
-                else if (dynamic_cast<Language::Object*>(d.get()))
+                else if (d->kind() == Language::Element::Kind::Object)
                 {
                     rapidjson::Value e(rapidjson::kObjectType);
-                    addObject(doc, e, std::dynamic_pointer_cast<Language::Object>(d));
+                    addObject(doc, e, std::static_pointer_cast<Language::Object>(d));
                     b.PushBack(e, doc.GetAllocator());
                 }
-                else if (dynamic_cast<Language::MethodVariant*>(d.get()))
+                else if (d->kind() == Language::Element::Kind::MethodVariant)
 				{
 					rapidjson::Value e(rapidjson::kObjectType);
-					addMethod(doc, e, std::dynamic_pointer_cast<Language::MethodVariant>(d));
+					addMethod(doc, e, std::static_pointer_cast<Language::MethodVariant>(d));
 					b.PushBack(e, doc.GetAllocator());
 				}
-				else if (dynamic_cast<Language::Property*>(d.get()))
+				else if (d->kind() == Language::Element::Kind::Property)
 				{
 					rapidjson::Value e(rapidjson::kObjectType);
-					addProperty(doc, e, std::dynamic_pointer_cast<Language::Property>(d));
+					addProperty(doc, e, std::static_pointer_cast<Language::Property>(d));
 					b.PushBack(e, doc.GetAllocator());
 				}
 			}
@@ -252,22 +262,22 @@ namespace PIDL
 
 			for (auto & d : intf->definitions())
 			{
-				if (dynamic_cast<Language::TypeDefinition*>(d.get()))
+				if (d->kind() == Language::Element::Kind::TypeDefinition)
 				{
 					rapidjson::Value e(rapidjson::kObjectType);
-					addTypeDefinition(doc, e, std::dynamic_pointer_cast<Language::TypeDefinition>(d));
+					addTypeDefinition(doc, e, std::static_pointer_cast<Language::TypeDefinition>(d));
 					b.PushBack(e, doc.GetAllocator());
 				}
-				else if (dynamic_cast<Language::FunctionVariant*>(d.get()))
+				else if (d->kind() == Language::Element::Kind::FunctionVariant || d->kind() == Language::Element::Kind::MethodVariant)
 				{
 					rapidjson::Value e(rapidjson::kObjectType);
-					addFunction(doc, e, std::dynamic_pointer_cast<Language::FunctionVariant>(d));
+					addFunction(doc, e, std::static_pointer_cast<Language::FunctionVariant>(d));
 					b.PushBack(e, doc.GetAllocator());
 				}
-				else if (dynamic_cast<Language::Object*>(d.get()))
+				else if (d->kind() == Language::Element::Kind::Object)
 				{
 					rapidjson::Value e(rapidjson::kObjectType);
-					addObject(doc, e, std::dynamic_pointer_cast<Language::Object>(d));
+					addObject(doc, e, std::static_pointer_cast<Language::Object>(d));
 					b.PushBack(e, doc.GetAllocator());
 				}
 			}
@@ -311,10 +321,17 @@ namespace PIDL
 		static void addTopLevel(rapidjson::Document & doc, rapidjson::Value & v, const std::shared_ptr<Language::TopLevel> & tl)
 		{
 			rapidjson::Value b(rapidjson::kArrayType);
-			if (dynamic_cast<Language::Interface*>(tl.get()))
-				addInterface(doc, v, std::dynamic_pointer_cast<Language::Interface>(tl));
-			else if (dynamic_cast<Language::Module*>(tl.get()))
-				addModule(doc, v, std::dynamic_pointer_cast<Language::Module>(tl));
+			switch (tl->kind())
+			{
+			case Language::Element::Kind::Interface:
+				addInterface(doc, v, std::static_pointer_cast<Language::Interface>(tl));
+				break;
+			case Language::Element::Kind::Module:
+				addModule(doc, v, std::static_pointer_cast<Language::Module>(tl));
+				break;
+			default:
+				break;
+			}
 		}
 
 		bool write(const std::vector<std::shared_ptr<Language::TopLevel>> & topLevels, ErrorCollector & ec)
@@ -63,6 +63,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Variable::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		const char * Variable::name() const
 		{
 			return priv->name.c_str();
@@ -97,6 +102,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void TypeDefinition::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		const char * TypeDefinition::name() const
 		{
 			return priv->name.c_str();
@@ -132,6 +142,11 @@ namespace PIDL {
 		Blob::Blob() : priv(nullptr) { }
 		Blob::~Blob() = default;
 
+		void Blob::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 
 		struct Generic::Priv
 		{
@@ -171,15 +186,30 @@ namespace PIDL {
 		Nullable::Nullable(const Type::Ptr & type) : Generic(type), priv(nullptr) { }
 		Nullable::~Nullable() = default;
 
+		void Nullable::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		//struct Array::Priv { };
 		Array::Array(const Type::Ptr & type) : Generic(type), priv(nullptr) { }
 		Array::~Array() = default;
 
+		void Array::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 
 		//struct Tuple::Priv { };
 		Tuple::Tuple(const std::vector<Type::Ptr> & types) : Generic(types), priv(nullptr) { }
 		Tuple::~Tuple() = default;
 
+		void Tuple::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 
 		struct Structure::Member::Priv 
 		{
@@ -199,6 +229,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Structure::Member::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		const Structure::Member::Documentation & Structure::Member::documentation() const
 		{
 			return priv->doc;
@@ -234,6 +269,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Structure::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		const std::vector<Structure::Member::Ptr> & Structure::members() const
 		{
 			return priv->members;
@@ -249,14 +289,29 @@ namespace PIDL {
 		Integer::Integer() : priv(nullptr) { }
 		Integer::~Integer() = default;
 
+		void Integer::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		//struct Float::Priv { };
 		Float::Float() : priv(nullptr) { }
 		Float::~Float() = default;
 
+		void Float::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		//struct Boolean::Priv { };
 		Boolean::Boolean() : priv(nullptr) { }
 		Boolean::~Boolean() = default;
 
+		void Boolean::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		//struct EmbeddedType::Priv { };
 		EmbeddedType::EmbeddedType() : priv(nullptr) { }
 		EmbeddedType::~EmbeddedType() = default;
@@ -265,14 +320,29 @@ namespace PIDL {
 		String::String() : priv(nullptr) { }
 		String::~String() = default;
 
+		void String::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		//struct DateTime::Priv { };
 		DateTime::DateTime() : priv(nullptr) { }
 		DateTime::~DateTime() = default;
 
+		void DateTime::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		//struct Void::Priv { };
 		Void::Void() : priv(nullptr) { }
 		Void::~Void() = default;
 
+		void Void::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 
 		struct Function::Variant::Argument::Priv
 		{
@@ -293,6 +363,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Function::Variant::Argument::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		Function::Variant::Argument::Direction Function::Variant::Argument::direction() const
 		{
 			return priv->direction;
@@ -403,6 +478,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void FunctionVariant::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		const char * FunctionVariant::name() const
 		{
 			return priv->name.c_str();
@@ -463,6 +543,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Function::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		const char * Function::name() const
 		{
 			return priv->name.c_str();
@@ -529,6 +614,54 @@ namespace PIDL {
 		DefinitionProvider::DefinitionProvider() : priv(nullptr) { }
 		DefinitionProvider::~DefinitionProvider() = default;
 
+		std::vector<DefinitionProvider::Call> DefinitionProvider::calls() const
+		{
+			std::vector<Call> ret;
+			bool has_objects = false;
+			for (auto & d : definitions())
+			{
+				switch (d->kind())
+				{
+				case Kind::FunctionVariant:
+				case Kind::MethodVariant:
+				{
+					auto function = static_cast<FunctionVariant*>(d.get());
+					ret.push_back({ function, function->name(), function->variantId() });
+					break;
+				}
+				case Kind::Property:
+				{
+					auto property = static_cast<Property*>(d.get());
+					ret.push_back({ property, property->name(), "get" });
+					if (!property->readOnly())
+						ret.push_back({ property, property->name(), "set" });
+					break;
+				}
+				case Kind::Object:
+					has_objects = true;
+					break;
+				default:
+					break;
+				}
+			}
+			if (has_objects && kind() == Kind::Interface)
+				ret.push_back({ nullptr, "_dispose_object", std::string() });
+			return ret;
+		}
+
+		int DefinitionProvider::callId(const std::string & name, const std::string & variant)
+		{
+			//32 bit FNV-1a of 'name/variant' without the sign bit
+			unsigned long h = 2166136261ul;
+			auto add = [&](char c) { h = ((h ^ (unsigned char)c) * 16777619ul) & 0xfffffffful; };
+			for (auto c : name)
+				add(c);
+			add('/');
+			for (auto c : variant)
+				add(c);
+			return (int)(h & 0x7ffffffful);
+		}
+
 
 		struct Interface::Priv
 		{
@@ -571,6 +704,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Interface::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		const std::vector<std::shared_ptr<Definition>> & Interface::definitions() const
 		{
 			return priv->definitions;
@@ -608,6 +746,11 @@ namespace PIDL {
 
 		MethodVariant::~MethodVariant() = default;
 
+		void MethodVariant::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 
 		//struct Method::Priv { };
 
@@ -616,6 +759,11 @@ namespace PIDL {
 
 		Method::~Method() = default;
 
+		void Method::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 
 		struct Property::Priv
 		{
@@ -639,6 +787,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Property::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		Type::Ptr Property::type() const
 		{
 			return priv->type;
@@ -704,6 +857,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Object::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
         void Object::init(const std::vector<std::string> & scope, const Documentation & doc, const std::string & loggerName)
         {
             priv->scope = scope;
@@ -779,6 +937,11 @@ namespace PIDL {
 			delete priv;
 		}
 
+		void Module::accept(Visitor & visitor) const
+		{
+			visitor.visit(*this);
+		}
+
 		const char * Module::name() const
 		{
 			return priv->name.c_str();
@@ -794,4 +957,31 @@ namespace PIDL {
 			return priv->doc;
 		}
 
+
+		Visitor::~Visitor() = default;
+
+		void Visitor::visit(const TypeDefinition &) { }
+		void Visitor::visit(const Nullable &) { }
+		void Visitor::visit(const Array &) { }
+		void Visitor::visit(const Tuple &) { }
+		void Visitor::visit(const Structure &) { }
+		void Visitor::visit(const Structure::Member &) { }
+		void Visitor::visit(const Integer &) { }
+		void Visitor::visit(const Float &) { }
+		void Visitor::visit(const Boolean &) { }
+		void Visitor::visit(const String &) { }
+		void Visitor::visit(const DateTime &) { }
+		void Visitor::visit(const Blob &) { }
+		void Visitor::visit(const Void &) { }
+		void Visitor::visit(const Variable &) { }
+		void Visitor::visit(const FunctionVariant &) { }
+		void Visitor::visit(const FunctionVariant::Argument &) { }
+		void Visitor::visit(const Function &) { }
+		void Visitor::visit(const MethodVariant &) { }
+		void Visitor::visit(const Method &) { }
+		void Visitor::visit(const Property &) { }
+		void Visitor::visit(const Object &) { }
+		void Visitor::visit(const Interface &) { }
+		void Visitor::visit(const Module &) { }
+
 }}
@@ -27,11 +27,13 @@
 #include "include/pidlBackend/cswriter.h"
 #include "include/pidlBackend/jsonwriter.h"
 #include "include/pidlBackend/json_stl_codegen.h"
+#include "include/pidlBackend/binary_stl_codegen.h"
 #include "include/pidlBackend/json_cscodegen.h"
 #include "include/pidlBackend/operationfactory_json.h"
 #include "include/pidlBackend/cstyledocumentationfactory_json.h"
 #include "include/pidlBackend/language.h"
 #include "include/pidlBackend/configreader.h"
+#include "include/pidlBackend/incrementalbuild.h"
 
 #include <pidlCore/errorcollector.h>
 #include <pidlCore/jsontools.h>
@@ -83,11 +85,13 @@ namespace PIDL {
         std::shared_ptr<ObjectFactoryRegistry_JSON> m_facreg;
         std::shared_ptr<ObjectRegistry> m_objreg;
         std::shared_ptr<ConfigReader> m_config;
+        std::shared_ptr<IncrementalBuild> m_incremental;
     public:
-        Context(const std::shared_ptr<ObjectFactoryRegistry_JSON> & facreg, const std::shared_ptr<ObjectRegistry> & objreg, const std::shared_ptr<ConfigReader> & cr) :
+        Context(const std::shared_ptr<ObjectFactoryRegistry_JSON> & facreg, const std::shared_ptr<ObjectRegistry> & objreg, const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental) :
             m_facreg(facreg),
             m_objreg(objreg),
-            m_config(cr)
+            m_config(cr),
+            m_incremental(incremental)
         { }
 
         template<typename T>
@@ -100,11 +104,14 @@ namespace PIDL {
         bool getCfgValue(const std::string name, Nullable<std::string> & ret, ErrorCollector & ec) const
         {
             std::string tmp;
-            if(m_config->get(name, tmp, ec) == ConfigReader::Status::Error)
+            auto status = m_config->get(name, tmp, ec);
+            if(status == ConfigReader::Status::Error)
             {
                 ret.setNull();
                 return false;
             }
+            if(m_incremental)
+                m_incremental->addInput(status == ConfigReader::Status::OK ? name + "=" + tmp : name);
             ret = tmp;
             return true;
         }
@@ -112,11 +119,14 @@ namespace PIDL {
         bool getCfgValue(const std::string name, Nullable<long long> & ret, ErrorCollector & ec) const
         {
             long long tmp;
-            if(m_config->get(name, tmp, ec) == ConfigReader::Status::Error)
+            auto status = m_config->get(name, tmp, ec);
+            if(status == ConfigReader::Status::Error)
             {
                 ret.setNull();
                 return false;
             }
+            if(m_incremental)
+                m_incremental->addInput(status == ConfigReader::Status::OK ? name + "=" + std::to_string(tmp) : name);
             ret = tmp;
             return true;
         }
@@ -124,11 +134,14 @@ namespace PIDL {
         bool getCfgValue(const std::string & name, Nullable<int> & ret, ErrorCollector & ec) const
         {
             long long tmp;
-            if(m_config->get(name, tmp, ec) == ConfigReader::Status::Error)
+            auto status = m_config->get(name, tmp, ec);
+            if(status == ConfigReader::Status::Error)
             {
                 ret.setNull();
                 return false;
             }
+            if(m_incremental)
+                m_incremental->addInput(status == ConfigReader::Status::OK ? name + "=" + std::to_string(tmp) : name);
             ret = static_cast<int>(tmp);
             return true;
         }
@@ -136,11 +149,14 @@ namespace PIDL {
         bool getCfgValue(const std::string & name, Nullable<bool> & ret, ErrorCollector & ec) const
         {
             bool tmp;
-            if(m_config->get(name, tmp, ec) == ConfigReader::Status::Error)
+            auto status = m_config->get(name, tmp, ec);
+            if(status == ConfigReader::Status::Error)
             {
                 ret.setNull();
                 return false;
             }
+            if(m_incremental)
+                m_incremental->addInput(status == ConfigReader::Status::OK ? name + "=" + std::to_string(tmp) : name);
             ret = tmp;
             return true;
         }
@@ -375,6 +391,12 @@ namespace PIDL {
 					if (!getValue(r, "filename", filename, ec))
 						return false;
 
+					if (m_incremental)
+					{
+						o = m_incremental->output(filename);
+						return true;
+					}
+
 					auto file = std::make_shared<std::ofstream>();
 					file->open(filename, std::ios::binary);
 					if (file->fail())
@@ -417,6 +439,9 @@ namespace PIDL {
 					return false;
 				}
 
+				if (m_incremental)
+					m_incremental->addInput(str);
+
 				return true;
 			}
 
@@ -893,6 +918,30 @@ namespace PIDL {
                     {
                         if(str == "use_optional")
                             flags.insert(JSON_STL_CodeGen::Flag::UseOptional);
+                        else if(str == "sax_unmarshalling")
+                            flags.insert(JSON_STL_CodeGen::Flag::SAXUnmarshalling);
+                        else if(str == "writer_marshalling")
+                            flags.insert(JSON_STL_CodeGen::Flag::WriterMarshalling);
+                        else if(str == "document_pool")
+                            flags.insert(JSON_STL_CodeGen::Flag::DocumentPool);
+                        else if(str == "worker_pool")
+                            flags.insert(JSON_STL_CodeGen::Flag::WorkerPool);
+                        else if(str == "instrumentation")
+                            flags.insert(JSON_STL_CodeGen::Flag::Instrumentation);
+                        else if(str == "function_ids")
+                            flags.insert(JSON_STL_CodeGen::Flag::FunctionIds);
+                        else if(str == "batch_calls")
+                            flags.insert(JSON_STL_CodeGen::Flag::BatchCalls);
+                        else if(str == "async_calls")
+                            flags.insert(JSON_STL_CodeGen::Flag::AsyncCalls);
+                        else if(str == "object_table")
+                            flags.insert(JSON_STL_CodeGen::Flag::ObjectTable);
+                        else if(str == "object_data_changes")
+                            flags.insert(JSON_STL_CodeGen::Flag::ObjectDataChanges);
+                        else if(str == "deferred_disposal")
+                            flags.insert(JSON_STL_CodeGen::Flag::DeferredDisposal);
+                        else if(str == "compact_datetime")
+                            flags.insert(JSON_STL_CodeGen::Flag::CompactDateTime);
                         else
                         {
                             ec.add(-1, std::string() + "unsupported/invalid flag: '"+str+"'");
@@ -916,6 +965,66 @@ namespace PIDL {
 			}
 		};
 
+		class Binary_STL_CodeGenFactory : public CPPCodeGenFactory_JSON
+		{
+			Context ctx;
+		public:
+			Binary_STL_CodeGenFactory(const Context & ctx_) :
+				CPPCodeGenFactory_JSON(),
+				ctx(ctx_)
+			{ }
+
+			virtual ~Binary_STL_CodeGenFactory() = default;
+
+			virtual bool build(const rapidjson::Value & value, std::shared_ptr<CPPCodeGen> & ret, ErrorCollector & ec) override
+			{
+				if(!isValid(value))
+				{
+					ec.add(-1, std::string() + "unexpected: json object is invalid");
+					return false;
+				}
+
+				std::shared_ptr<CPPCodeGenHelper> helper;
+				rapidjson::Value * helper_v;
+				if(JSONTools::getValue(value, "helper", helper_v))
+				{
+					if(!ctx.get_object(*helper_v, helper, ec))
+						return false;
+				}
+				else
+					helper = std::make_shared<CPPBasicCodeGenHelper>();
+
+				std::set<Binary_STL_CodeGen::Flag> flags;
+				std::vector<std::string> strl;
+				if(ctx.getExistingValue(value, "flags", strl, ec))
+				{
+					for(auto & str : strl)
+					{
+						if(str == "use_optional")
+							flags.insert(Binary_STL_CodeGen::Flag::UseOptional);
+						else
+						{
+							ec.add(-1, std::string() + "unsupported/invalid flag: '"+str+"'");
+							return false;
+						}
+					}
+				}
+
+				ret = std::make_shared<Binary_STL_CodeGen>(helper, flags);
+
+				return true;
+			}
+
+			virtual bool isValid(const rapidjson::Value & value) const override
+			{
+				std::string type_str;
+				if(!value.IsObject() || !JSONTools::getValue(value, "type", type_str))
+					return false;
+
+				return type_str == "binary_stl";
+			}
+		};
+
 		class JSON_CSCodeGenFactory : public CSCodeGenFactory_JSON
 		{
 			Context ctx;
@@ -945,7 +1054,23 @@ namespace PIDL {
 				else
 					helper = std::make_shared<CSBasicCodeGenHelper>();
 
-				ret = std::make_shared<JSON_CSCodeGen>(helper);
+				std::set<JSON_CSCodeGen::Flag> flags;
+				std::vector<std::string> strl;
+				if(ctx.getExistingValue(value, "flags", strl, ec))
+				{
+					for(auto & str : strl)
+					{
+						if(str == "function_ids")
+							flags.insert(JSON_CSCodeGen::Flag::FunctionIds);
+						else
+						{
+							ec.add(-1, std::string() + "unsupported/invalid flag: '"+str+"'");
+							return false;
+						}
+					}
+				}
+
+				ret = std::make_shared<JSON_CSCodeGen>(helper, flags);
 
 				return true;
 			}
@@ -976,6 +1101,8 @@ namespace PIDL {
 
 					std::string moduleSuffix;
 					std::string interfaceSuffix;
+
+					std::string instrumentationRegistry;
 				};
 
 				CustomCPPHelper(const Settings & settings_) : settings(settings_)
@@ -1005,14 +1132,14 @@ namespace PIDL {
 
 				virtual std::string getName(const Language::TopLevel * t) const override
 				{
-					if (dynamic_cast<const Language::Interface*>(t))
+					if (t->kind() == Language::Element::Kind::Interface)
 						return settings.interfaceSuffix.length() ? (t->name() + settings.interfaceSuffix) : t->name();
 
-                    if (auto mod = dynamic_cast<const Language::Module*>(t))
+                    if (t->kind() == Language::Element::Kind::Module)
                     {
-                        for(auto & e : mod->elements())
+                        for(auto & e : static_cast<const Language::Module*>(t)->elements())
                         {
-                            if(std::dynamic_pointer_cast<Language::Interface>(e)) //apply suffix only when the module has interface(s)
+                            if(e->kind() == Language::Element::Kind::Interface) //apply suffix only when the module has interface(s)
                                 return settings.moduleSuffix.length() ? (t->name() + settings.moduleSuffix) : t->name();
                         }
                     }
@@ -1020,6 +1147,11 @@ namespace PIDL {
 					return t->name();
 				}
 
+				virtual std::string instrumentationRegistry() const override
+				{
+					return settings.instrumentationRegistry.length() ? settings.instrumentationRegistry : CPPCodeGenHelper::instrumentationRegistry();
+				}
+
 			private:
 				Settings settings;
 			};
@@ -1099,6 +1231,9 @@ namespace PIDL {
 				if (!ctx.getValueOptional(r, "interfaceSuffix", settings.interfaceSuffix, ec))
 					return false;
 
+				if (!ctx.getValueOptional(r, "instrumentationRegistry", settings.instrumentationRegistry, ec))
+					return false;
+
 				ret = std::make_shared<CustomCPPHelper>(settings);
 
 				return true;
@@ -1147,10 +1282,10 @@ namespace PIDL {
 
 				virtual std::string getName(const Language::TopLevel * t) const
 				{
-					if (dynamic_cast<const Language::Interface*>(t))
+					if (t->kind() == Language::Element::Kind::Interface)
 						return settings.interfaceSuffix.length() ? (t->name() + settings.interfaceSuffix) : t->name();
 
-					if (dynamic_cast<const Language::Module*>(t))
+					if (t->kind() == Language::Element::Kind::Module)
 						return settings.moduleSuffix.length() ? (t->name() + settings.moduleSuffix) : t->name();
 
 					return t->name();
@@ -1422,6 +1557,72 @@ namespace PIDL {
 
 		};
 
+		class ParallelOperationGroupFactory : public OperationFactory_JSON
+		{
+			Context ctx;
+
+		public:
+			ParallelOperationGroupFactory(const Context & ctx_) :
+				OperationFactory_JSON(),
+				ctx(ctx_)
+			{ }
+
+			virtual ~ParallelOperationGroupFactory() = default;
+
+			virtual bool build(const rapidjson::Value & r, std::shared_ptr<Operation> & ret, ErrorCollector & ec) override
+			{
+				if (!isValid(r))
+				{
+					ec << "unexpected: json object is invalid";
+					return false;
+				}
+
+				rapidjson::Value * ops_v;
+				if (!JSONTools::getValue(r, "operations", ops_v))
+				{
+					ec << "value 'operations' is not found";
+					return false;
+				}
+				if (!ops_v->IsArray())
+				{
+					ec << "value 'operations' is not array";
+					return false;
+				}
+
+				unsigned int threads = 0;
+				rapidjson::Value * threads_v;
+				if (JSONTools::getValue(r, "threads", threads_v) && !JSONTools::getValue(*threads_v, threads))
+				{
+					ec << "value 'threads' is not unsigned integer";
+					return false;
+				}
+
+				std::vector<std::shared_ptr<Operation>> ops(ops_v->Size());
+				bool has_error = false;
+				for (rapidjson::SizeType i = 0, l = ops_v->Size(); i < l; ++i)
+				{
+					if (!ctx.get_object((*ops_v)[i], ops[i], ec))
+						has_error = true;
+				}
+				if (has_error)
+					return false;
+
+				ret = std::make_shared<ParallelOperationGroup>(ops, threads);
+
+				return true;
+			}
+
+			virtual bool isValid(const rapidjson::Value & value) const override
+			{
+				std::string nature_str;
+				if (!value.IsObject() || !JSONTools::getValue(value, "nature", nature_str))
+					return false;
+
+				return nature_str == "parallel_group";
+			}
+
+		};
+
 		class MessageFactory : public OperationFactory_JSON
 		{
 			Context ctx;
@@ -1497,11 +1698,11 @@ namespace PIDL {
 	}
 
 	//static
-    std::shared_ptr<ObjectFactoryRegistry_JSON> ObjectFactoryRegistry_JSON::build(const std::shared_ptr<ObjectRegistry> & objreg, const std::shared_ptr<ConfigReader> & cr)
+    std::shared_ptr<ObjectFactoryRegistry_JSON> ObjectFactoryRegistry_JSON::build(const std::shared_ptr<ObjectRegistry> & objreg, const std::shared_ptr<ConfigReader> & cr, const std::shared_ptr<IncrementalBuild> & incremental)
 	{
 		auto ret = std::make_shared<ObjectFactoryRegistry_JSON>();
 
-        Factories_JSON::Context ctx(ret, objreg, cr);
+        Factories_JSON::Context ctx(ret, objreg, cr, incremental);
 
 		ret->add(std::make_shared<Factories_JSON::CPPWriterFactory>(ctx));
 		ret->add(std::make_shared<Factories_JSON::CSWriterFactory>(ctx));
@@ -1518,12 +1719,14 @@ namespace PIDL {
 		ret->add(std::make_shared<Factories_JSON::CStyleDoxygenDocumentationFactory>(ctx));
 
 		ret->add(std::make_shared<Factories_JSON::JSON_STL_CodeGenFactory>(ctx));
+		ret->add(std::make_shared<Factories_JSON::Binary_STL_CodeGenFactory>(ctx));
 		ret->add(std::make_shared<Factories_JSON::JSON_CSCodeGenFactory>(ctx));
 
 		ret->add(std::make_shared<Factories_JSON::CustomCPPHelperFactory>(ctx));
 		ret->add(std::make_shared<Factories_JSON::CustomCSHelperFactory>(ctx));
 
 		ret->add(std::make_shared<Factories_JSON::OperationGroupFactory>(ctx));
+		ret->add(std::make_shared<Factories_JSON::ParallelOperationGroupFactory>(ctx));
 		ret->add(std::make_shared<Factories_JSON::ReadFactory>(ctx));
 		ret->add(std::make_shared<Factories_JSON::WriteFactory>(ctx));
 		ret->add(std::make_shared<Factories_JSON::MessageFactory>(ctx));
@@ -20,6 +20,12 @@
 #include "include/pidlBackend/writer.h"
 #include "include/pidlBackend/reader.h"
 
+#include <pidlCore/errorcollector.h>
+#include <pidlCore/workerpool.h>
+
+#include <mutex>
+#include <utility>
+
 namespace PIDL {
 
 	//struct Operation::Priv { }
@@ -55,12 +61,91 @@ namespace PIDL {
 	}
 
 
+	struct ParallelOperationGroup::Priv
+	{
+		Priv(const std::vector<std::shared_ptr<Operation>> & ops_, size_t threads_) : ops(ops_), threads(threads_)
+		{ }
+
+		class BufferedErrorCollector : public ErrorCollector
+		{
+		public:
+			std::vector<std::pair<long, std::string>> errors;
+		protected:
+			virtual void append(long errorCode, const std::string & errorText) override
+			{
+				errors.push_back(std::make_pair(errorCode, errorText));
+			}
+		};
+
+		std::vector<std::shared_ptr<Operation>> ops;
+		size_t threads;
+	};
+
+	ParallelOperationGroup::ParallelOperationGroup(const std::vector<std::shared_ptr<Operation>> & ops, size_t threads) :
+		Operation(),
+		priv(new Priv(ops, threads))
+	{ }
+
+	ParallelOperationGroup::~ParallelOperationGroup()
+	{
+		delete priv;
+	}
+
+	bool ParallelOperationGroup::run(ErrorCollector & ec)
+	{
+		// every read operation, listed or referenced by a write, runs before any writer
+		std::vector<std::shared_ptr<Operation>> rest;
+		for (auto & o : priv->ops)
+		{
+			if (dynamic_cast<Read*>(o.get()))
+			{
+				if (!o->run(ec))
+					return false;
+			}
+			else
+			{
+				auto write = dynamic_cast<Write*>(o.get());
+				if (write && write->readOperation() && !write->readOperation()->run(ec))
+					return false;
+				rest.push_back(o);
+			}
+		}
+
+		std::vector<Priv::BufferedErrorCollector> ecs(rest.size());
+		std::vector<char> results(rest.size(), 0);
+		{
+			WorkerPool pool(priv->threads);
+			for (size_t i = 0; i < rest.size(); ++i)
+				pool.post([&, i]()
+				{
+					auto write = dynamic_cast<Write*>(rest[i].get());
+					results[i] = write ? write->write(ecs[i]) : rest[i]->run(ecs[i]);
+				});
+			pool.wait();
+		}
+
+		// errors are reported in the order of the operations
+		bool ret = true;
+		for (size_t i = 0; i < rest.size(); ++i)
+		{
+			for (auto & e : ecs[i].errors)
+				ec.add(e.first, e.second);
+			if (!results[i])
+				ret = false;
+		}
+
+		return ret;
+	}
+
+
 	struct Read::Priv
 	{
-		Priv(std::shared_ptr<Reader> & reader_) : reader(reader_)
+		Priv(std::shared_ptr<Reader> & reader_) : reader(reader_), done(false)
 		{ }
 
 		std::shared_ptr<Reader> reader;
+		std::mutex mutex;
+		bool done;
 	};
 
 	Read::Read(std::shared_ptr<Reader> & reader) :
@@ -80,7 +165,16 @@ namespace PIDL {
 
 	bool Read::run(ErrorCollector & ec)
 	{
-		return priv->reader->read(ec);
+		std::lock_guard<std::mutex> lock(priv->mutex);
+		if (!priv->done)
+			priv->done = priv->reader->read(ec);
+		return priv->done;
+	}
+
+	void Read::invalidate()
+	{
+		std::lock_guard<std::mutex> lock(priv->mutex);
+		priv->done = false;
 	}
 
 
@@ -107,12 +201,22 @@ namespace PIDL {
 		delete priv;
 	}
 
+	std::shared_ptr<Read> Write::readOperation() const
+	{
+		return priv->read_op;
+	}
+
+	bool Write::write(ErrorCollector & ec)
+	{
+		return priv->writer->write(priv->reader.get(), ec);
+	}
+
 	bool Write::run(ErrorCollector & ec)
 	{
 		if (priv->read_op && !priv->read_op->run(ec))
 			return false;
 
-		return priv->writer->write(priv->reader.get(), ec);
+		return write(ec);
 	}
 
 }
@@ -10,12 +10,14 @@ LIBS += -L../pidlCore -lpidlCore
 INCLUDEPATH += ../pidlCore/include
 
 SOURCES += \
+    binary_stl_codegen.cpp \
     codegencontext.cpp \
     cppcodegen.cpp \
     cppwriter.cpp \
     cscodegen.cpp \
     cstyledocumentation.cpp \
     cswriter.cpp \
+    incrementalbuild.cpp \
     job_json.cpp \
     json_cscodegen.cpp \
     json_stl_codegen.cpp \
@@ -31,6 +33,7 @@ SOURCES += \
     configreader.cpp
 
 HEADERS += \
+    include/pidlBackend/binary_stl_codegen.h \
     include/pidlBackend/codegencontext.h \
     include/pidlBackend/config.h \
     include/pidlBackend/cppcodegen.h \
@@ -41,6 +44,7 @@ HEADERS += \
     include/pidlBackend/cstyledocumentation.h \
     include/pidlBackend/cstyledocumentationfactory_json.h \
     include/pidlBackend/cswriter.h \
+    include/pidlBackend/incrementalbuild.h \
     include/pidlBackend/job_json.h \
     include/pidlBackend/json_cscodegen.h \
     include/pidlBackend/json_stl_codegen.h \
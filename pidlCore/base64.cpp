@@ -0,0 +1,449 @@
+
+#include "include/pidlCore/base64.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define PIDL_BASE64__X86
+#  define PIDL_BASE64__TARGET(t) __attribute__((target(t)))
+#  include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  define PIDL_BASE64__X86
+#  define PIDL_BASE64__TARGET(t)
+#  include <intrin.h>
+#  include <immintrin.h>
+#endif
+
+namespace PIDL { namespace Base64 {
+
+	namespace {
+
+		const char encode_table[] =
+			"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+			"abcdefghijklmnopqrstuvwxyz"
+			"0123456789+/";
+
+		const unsigned char invalid = 0xff;
+
+		struct DecodeTable
+		{
+			unsigned char values[256];
+			DecodeTable()
+			{
+				memset(values, invalid, sizeof(values));
+				for (unsigned char i = 0; i < 64; ++i)
+					values[static_cast<unsigned char>(encode_table[i])] = i;
+			}
+		};
+
+		const DecodeTable decode_table;
+
+		// encodes complete triplets, returns the number of consumed input bytes
+		size_t encode_scalar(const unsigned char * in, size_t size, char * out)
+		{
+			size_t i = 0;
+			for (; i + 3 <= size; i += 3, out += 4)
+			{
+				uint32_t v = (uint32_t(in[i]) << 16) | (uint32_t(in[i + 1]) << 8) | in[i + 2];
+				out[0] = encode_table[(v >> 18) & 0x3f];
+				out[1] = encode_table[(v >> 12) & 0x3f];
+				out[2] = encode_table[(v >> 6) & 0x3f];
+				out[3] = encode_table[v & 0x3f];
+			}
+			return i;
+		}
+
+		void encode_tail(const unsigned char * in, size_t size, char * out)
+		{
+			switch (size)
+			{
+			case 1:
+				out[0] = encode_table[in[0] >> 2];
+				out[1] = encode_table[(in[0] & 0x03) << 4];
+				out[2] = '=';
+				out[3] = '=';
+				break;
+			case 2:
+				out[0] = encode_table[in[0] >> 2];
+				out[1] = encode_table[((in[0] & 0x03) << 4) | (in[1] >> 4)];
+				out[2] = encode_table[(in[1] & 0x0f) << 2];
+				out[3] = '=';
+				break;
+			}
+		}
+
+		// decodes complete quads without padding, returns false on invalid character
+		bool decode_scalar(const unsigned char * in, size_t length, unsigned char * out)
+		{
+			const unsigned char * t = decode_table.values;
+			for (size_t i = 0; i < length; i += 4, out += 3)
+			{
+				unsigned char a = t[in[i]], b = t[in[i + 1]], c = t[in[i + 2]], d = t[in[i + 3]];
+				if ((a | b | c | d) & 0x80)
+					return false;
+				uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | d;
+				out[0] = static_cast<unsigned char>(v >> 16);
+				out[1] = static_cast<unsigned char>(v >> 8);
+				out[2] = static_cast<unsigned char>(v);
+			}
+			return true;
+		}
+
+		// last quad, may contain padding; unused bits must be zero
+		bool decode_tail(const unsigned char * in, unsigned char * out)
+		{
+			const unsigned char * t = decode_table.values;
+			if (in[3] != '=')
+				return decode_scalar(in, 4, out);
+
+			unsigned char a = t[in[0]], b = t[in[1]];
+			if ((a | b) & 0x80)
+				return false;
+			if (in[2] == '=')
+			{
+				if (b & 0x0f)
+					return false;
+				out[0] = static_cast<unsigned char>((a << 2) | (b >> 4));
+				return true;
+			}
+
+			unsigned char c = t[in[2]];
+			if ((c & 0x80) || (c & 0x03))
+				return false;
+			out[0] = static_cast<unsigned char>((a << 2) | (b >> 4));
+			out[1] = static_cast<unsigned char>((b << 4) | (c >> 2));
+			return true;
+		}
+
+#ifdef PIDL_BASE64__X86
+		// vectorized lookups after W. Mula, D. Lemire: "Faster Base64 Encoding and Decoding Using AVX2 Instructions"
+
+		PIDL_BASE64__TARGET("sse4.1")
+		inline __m128i enc_reshuffle(__m128i in)
+		{
+			in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+			const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+			const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+			const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+			const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+			return _mm_or_si128(t1, t3);
+		}
+
+		PIDL_BASE64__TARGET("sse4.1")
+		inline __m128i enc_translate(__m128i in)
+		{
+			const __m128i lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+				'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+			__m128i idx = _mm_subs_epu8(in, _mm_set1_epi8(51));
+			const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), in);
+			idx = _mm_or_si128(idx, _mm_and_si128(less, _mm_set1_epi8(13)));
+			return _mm_add_epi8(_mm_shuffle_epi8(lut, idx), in);
+		}
+
+		// returns the sextet values, sets 'error' lanes for characters outside the alphabet
+		PIDL_BASE64__TARGET("sse4.1")
+		inline __m128i dec_translate(__m128i in, __m128i & error)
+		{
+			const __m128i shift_lut = _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+			const __m128i mask_lut = _mm_setr_epi8(
+				(char)0xa8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8,
+				(char)0xf8, (char)0xf8, (char)0xf0, 0x54, 0x50, 0x50, 0x50, 0x54);
+			const __m128i bitpos_lut = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0);
+
+			const __m128i hi = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+			const __m128i lo = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+			const __m128i sh = _mm_shuffle_epi8(shift_lut, hi);
+			const __m128i shift = _mm_blendv_epi8(sh, _mm_set1_epi8(16), _mm_cmpeq_epi8(in, _mm_set1_epi8(0x2f)));
+			const __m128i m = _mm_and_si128(_mm_shuffle_epi8(mask_lut, lo), _mm_shuffle_epi8(bitpos_lut, hi));
+			error = _mm_cmpeq_epi8(m, _mm_setzero_si128());
+			return _mm_add_epi8(in, shift);
+		}
+
+		PIDL_BASE64__TARGET("sse4.1")
+		inline __m128i dec_pack(__m128i values)
+		{
+			const __m128i ab_bc = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+			const __m128i abc = _mm_madd_epi16(ab_bc, _mm_set1_epi32(0x00011000));
+			return _mm_shuffle_epi8(abc, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		}
+
+		// each block reads 16 bytes and consumes 12
+		PIDL_BASE64__TARGET("sse4.1")
+		size_t encode_sse41(const unsigned char * in, size_t size, char * out)
+		{
+			size_t i = 0;
+			for (; i + 16 <= size; i += 12, out += 16)
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(out), enc_translate(enc_reshuffle(v)));
+			}
+			return i;
+		}
+
+		// each block consumes 16 characters and writes 16 bytes of which 12 are valid
+		PIDL_BASE64__TARGET("sse4.1")
+		size_t decode_sse41(const unsigned char * in, size_t length, size_t out_size, unsigned char * out, bool & ok)
+		{
+			size_t i = 0;
+			for (; i + 16 <= length && (i / 4 * 3) + 16 <= out_size; i += 16, out += 12)
+			{
+				__m128i error;
+				__m128i v = dec_translate(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), error);
+				if (_mm_movemask_epi8(error))
+				{
+					ok = false;
+					return i;
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(out), dec_pack(v));
+			}
+			ok = true;
+			return i;
+		}
+
+		// each block reads 28 bytes and consumes 24
+		PIDL_BASE64__TARGET("avx2")
+		size_t encode_avx2(const unsigned char * in, size_t size, char * out)
+		{
+			const __m256i shuffle = _mm256_set_epi8(
+				10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+				10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+			const __m256i lut = _mm256_setr_epi8(
+				'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+				'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+				'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+				'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+			size_t i = 0;
+			for (; i + 28 <= size; i += 24, out += 32)
+			{
+				__m256i v = _mm256_inserti128_si256(
+					_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i))),
+					_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 12)), 1);
+				v = _mm256_shuffle_epi8(v, shuffle);
+				const __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00));
+				const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+				const __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0));
+				const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+				const __m256i idx = _mm256_or_si256(t1, t3);
+
+				__m256i r = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+				const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx);
+				r = _mm256_or_si256(r, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+				r = _mm256_add_epi8(_mm256_shuffle_epi8(lut, r), idx);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(out), r);
+			}
+			return i;
+		}
+
+		// each block consumes 32 characters and writes 32 bytes of which 24 are valid
+		PIDL_BASE64__TARGET("avx2")
+		size_t decode_avx2(const unsigned char * in, size_t length, size_t out_size, unsigned char * out, bool & ok)
+		{
+			const __m256i shift_lut = _mm256_setr_epi8(
+				0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+			const __m256i mask_lut = _mm256_setr_epi8(
+				(char)0xa8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8,
+				(char)0xf8, (char)0xf8, (char)0xf0, 0x54, 0x50, 0x50, 0x50, 0x54,
+				(char)0xa8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8,
+				(char)0xf8, (char)0xf8, (char)0xf0, 0x54, 0x50, 0x50, 0x50, 0x54);
+			const __m256i bitpos_lut = _mm256_setr_epi8(
+				0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0,
+				0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0);
+			const __m256i pack_shuffle = _mm256_setr_epi8(
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+			size_t i = 0;
+			for (; i + 32 <= length && (i / 4 * 3) + 32 <= out_size; i += 32, out += 24)
+			{
+				const __m256i in_v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+				const __m256i hi = _mm256_and_si256(_mm256_srli_epi32(in_v, 4), _mm256_set1_epi8(0x0f));
+				const __m256i lo = _mm256_and_si256(in_v, _mm256_set1_epi8(0x0f));
+				const __m256i sh = _mm256_shuffle_epi8(shift_lut, hi);
+				const __m256i shift = _mm256_blendv_epi8(sh, _mm256_set1_epi8(16), _mm256_cmpeq_epi8(in_v, _mm256_set1_epi8(0x2f)));
+				const __m256i m = _mm256_and_si256(_mm256_shuffle_epi8(mask_lut, lo), _mm256_shuffle_epi8(bitpos_lut, hi));
+				if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(m, _mm256_setzero_si256())))
+				{
+					ok = false;
+					return i;
+				}
+				const __m256i values = _mm256_add_epi8(in_v, shift);
+				const __m256i ab_bc = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+				__m256i abc = _mm256_madd_epi16(ab_bc, _mm256_set1_epi32(0x00011000));
+				abc = _mm256_shuffle_epi8(abc, pack_shuffle);
+				abc = _mm256_permutevar8x32_epi32(abc, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(out), abc);
+			}
+			ok = true;
+			return i;
+		}
+
+		struct CPUFeatures
+		{
+			bool sse41 = false;
+			bool avx2 = false;
+			CPUFeatures()
+			{
+#  if defined(__GNUC__)
+				__builtin_cpu_init();
+				sse41 = __builtin_cpu_supports("sse4.1") != 0;
+				avx2 = __builtin_cpu_supports("avx2") != 0;
+#  else
+				int info[4];
+				__cpuid(info, 0);
+				int max_leaf = info[0];
+				__cpuid(info, 1);
+				sse41 = (info[2] & (1 << 19)) != 0;
+				bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+				if (os_avx && max_leaf >= 7)
+				{
+					__cpuidex(info, 7, 0);
+					avx2 = (info[1] & (1 << 5)) != 0;
+				}
+#  endif
+			}
+		};
+
+		const CPUFeatures & cpuFeatures()
+		{
+			static CPUFeatures features;
+			return features;
+		}
+#endif
+
+	}
+
+	extern PIDL_CORE__FUNCTION bool isSupported(Engine engine)
+	{
+		switch (engine)
+		{
+		case Engine::Scalar:
+			return true;
+#ifdef PIDL_BASE64__X86
+		case Engine::SSE41:
+			return cpuFeatures().sse41;
+		case Engine::AVX2:
+			return cpuFeatures().avx2;
+#else
+		case Engine::SSE41:
+		case Engine::AVX2:
+			break;
+#endif
+		}
+		return false;
+	}
+
+	extern PIDL_CORE__FUNCTION Engine engine()
+	{
+		static const Engine best =
+			isSupported(Engine::AVX2) ? Engine::AVX2 :
+			isSupported(Engine::SSE41) ? Engine::SSE41 :
+			Engine::Scalar;
+		return best;
+	}
+
+	extern PIDL_CORE__FUNCTION void encode(Engine engine, const char * data, size_t size, char * out)
+	{
+		auto in = reinterpret_cast<const unsigned char *>(data);
+		size_t done = 0;
+#ifdef PIDL_BASE64__X86
+		switch (engine)
+		{
+		case Engine::AVX2:
+			done = encode_avx2(in, size, out);
+			break;
+		case Engine::SSE41:
+			done = encode_sse41(in, size, out);
+			break;
+		case Engine::Scalar:
+			break;
+		}
+#else
+		(void)engine;
+#endif
+		out += done / 3 * 4;
+		size_t rest = encode_scalar(in + done, size - done, out);
+		encode_tail(in + done + rest, size - done - rest, out + rest / 3 * 4);
+	}
+
+	extern PIDL_CORE__FUNCTION void encode(const char * data, size_t size, char * out)
+	{
+		encode(engine(), data, size, out);
+	}
+
+	extern PIDL_CORE__FUNCTION bool decodedLength(const char * data, size_t length, size_t & ret)
+	{
+		if (length % 4)
+			return false;
+		ret = length / 4 * 3;
+		if (length)
+		{
+			if (data[length - 1] == '=')
+				--ret;
+			if (data[length - 2] == '=')
+				--ret;
+		}
+		return true;
+	}
+
+	extern PIDL_CORE__FUNCTION bool decode(Engine engine, const char * data, size_t length, char * out)
+	{
+		size_t out_size;
+		if (!decodedLength(data, length, out_size))
+			return false;
+		if (!length)
+			return true;
+
+		auto in = reinterpret_cast<const unsigned char *>(data);
+		auto o = reinterpret_cast<unsigned char *>(out);
+		// the last quad may hold padding, it is always decoded by decode_tail
+		size_t body = length - 4;
+		size_t done = 0;
+#ifdef PIDL_BASE64__X86
+		bool ok = true;
+		switch (engine)
+		{
+		case Engine::AVX2:
+			done = decode_avx2(in, body, out_size, o, ok);
+			break;
+		case Engine::SSE41:
+			done = decode_sse41(in, body, out_size, o, ok);
+			break;
+		case Engine::Scalar:
+			break;
+		}
+		if (!ok)
+			return false;
+#else
+		(void)engine;
+#endif
+		if (!decode_scalar(in + done, body - done, o + done / 4 * 3))
+			return false;
+		return decode_tail(in + body, o + body / 4 * 3);
+	}
+
+	extern PIDL_CORE__FUNCTION bool decode(const char * data, size_t length, char * out)
+	{
+		return decode(engine(), data, length, out);
+	}
+
+	extern PIDL_CORE__FUNCTION std::string & encode(const std::vector<char> & bin, std::string & ret)
+	{
+		ret.resize(encodedLength(bin.size()));
+		if (bin.size())
+			encode(bin.data(), bin.size(), &ret[0]);
+		return ret;
+	}
+
+	extern PIDL_CORE__FUNCTION bool decode(const char * data, size_t length, std::vector<char> & ret)
+	{
+		size_t size;
+		if (!decodedLength(data, length, size))
+			return false;
+		ret.resize(size);
+		return decode(data, length, ret.data());
+	}
+
+}}
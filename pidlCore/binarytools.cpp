@@ -0,0 +1,54 @@
+
+#include "include/pidlCore/binarytools.h"
+
+namespace PIDL { namespace BinaryTools {
+
+	namespace
+	{
+		bool readShort(Reader & r, short & ret)
+		{
+			long long v;
+			if (!r.readVarInt(v) || v < SHRT_MIN || v > SHRT_MAX)
+				return false;
+			ret = static_cast<short>(v);
+			return true;
+		}
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const DateTime & dt)
+	{
+		w.writeVarInt(dt.year);
+		w.writeVarInt(dt.month);
+		w.writeVarInt(dt.day);
+		w.writeVarInt(dt.hour);
+		w.writeVarInt(dt.minute);
+		w.writeVarInt(dt.second);
+		w.writeVarInt(dt.nanosecond);
+		w.writeByte(static_cast<unsigned char>(dt.kind));
+	}
+
+	extern PIDL_CORE__FUNCTION bool readValue(Reader & r, DateTime & ret)
+	{
+		unsigned char kind;
+		if (!readShort(r, ret.year) ||
+			!readShort(r, ret.month) ||
+			!readShort(r, ret.day) ||
+			!readShort(r, ret.hour) ||
+			!readShort(r, ret.minute) ||
+			!readShort(r, ret.second) ||
+			!readValue(r, ret.nanosecond) ||
+			!r.readByte(kind))
+			return false;
+
+		switch (kind)
+		{
+		case DateTime::None:
+		case DateTime::UTC:
+		case DateTime::Local:
+			ret.kind = static_cast<DateTime::Kind>(kind);
+			return true;
+		}
+		return false;
+	}
+
+}}
@@ -2,38 +2,183 @@
 #include "include/pidlCore/datetime.h"
 #include <string.h>
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 namespace PIDL {
     namespace {
-        time_t timeutc (const struct tm *tm)
+        const long long secondsPerDay = 24 * 60 * 60;
+
+        inline long long floorDiv(long long a, long long b)
+        {
+            return a / b - ((a % b) != 0 && ((a < 0) != (b < 0)));
+        }
+
+        // UTC offset of the local time zone in [begin, end) (seconds since epoch)
+        struct ZoneSegment
+        {
+            long long begin;
+            long long end;
+            long offset;
+            bool utc;
+
+            bool contains(long long t) const { return t >= begin && t < end; }
+            bool sameZone(const ZoneSegment & o) const { return offset == o.offset && utc == o.utc; }
+        };
+
+        // The offsets of the local time zone, read from the system once per segment: a miss searches the transitions
+        // around the time by localtime_r and stores the segment in between. The time zone is expected not to be changed
+        // after the first conversion.
+        class LocalZone
+        {
+            std::mutex mutex;
+            std::vector<ZoneSegment> segments;
+
+            static bool probe(long long t, ZoneSegment & ret)
+            {
+                time_t tt = static_cast<time_t>(t);
+                tm tmp;
+                if (!localtime_r(&tt, &tmp))
+                    return false;
+                ret.offset = tmp.tm_gmtoff;
+                ret.utc = tmp.tm_zone && strcmp(tmp.tm_zone, "UTC") == 0;
+                return true;
+            }
+
+            // the transitions are searched week by week up to a year, then by bisection
+            static bool search(long long t, ZoneSegment & ret)
+            {
+                const long long week = 7 * secondsPerDay;
+                const int weeks = 53;
+
+                if (!probe(t, ret))
+                    return false;
+                ZoneSegment tmp;
+                auto same = [&](long long x) { return probe(x, tmp) && tmp.sameZone(ret); };
+                auto bisect = [&](long long in, long long out) {
+                    while (in - out > 1 || out - in > 1)
+                    {
+                        auto mid = in + (out - in) / 2;
+                        if (same(mid))
+                            in = mid;
+                        else
+                            out = mid;
+                    }
+                    return out;
+                };
+
+                ret.begin = t;
+                for (int i = 0; i < weeks; ++i, ret.begin -= week)
+                    if (!same(ret.begin - week))
+                    {
+                        ret.begin = bisect(ret.begin, ret.begin - week) + 1;
+                        break;
+                    }
+
+                long long last = t;
+                for (int i = 0; i < weeks; ++i, last += week)
+                    if (!same(last + week))
+                    {
+                        last = bisect(last, last + week) - 1;
+                        break;
+                    }
+                ret.end = last + 1;
+                return true;
+            }
+
+        public:
+            LocalZone()
+            {
+                tzset();
+            }
+
+            bool segment(long long t, ZoneSegment & ret)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = std::upper_bound(segments.begin(), segments.end(), t, [](long long v, const ZoneSegment & s) { return v < s.begin; });
+                if (it != segments.begin() && (it - 1)->contains(t))
+                {
+                    ret = *(it - 1);
+                    return true;
+                }
+                if (!search(t, ret))
+                    return false;
+
+                //the neighbours of the same zone are merged
+                it = segments.insert(it, ret);
+                if (it + 1 != segments.end() && (it + 1)->begin <= it->end && (it + 1)->sameZone(*it))
+                {
+                    it->end = std::max(it->end, (it + 1)->end);
+                    segments.erase(it + 1);
+                }
+                if (it != segments.begin() && (it - 1)->end >= it->begin && (it - 1)->sameZone(*it))
+                {
+                    (it - 1)->end = std::max(it->end, (it - 1)->end);
+                    it = segments.erase(it) - 1;
+                }
+                ret = *it;
+                return true;
+            }
+
+            static LocalZone & instance()
+            {
+                static LocalZone zone;
+                return zone;
+            }
+        };
+
+        // the last segment used by the thread, looked up without locking
+        bool localSegment(long long t, ZoneSegment & ret)
+        {
+            static thread_local ZoneSegment last = { 0, 0, 0, false };
+            if (!last.contains(t) && !LocalZone::instance().segment(t, last))
+                return false;
+            ret = last;
+            return true;
+        }
+
+        // false if 'local' is ambiguous, skipped, or too close to a transition to be decided here
+        bool localToUTC(long long local, long long & ret)
+        {
+            ZoneSegment s;
+            if (!localSegment(local, s) || !localSegment(local - s.offset, s))
+                return false;
+            ret = local - s.offset;
+            return ret - s.begin >= secondsPerDay && s.end - ret > secondsPerDay;
+        }
+
+        long long secondsFromCivil(const DateTime & dt)
         {
-            auto is_leap = [](int y) {
-                y += 1900;
-                return (y % 4) == 0 && ((y % 100) != 0 || (y % 400) == 0);
-            };
-
-            static const unsigned ndays[2][12] = {
-                {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
-                {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}
-            };
-            time_t res = 0;
-            int i;
-
-            for (i = 70; i < tm->tm_year; ++i)
-                res += is_leap(i) ? 366 : 365;
-
-            for (i = 0; i < tm->tm_mon; ++i)
-                res += ndays[is_leap(tm->tm_year)][i];
-            res += tm->tm_mday - 1;
-            res *= 24;
-            res += tm->tm_hour;
-            res *= 60;
-            res += tm->tm_min;
-            res *= 60;
-            res += tm->tm_sec;
-            return res;
+            return daysFromCivil(dt.year, dt.month, dt.day) * secondsPerDay + dt.hour * 3600LL + dt.minute * 60LL + dt.second;
         }
     }
 
+    extern PIDL_CORE__FUNCTION long long daysFromCivil(long long year, long long month, long long day)
+    {
+        year += floorDiv(month - 1, 12);
+        month -= floorDiv(month - 1, 12) * 12;
+        year -= month <= 2;
+        auto era = floorDiv(year, 400);
+        auto yoe = year - era * 400;
+        auto doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    extern PIDL_CORE__FUNCTION void civilFromDays(long long days, long long & year, int & month, int & day)
+    {
+        days += 719468;
+        auto era = floorDiv(days, 146097);
+        auto doe = days - era * 146097;
+        auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        auto mp = (5 * doy + 2) / 153;
+        day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+        month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        year = yoe + era * 400 + (month <= 2);
+    }
+
     extern PIDL_CORE__FUNCTION bool fromDateTime(const DateTime & dt, tm & ret)
 	{
         std::chrono::system_clock::time_point tmp;
@@ -50,32 +195,39 @@ namespace PIDL {
 
     extern PIDL_CORE__FUNCTION bool fromDateTime(const DateTime & dt, std::chrono::system_clock::time_point & ret)
     {
-        tm tmp;
-        memset(&tmp, 0, sizeof(tm));
-
-        tmp.tm_year = dt.year - 1900;
-        tmp.tm_mon = dt.month - 1;
-        tmp.tm_mday = dt.day;
-        tmp.tm_hour = dt.hour;
-        tmp.tm_min = dt.minute;
-        tmp.tm_sec = dt.second;
-        tmp.tm_isdst = -1;
-
+        long long t;
         switch(dt.kind)
         {
         case DateTime::UTC:
-            tmp.tm_zone = "UTC";
-            ret = std::chrono::system_clock::time_point(std::chrono::seconds(timeutc(&tmp)));
+            if(dt.month < 1)
+                return false;
+            ret = std::chrono::system_clock::time_point(std::chrono::seconds(secondsFromCivil(dt)));
             break;
         case DateTime::None:
         case DateTime::Local:
-            ret = std::chrono::system_clock::time_point(std::chrono::seconds(mktime(&tmp)));
+            if(localToUTC(secondsFromCivil(dt), t))
+                ret = std::chrono::system_clock::time_point(std::chrono::seconds(t));
+            else
+            {
+                //around the transitions it is left to mktime()
+                tm tmp;
+                memset(&tmp, 0, sizeof(tm));
+
+                tmp.tm_year = dt.year - 1900;
+                tmp.tm_mon = dt.month - 1;
+                tmp.tm_mday = dt.day;
+                tmp.tm_hour = dt.hour;
+                tmp.tm_min = dt.minute;
+                tmp.tm_sec = dt.second;
+                tmp.tm_isdst = -1;
+
+                ret = std::chrono::system_clock::time_point(std::chrono::seconds(mktime(&tmp)));
+                if(tmp.tm_mon < 0)
+                    return false;
+            }
             break;
         }
 
-        if(tmp.tm_mon < 0)
-            return false;
-
         ret += std::chrono::nanoseconds(dt.nanosecond);
 
         return true;
@@ -124,13 +276,51 @@ namespace PIDL {
     extern PIDL_CORE__FUNCTION bool toDateTime(std::chrono::system_clock::time_point t, DateTime & ret)
     {
         time_t tt = std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
-        auto tmp = localtime(&tt);
 
-        if(!toDateTime(*tmp, ret))
-            return false;
+        ZoneSegment s;
+        if(localSegment(tt, s))
+        {
+            auto local = static_cast<long long>(tt) + s.offset;
+            auto days = floorDiv(local, secondsPerDay);
+            auto seconds = local - days * secondsPerDay;
+            long long year;
+            int month, day;
+            civilFromDays(days, year, month, day);
+            ret.year = static_cast<short>(year);
+            ret.month = static_cast<short>(month);
+            ret.day = static_cast<short>(day);
+            ret.hour = static_cast<short>(seconds / 3600);
+            ret.minute = static_cast<short>(seconds / 60 % 60);
+            ret.second = static_cast<short>(seconds % 60);
+            ret.kind = s.utc ? DateTime::UTC : DateTime::Local;
+        }
+        else
+        {
+            tm tmp;
+            if(!localtime_r(&tt, &tmp) || !toDateTime(tmp, ret))
+                return false;
+        }
 
         ret.nanosecond = static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch() - std::chrono::seconds(tt)).count());
 
         return true;
     }
+
+    extern PIDL_CORE__FUNCTION bool toTimepoints(const DateTime * dts, size_t count, std::chrono::system_clock::time_point * ret)
+    {
+        bool ok = true;
+        for (size_t i = 0; i < count; ++i)
+            if (!fromDateTime(dts[i], ret[i]))
+                ok = false;
+        return ok;
+    }
+
+    extern PIDL_CORE__FUNCTION bool toDateTimes(const std::chrono::system_clock::time_point * ts, size_t count, DateTime * ret)
+    {
+        bool ok = true;
+        for (size_t i = 0; i < count; ++i)
+            if (!toDateTime(ts[i], ret[i]))
+                ok = false;
+        return ok;
+    }
 }
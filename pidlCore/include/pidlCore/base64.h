@@ -0,0 +1,64 @@
+/*
+    This file is part of pidlCore.
+
+    pidlCore is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlCore is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlCore.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef pidlCore__base64_h
+#define pidlCore__base64_h
+
+#include "config.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace PIDL { namespace Base64 {
+
+	// Base64 codec (RFC 4648, standard alphabet, padded) used for blob marshalling.
+	// Vectorized engines are selected at runtime by CPU support; every engine produces
+	// the very same output as the scalar one.
+	enum class Engine
+	{
+		Scalar,
+		SSE41,
+		AVX2
+	};
+
+	extern PIDL_CORE__FUNCTION bool isSupported(Engine engine);
+	// the fastest engine supported by the running CPU
+	extern PIDL_CORE__FUNCTION Engine engine();
+
+	inline size_t encodedLength(size_t size) { return (size + 2) / 3 * 4; }
+
+	// 'out' must point to at least encodedLength(size) bytes
+	extern PIDL_CORE__FUNCTION void encode(const char * data, size_t size, char * out);
+	extern PIDL_CORE__FUNCTION void encode(Engine engine, const char * data, size_t size, char * out);
+
+	// returns false if 'length' is not a valid padded base64 length
+	extern PIDL_CORE__FUNCTION bool decodedLength(const char * data, size_t length, size_t & ret);
+
+	// 'out' must point to at least decodedLength() bytes; returns false on any invalid character or padding
+	extern PIDL_CORE__FUNCTION bool decode(const char * data, size_t length, char * out);
+	extern PIDL_CORE__FUNCTION bool decode(Engine engine, const char * data, size_t length, char * out);
+
+	extern PIDL_CORE__FUNCTION std::string & encode(const std::vector<char> & bin, std::string & ret);
+
+	extern PIDL_CORE__FUNCTION bool decode(const char * data, size_t length, std::vector<char> & ret);
+
+	inline bool decode(const std::string & str, std::vector<char> & ret) { return decode(str.data(), str.length(), ret); }
+
+}}
+
+#endif // pidlCore__base64_h
@@ -0,0 +1,423 @@
+/*
+    This file is part of pidlCore.
+
+    pidlCore is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlCore is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlCore.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef pidlCore__binarytools_h
+#define pidlCore__binarytools_h
+
+#include "config.h"
+#include "nullable.h"
+#include "datetime.h"
+
+#include <climits>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <vector>
+#ifdef PIDL__HAS_OPTIONAL
+#  include <optional>
+#endif
+
+namespace PIDL { namespace BinaryTools {
+
+	// Compact binary marshalling. The layout is defined by the IDL, so nothing but the values is written:
+	//  - integers are LEB128 varints, signed ones are zigzag encoded
+	//  - floating point numbers are 8 bytes, little endian
+	//  - strings and blobs are a varint length followed by the raw bytes
+	//  - nullable values are a 0/1 byte followed by the value, arrays are a varint count followed by the items
+	//  - tuples and structures are their items in order of declaration
+
+	typedef std::vector<char> Buffer;
+
+	// the byte after the version in a request
+	enum Call : unsigned char
+	{
+		FunctionCall = 0,
+		ObjectCall = 1
+	};
+
+	// the byte after the object data in an object call
+	enum ObjectCallKind : unsigned char
+	{
+		MethodCall = 0,
+		PropertyGet = 1,
+		PropertySet = 2
+	};
+
+	// appends to a buffer
+	class Writer
+	{
+		Buffer & _buffer;
+	public:
+		explicit Writer(Buffer & buffer) : _buffer(buffer) { }
+
+		Buffer & buffer() { return _buffer; }
+
+		void writeByte(unsigned char b)
+		{
+			_buffer.push_back(static_cast<char>(b));
+		}
+
+		void writeVarUInt(unsigned long long v)
+		{
+			char tmp[10];
+			size_t n = 0;
+			for (; v >= 0x80; v >>= 7)
+				tmp[n++] = static_cast<char>(v | 0x80);
+			tmp[n++] = static_cast<char>(v);
+			_buffer.insert(_buffer.end(), tmp, tmp + n);
+		}
+
+		void writeVarInt(long long v)
+		{
+			writeVarUInt((static_cast<unsigned long long>(v) << 1) ^ static_cast<unsigned long long>(v >> 63));
+		}
+
+		void writeFixed64(unsigned long long v)
+		{
+			char tmp[8];
+			for (size_t i = 0; i < 8; ++i, v >>= 8)
+				tmp[i] = static_cast<char>(v & 0xff);
+			_buffer.insert(_buffer.end(), tmp, tmp + 8);
+		}
+
+		// length prefixed
+		void writeBytes(const char * data, size_t size)
+		{
+			writeVarUInt(size);
+			_buffer.insert(_buffer.end(), data, data + size);
+		}
+	};
+
+	// reads a buffer owned by the caller; every read fails on truncated or malformed data
+	class Reader
+	{
+		const char * _pos;
+		const char * _end;
+	public:
+		Reader(const char * data, size_t length) : _pos(data), _end(data + length) { }
+
+		size_t left() const { return static_cast<size_t>(_end - _pos); }
+		bool atEnd() const { return _pos == _end; }
+
+		bool readByte(unsigned char & ret)
+		{
+			if (_pos == _end)
+				return false;
+			ret = static_cast<unsigned char>(*_pos++);
+			return true;
+		}
+
+		bool readVarUInt(unsigned long long & ret)
+		{
+			ret = 0;
+			for (unsigned shift = 0; _pos != _end && shift < 64; shift += 7)
+			{
+				auto b = static_cast<unsigned char>(*_pos++);
+				ret |= static_cast<unsigned long long>(b & 0x7f) << shift;
+				if (!(b & 0x80))
+					return true;
+			}
+			return false;
+		}
+
+		bool readVarInt(long long & ret)
+		{
+			unsigned long long v;
+			if (!readVarUInt(v))
+				return false;
+			ret = static_cast<long long>((v >> 1) ^ (~(v & 1) + 1));
+			return true;
+		}
+
+		bool readFixed64(unsigned long long & ret)
+		{
+			if (left() < 8)
+				return false;
+			ret = 0;
+			for (size_t i = 0; i < 8; ++i)
+				ret |= static_cast<unsigned long long>(static_cast<unsigned char>(_pos[i])) << (8 * i);
+			_pos += 8;
+			return true;
+		}
+
+		// length prefixed; 'data' points into the buffer
+		bool readBytes(const char *& data, size_t & size)
+		{
+			unsigned long long len;
+			if (!readVarUInt(len) || len > left())
+				return false;
+			data = _pos;
+			size = static_cast<size_t>(len);
+			_pos += size;
+			return true;
+		}
+	};
+
+	inline void writeValue(Writer & w, bool b) { w.writeByte(b ? 1 : 0); }
+	inline void writeValue(Writer & w, int num) { w.writeVarInt(num); }
+	inline void writeValue(Writer & w, unsigned int num) { w.writeVarUInt(num); }
+	inline void writeValue(Writer & w, long long num) { w.writeVarInt(num); }
+	inline void writeValue(Writer & w, unsigned long long num) { w.writeVarUInt(num); }
+
+	inline void writeValue(Writer & w, double num)
+	{
+		unsigned long long bits;
+		memcpy(&bits, &num, sizeof(bits));
+		w.writeFixed64(bits);
+	}
+
+	inline void writeValue(Writer & w, const char * str) { w.writeBytes(str, strlen(str)); }
+	inline void writeValue(Writer & w, const std::string & str) { w.writeBytes(str.data(), str.length()); }
+	inline void writeValue(Writer & w, const std::vector<char> & b) { w.writeBytes(b.data(), b.size()); }
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const DateTime & dt);
+
+	template<typename T>
+	void writeValue(Writer & w, const Nullable<T> & v);
+	template<typename T>
+	void writeValue(Writer & w, const NullableConstRef<T> & v);
+#ifdef PIDL__HAS_OPTIONAL
+	template<typename T>
+	void writeValue(Writer & w, const std::optional<T> & v);
+#endif
+	template<typename T>
+	void writeValue(Writer & w, const std::vector<T> & values);
+	template<typename ...T>
+	void writeValue(Writer & w, const std::tuple<T...> & values);
+
+	template<typename T>
+	void writeValue(Writer & w, const Nullable<T> & v)
+	{
+		w.writeByte(v ? 1 : 0);
+		if (v)
+			writeValue(w, *v);
+	}
+
+	template<typename T>
+	void writeValue(Writer & w, const NullableConstRef<T> & v)
+	{
+		w.writeByte(v ? 1 : 0);
+		if (v)
+			writeValue(w, *v);
+	}
+
+#ifdef PIDL__HAS_OPTIONAL
+	template<typename T>
+	void writeValue(Writer & w, const std::optional<T> & v)
+	{
+		w.writeByte(v ? 1 : 0);
+		if (v)
+			writeValue(w, *v);
+	}
+#endif
+
+	template<typename T>
+	void writeValue(Writer & w, const std::vector<T> & values)
+	{
+		w.writeVarUInt(values.size());
+		for (auto & v : values)
+			writeValue(w, v);
+	}
+
+	namespace _internal
+	{
+		template<int... Is>
+		struct seq { };
+
+		template<int N, int... Is>
+		struct gen_seq : gen_seq<N - 1, N - 1, Is...> { };
+
+		template<int... Is>
+		struct gen_seq<0, Is...> : seq<Is...> { };
+
+		template<typename T, typename F, int... Is>
+		void for_each(T && t, F & f, seq<Is...>)
+		{
+			auto l = { (f(std::get<Is>(t)), 0)... };
+			(void)l;
+		}
+
+		struct tuple_writeValue_functor
+		{
+			Writer & w;
+			template<typename T> void operator () (const T & v) { writeValue(w, v); }
+		};
+
+		struct tuple_readValue_functor
+		{
+			Reader & r;
+			bool ok;
+			template<typename T> void operator () (T & v) { ok = ok && readValue(r, v); }
+		};
+	}
+
+	// calls 'f' for the items of 't' in order
+	template<typename... Ts, typename F>
+	void for_each_in_tuple(const std::tuple<Ts...> & t, F & f)
+	{
+		_internal::for_each(t, f, _internal::gen_seq<sizeof...(Ts)>());
+	}
+
+	template<typename... Ts, typename F>
+	void for_each_in_tuple(std::tuple<Ts...> & t, F & f)
+	{
+		_internal::for_each(t, f, _internal::gen_seq<sizeof...(Ts)>());
+	}
+
+	template<typename ...T>
+	void writeValue(Writer & w, const std::tuple<T...> & values)
+	{
+		_internal::tuple_writeValue_functor f = { w };
+		for_each_in_tuple(values, f);
+	}
+
+	inline bool readValue(Reader & r, bool & ret)
+	{
+		unsigned char b;
+		if (!r.readByte(b) || b > 1)
+			return false;
+		ret = b != 0;
+		return true;
+	}
+
+	inline bool readValue(Reader & r, long long & ret) { return r.readVarInt(ret); }
+	inline bool readValue(Reader & r, unsigned long long & ret) { return r.readVarUInt(ret); }
+
+	inline bool readValue(Reader & r, int & ret)
+	{
+		long long v;
+		if (!r.readVarInt(v) || v < INT_MIN || v > INT_MAX)
+			return false;
+		ret = static_cast<int>(v);
+		return true;
+	}
+
+	inline bool readValue(Reader & r, unsigned int & ret)
+	{
+		unsigned long long v;
+		if (!r.readVarUInt(v) || v > UINT_MAX)
+			return false;
+		ret = static_cast<unsigned int>(v);
+		return true;
+	}
+
+	inline bool readValue(Reader & r, double & ret)
+	{
+		unsigned long long bits;
+		if (!r.readFixed64(bits))
+			return false;
+		memcpy(&ret, &bits, sizeof(ret));
+		return true;
+	}
+
+	inline bool readValue(Reader & r, std::string & ret)
+	{
+		const char * data;
+		size_t size;
+		if (!r.readBytes(data, size))
+			return false;
+		ret.assign(data, size);
+		return true;
+	}
+
+	inline bool readValue(Reader & r, std::vector<char> & ret)
+	{
+		const char * data;
+		size_t size;
+		if (!r.readBytes(data, size))
+			return false;
+		ret.assign(data, data + size);
+		return true;
+	}
+
+	extern PIDL_CORE__FUNCTION bool readValue(Reader & r, DateTime & ret);
+
+	template<typename T>
+	bool readValue(Reader & r, Nullable<T> & ret);
+#ifdef PIDL__HAS_OPTIONAL
+	template<typename T>
+	bool readValue(Reader & r, std::optional<T> & ret);
+#endif
+	template<typename T>
+	bool readValue(Reader & r, std::vector<T> & ret);
+	template<typename ...T>
+	bool readValue(Reader & r, std::tuple<T...> & ret);
+
+	template<typename T>
+	bool readValue(Reader & r, Nullable<T> & ret)
+	{
+		bool not_null;
+		if (!readValue(r, not_null))
+			return false;
+		if (!not_null)
+		{
+			ret.setNull();
+			return true;
+		}
+		return readValue(r, ret.emplace());
+	}
+
+#ifdef PIDL__HAS_OPTIONAL
+	template<typename T>
+	bool readValue(Reader & r, std::optional<T> & ret)
+	{
+		bool not_null;
+		if (!readValue(r, not_null))
+			return false;
+		if (!not_null)
+		{
+			ret.reset();
+			return true;
+		}
+		return readValue(r, ret.emplace());
+	}
+#endif
+
+	// reads the item count of an array; every item takes at least one byte, so a count beyond the rest of the data is invalid
+	inline bool readSize(Reader & r, size_t & ret)
+	{
+		unsigned long long size;
+		if (!r.readVarUInt(size) || size > r.left())
+			return false;
+		ret = static_cast<size_t>(size);
+		return true;
+	}
+
+	template<typename T>
+	bool readValue(Reader & r, std::vector<T> & ret)
+	{
+		size_t size;
+		if (!readSize(r, size))
+			return false;
+		ret.resize(size);
+		for (auto & v : ret)
+			if (!readValue(r, v))
+				return false;
+		return true;
+	}
+
+	template<typename ...T>
+	bool readValue(Reader & r, std::tuple<T...> & ret)
+	{
+		_internal::tuple_readValue_functor f = { r, true };
+		for_each_in_tuple(ret, f);
+		return f.ok;
+	}
+
+}}
+
+#endif // pidlCore__binarytools_h
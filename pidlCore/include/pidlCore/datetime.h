@@ -36,6 +36,14 @@ namespace PIDL {
     extern PIDL_CORE__FUNCTION bool toDateTime(const tm & t, DateTime & ret);
     extern PIDL_CORE__FUNCTION bool toDateTime(std::chrono::system_clock::time_point t, DateTime & ret);
 
+    //the conversions of 'count' values; false if any of them cannot be converted (the others are converted anyway)
+    extern PIDL_CORE__FUNCTION bool toTimepoints(const DateTime * dts, size_t count, std::chrono::system_clock::time_point * ret);
+    extern PIDL_CORE__FUNCTION bool toDateTimes(const std::chrono::system_clock::time_point * ts, size_t count, DateTime * ret);
+
+    //days since 1970-01-01 of a date of the proleptic Gregorian calendar, and back; 'month' may be out of 1..12
+    extern PIDL_CORE__FUNCTION long long daysFromCivil(long long year, long long month, long long day);
+    extern PIDL_CORE__FUNCTION void civilFromDays(long long days, long long & year, int & month, int & day);
+
     template<typename T>
     DateTime toDateTime(const T & t)
     {
@@ -0,0 +1,211 @@
+/*
+    This file is part of pidlCore.
+
+    pidlCore is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlCore is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlCore.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef pidlCore__instrumentation_h
+#define pidlCore__instrumentation_h
+
+#include "config.h"
+#include "basictypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Statistics of the server functions generated with the 'instrumentation' flag of the json_stl code generator.
+// Recording is lock-free; the servers generated without the flag do not refer to any of this.
+namespace PIDL { namespace Instrumentation {
+
+	// values in power of two buckets: bucket 0 counts the zeros, bucket i the values of [2^(i-1), 2^i)
+	class PIDL_CORE__CLASS Histogram
+	{
+		PIDL_COPY_PROTECTOR(Histogram)
+	public:
+		enum { BucketCount = 65 };
+
+		struct Snapshot
+		{
+			unsigned long long count = 0;
+			unsigned long long sum = 0;
+			unsigned long long max = 0;
+			std::vector<unsigned long long> buckets;
+
+			// upper bound of the bucket holding the 'q' (0..1) quantile
+			unsigned long long quantile(double q) const;
+		};
+
+		Histogram();
+
+		void record(unsigned long long value);
+
+		Snapshot snapshot() const;
+		void reset();
+
+	private:
+		std::atomic<unsigned long long> _sum;
+		std::atomic<unsigned long long> _max;
+		std::atomic<unsigned long long> _buckets[BucketCount];
+	};
+
+	class Registry;
+
+	// what is recorded about a variant of a function
+	class PIDL_CORE__CLASS FunctionStats
+	{
+		PIDL_COPY_PROTECTOR(FunctionStats)
+	public:
+		enum { StatusCount = (int)InvokeStatus::FatalError + 1 };
+
+		FunctionStats(Registry & registry, const std::string & scope, const std::string & name, const std::string & variant);
+
+		Registry & registry() const { return _registry; }
+		const std::string & scope() const { return _scope; }
+		const std::string & name() const { return _name; }
+		const std::string & variant() const { return _variant; }
+
+		Histogram unmarshalNs;
+		Histogram callNs;
+		Histogram marshalNs;
+		Histogram requestBytes;
+		Histogram responseBytes;
+
+		void recordStatus(InvokeStatus status);
+		unsigned long long statusCount(InvokeStatus status) const;
+
+		void reset();
+
+	private:
+		Registry & _registry;
+		std::string _scope, _name, _variant;
+		std::atomic<unsigned long long> _status[StatusCount];
+	};
+
+	class PIDL_CORE__CLASS Registry
+	{
+		PIDL_COPY_PROTECTOR(Registry)
+		struct Priv;
+		Priv * priv;
+	public:
+		struct FunctionSnapshot
+		{
+			std::string scope, name, variant;
+			unsigned long long status[FunctionStats::StatusCount];
+			Histogram::Snapshot unmarshalNs, callNs, marshalNs, requestBytes, responseBytes;
+		};
+
+		Registry();
+		~Registry();
+
+		// the registry of the generated code, unless the code generator helper names another one
+		static Registry & global();
+
+		// a disabled registry records nothing; it can be switched at any time
+		void setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+		bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+		// registers the function at its first use; the returned object lives as long as the registry
+		FunctionStats * function(const char * scope, const char * name, const char * variant);
+
+		std::vector<FunctionSnapshot> snapshot() const;
+
+		// the snapshot as {"functions":[{"scope":...,"name":...,"variant":...,"status":{"Ok":...,...},
+		// "unmarshal_ns":{"count":...,"sum":...,"max":...,"p50":...,"p90":...,"p99":...,"buckets":[...]},"call_ns":...}, ...]}
+		std::string toJSON() const;
+
+		// zeroes the statistics, the functions stay registered
+		void reset();
+
+	private:
+		std::atomic<bool> _enabled;
+	};
+
+	// Sizes of a request arriving as text and of its response, recorded for the function the request is dispatched to.
+	// The generated entry points taking text open one; callers of the document based '_invoke' can do the same.
+	// Scopes nest per thread, only the outermost one records.
+	class PIDL_CORE__CLASS Payload
+	{
+		PIDL_COPY_PROTECTOR(Payload)
+	public:
+		explicit Payload(size_t request_bytes);
+		~Payload();
+
+		void response(size_t bytes);
+
+	private:
+		friend class Call;
+		static Payload *& current();
+
+		Payload * _outer;
+		FunctionStats * _stats;
+		size_t _request;
+		size_t _response;
+		bool _has_response;
+	};
+
+	// Times the stages of a call of a generated server function: unmarshalling, the call itself, then
+	// marshalling until the destruction. Inactive, so nearly free, while the registry is disabled.
+	class PIDL_CORE__CLASS Call
+	{
+		PIDL_COPY_PROTECTOR(Call)
+		typedef std::chrono::steady_clock Clock;
+	public:
+		explicit Call(FunctionStats * stats) :
+			_stats(stats->registry().isEnabled() ? stats : nullptr)
+		{
+			if (_stats)
+				_start = Clock::now();
+		}
+
+		~Call()
+		{
+			if (_stats)
+				finish();
+		}
+
+		void unmarshalled()
+		{
+			if (_stats)
+			{
+				_unmarshalled = Clock::now();
+				_has_unmarshalled = true;
+			}
+		}
+
+		void called(InvokeStatus status)
+		{
+			if (_stats)
+			{
+				_called = Clock::now();
+				_has_called = true;
+				_status = status;
+			}
+		}
+
+	private:
+		void finish();
+
+		FunctionStats * _stats;
+		Clock::time_point _start, _unmarshalled, _called;
+		bool _has_unmarshalled = false;
+		bool _has_called = false;
+		InvokeStatus _status = InvokeStatus::MarshallingError;
+	};
+
+}}
+
+#endif // pidlCore__instrumentation_h
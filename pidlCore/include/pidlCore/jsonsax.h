@@ -0,0 +1,530 @@
+/*
+    This file is part of pidlCore.
+
+    pidlCore is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlCore is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlCore.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef pidlCore__jsonsax_h
+#define pidlCore__jsonsax_h
+
+#include "config.h"
+#include "nullable.h"
+#include "datetime.h"
+#include "errorcollector.h"
+#include "jsontools.h"
+
+#include <rapidjson/reader.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#ifdef PIDL__HAS_OPTIONAL
+#  include <optional>
+#endif
+
+// Streaming (SAX) counterpart of the JSONTools::getValue() family: JSON events coming from
+// rapidjson::Reader are bound straight into the destination C++ values, no DOM is built.
+namespace PIDL { namespace JSONTools { namespace SAX {
+
+	class Handler;
+	struct Frame;
+	class Binder;
+
+	// one scalar event of the reader
+	struct Scalar
+	{
+		enum class Type
+		{
+			Null, False, True, Int, Uint, Int64, Uint64, Double, String
+		};
+
+		Type type;
+		union
+		{
+			int64_t i;
+			uint64_t u;
+			double d;
+		};
+		const char * str = nullptr;
+		rapidjson::SizeType length = 0;
+
+		// the same classification as rapidjson::Value would give for the very same number
+		PIDL_CORE__FUNCTION bool isNumber() const;
+		PIDL_CORE__FUNCTION bool isInt() const;
+		PIDL_CORE__FUNCTION bool isUint() const;
+		PIDL_CORE__FUNCTION bool isInt64() const;
+		PIDL_CORE__FUNCTION bool isUint64() const;
+		PIDL_CORE__FUNCTION double getDouble() const;
+	};
+
+	// a typed destination of one JSON value
+	struct Slot
+	{
+		void * ptr;
+		void * ctx;
+		const Binder * binder;
+
+		inline bool isValid() const { return binder != nullptr; }
+
+		static inline Slot invalid() { return Slot{ nullptr, nullptr, nullptr }; }
+		// accepts and drops any value
+		static PIDL_CORE__FUNCTION Slot skip();
+	};
+
+	// state of an open object or array
+	struct Frame
+	{
+		Slot slot;
+		bool is_object;
+		Slot next;
+		size_t index;
+		uint64_t seen;
+		size_t found;
+		// the members from 64 on; allocated only for such large structures
+		std::vector<bool> seen_above;
+
+		// marks the member 'index' as present, a repeated member is counted once
+		inline void markSeen(size_t idx)
+		{
+			if (idx < 64)
+			{
+				if (seen & (uint64_t(1) << idx))
+					return;
+				seen |= uint64_t(1) << idx;
+			}
+			else
+			{
+				idx -= 64;
+				if (idx >= seen_above.size())
+					seen_above.resize(idx + 1);
+				else if (seen_above[idx])
+					return;
+				seen_above[idx] = true;
+			}
+			++found;
+		}
+		inline bool isSeen(size_t idx) const
+		{
+			return idx < 64 ? (seen & (uint64_t(1) << idx)) != 0 : idx - 64 < seen_above.size() && seen_above[idx - 64];
+		}
+	};
+
+	// describes how values of a C++ type are read from JSON events
+	class PIDL_CORE__CLASS Binder
+	{
+	public:
+		virtual ~Binder();
+
+		virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const;
+		virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const;
+		virtual Slot member(Frame & frame, const char * key, rapidjson::SizeType length, Handler & h) const;
+		virtual Slot element(Frame & frame, Handler & h) const;
+		virtual bool close(Frame & frame, Handler & h) const;
+	};
+
+	class PIDL_CORE__CLASS Handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler>
+	{
+		PIDL_COPY_PROTECTOR(Handler)
+	public:
+		Handler(const Slot & root, ErrorCollector & ec);
+		~Handler();
+
+		ErrorCollector & errorCollector();
+		// adds the message to the error collector and returns false so that the reader stops
+		bool error(const std::string & msg);
+		bool hasError() const;
+		Frame & top();
+
+		bool isComplete() const;
+
+		bool Null();
+		bool Bool(bool b);
+		bool Int(int i);
+		bool Uint(unsigned u);
+		bool Int64(int64_t i);
+		bool Uint64(uint64_t u);
+		bool Double(double d);
+		bool String(const char * str, rapidjson::SizeType length, bool copy);
+		bool StartObject();
+		bool Key(const char * str, rapidjson::SizeType length, bool copy);
+		bool EndObject(rapidjson::SizeType memberCount);
+		bool StartArray();
+		bool EndArray(rapidjson::SizeType elementCount);
+
+	private:
+		bool target(Slot & ret);
+		bool value(const Scalar & s);
+		bool start(bool is_object);
+		bool end();
+
+		Slot _root;
+		bool _root_done;
+		bool _has_error;
+		std::vector<Frame> _stack;
+		ErrorCollector & _ec;
+	};
+
+	// parses a complete JSON text into 'root'
+	extern PIDL_CORE__FUNCTION bool parse(const char * json, size_t length, const Slot & root, ErrorCollector & ec);
+
+	// name to slot table of a fixed set of members, e.g. arguments of a function; every member is required
+	struct Member
+	{
+		const char * name;
+		rapidjson::SizeType length;
+		Slot slot;
+	};
+
+	// binds a JSON object into a member table
+	class PIDL_CORE__CLASS Members : public Binder
+	{
+	public:
+		Members(const Member * members, size_t count);
+
+		Slot slot() const;
+
+		virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const override;
+		virtual Slot member(Frame & frame, const char * key, rapidjson::SizeType length, Handler & h) const override;
+		virtual bool close(Frame & frame, Handler & h) const override;
+
+	private:
+		const Member * _members;
+		size_t _count;
+	};
+
+	// Envelope of a function call ({"version": .., "function": {"name": .., "variant": .., "arguments": {..}}}),
+	// the function may be identified by its numeric "id" instead of "name" and "variant".
+	// Only the member order written by the generated clients is recognized; anything else reports
+	// isFunctionCall() == false and has to be processed through the DOM.
+	class PIDL_CORE__CLASS Request
+	{
+		PIDL_COPY_PROTECTOR(Request)
+	public:
+		Request(const char * json, size_t length);
+
+		bool isFunctionCall() const;
+		int version() const;
+		const std::string & name() const;
+		const std::string & variant() const;
+		bool hasId() const;
+		int id() const;
+
+		// binds the arguments and checks the rest of the request;
+		// when false is returned and isFallback() is true, nothing went wrong but the DOM has to be used
+		bool readArguments(const Member * members, size_t count, ErrorCollector & ec);
+		bool isFallback() const;
+
+	private:
+		struct Envelope;
+		const char * _json;
+		size_t _length;
+		bool _is_function_call;
+		bool _fallback;
+		bool _has_arguments;
+		size_t _arguments_offset;
+		int _version;
+		bool _has_id;
+		int _id;
+		std::string _name;
+		std::string _variant;
+	};
+
+	//primitives
+
+	extern PIDL_CORE__FUNCTION Slot slot(std::string & ret);
+	extern PIDL_CORE__FUNCTION Slot slot(int & ret);
+	extern PIDL_CORE__FUNCTION Slot slot(unsigned int & ret);
+	extern PIDL_CORE__FUNCTION Slot slot(long long & ret);
+	extern PIDL_CORE__FUNCTION Slot slot(unsigned long long & ret);
+	extern PIDL_CORE__FUNCTION Slot slot(double & ret);
+	extern PIDL_CORE__FUNCTION Slot slot(bool & ret);
+	extern PIDL_CORE__FUNCTION Slot slot(DateTime & ret);
+	extern PIDL_CORE__FUNCTION Slot slot(std::vector<char> & ret);
+
+	template<typename Ctx> Slot slot(std::string & ret, Ctx *) { return slot(ret); }
+	template<typename Ctx> Slot slot(int & ret, Ctx *) { return slot(ret); }
+	template<typename Ctx> Slot slot(unsigned int & ret, Ctx *) { return slot(ret); }
+	template<typename Ctx> Slot slot(long long & ret, Ctx *) { return slot(ret); }
+	template<typename Ctx> Slot slot(unsigned long long & ret, Ctx *) { return slot(ret); }
+	template<typename Ctx> Slot slot(double & ret, Ctx *) { return slot(ret); }
+	template<typename Ctx> Slot slot(bool & ret, Ctx *) { return slot(ret); }
+	template<typename Ctx> Slot slot(DateTime & ret, Ctx *) { return slot(ret); }
+	template<typename Ctx> Slot slot(std::vector<char> & ret, Ctx *) { return slot(ret); }
+
+	// Containers below ask the context for the slot of their items ('ctx->_slot(item)'),
+	// so generated structures can be nested in them.
+
+	template<typename T, typename Ctx>
+	class NullableBinder : public Binder
+	{
+	public:
+		virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+		{
+			auto & ret = *static_cast<Nullable<T>*>(ptr);
+			if (value.type == Scalar::Type::Null)
+			{
+				ret.setNull();
+				return true;
+			}
+			auto s = static_cast<Ctx*>(ctx)->_slot(ret.setNotNull());
+			return s.binder->scalar(s.ptr, s.ctx, value, h);
+		}
+
+		virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const override
+		{
+			frame.slot = static_cast<Ctx*>(ctx)->_slot(static_cast<Nullable<T>*>(ptr)->setNotNull());
+			return frame.slot.binder->open(frame.slot.ptr, frame.slot.ctx, is_object, frame, h);
+		}
+
+		static const NullableBinder instance;
+	};
+
+	template<typename T, typename Ctx> const NullableBinder<T, Ctx> NullableBinder<T, Ctx>::instance;
+
+	template<typename T, typename Ctx>
+	Slot slot(Nullable<T> & ret, Ctx * ctx)
+	{
+		return Slot{ &ret, ctx, &NullableBinder<T, Ctx>::instance };
+	}
+
+#ifdef PIDL__HAS_OPTIONAL
+	template<typename T, typename Ctx>
+	class OptionalBinder : public Binder
+	{
+	public:
+		virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+		{
+			auto & ret = *static_cast<std::optional<T>*>(ptr);
+			if (value.type == Scalar::Type::Null)
+			{
+				ret.reset();
+				return true;
+			}
+			auto s = static_cast<Ctx*>(ctx)->_slot(ret.emplace());
+			return s.binder->scalar(s.ptr, s.ctx, value, h);
+		}
+
+		virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const override
+		{
+			frame.slot = static_cast<Ctx*>(ctx)->_slot(static_cast<std::optional<T>*>(ptr)->emplace());
+			return frame.slot.binder->open(frame.slot.ptr, frame.slot.ctx, is_object, frame, h);
+		}
+
+		static const OptionalBinder instance;
+	};
+
+	template<typename T, typename Ctx> const OptionalBinder<T, Ctx> OptionalBinder<T, Ctx>::instance;
+
+	template<typename T, typename Ctx>
+	Slot slot(std::optional<T> & ret, Ctx * ctx)
+	{
+		return Slot{ &ret, ctx, &OptionalBinder<T, Ctx>::instance };
+	}
+#endif
+
+	template<typename T, typename Ctx>
+	class ArrayBinder : public Binder
+	{
+	public:
+		virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const override
+		{
+			(void)ctx; (void)frame;
+			if (is_object)
+				return h.error("value is not array");
+			static_cast<std::vector<T>*>(ptr)->clear();
+			return true;
+		}
+
+		virtual Slot element(Frame & frame, Handler & h) const override
+		{
+			(void)h;
+			auto & ret = *static_cast<std::vector<T>*>(frame.slot.ptr);
+			ret.emplace_back();
+			return static_cast<Ctx*>(frame.slot.ctx)->_slot(ret.back());
+		}
+
+		static const ArrayBinder instance;
+	};
+
+	template<typename T, typename Ctx> const ArrayBinder<T, Ctx> ArrayBinder<T, Ctx>::instance;
+
+	template<typename T, typename Ctx>
+	Slot slot(std::vector<T> & ret, Ctx * ctx)
+	{
+		return Slot{ &ret, ctx, &ArrayBinder<T, Ctx>::instance };
+	}
+
+	template<typename Ctx, typename... Ts>
+	class TupleBinder : public Binder
+	{
+		typedef std::tuple<Ts...> Tuple;
+		typedef Slot(*Element_F)(Tuple & t, Ctx * ctx);
+
+		template<int I>
+		static Slot elementSlot(Tuple & t, Ctx * ctx)
+		{
+			return ctx->_slot(std::get<I>(t));
+		}
+
+		template<int... Is>
+		static const Element_F * elements(_internal::seq<Is...>)
+		{
+			static const Element_F ret[] = { &elementSlot<Is>..., nullptr };
+			return ret;
+		}
+
+	public:
+		virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const override
+		{
+			(void)ptr; (void)ctx; (void)frame;
+			if (is_object)
+				return h.error("value is not array");
+			return true;
+		}
+
+		virtual Slot element(Frame & frame, Handler & h) const override
+		{
+			(void)h;
+			if (frame.index >= sizeof...(Ts))
+				return Slot::skip();
+			auto f = elements(_internal::gen_seq<sizeof...(Ts)>())[frame.index];
+			return f(*static_cast<Tuple*>(frame.slot.ptr), static_cast<Ctx*>(frame.slot.ctx));
+		}
+
+		virtual bool close(Frame & frame, Handler & h) const override
+		{
+			if (frame.index < sizeof...(Ts))
+				return h.error("invalid marshalling when tuple value");
+			return true;
+		}
+
+		static const TupleBinder instance;
+	};
+
+	template<typename Ctx, typename... Ts> const TupleBinder<Ctx, Ts...> TupleBinder<Ctx, Ts...>::instance;
+
+	template<typename Ctx, typename... Ts>
+	Slot slot(std::tuple<Ts...> & ret, Ctx * ctx)
+	{
+		return Slot{ &ret, ctx, &TupleBinder<Ctx, Ts...>::instance };
+	}
+
+	// object references are marshalled by their object data; the context resolves them by
+	// 'bool _getObject(std::shared_ptr<T> & ret, const std::string & object_data, ErrorCollector & ec)'
+	template<typename T, typename Ctx>
+	class ObjectRefBinder : public Binder
+	{
+	public:
+		virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+		{
+			auto & ret = *static_cast<std::shared_ptr<T>*>(ptr);
+			switch (value.type)
+			{
+			case Scalar::Type::Null:
+				ret.reset();
+				return true;
+			case Scalar::Type::String:
+				if (!static_cast<Ctx*>(ctx)->_getObject(ret, std::string(value.str, value.length), h.errorCollector()))
+					return h.error("value is invalid");
+				return true;
+			default:
+				return h.error("value is invalid");
+			}
+		}
+
+		static const ObjectRefBinder instance;
+	};
+
+	template<typename T, typename Ctx> const ObjectRefBinder<T, Ctx> ObjectRefBinder<T, Ctx>::instance;
+
+	template<typename T, typename Ctx>
+	Slot slot(std::shared_ptr<T> & ret, Ctx * ctx)
+	{
+		return Slot{ &ret, ctx, &ObjectRefBinder<T, Ctx>::instance };
+	}
+
+	// Binds a structure through a member resolver of the context:
+	// 'Slot Ctx::resolver(T & ret, const char * key, rapidjson::SizeType length, size_t & index)'
+	// returns the slot of the member and its index, or Slot::skip() for unknown keys.
+	// All 'count' members are required.
+	template<typename T, typename Ctx>
+	class StructureBinder : public Binder
+	{
+	public:
+		typedef Slot(Ctx::*Resolver)(T & ret, const char * key, rapidjson::SizeType length, size_t & index);
+
+		StructureBinder(const char * name, size_t count, Resolver resolver) :
+			_name(name), _count(count), _resolver(resolver)
+		{ }
+
+		Slot slot(T & ret, Ctx * ctx) const
+		{
+			return Slot{ &ret, ctx, this };
+		}
+
+		virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const override
+		{
+			(void)ptr; (void)ctx; (void)frame;
+			if (!is_object)
+				return h.error(std::string() + "value of '" + _name + "' is not object");
+			return true;
+		}
+
+		virtual Slot member(Frame & frame, const char * key, rapidjson::SizeType length, Handler & h) const override
+		{
+			(void)h;
+			size_t idx = _count;
+			auto ret = (static_cast<Ctx*>(frame.slot.ctx)->*_resolver)(*static_cast<T*>(frame.slot.ptr), key, length, idx);
+			if (idx < _count)
+				frame.markSeen(idx);
+			return ret;
+		}
+
+		virtual bool close(Frame & frame, Handler & h) const override
+		{
+			if (frame.found < _count)
+				return h.error(std::string() + "value of '" + _name + "' is incomplete");
+			return true;
+		}
+
+	private:
+		const char * _name;
+		size_t _count;
+		Resolver _resolver;
+	};
+
+	inline bool isKey(const char * key, rapidjson::SizeType length, const char * name, rapidjson::SizeType name_length)
+	{
+		return length == name_length && memcmp(key, name, length) == 0;
+	}
+
+	// context for values which do not contain generated types
+	struct DefaultContext
+	{
+		template<typename T> Slot _slot(T & ret) { return slot(ret, this); }
+	};
+
+	template<typename T>
+	bool parse(const char * json, size_t length, T & ret, ErrorCollector & ec)
+	{
+		DefaultContext ctx;
+		return parse(json, length, ctx._slot(ret), ec);
+	}
+
+}}}
+
+#endif // pidlCore__jsonsax_h
@@ -21,8 +21,13 @@
 #include "config.h"
 #include "nullable.h"
 #include "datetime.h"
+#include "basictypes.h"
+#include "exception.h"
+#include "errorcollector.h"
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include <vector>
 #ifdef PIDL__HAS_OPTIONAL
@@ -70,6 +75,9 @@ namespace PIDL { namespace JSONTools {
 
     extern PIDL_CORE__FUNCTION bool getValue(const rapidjson::Value & r, const char * name, std::reference_wrapper<rapidjson::Document> & ret);
 
+    //true if the value 'name' of 'r' is the string 'value'
+    extern PIDL_CORE__FUNCTION bool equals(const rapidjson::Value & r, const char * name, const std::string & value);
+
     extern PIDL_CORE__FUNCTION bool getValue(const rapidjson::Value & v, rapidjson::Value *& ret);
 
     extern PIDL_CORE__FUNCTION bool getValue(const rapidjson::Value & v, const rapidjson::Value *& ret);
@@ -92,8 +100,19 @@ namespace PIDL { namespace JSONTools {
 
 	extern PIDL_CORE__FUNCTION bool getValue(const rapidjson::Value & v, tm & ret);
 
+	//accepts both the object and the compact string form of DateTime
 	extern PIDL_CORE__FUNCTION bool getValue(const rapidjson::Value & v, DateTime & ret);
 
+	//the compact form of DateTime is the fixed layout string 'YYYY-MM-DDThh:mm:ss[.nnnnnnnnn][Z|L]', where 'Z' is utc,
+	//'L' is local and no suffix is none; the fraction is written with 9 digits, up to 9 digits are accepted
+	const size_t compactDateTimeMaxLength = 30;
+
+	//the length of the compact form written into 'buffer' (of compactDateTimeMaxLength bytes at least); 0 if 'dt' has
+	//fields out of its layout (negative values or a year over 9999)
+	extern PIDL_CORE__FUNCTION size_t formatDateTime(const DateTime & dt, char * buffer);
+
+	extern PIDL_CORE__FUNCTION bool parseDateTime(const char * str, size_t length, DateTime & ret);
+
 	extern PIDL_CORE__FUNCTION bool getValue(const rapidjson::Value & v, std::vector<char> & ret);
 
     template <typename T>
@@ -209,6 +228,9 @@ namespace PIDL { namespace JSONTools {
 
 	extern PIDL_CORE__FUNCTION rapidjson::Value createValue(rapidjson::Document & doc, const DateTime & t);
 
+	//the compact form of 't' (the object one if it does not fit)
+	extern PIDL_CORE__FUNCTION rapidjson::Value createCompactValue(rapidjson::Document & doc, const DateTime & t);
+
 	template<typename T>
 	void addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const T & v)
 	{
@@ -217,6 +239,7 @@ namespace PIDL { namespace JSONTools {
 	}
 
 	extern PIDL_CORE__FUNCTION void addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const std::vector<char> & b);
+	//the base64 text is kept in the allocator of 'doc', the value is valid as long as 'doc' is
 	extern PIDL_CORE__FUNCTION rapidjson::Value createValue(rapidjson::Document & doc, const std::vector<char> & b);
 
     template<typename T>
@@ -316,6 +339,174 @@ namespace PIDL { namespace JSONTools {
 		addValue(doc, r, name, tmp);
 	}
 
+	// Writer based counterpart of createValue() / addValue(): values are serialized straight into
+	// the output buffer, no DOM nodes are allocated.
+	typedef rapidjson::Writer<rapidjson::StringBuffer> Writer;
+
+	// Output buffer taken from a per-thread pool and given back on destruction, so consecutive
+	// calls reuse the memory of the previous ones. Nested calls get a buffer of their own.
+	class PIDL_CORE__CLASS OutputBuffer
+	{
+		PIDL_COPY_PROTECTOR(OutputBuffer)
+	public:
+		OutputBuffer();
+		~OutputBuffer();
+
+		rapidjson::StringBuffer & buffer();
+
+		const char * data() const;
+		size_t size() const;
+
+	private:
+		rapidjson::StringBuffer * _buffer;
+	};
+
+	namespace _internal { struct DocumentArena; }
+
+	// Document taken from a per-thread pool and given back on destruction. Its allocator works on a
+	// chunk kept by the pool, so consecutive calls build and parse documents without allocating as
+	// long as they fit into it; the chunk grows to what the calls of the thread need.
+	class PIDL_CORE__CLASS PooledDocument
+	{
+		PIDL_COPY_PROTECTOR(PooledDocument)
+	public:
+		PooledDocument();
+		~PooledDocument();
+
+		rapidjson::Document & document();
+
+	private:
+		_internal::DocumentArena * _arena;
+	};
+
+	extern PIDL_CORE__FUNCTION void writeNull(Writer & w);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const char * str);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const std::reference_wrapper<rapidjson::Document> & value);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const std::string & str);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, int num);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, unsigned int num);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, long long num);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, unsigned long long num);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, double num);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, bool b);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const tm & t);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const DateTime & t);
+
+	extern PIDL_CORE__FUNCTION void writeCompactValue(Writer & w, const DateTime & t);
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const std::vector<char> & b);
+
+	template<typename T>
+	void writeValue(Writer & w, const Nullable<T> & v);
+
+	template<typename T>
+	void writeValue(Writer & w, const NullableConstRef<T> & v);
+
+#ifdef PIDL__HAS_OPTIONAL
+	template<typename T>
+	void writeValue(Writer & w, const std::optional<T> & v);
+#endif
+
+	template<typename T>
+	void writeValue(Writer & w, const std::vector<T> & values);
+
+	template<typename ...T>
+	void writeValue(Writer & w, const std::tuple<T...> & values);
+
+	template<typename T>
+	void writeValue(Writer & w, const char * name, const T & v)
+	{
+		w.Key(name);
+		writeValue(w, v);
+	}
+
+	template<typename T>
+	void writeValue(Writer & w, const Nullable<T> & v)
+	{
+		if (v.isNull())
+			writeNull(w);
+		else
+			writeValue(w, *v);
+	}
+
+	template<typename T>
+	void writeValue(Writer & w, const NullableConstRef<T> & v)
+	{
+		if (v.isNull())
+			writeNull(w);
+		else
+			writeValue(w, *v);
+	}
+
+#ifdef PIDL__HAS_OPTIONAL
+	template<typename T>
+	void writeValue(Writer & w, const std::optional<T> & v)
+	{
+		if (v)
+			writeValue(w, *v);
+		else
+			writeNull(w);
+	}
+#endif
+
+	template<typename T>
+	void writeValue(Writer & w, const std::vector<T> & values)
+	{
+		w.StartArray();
+		for (auto & v : values)
+			writeValue(w, v);
+		w.EndArray();
+	}
+
+	namespace _internal
+	{
+		struct tuple_writeValue_functor
+		{
+			tuple_writeValue_functor(Writer & w_) : w(w_)
+			{ }
+
+			Writer & w;
+
+			template<typename T>
+			void operator () (T && v)
+			{
+				writeValue(w, v);
+			}
+		};
+	}
+
+	template<typename ...T>
+	void writeValue(Writer & w, const std::tuple<T...> & values)
+	{
+		w.StartArray();
+		for_each_in_tuple(values, _internal::tuple_writeValue_functor(w));
+		w.EndArray();
+	}
+
+	// Batched calls: the response to {"version": 2, "batch": [<request>, ...]} is {"batch": [<result>, ...]}, where a result
+	// is {"status": <InvokeStatus>, "result": <response>} or, when the call has failed, {"status": <InvokeStatus>, "errors": [...]}.
+	namespace Batch
+	{
+		extern PIDL_CORE__FUNCTION void addResult(rapidjson::Document & doc, rapidjson::Value & results, InvokeStatus status, rapidjson::Value & response, const std::list<Exception::Error> & errors);
+
+		// 'response' is the serialized response of the call (may be empty)
+		extern PIDL_CORE__FUNCTION void writeResult(Writer & w, InvokeStatus status, const char * response, size_t length, const std::list<Exception::Error> & errors);
+
+		// the response of the call; nullptr if the call has failed or 'result' is invalid, the errors are added to 'ec'
+		extern PIDL_CORE__FUNCTION const rapidjson::Value * getResult(const rapidjson::Value & result, ErrorCollector & ec);
+	}
+
 }}
 
 #endif // pidlCore__jsontools_h
@@ -20,102 +20,153 @@
 
 #include "config.h"
 
-#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace PIDL {
 
-	template<typename T>
+	// common accessors of Nullable and NullableConstRef; resolved statically, no virtual call involved
+	template<typename T, class Derived>
 	class AbstractNullable
 	{
 	public:
-		virtual inline ~AbstractNullable() { }
+		inline bool isNull() const { return self().ptr() == nullptr; }
+		inline operator bool () const { return self().ptr() != nullptr; }
 
-		inline bool isNull() const { return ptr() == nullptr; }
-		inline operator bool () const { return ptr() != nullptr; }
+		inline T & ref() { return *self().ptr(); }
+		inline const T & ref() const { return *self().ptr(); }
 
-		inline T & ref() { return *ptr(); }
-		inline const T & ref() const { return *ptr(); }
+		inline T * operator -> () { return self().ptr(); }
+		inline const T * operator -> () const { return self().ptr(); }
 
-		inline T * operator -> () const { return ptr(); }
-
-		inline T & operator * () { return *ptr(); }
-		inline const T & operator * () const { return *ptr(); }
-
-		virtual T * ptr() const = 0;
+		inline T & operator * () { return *self().ptr(); }
+		inline const T & operator * () const { return *self().ptr(); }
 
+	private:
+		inline Derived & self() { return static_cast<Derived &>(*this); }
+		inline const Derived & self() const { return static_cast<const Derived &>(*this); }
 	};
 
+	// the value is stored in place, setting and resetting it never allocates
 	template <typename T>
-	class Nullable : public AbstractNullable<T>
+	class Nullable : public AbstractNullable<T, Nullable<T>>
 	{
 	public:
-		inline Nullable(const T * o) : val(o ? new T(*o) : nullptr)
-		{ }
+		inline Nullable(const T * o) : has_val(false)
+		{
+			if (o)
+				construct(*o);
+		}
 
-		inline Nullable(const Nullable<T> & o) : val(o.val ? new T(*o.val) : nullptr)
-		{ }
+		inline Nullable(const Nullable<T> & o) : has_val(false)
+		{
+			if (o.has_val)
+				construct(o.val);
+		}
 
-		inline Nullable(const T & a) : val(new T(a))
-		{ }
+		inline Nullable(Nullable<T> && o) noexcept(std::is_nothrow_move_constructible<T>::value) : has_val(false)
+		{
+			if (o.has_val)
+				construct(std::move(o.val));
+		}
+
+		inline Nullable(const T & a) : has_val(false)
+		{
+			construct(a);
+		}
 
-		inline Nullable() : val(nullptr)
+		inline Nullable(T && a) : has_val(false)
+		{
+			construct(std::move(a));
+		}
+
+		inline Nullable() : has_val(false)
 		{ }
 
-		virtual inline ~Nullable()
+		inline ~Nullable()
 		{
-			if(val)
-				delete val;
+			setNull();
 		}
 
 		void setNull()
 		{
-			if(val)
-				delete val;
-			val = nullptr;
+			if (has_val)
+			{
+				val.~T();
+				has_val = false;
+			}
 		}
 
 		T & setNotNull()
 		{
-			if(val)
-				delete val;
-			val = new T();
-			return *val;
+			return emplace();
+		}
+
+		template<typename ... Args>
+		T & emplace(Args && ... args)
+		{
+			setNull();
+			construct(std::forward<Args>(args)...);
+			return val;
 		}
 
 		Nullable<T> & operator = (const Nullable<T> & o)
 		{
-			if(o.val)
-			{
-				if(val)
-					*val = *o.val;
-				else
-					val = new T(*o.val);
-			}
-			else if(val)
-			{
-				delete val;
-				val = nullptr;
-			}
+			if (o.has_val)
+				*this = o.val;
+			else
+				setNull();
+			return *this;
+		}
+
+		Nullable<T> & operator = (Nullable<T> && o) noexcept(std::is_nothrow_move_assignable<T>::value && std::is_nothrow_move_constructible<T>::value)
+		{
+			if (o.has_val)
+				*this = std::move(o.val);
+			else
+				setNull();
 			return *this;
 		}
 
 		Nullable<T> & operator = (const T & o)
 		{
-			if(val)
-				*val = o;
+			if (has_val)
+				val = o;
 			else
-				val = new T(o);
+				construct(o);
 			return *this;
 		}
 
-		virtual inline T * ptr() const override { return val; }
+		Nullable<T> & operator = (T && o)
+		{
+			if (has_val)
+				val = std::move(o);
+			else
+				construct(std::move(o));
+			return *this;
+		}
+
+		inline T * ptr() { return has_val ? &val : nullptr; }
+		inline const T * ptr() const { return has_val ? &val : nullptr; }
 
 	private:
-		T * val;
+		template<typename ... Args>
+		void construct(Args && ... args)
+		{
+			new (&val) T(std::forward<Args>(args)...);
+			has_val = true;
+		}
+
+		union
+		{
+			T val;
+		};
+		bool has_val;
 	};
 
 	template <typename T>
-	class NullableConstRef : public AbstractNullable<const T>
+	class NullableConstRef : public AbstractNullable<const T, NullableConstRef<T>>
 	{
 	public:
 		inline NullableConstRef(const Nullable<T> & o) : val(o.ptr())
@@ -144,7 +195,7 @@ namespace PIDL {
 
 		NullableConstRef<T> & operator = (const Nullable<T> & o)
 		{
-			val = o.val;
+			val = o.ptr();
 			return *this;
 		}
 
@@ -160,7 +211,7 @@ namespace PIDL {
 			return *this;
 		}
 
-		inline const T * ptr() const override { return val; }
+		inline const T * ptr() const { return val; }
 
 	private:
 		const T * val;
@@ -0,0 +1,63 @@
+/*
+    This file is part of pidlCore.
+
+    pidlCore is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlCore is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlCore.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef pidlCore__objecttable_h
+#define pidlCore__objecttable_h
+
+#include "config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace PIDL {
+
+	// Table of shared objects addressed by generational handles. A handle is the index of a slot and the generation of
+	// the slot, so the handle of a removed object is not resolved again, not even after its slot is reused.
+	// get() takes no lock: it pins the slot by an atomic counter while it copies the object, remove() waits for the
+	// pins of the slot to be released. add() and remove() are serialized. The slots are never moved.
+	class PIDL_CORE__CLASS ObjectTable
+	{
+		PIDL_COPY_PROTECTOR(ObjectTable)
+		struct Priv;
+		Priv * priv;
+	public:
+		// 0 is never a valid handle
+		typedef std::uint64_t Handle;
+
+		ObjectTable();
+		~ObjectTable();
+
+		Handle add(const std::shared_ptr<void> & object);
+
+		// nullptr if 'handle' is not valid (anymore)
+		std::shared_ptr<void> get(Handle handle) const;
+
+		// false if 'handle' is not valid (anymore)
+		bool remove(Handle handle);
+
+		size_t size() const;
+
+		// the text form of the handles, used as object data on the wire; fromString() returns 0 for invalid text
+		static std::string toString(Handle handle);
+		static Handle fromString(const std::string & str);
+	};
+
+}
+
+#endif // pidlCore__objecttable_h
@@ -0,0 +1,52 @@
+/*
+    This file is part of pidlCore.
+
+    pidlCore is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlCore is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlCore.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef pidlCore__workerpool_h
+#define pidlCore__workerpool_h
+
+#include "config.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace PIDL {
+
+	// Fixed set of threads running the posted tasks, started in order of posting. post() can be called from any thread.
+	// The destructor runs the tasks still queued, then joins the threads. An exception escaping a task is dropped.
+	class PIDL_CORE__CLASS WorkerPool
+	{
+		PIDL_COPY_PROTECTOR(WorkerPool)
+		struct Priv;
+		Priv * priv;
+	public:
+		typedef std::function<void()> Task;
+
+		// 0 threads means one per hardware thread
+		explicit WorkerPool(size_t threads = 0);
+		~WorkerPool();
+
+		size_t size() const;
+
+		void post(const Task & task);
+
+		// blocks until every task posted so far has finished
+		void wait();
+	};
+
+}
+
+#endif // pidlCore__workerpool_h
@@ -0,0 +1,294 @@
+
+#include "include/pidlCore/instrumentation.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace PIDL { namespace Instrumentation {
+
+	namespace {
+
+		size_t bucketOf(unsigned long long value)
+		{
+			if (!value)
+				return 0;
+#if defined(__GNUC__)
+			return 64 - __builtin_clzll(value);
+#else
+			size_t ret = 0;
+			for (; value; value >>= 1)
+				++ret;
+			return ret;
+#endif
+		}
+
+		const char * statusName(int status)
+		{
+			switch ((InvokeStatus)status)
+			{
+			case InvokeStatus::Ok: return "Ok";
+			case InvokeStatus::NotImplemented: return "NotImplemented";
+			case InvokeStatus::Error: return "Error";
+			case InvokeStatus::MarshallingError: return "MarshallingError";
+			case InvokeStatus::NotSupportedMarshallingVersion: return "NotSupportedMarshallingVersion";
+			case InvokeStatus::FatalError: return "FatalError";
+			}
+			return "";
+		}
+
+		void writeString(std::ostream & o, const std::string & str)
+		{
+			o << '"';
+			for (char c : str)
+			{
+				if (c == '"' || c == '\\')
+					o << '\\';
+				o << c;
+			}
+			o << '"';
+		}
+
+		void writeHistogram(std::ostream & o, const char * name, const Histogram::Snapshot & h)
+		{
+			o << ",\"" << name << "\":{\"count\":" << h.count << ",\"sum\":" << h.sum << ",\"max\":" << h.max
+			  << ",\"p50\":" << h.quantile(0.5) << ",\"p90\":" << h.quantile(0.9) << ",\"p99\":" << h.quantile(0.99) << ",\"buckets\":[";
+			//trailing empty buckets are left out
+			size_t length = h.buckets.size();
+			while (length && !h.buckets[length - 1])
+				--length;
+			for (size_t i = 0; i < length; ++i)
+				o << (i ? "," : "") << h.buckets[i];
+			o << "]}";
+		}
+
+	}
+
+	unsigned long long Histogram::Snapshot::quantile(double q) const
+	{
+		if (!count)
+			return 0;
+		auto rank = (unsigned long long)(q * count);
+		if (rank >= count)
+			rank = count - 1;
+		unsigned long long seen = 0;
+		for (size_t i = 0; i < buckets.size(); ++i)
+		{
+			seen += buckets[i];
+			if (seen > rank)
+				return i ? std::min(max, i < 64 ? (1ULL << i) - 1 : ~0ULL) : 0;
+		}
+		return max;
+	}
+
+	Histogram::Histogram() : _sum(0), _max(0)
+	{
+		for (auto & b : _buckets)
+			b.store(0, std::memory_order_relaxed);
+	}
+
+	void Histogram::record(unsigned long long value)
+	{
+		_buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+		_sum.fetch_add(value, std::memory_order_relaxed);
+		auto max = _max.load(std::memory_order_relaxed);
+		while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+	}
+
+	Histogram::Snapshot Histogram::snapshot() const
+	{
+		Snapshot ret;
+		ret.buckets.resize(BucketCount);
+		for (size_t i = 0; i < BucketCount; ++i)
+		{
+			ret.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+			ret.count += ret.buckets[i]; //the count is the sum of the buckets
+		}
+		ret.sum = _sum.load(std::memory_order_relaxed);
+		ret.max = _max.load(std::memory_order_relaxed);
+		return ret;
+	}
+
+	void Histogram::reset()
+	{
+		for (auto & b : _buckets)
+			b.store(0, std::memory_order_relaxed);
+		_sum.store(0, std::memory_order_relaxed);
+		_max.store(0, std::memory_order_relaxed);
+	}
+
+	FunctionStats::FunctionStats(Registry & registry, const std::string & scope, const std::string & name, const std::string & variant) :
+		_registry(registry), _scope(scope), _name(name), _variant(variant)
+	{
+		for (auto & s : _status)
+			s.store(0, std::memory_order_relaxed);
+	}
+
+	void FunctionStats::recordStatus(InvokeStatus status)
+	{
+		_status[(int)status].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	unsigned long long FunctionStats::statusCount(InvokeStatus status) const
+	{
+		return _status[(int)status].load(std::memory_order_relaxed);
+	}
+
+	void FunctionStats::reset()
+	{
+		unmarshalNs.reset();
+		callNs.reset();
+		marshalNs.reset();
+		requestBytes.reset();
+		responseBytes.reset();
+		for (auto & s : _status)
+			s.store(0, std::memory_order_relaxed);
+	}
+
+	struct Registry::Priv
+	{
+		mutable std::mutex mutex;
+		//a deque, so that the registered objects never move
+		std::deque<std::unique_ptr<FunctionStats>> functions;
+	};
+
+	Registry::Registry() : priv(new Priv), _enabled(true)
+	{ }
+
+	Registry::~Registry()
+	{
+		delete priv;
+	}
+
+	Registry & Registry::global()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	FunctionStats * Registry::function(const char * scope, const char * name, const char * variant)
+	{
+		std::lock_guard<std::mutex> lock(priv->mutex);
+		for (auto & f : priv->functions)
+			if (f->scope() == scope && f->name() == name && f->variant() == variant)
+				return f.get();
+		priv->functions.emplace_back(new FunctionStats(*this, scope, name, variant));
+		return priv->functions.back().get();
+	}
+
+	std::vector<Registry::FunctionSnapshot> Registry::snapshot() const
+	{
+		std::lock_guard<std::mutex> lock(priv->mutex);
+		std::vector<FunctionSnapshot> ret(priv->functions.size());
+		for (size_t i = 0; i < ret.size(); ++i)
+		{
+			auto & f = *priv->functions[i];
+			auto & s = ret[i];
+			s.scope = f.scope();
+			s.name = f.name();
+			s.variant = f.variant();
+			for (int st = 0; st < FunctionStats::StatusCount; ++st)
+				s.status[st] = f.statusCount((InvokeStatus)st);
+			s.unmarshalNs = f.unmarshalNs.snapshot();
+			s.callNs = f.callNs.snapshot();
+			s.marshalNs = f.marshalNs.snapshot();
+			s.requestBytes = f.requestBytes.snapshot();
+			s.responseBytes = f.responseBytes.snapshot();
+		}
+		return ret;
+	}
+
+	std::string Registry::toJSON() const
+	{
+		std::stringstream o;
+		o << "{\"functions\":[";
+		bool is_first = true;
+		for (auto & f : snapshot())
+		{
+			o << (is_first ? "" : ",") << "{\"scope\":";
+			writeString(o, f.scope);
+			o << ",\"name\":";
+			writeString(o, f.name);
+			o << ",\"variant\":";
+			writeString(o, f.variant);
+			o << ",\"status\":{";
+			for (int st = 0; st < FunctionStats::StatusCount; ++st)
+				o << (st ? "," : "") << "\"" << statusName(st) << "\":" << f.status[st];
+			o << "}";
+			writeHistogram(o, "unmarshal_ns", f.unmarshalNs);
+			writeHistogram(o, "call_ns", f.callNs);
+			writeHistogram(o, "marshal_ns", f.marshalNs);
+			writeHistogram(o, "request_bytes", f.requestBytes);
+			writeHistogram(o, "response_bytes", f.responseBytes);
+			o << "}";
+			is_first = false;
+		}
+		o << "]}";
+		return o.str();
+	}
+
+	void Registry::reset()
+	{
+		std::lock_guard<std::mutex> lock(priv->mutex);
+		for (auto & f : priv->functions)
+			f->reset();
+	}
+
+	Payload *& Payload::current()
+	{
+		static thread_local Payload * payload = nullptr;
+		return payload;
+	}
+
+	Payload::Payload(size_t request_bytes) :
+		_outer(current()), _stats(nullptr), _request(request_bytes), _response(0), _has_response(false)
+	{
+		current() = this;
+	}
+
+	Payload::~Payload()
+	{
+		current() = _outer;
+		if (!_stats)
+			return;
+		if (_outer)
+		{
+			_outer->_stats = _stats;
+			return;
+		}
+		_stats->requestBytes.record(_request);
+		if (_has_response)
+			_stats->responseBytes.record(_response);
+	}
+
+	void Payload::response(size_t bytes)
+	{
+		_response = bytes;
+		_has_response = true;
+	}
+
+	void Call::finish()
+	{
+		auto now = Clock::now();
+		auto ns = [](Clock::duration d) { return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(); };
+		if (!_has_unmarshalled)
+			_stats->unmarshalNs.record(ns(now - _start));
+		else
+		{
+			_stats->unmarshalNs.record(ns(_unmarshalled - _start));
+			if (_has_called)
+			{
+				_stats->callNs.record(ns(_called - _unmarshalled));
+				if (_status == InvokeStatus::Ok)
+					_stats->marshalNs.record(ns(now - _called));
+			}
+		}
+		_stats->recordStatus(_status);
+
+		if (auto payload = Payload::current())
+			payload->_stats = _stats;
+	}
+
+}}
@@ -0,0 +1,1004 @@
+/*
+    This file is part of pidlCore.
+
+    pidlCore is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    pidlCore is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with pidlCore.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "include/pidlCore/jsonsax.h"
+#include "include/pidlCore/base64.h"
+
+#include <rapidjson/memorystream.h>
+
+#include <chrono>
+#include <climits>
+
+namespace PIDL { namespace JSONTools { namespace SAX {
+
+	namespace {
+
+		inline bool isSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+		}
+
+		// conversions below follow JSONTools::getValue() for rapidjson::Value
+
+		bool assign(std::string & ret, const Scalar & s)
+		{
+			if (s.type != Scalar::Type::String)
+				return false;
+			ret.assign(s.str, s.length);
+			return true;
+		}
+
+		bool assign(int & ret, const Scalar & s)
+		{
+			if (!s.isNumber())
+				return false;
+			ret = s.isInt() ? static_cast<int>(s.type == Scalar::Type::Int || s.type == Scalar::Type::Int64 ? s.i : static_cast<int64_t>(s.u)) : static_cast<int>(s.getDouble());
+			return true;
+		}
+
+		bool assign(unsigned int & ret, const Scalar & s)
+		{
+			if (!s.isNumber())
+				return false;
+
+			if (s.isUint())
+				ret = static_cast<unsigned int>(s.type == Scalar::Type::Uint || s.type == Scalar::Type::Uint64 ? s.u : static_cast<uint64_t>(s.i));
+			else if (s.isInt() || s.getDouble() < 0)
+				return false;
+			else
+				ret = static_cast<unsigned int>(s.getDouble());
+
+			return true;
+		}
+
+		bool assign(long long & ret, const Scalar & s)
+		{
+			if (!s.isNumber())
+				return false;
+			ret = s.isInt64() ? static_cast<long long>(s.type == Scalar::Type::Int || s.type == Scalar::Type::Int64 ? s.i : static_cast<int64_t>(s.u)) : static_cast<long long>(s.getDouble());
+			return true;
+		}
+
+		bool assign(unsigned long long & ret, const Scalar & s)
+		{
+			if (!s.isNumber())
+				return false;
+
+			if (s.isUint64())
+				ret = static_cast<unsigned long long>(s.type == Scalar::Type::Uint || s.type == Scalar::Type::Uint64 ? s.u : static_cast<uint64_t>(s.i));
+			else if (s.isInt64() || s.getDouble() < 0)
+				return false;
+			else
+				ret = static_cast<unsigned long long>(s.getDouble());
+
+			return true;
+		}
+
+		bool assign(double & ret, const Scalar & s)
+		{
+			if (!s.isNumber())
+				return false;
+			ret = s.getDouble();
+			return true;
+		}
+
+		bool assign(bool & ret, const Scalar & s)
+		{
+			switch (s.type)
+			{
+			case Scalar::Type::False:
+				ret = false;
+				return true;
+			case Scalar::Type::True:
+				ret = true;
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		bool assign(std::vector<char> & ret, const Scalar & s)
+		{
+			if (s.type != Scalar::Type::String)
+				return false;
+			return Base64::decode(s.str, s.length, ret);
+		}
+
+		template<typename T>
+		class PrimitiveBinder : public Binder
+		{
+		public:
+			virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+			{
+				(void)ctx;
+				if (!assign(*static_cast<T*>(ptr), value))
+					return h.error("value is invalid");
+				return true;
+			}
+		};
+
+		const PrimitiveBinder<std::string> stringBinder;
+		const PrimitiveBinder<int> intBinder;
+		const PrimitiveBinder<unsigned int> uintBinder;
+		const PrimitiveBinder<long long> int64Binder;
+		const PrimitiveBinder<unsigned long long> uint64Binder;
+		const PrimitiveBinder<double> doubleBinder;
+		const PrimitiveBinder<bool> boolBinder;
+		const PrimitiveBinder<std::vector<char>> blobBinder;
+
+		class SkipBinder : public Binder
+		{
+		public:
+			virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+			{
+				(void)ptr; (void)ctx; (void)value; (void)h;
+				return true;
+			}
+
+			virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const override
+			{
+				(void)ptr; (void)ctx; (void)is_object; (void)frame; (void)h;
+				return true;
+			}
+		} const skipBinder;
+
+		//datetime
+
+		enum DateTimeMember
+		{
+			DT_Year, DT_Month, DT_Day, DT_Hour, DT_Minute, DT_Second, DT_Nanosecond, DT_Millisecond, DT_Kind
+		};
+
+		const uint64_t DateTimeRequired = (1 << DT_Year) | (1 << DT_Month) | (1 << DT_Day) | (1 << DT_Hour) | (1 << DT_Minute) | (1 << DT_Second);
+
+		class DateTimeFieldBinder : public Binder
+		{
+		public:
+			virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+			{
+				(void)ctx;
+				long long tmp;
+				if (!assign(tmp, value))
+					return h.error("value is invalid");
+				*static_cast<short*>(ptr) = static_cast<short>(tmp);
+				return true;
+			}
+		} const dateTimeFieldBinder;
+
+		class NanosecondBinder : public Binder
+		{
+		public:
+			virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+			{
+				(void)ctx;
+				long long tmp;
+				if (assign(tmp, value))
+				{
+					static_cast<DateTime*>(ptr)->nanosecond = static_cast<int>(tmp);
+					h.top().markSeen(DT_Nanosecond);
+				}
+				return true;
+			}
+		} const nanosecondBinder;
+
+		class MillisecondBinder : public Binder
+		{
+		public:
+			virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+			{
+				(void)ctx;
+				long long tmp;
+				if (!h.top().isSeen(DT_Nanosecond) && assign(tmp, value))
+					static_cast<DateTime*>(ptr)->nanosecond = static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::milliseconds(tmp)).count());
+				return true;
+			}
+		} const millisecondBinder;
+
+		class KindBinder : public Binder
+		{
+		public:
+			virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+			{
+				(void)ctx; (void)h;
+				auto & ret = *static_cast<DateTime::Kind*>(ptr);
+				std::string kind_str;
+				if (assign(kind_str, value))
+				{
+					if (kind_str == "local")
+						ret = DateTime::Local;
+					else if (kind_str == "utc")
+						ret = DateTime::UTC;
+					else if (kind_str == "none")
+						ret = DateTime::None;
+				}
+				else
+					ret = DateTime::None;
+				return true;
+			}
+		} const kindBinder;
+
+		class DateTimeBinder : public Binder
+		{
+		public:
+			virtual bool open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const override
+			{
+				(void)ctx; (void)frame;
+				if (!is_object)
+					return h.error("value is invalid");
+				auto & ret = *static_cast<DateTime*>(ptr);
+				ret.nanosecond = 0;
+				ret.kind = DateTime::None;
+				return true;
+			}
+
+			//the compact form (see PIDL::JSONTools::parseDateTime)
+			virtual bool scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const override
+			{
+				(void)ctx;
+				if (value.type != Scalar::Type::String ||
+					!JSONTools::parseDateTime(value.str, value.length, *static_cast<DateTime*>(ptr)))
+					return h.error("value is invalid");
+				return true;
+			}
+
+			virtual Slot member(Frame & frame, const char * key, rapidjson::SizeType length, Handler & h) const override
+			{
+				(void)h;
+				auto & ret = *static_cast<DateTime*>(frame.slot.ptr);
+				auto field = [&](DateTimeMember idx, short & v) {
+					frame.markSeen(idx);
+					return Slot{ &v, nullptr, &dateTimeFieldBinder };
+				};
+
+				if (isKey(key, length, "year", 4))
+					return field(DT_Year, ret.year);
+				if (isKey(key, length, "month", 5))
+					return field(DT_Month, ret.month);
+				if (isKey(key, length, "day", 3))
+					return field(DT_Day, ret.day);
+				if (isKey(key, length, "hour", 4))
+					return field(DT_Hour, ret.hour);
+				if (isKey(key, length, "minute", 6))
+					return field(DT_Minute, ret.minute);
+				if (isKey(key, length, "second", 6))
+					return field(DT_Second, ret.second);
+				if (isKey(key, length, "nanosecond", 10))
+					return Slot{ &ret, nullptr, &nanosecondBinder };
+				if (isKey(key, length, "millisecond", 11))
+					return Slot{ &ret, nullptr, &millisecondBinder };
+				if (isKey(key, length, "kind", 4))
+					return Slot{ &ret.kind, nullptr, &kindBinder };
+				return Slot::skip();
+			}
+
+			virtual bool close(Frame & frame, Handler & h) const override
+			{
+				if ((frame.seen & DateTimeRequired) != DateTimeRequired)
+					return h.error("value is invalid");
+				return true;
+			}
+		} const dateTimeBinder;
+
+	}
+
+	//Scalar
+
+	PIDL_CORE__FUNCTION bool Scalar::isNumber() const
+	{
+		switch (type)
+		{
+		case Type::Int:
+		case Type::Uint:
+		case Type::Int64:
+		case Type::Uint64:
+		case Type::Double:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	PIDL_CORE__FUNCTION bool Scalar::isInt() const
+	{
+		switch (type)
+		{
+		case Type::Int:
+		case Type::Int64:
+			return i >= INT_MIN && i <= INT_MAX;
+		case Type::Uint:
+		case Type::Uint64:
+			return u <= static_cast<uint64_t>(INT_MAX);
+		default:
+			return false;
+		}
+	}
+
+	PIDL_CORE__FUNCTION bool Scalar::isUint() const
+	{
+		switch (type)
+		{
+		case Type::Int:
+		case Type::Int64:
+			return i >= 0 && i <= static_cast<int64_t>(UINT_MAX);
+		case Type::Uint:
+		case Type::Uint64:
+			return u <= static_cast<uint64_t>(UINT_MAX);
+		default:
+			return false;
+		}
+	}
+
+	PIDL_CORE__FUNCTION bool Scalar::isInt64() const
+	{
+		switch (type)
+		{
+		case Type::Int:
+		case Type::Int64:
+			return true;
+		case Type::Uint:
+		case Type::Uint64:
+			return u <= static_cast<uint64_t>(INT64_MAX);
+		default:
+			return false;
+		}
+	}
+
+	PIDL_CORE__FUNCTION bool Scalar::isUint64() const
+	{
+		switch (type)
+		{
+		case Type::Int:
+		case Type::Int64:
+			return i >= 0;
+		case Type::Uint:
+		case Type::Uint64:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	PIDL_CORE__FUNCTION double Scalar::getDouble() const
+	{
+		switch (type)
+		{
+		case Type::Int:
+		case Type::Int64:
+			return static_cast<double>(i);
+		case Type::Uint:
+		case Type::Uint64:
+			return static_cast<double>(u);
+		case Type::Double:
+			return d;
+		default:
+			return 0;
+		}
+	}
+
+	PIDL_CORE__FUNCTION Slot Slot::skip()
+	{
+		return Slot{ nullptr, nullptr, &skipBinder };
+	}
+
+	//Binder
+
+	Binder::~Binder() = default;
+
+	bool Binder::scalar(void * ptr, void * ctx, const Scalar & value, Handler & h) const
+	{
+		(void)ptr; (void)ctx; (void)value;
+		return h.error("value is invalid");
+	}
+
+	bool Binder::open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const
+	{
+		(void)ptr; (void)ctx; (void)is_object; (void)frame;
+		return h.error("value is invalid");
+	}
+
+	Slot Binder::member(Frame & frame, const char * key, rapidjson::SizeType length, Handler & h) const
+	{
+		(void)frame; (void)key; (void)length; (void)h;
+		return Slot::skip();
+	}
+
+	Slot Binder::element(Frame & frame, Handler & h) const
+	{
+		(void)frame; (void)h;
+		return Slot::skip();
+	}
+
+	bool Binder::close(Frame & frame, Handler & h) const
+	{
+		(void)frame; (void)h;
+		return true;
+	}
+
+	//Handler
+
+	Handler::Handler(const Slot & root, ErrorCollector & ec) :
+		_root(root),
+		_root_done(false),
+		_has_error(false),
+		_ec(ec)
+	{
+		_stack.reserve(16);
+	}
+
+	Handler::~Handler() = default;
+
+	ErrorCollector & Handler::errorCollector()
+	{
+		return _ec;
+	}
+
+	bool Handler::error(const std::string & msg)
+	{
+		_has_error = true;
+		_ec << msg;
+		return false;
+	}
+
+	bool Handler::hasError() const
+	{
+		return _has_error;
+	}
+
+	Frame & Handler::top()
+	{
+		return _stack.back();
+	}
+
+	bool Handler::isComplete() const
+	{
+		return _root_done && _stack.empty();
+	}
+
+	bool Handler::target(Slot & ret)
+	{
+		if (_stack.empty())
+		{
+			if (_root_done)
+				return error("unexpected value");
+			_root_done = true;
+			ret = _root;
+		}
+		else
+		{
+			auto & f = _stack.back();
+			if (f.is_object)
+			{
+				ret = f.next;
+				f.next = Slot::invalid();
+			}
+			else
+			{
+				ret = f.slot.binder->element(f, *this);
+				++f.index;
+			}
+		}
+
+		if (!ret.isValid())
+			return _has_error ? false : error("value is invalid");
+		return true;
+	}
+
+	bool Handler::value(const Scalar & s)
+	{
+		Slot t;
+		if (!target(t))
+			return false;
+		if (!t.binder->scalar(t.ptr, t.ctx, s, *this))
+			return _has_error ? false : error("value is invalid");
+		return true;
+	}
+
+	bool Handler::start(bool is_object)
+	{
+		Slot t;
+		if (!target(t))
+			return false;
+		_stack.push_back(Frame{ t, is_object, Slot::invalid(), 0, 0, 0 });
+		auto & f = _stack.back();
+		if (!t.binder->open(t.ptr, t.ctx, is_object, f, *this))
+			return _has_error ? false : error("value is invalid");
+		return true;
+	}
+
+	bool Handler::end()
+	{
+		auto & f = _stack.back();
+		bool ok = f.slot.binder->close(f, *this);
+		_stack.pop_back();
+		if (!ok)
+			return _has_error ? false : error("value is invalid");
+		return true;
+	}
+
+	bool Handler::Null()
+	{
+		Scalar s;
+		s.type = Scalar::Type::Null;
+		return value(s);
+	}
+
+	bool Handler::Bool(bool b)
+	{
+		Scalar s;
+		s.type = b ? Scalar::Type::True : Scalar::Type::False;
+		return value(s);
+	}
+
+	bool Handler::Int(int i)
+	{
+		Scalar s;
+		s.type = Scalar::Type::Int;
+		s.i = i;
+		return value(s);
+	}
+
+	bool Handler::Uint(unsigned u)
+	{
+		Scalar s;
+		s.type = Scalar::Type::Uint;
+		s.u = u;
+		return value(s);
+	}
+
+	bool Handler::Int64(int64_t i)
+	{
+		Scalar s;
+		s.type = Scalar::Type::Int64;
+		s.i = i;
+		return value(s);
+	}
+
+	bool Handler::Uint64(uint64_t u)
+	{
+		Scalar s;
+		s.type = Scalar::Type::Uint64;
+		s.u = u;
+		return value(s);
+	}
+
+	bool Handler::Double(double d)
+	{
+		Scalar s;
+		s.type = Scalar::Type::Double;
+		s.d = d;
+		return value(s);
+	}
+
+	bool Handler::String(const char * str, rapidjson::SizeType length, bool copy)
+	{
+		(void)copy;
+		Scalar s;
+		s.type = Scalar::Type::String;
+		s.str = str;
+		s.length = length;
+		return value(s);
+	}
+
+	bool Handler::StartObject()
+	{
+		return start(true);
+	}
+
+	bool Handler::Key(const char * str, rapidjson::SizeType length, bool copy)
+	{
+		(void)copy;
+		auto & f = _stack.back();
+		f.next = f.slot.binder->member(f, str, length, *this);
+		if (!f.next.isValid())
+			return _has_error ? false : error("value is invalid");
+		return true;
+	}
+
+	bool Handler::EndObject(rapidjson::SizeType memberCount)
+	{
+		(void)memberCount;
+		return end();
+	}
+
+	bool Handler::StartArray()
+	{
+		return start(false);
+	}
+
+	bool Handler::EndArray(rapidjson::SizeType elementCount)
+	{
+		(void)elementCount;
+		return end();
+	}
+
+	extern PIDL_CORE__FUNCTION bool parse(const char * json, size_t length, const Slot & root, ErrorCollector & ec)
+	{
+		Handler h(root, ec);
+		rapidjson::Reader reader;
+		rapidjson::MemoryStream ms(json, length);
+		if (reader.Parse(ms, h).IsError())
+		{
+			if (!h.hasError())
+				ec << "could not parse JSON: " + getErrorText(reader.GetParseErrorCode());
+			return false;
+		}
+		return true;
+	}
+
+	//Members
+
+	Members::Members(const Member * members, size_t count) :
+		_members(members),
+		_count(count)
+	{ }
+
+	Slot Members::slot() const
+	{
+		return Slot{ nullptr, nullptr, this };
+	}
+
+	bool Members::open(void * ptr, void * ctx, bool is_object, Frame & frame, Handler & h) const
+	{
+		(void)ptr; (void)ctx; (void)frame;
+		if (!is_object)
+			return h.error("value is not object");
+		return true;
+	}
+
+	Slot Members::member(Frame & frame, const char * key, rapidjson::SizeType length, Handler & h) const
+	{
+		(void)h;
+		for (size_t i = 0; i < _count; ++i)
+		{
+			auto & m = _members[i];
+			if (isKey(key, length, m.name, m.length))
+			{
+				frame.markSeen(i);
+				return m.slot;
+			}
+		}
+		return Slot::skip();
+	}
+
+	bool Members::close(Frame & frame, Handler & h) const
+	{
+		if (frame.found >= _count)
+			return true;
+		for (size_t i = 0; i < _count; ++i)
+			if (!frame.isSeen(i))
+				return h.error(std::string() + "value '" + _members[i].name + "' is not found");
+		return h.error("value is not found");
+	}
+
+	//Request
+
+	// reads the envelope until the key of the arguments
+	struct Request::Envelope : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Envelope>
+	{
+		enum class State
+		{
+			Start, Root, Version, FunctionStart, Function, Name, Variant, Id, Arguments, Done
+		};
+
+		Envelope(Request * that_, rapidjson::MemoryStream & ms_) : that(that_), ms(ms_)
+		{ }
+
+		Request * that;
+		rapidjson::MemoryStream & ms;
+		State state = State::Start;
+		bool has_version = false;
+		bool has_name = false;
+		bool function_done = false;
+
+		bool Default()
+		{
+			return false;
+		}
+
+		bool number(const Scalar & s)
+		{
+			switch (state)
+			{
+			case State::Version:
+				if (!assign(that->_version, s))
+					return false;
+				has_version = true;
+				state = State::Root;
+				return true;
+			case State::Id:
+				if (!assign(that->_id, s))
+					return false;
+				that->_has_id = true;
+				state = State::Function;
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		bool Int(int i) { Scalar s; s.type = Scalar::Type::Int; s.i = i; return number(s); }
+		bool Uint(unsigned u) { Scalar s; s.type = Scalar::Type::Uint; s.u = u; return number(s); }
+		bool Int64(int64_t i) { Scalar s; s.type = Scalar::Type::Int64; s.i = i; return number(s); }
+		bool Uint64(uint64_t u) { Scalar s; s.type = Scalar::Type::Uint64; s.u = u; return number(s); }
+		bool Double(double d) { Scalar s; s.type = Scalar::Type::Double; s.d = d; return number(s); }
+
+		bool String(const char * str, rapidjson::SizeType length, bool copy)
+		{
+			(void)copy;
+			switch (state)
+			{
+			case State::Name:
+				that->_name.assign(str, length);
+				has_name = true;
+				break;
+			case State::Variant:
+				that->_variant.assign(str, length);
+				break;
+			default:
+				return false;
+			}
+			state = State::Function;
+			return true;
+		}
+
+		bool StartObject()
+		{
+			switch (state)
+			{
+			case State::Start:
+				state = State::Root;
+				return true;
+			case State::FunctionStart:
+				state = State::Function;
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		bool Key(const char * str, rapidjson::SizeType length, bool copy)
+		{
+			(void)copy;
+			switch (state)
+			{
+			case State::Root:
+				if (isKey(str, length, "version", 7))
+					state = State::Version;
+				else if (isKey(str, length, "function", 8) && has_version && !function_done)
+					state = State::FunctionStart;
+				else
+					return false;
+				return true;
+			case State::Function:
+				if (isKey(str, length, "name", 4))
+					state = State::Name;
+				else if (isKey(str, length, "variant", 7))
+					state = State::Variant;
+				else if (isKey(str, length, "id", 2))
+					state = State::Id;
+				else if (isKey(str, length, "arguments", 9) && (has_name || that->_has_id))
+				{
+					// stop here, the arguments are bound by the generated code
+					state = State::Arguments;
+					that->_arguments_offset = ms.Tell();
+					return false;
+				}
+				else
+					return false;
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		bool EndObject(rapidjson::SizeType memberCount)
+		{
+			(void)memberCount;
+			switch (state)
+			{
+			case State::Function:
+				if (!has_name && !that->_has_id)
+					return false;
+				function_done = true;
+				state = State::Root;
+				return true;
+			case State::Root:
+				if (!function_done)
+					return false;
+				state = State::Done;
+				return true;
+			default:
+				return false;
+			}
+		}
+	};
+
+	Request::Request(const char * json, size_t length) :
+		_json(json),
+		_length(length),
+		_is_function_call(false),
+		_fallback(false),
+		_has_arguments(false),
+		_arguments_offset(0),
+		_version(0),
+		_has_id(false),
+		_id(-1)
+	{
+		rapidjson::MemoryStream ms(json, length);
+		Envelope envelope(this, ms);
+		rapidjson::Reader reader;
+		reader.Parse(ms, envelope);
+		switch (envelope.state)
+		{
+		case Envelope::State::Arguments:
+			_is_function_call = true;
+			_has_arguments = true;
+			break;
+		case Envelope::State::Done:
+			_is_function_call = !reader.HasParseError();
+			break;
+		default:
+			break;
+		}
+	}
+
+	bool Request::isFunctionCall() const
+	{
+		return _is_function_call;
+	}
+
+	int Request::version() const
+	{
+		return _version;
+	}
+
+	const std::string & Request::name() const
+	{
+		return _name;
+	}
+
+	const std::string & Request::variant() const
+	{
+		return _variant;
+	}
+
+	bool Request::hasId() const
+	{
+		return _has_id;
+	}
+
+	int Request::id() const
+	{
+		return _id;
+	}
+
+	bool Request::isFallback() const
+	{
+		return _fallback;
+	}
+
+	bool Request::readArguments(const Member * members, size_t count, ErrorCollector & ec)
+	{
+		if (!_is_function_call)
+		{
+			_fallback = true;
+			return false;
+		}
+
+		if (!_has_arguments)
+		{
+			if (count)
+			{
+				ec << "value 'arguments' is not found";
+				return false;
+			}
+			return true;
+		}
+
+		size_t pos = _arguments_offset;
+		while (pos < _length && isSpace(_json[pos]))
+			++pos;
+		if (pos >= _length || _json[pos] != ':')
+		{
+			_fallback = true;
+			return false;
+		}
+		++pos;
+
+		Members args(members, count);
+		Handler h(count ? args.slot() : Slot::skip(), ec);
+		rapidjson::Reader reader;
+		rapidjson::MemoryStream ms(_json + pos, _length - pos);
+		if (reader.Parse<rapidjson::kParseStopWhenDoneFlag>(ms, h).IsError())
+		{
+			if (!h.hasError())
+				ec << "could not parse JSON: " + getErrorText(reader.GetParseErrorCode());
+			return false;
+		}
+		pos += ms.Tell();
+
+		// the arguments have to close both the function and the root object
+		for (int closing = 0; closing < 2; ++closing)
+		{
+			while (pos < _length && isSpace(_json[pos]))
+				++pos;
+			if (pos >= _length || _json[pos] != '}')
+			{
+				_fallback = true;
+				return false;
+			}
+			++pos;
+		}
+		while (pos < _length && isSpace(_json[pos]))
+			++pos;
+		if (pos != _length)
+		{
+			_fallback = true;
+			return false;
+		}
+
+		return true;
+	}
+
+	//primitives
+
+	extern PIDL_CORE__FUNCTION Slot slot(std::string & ret)
+	{
+		return Slot{ &ret, nullptr, &stringBinder };
+	}
+
+	extern PIDL_CORE__FUNCTION Slot slot(int & ret)
+	{
+		return Slot{ &ret, nullptr, &intBinder };
+	}
+
+	extern PIDL_CORE__FUNCTION Slot slot(unsigned int & ret)
+	{
+		return Slot{ &ret, nullptr, &uintBinder };
+	}
+
+	extern PIDL_CORE__FUNCTION Slot slot(long long & ret)
+	{
+		return Slot{ &ret, nullptr, &int64Binder };
+	}
+
+	extern PIDL_CORE__FUNCTION Slot slot(unsigned long long & ret)
+	{
+		return Slot{ &ret, nullptr, &uint64Binder };
+	}
+
+	extern PIDL_CORE__FUNCTION Slot slot(double & ret)
+	{
+		return Slot{ &ret, nullptr, &doubleBinder };
+	}
+
+	extern PIDL_CORE__FUNCTION Slot slot(bool & ret)
+	{
+		return Slot{ &ret, nullptr, &boolBinder };
+	}
+
+	extern PIDL_CORE__FUNCTION Slot slot(DateTime & ret)
+	{
+		return Slot{ &ret, nullptr, &dateTimeBinder };
+	}
+
+	extern PIDL_CORE__FUNCTION Slot slot(std::vector<char> & ret)
+	{
+		return Slot{ &ret, nullptr, &blobBinder };
+	}
+
+}}}
@@ -1,108 +1,13 @@
 
 #include "include/pidlCore/jsontools.h"
+#include "include/pidlCore/base64.h"
+#include "include/pidlCore/errorcollector.h"
 
-namespace PIDL { namespace JSONTools {
-
-	namespace base64 {
-		static const std::string base64_chars =
-			"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-			"abcdefghijklmnopqrstuvwxyz"
-			"0123456789+/";
-
-		typedef char byte;
-
-		static inline bool is_base64(byte c) {
-			return (isalnum(c) || (c == '+') || (c == '/'));
-		}
-
-		std::string & encode(const std::vector<byte> & bin, std::string & ret) {
-
-			byte const* bytes_to_encode = bin.data();
-			size_t in_len = bin.size();
-
-			int i = 0;
-			int j = 0;
-			byte char_array_3[3];
-			byte char_array_4[4];
-
-
-			while (in_len--) {
-				char_array_3[i++] = *(bytes_to_encode++);
-				if (i == 3) {
-					char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-					char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-					char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-					char_array_4[3] = char_array_3[2] & 0x3f;
-
-					for (i = 0; (i < 4); i++)
-						ret += base64_chars[char_array_4[i]];
-					i = 0;
-				}
-			}
-
-			if (i)
-			{
-				for (j = i; j < 3; j++)
-					char_array_3[j] = '\0';
-
-				char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-				char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-				char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-				char_array_4[3] = char_array_3[2] & 0x3f;
-
-				for (j = 0; (j < i + 1); j++)
-					ret += base64_chars[char_array_4[j]];
-
-				while ((i++ < 3))
-					ret += '=';
-
-			}
-
-			return ret;
-
-		}
-
-		std::vector<char> & decode(std::string const& encoded_string, std::vector<byte> & ret)
-		{
-			size_t in_len = encoded_string.size();
-			size_t i = 0;
-			size_t j = 0;
-			int in_ = 0;
-			byte char_array_4[4], char_array_3[3];
-
-			while (in_len-- && (encoded_string[in_] != '=') && is_base64(encoded_string[in_])) {
-				char_array_4[i++] = encoded_string[in_]; in_++;
-				if (i == 4) {
-					for (i = 0; i < 4; i++)
-						char_array_4[i] = static_cast<unsigned char>(base64_chars.find(char_array_4[i]));
-
-					char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-					char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-					char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-					for (i = 0; (i < 3); i++)
-						ret.push_back(char_array_3[i]);
-					i = 0;
-				}
-			}
-
-			if (i) {
-				for (j = i; j < 4; j++)
-					char_array_4[j] = 0;
+#include <algorithm>
+#include <cstring>
+#include <memory>
 
-				for (j = 0; j < 4; j++)
-					char_array_4[j] = static_cast<unsigned char>(base64_chars.find(char_array_4[j]));
-
-				char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-				char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-				char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-				for (j = 0; (j < i - 1); j++) ret.push_back(char_array_3[j]);
-			}
-
-			return ret;
-		}
-	}
+namespace PIDL { namespace JSONTools {
 
 	extern PIDL_CORE__FUNCTION std::string getErrorText(rapidjson::ParseErrorCode code)
 	{
@@ -164,6 +69,15 @@ namespace PIDL { namespace JSONTools {
         return true;
     }
 
+    extern PIDL_CORE__FUNCTION bool equals(const rapidjson::Value & r, const char * name, const std::string & value)
+    {
+        if (!r.IsObject())
+            return false;
+        auto it = r.FindMember(name);
+        return it != r.MemberEnd() && it->value.IsString() && it->value.GetStringLength() == value.length() &&
+            !memcmp(it->value.GetString(), value.data(), value.length());
+    }
+
     extern PIDL_CORE__FUNCTION bool getValue(const rapidjson::Value & v, rapidjson::Value *&ret)
     {
         ret = (rapidjson::Value *)&v;
@@ -301,8 +215,126 @@ namespace PIDL { namespace JSONTools {
 		return getValue(r, t, millisecond);
 	}
 
+	namespace
+	{
+		inline void formatDigits(char * p, unsigned int v, int width)
+		{
+			for (int i = width - 1; i >= 0; --i, v /= 10)
+				p[i] = static_cast<char>('0' + v % 10);
+		}
+
+		inline bool parseDigits(const char * p, int width, int & ret)
+		{
+			ret = 0;
+			for (int i = 0; i < width; ++i)
+			{
+				if (p[i] < '0' || p[i] > '9')
+					return false;
+				ret = ret * 10 + (p[i] - '0');
+			}
+			return true;
+		}
+
+		inline bool fitsInto(short v, short max)
+		{
+			return v >= 0 && v <= max;
+		}
+	}
+
+	extern PIDL_CORE__FUNCTION size_t formatDateTime(const DateTime & dt, char * buffer)
+	{
+		if (!fitsInto(dt.year, 9999) || !fitsInto(dt.month, 99) || !fitsInto(dt.day, 99) ||
+			!fitsInto(dt.hour, 99) || !fitsInto(dt.minute, 99) || !fitsInto(dt.second, 99) ||
+			dt.nanosecond < 0 || dt.nanosecond > 999999999)
+			return 0;
+
+		formatDigits(buffer, static_cast<unsigned int>(dt.year), 4);
+		buffer[4] = '-';
+		formatDigits(buffer + 5, static_cast<unsigned int>(dt.month), 2);
+		buffer[7] = '-';
+		formatDigits(buffer + 8, static_cast<unsigned int>(dt.day), 2);
+		buffer[10] = 'T';
+		formatDigits(buffer + 11, static_cast<unsigned int>(dt.hour), 2);
+		buffer[13] = ':';
+		formatDigits(buffer + 14, static_cast<unsigned int>(dt.minute), 2);
+		buffer[16] = ':';
+		formatDigits(buffer + 17, static_cast<unsigned int>(dt.second), 2);
+		size_t length = 19;
+		if (dt.nanosecond > 0)
+		{
+			buffer[length++] = '.';
+			formatDigits(buffer + length, static_cast<unsigned int>(dt.nanosecond), 9);
+			length += 9;
+		}
+		switch (dt.kind)
+		{
+		case DateTime::None:
+			break;
+		case DateTime::Local:
+			buffer[length++] = 'L';
+			break;
+		case DateTime::UTC:
+			buffer[length++] = 'Z';
+			break;
+		}
+		return length;
+	}
+
+	extern PIDL_CORE__FUNCTION bool parseDateTime(const char * str, size_t length, DateTime & ret)
+	{
+		int year, month, day, hour, minute, second;
+		if (length < 19 ||
+			!parseDigits(str, 4, year) || str[4] != '-' ||
+			!parseDigits(str + 5, 2, month) || str[7] != '-' ||
+			!parseDigits(str + 8, 2, day) || str[10] != 'T' ||
+			!parseDigits(str + 11, 2, hour) || str[13] != ':' ||
+			!parseDigits(str + 14, 2, minute) || str[16] != ':' ||
+			!parseDigits(str + 17, 2, second))
+			return false;
+
+		size_t pos = 19;
+		int nanosecond = 0;
+		if (pos < length && str[pos] == '.')
+		{
+			size_t digits = 0;
+			for (++pos; pos < length && str[pos] >= '0' && str[pos] <= '9'; ++pos)
+				if (++digits <= 9)
+					nanosecond = nanosecond * 10 + (str[pos] - '0');
+			if (!digits || digits > 9)
+				return false;
+			for (; digits < 9; ++digits)
+				nanosecond *= 10;
+		}
+
+		DateTime::Kind kind = DateTime::None;
+		if (pos < length)
+		{
+			if (str[pos] == 'Z')
+				kind = DateTime::UTC;
+			else if (str[pos] == 'L')
+				kind = DateTime::Local;
+			else
+				return false;
+			++pos;
+		}
+		if (pos != length)
+			return false;
+
+		ret.year = static_cast<short>(year);
+		ret.month = static_cast<short>(month);
+		ret.day = static_cast<short>(day);
+		ret.hour = static_cast<short>(hour);
+		ret.minute = static_cast<short>(minute);
+		ret.second = static_cast<short>(second);
+		ret.nanosecond = nanosecond;
+		ret.kind = kind;
+		return true;
+	}
+
 	extern bool PIDL_CORE__FUNCTION getValue(const rapidjson::Value & r, DateTime & ret)
 	{
+		if (r.IsString())
+			return parseDateTime(r.GetString(), r.GetStringLength(), ret);
 		if (r.IsNull() || !r.IsObject())
 			return false;
 
@@ -351,8 +383,7 @@ namespace PIDL { namespace JSONTools {
 	{
 		if (v.IsNull() || !v.IsString())
 			return false;
-		base64::decode(v.GetString(), ret);
-		return true;
+		return Base64::decode(v.GetString(), v.GetStringLength(), ret);
 	}
 
 	extern PIDL_CORE__FUNCTION rapidjson::Value setString(rapidjson::Document & doc, const char * str)
@@ -500,6 +531,15 @@ namespace PIDL { namespace JSONTools {
 		return v;
 	}
 
+	extern PIDL_CORE__FUNCTION rapidjson::Value createCompactValue(rapidjson::Document & doc, const DateTime & dt)
+	{
+		char buffer[compactDateTimeMaxLength];
+		auto length = formatDateTime(dt, buffer);
+		if (!length)
+			return createValue(doc, dt);
+		return rapidjson::Value(buffer, static_cast<rapidjson::SizeType>(length), doc.GetAllocator());
+	}
+
 
 	extern PIDL_CORE__FUNCTION void addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const std::vector<char> & b)
 	{
@@ -509,8 +549,348 @@ namespace PIDL { namespace JSONTools {
 
 	extern PIDL_CORE__FUNCTION rapidjson::Value createValue(rapidjson::Document & doc, const std::vector<char> & b)
 	{
-		std::string tmp;
-		return setString(doc, base64::encode(b, tmp).c_str());
+		if (b.empty())
+			return rapidjson::Value(rapidjson::kStringType);
+		// encoded straight into the memory of 'doc', the value refers to it
+		auto length = Base64::encodedLength(b.size());
+		auto buffer = static_cast<char *>(doc.GetAllocator().Malloc(length));
+		Base64::encode(b.data(), b.size(), buffer);
+		return rapidjson::Value(rapidjson::StringRef(buffer, length));
+	}
+
+	namespace
+	{
+		// free buffers of the thread; only a few are kept, the rest is released
+		struct OutputBufferPool
+		{
+			enum { MaxSize = 8 };
+			std::vector<std::unique_ptr<rapidjson::StringBuffer>> free;
+		};
+
+		OutputBufferPool & outputBufferPool()
+		{
+			static thread_local OutputBufferPool pool;
+			return pool;
+		}
+	}
+
+	OutputBuffer::OutputBuffer()
+	{
+		auto & pool = outputBufferPool();
+		if (pool.free.size())
+		{
+			_buffer = pool.free.back().release();
+			pool.free.pop_back();
+			_buffer->Clear();
+		}
+		else
+			_buffer = new rapidjson::StringBuffer();
+	}
+
+	OutputBuffer::~OutputBuffer()
+	{
+		auto & pool = outputBufferPool();
+		if (pool.free.size() < OutputBufferPool::MaxSize)
+			pool.free.emplace_back(_buffer);
+		else
+			delete _buffer;
+	}
+
+	rapidjson::StringBuffer & OutputBuffer::buffer()
+	{
+		return *_buffer;
+	}
+
+	const char * OutputBuffer::data() const
+	{
+		return _buffer->GetString();
+	}
+
+	size_t OutputBuffer::size() const
+	{
+		return _buffer->GetSize();
+	}
+
+	namespace _internal
+	{
+		// a document and the memory pool allocator it works with; the first chunk of the allocator is owned by the arena
+		struct DocumentArena
+		{
+			enum { InitialChunkSize = 16 * 1024, MaxChunkSize = 1024 * 1024 };
+
+			explicit DocumentArena(size_t chunk_size_) :
+				chunk_size(chunk_size_),
+				chunk(new char[chunk_size_]),
+				allocator(chunk.get(), chunk_size_),
+				document(&allocator)
+			{ }
+
+			size_t chunk_size;
+			std::unique_ptr<char[]> chunk;
+			rapidjson::MemoryPoolAllocator<> allocator;
+			rapidjson::Document document;
+		};
+	}
+
+	namespace
+	{
+		// free arenas of the thread; only a few are kept, the rest is released
+		struct DocumentPool
+		{
+			enum { MaxSize = 8 };
+			std::vector<std::unique_ptr<_internal::DocumentArena>> free;
+		};
+
+		DocumentPool & documentPool()
+		{
+			static thread_local DocumentPool pool;
+			return pool;
+		}
+	}
+
+	PooledDocument::PooledDocument()
+	{
+		auto & pool = documentPool();
+		if (pool.free.size())
+		{
+			_arena = pool.free.back().release();
+			pool.free.pop_back();
+		}
+		else
+			_arena = new _internal::DocumentArena(_internal::DocumentArena::InitialChunkSize);
+	}
+
+	PooledDocument::~PooledDocument()
+	{
+		std::unique_ptr<_internal::DocumentArena> arena(_arena);
+		// a document swapped with another one does not work on the arena any more
+		if (&arena->document.GetAllocator() != &arena->allocator)
+			return;
+
+		auto used = arena->allocator.Size();
+		// the values do not own memory, the allocator releases everything at once
+		arena->document.SetNull();
+		if (used > arena->chunk_size && arena->chunk_size < _internal::DocumentArena::MaxChunkSize)
+			arena.reset(new _internal::DocumentArena(std::min<size_t>(used * 2, _internal::DocumentArena::MaxChunkSize)));
+		else
+			arena->allocator.Clear();
+
+		auto & pool = documentPool();
+		if (pool.free.size() < DocumentPool::MaxSize)
+			pool.free.emplace_back(arena.release());
+	}
+
+	rapidjson::Document & PooledDocument::document()
+	{
+		return _arena->document;
+	}
+
+	extern PIDL_CORE__FUNCTION void writeNull(Writer & w)
+	{
+		w.Null();
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const char * str)
+	{
+		w.String(str);
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const std::reference_wrapper<rapidjson::Document> & value)
+	{
+		value.get().Accept(w);
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const std::string & str)
+	{
+		w.String(str.data(), static_cast<rapidjson::SizeType>(str.length()));
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, int num)
+	{
+		w.Int(num);
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, unsigned int num)
+	{
+		w.Uint(num);
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, long long num)
+	{
+		w.Int64(num);
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, unsigned long long num)
+	{
+		w.Uint64(num);
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, double num)
+	{
+		w.Double(num);
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, bool b)
+	{
+		w.Bool(b);
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const tm & t)
+	{
+		w.StartObject();
+		writeValue(w, "year", static_cast<long long>(t.tm_year + 1900));
+		writeValue(w, "month", static_cast<long long>(t.tm_mon + 1));
+		writeValue(w, "day", static_cast<long long>(t.tm_mday));
+		writeValue(w, "hour", static_cast<long long>(t.tm_hour));
+		writeValue(w, "minute", static_cast<long long>(t.tm_min));
+		writeValue(w, "second", static_cast<long long>(t.tm_sec));
+		writeValue(w, "kind", "local");
+		w.EndObject();
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const DateTime & dt)
+	{
+		w.StartObject();
+		writeValue(w, "year", static_cast<long long>(dt.year));
+		writeValue(w, "month", static_cast<long long>(dt.month));
+		writeValue(w, "day", static_cast<long long>(dt.day));
+		writeValue(w, "hour", static_cast<long long>(dt.hour));
+		writeValue(w, "minute", static_cast<long long>(dt.minute));
+		writeValue(w, "second", static_cast<long long>(dt.second));
+		if (dt.nanosecond > 0)
+		{
+			writeValue(w, "nanosecond", static_cast<long long>(dt.nanosecond));
+			writeValue(w, "millisecond", static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(dt.nanosecond)).count()));
+		}
+
+		switch (dt.kind)
+		{
+		case DateTime::None:
+			break;
+		case DateTime::Local:
+			writeValue(w, "kind", "local");
+			break;
+		case DateTime::UTC:
+			writeValue(w, "kind", "utc");
+			break;
+		}
+		w.EndObject();
+	}
+
+	extern PIDL_CORE__FUNCTION void writeCompactValue(Writer & w, const DateTime & dt)
+	{
+		char buffer[compactDateTimeMaxLength];
+		auto length = formatDateTime(dt, buffer);
+		if (!length)
+			writeValue(w, dt);
+		else
+			w.String(buffer, static_cast<rapidjson::SizeType>(length));
+	}
+
+	extern PIDL_CORE__FUNCTION void writeValue(Writer & w, const std::vector<char> & b)
+	{
+		// reused per thread to avoid a heap allocation for every blob; a buffer grown by a large blob is not kept
+		enum { MaxKeptCapacity = 64 * 1024 };
+		static thread_local std::string tmp;
+		Base64::encode(b, tmp);
+		w.String(tmp.data(), static_cast<rapidjson::SizeType>(tmp.length()));
+		if (tmp.capacity() > MaxKeptCapacity)
+			std::string().swap(tmp);
+	}
+
+	namespace Batch
+	{
+		extern PIDL_CORE__FUNCTION void addResult(rapidjson::Document & doc, rapidjson::Value & results, InvokeStatus status, rapidjson::Value & response, const std::list<Exception::Error> & errors)
+		{
+			rapidjson::Value r(rapidjson::kObjectType);
+			addValue(doc, r, "status", static_cast<int>(status));
+			if (status == InvokeStatus::Ok)
+				addValue(doc, r, "result", response);
+			else
+			{
+				rapidjson::Value errors_v(rapidjson::kArrayType);
+				for (auto & e : errors)
+				{
+					rapidjson::Value e_v(rapidjson::kObjectType);
+					addValue(doc, e_v, "code", static_cast<long long>(e.first));
+					addValue(doc, e_v, "message", e.second);
+					errors_v.PushBack(e_v, doc.GetAllocator());
+				}
+				addValue(doc, r, "errors", errors_v);
+			}
+			results.PushBack(r, doc.GetAllocator());
+		}
+
+		extern PIDL_CORE__FUNCTION void writeResult(Writer & w, InvokeStatus status, const char * response, size_t length, const std::list<Exception::Error> & errors)
+		{
+			w.StartObject();
+			writeValue(w, "status", static_cast<int>(status));
+			if (status == InvokeStatus::Ok)
+			{
+				w.Key("result");
+				if (length)
+					w.RawValue(response, length, rapidjson::kObjectType);
+				else
+					w.Null();
+			}
+			else
+			{
+				w.Key("errors");
+				w.StartArray();
+				for (auto & e : errors)
+				{
+					w.StartObject();
+					writeValue(w, "code", static_cast<long long>(e.first));
+					writeValue(w, "message", e.second);
+					w.EndObject();
+				}
+				w.EndArray();
+			}
+			w.EndObject();
+		}
+
+		static const char * statusText(InvokeStatus status)
+		{
+			switch (status)
+			{
+			case InvokeStatus::Ok: break;
+			case InvokeStatus::NotImplemented: return "function is not implemented";
+			case InvokeStatus::Error: return "error while executing server function";
+			case InvokeStatus::MarshallingError: return "error while marshalling of function call";
+			case InvokeStatus::NotSupportedMarshallingVersion: return "not supported marshalling version";
+			case InvokeStatus::FatalError: return "fatal error while executing server function";
+			}
+			return "unknown status";
+		}
+
+		extern PIDL_CORE__FUNCTION const rapidjson::Value * getResult(const rapidjson::Value & result, ErrorCollector & ec)
+		{
+			int status;
+			if (!result.IsObject() || !getValue(result, "status", status))
+			{
+				ec << "invalid result of batched call";
+				return nullptr;
+			}
+			if (static_cast<InvokeStatus>(status) == InvokeStatus::Ok)
+			{
+				const rapidjson::Value * response;
+				if (getValue(result, "result", response))
+					return response;
+				ec << "invalid result of batched call";
+				return nullptr;
+			}
+			const rapidjson::Value * errors;
+			if (getValue(result, "errors", errors) && errors->IsArray())
+				for (auto & e : errors->GetArray())
+				{
+					long long code;
+					std::string message;
+					if (getValue(e, "code", code) && getValue(e, "message", message))
+						ec.add(static_cast<long>(code), message);
+				}
+			ec.add(status, statusText(static_cast<InvokeStatus>(status)));
+			return nullptr;
+		}
 	}
 
 }}
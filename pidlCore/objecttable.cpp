@@ -0,0 +1,186 @@
+
+#include "include/pidlCore/objecttable.h"
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PIDL {
+
+	namespace {
+
+		// chunk 'i' holds 'first_chunk_size << i' slots, so the chunks cover every 32 bit index
+		const size_t first_chunk_size = 256;
+		const size_t first_chunk_bits = 8;
+		const size_t max_chunks = 25;
+
+		inline void locate(std::uint32_t index, size_t & chunk, size_t & offset)
+		{
+			std::uint64_t i = (std::uint64_t)index + first_chunk_size;
+			size_t bit = first_chunk_bits;
+			while (i >> (bit + 1))
+				++bit;
+			chunk = bit - first_chunk_bits;
+			offset = (size_t)(i - ((std::uint64_t)1 << bit));
+		}
+
+	}
+
+	struct ObjectTable::Priv
+	{
+		// 'object' is written under 'mutex' only. get() pins the slot by 'readers' before it checks 'handle', remove()
+		// clears 'handle' before it waits for the pins to be released, so 'object' is not read while it is written.
+		struct Slot
+		{
+			// the handle of the object in the slot, 0 if the slot is free
+			std::atomic<Handle> handle;
+			std::atomic<std::uint32_t> readers;
+			std::shared_ptr<void> object;
+			std::uint32_t generation = 0;
+
+			Slot() : handle(0), readers(0) { }
+		};
+
+		std::atomic<Slot*> chunks[max_chunks];
+		std::mutex mutex;
+		std::vector<std::uint32_t> free;
+		std::uint32_t used = 0;
+		size_t count = 0;
+
+		Priv()
+		{
+			for (auto & c : chunks)
+				c.store(nullptr, std::memory_order_relaxed);
+		}
+
+		~Priv()
+		{
+			for (size_t i = 0; i < max_chunks; ++i)
+				delete [] chunks[i].load(std::memory_order_relaxed);
+		}
+
+		Slot * slot(std::uint32_t index) const
+		{
+			size_t chunk, offset;
+			locate(index, chunk, offset);
+			auto c = chunks[chunk].load(std::memory_order_acquire);
+			return c ? c + offset : nullptr;
+		}
+
+		// under 'mutex'
+		Slot * allocate(std::uint32_t & index)
+		{
+			if (free.size())
+			{
+				index = free.back();
+				free.pop_back();
+				return slot(index);
+			}
+
+			index = used++;
+			size_t chunk, offset;
+			locate(index, chunk, offset);
+			auto c = chunks[chunk].load(std::memory_order_relaxed);
+			if (!c)
+			{
+				c = new Slot[first_chunk_size << chunk];
+				chunks[chunk].store(c, std::memory_order_release);
+			}
+			return c + offset;
+		}
+	};
+
+	ObjectTable::ObjectTable() : priv(new Priv)
+	{ }
+
+	ObjectTable::~ObjectTable()
+	{
+		delete priv;
+	}
+
+	ObjectTable::Handle ObjectTable::add(const std::shared_ptr<void> & object)
+	{
+		std::lock_guard<std::mutex> lock(priv->mutex);
+		std::uint32_t index;
+		auto s = priv->allocate(index);
+		if (!++s->generation)
+			s->generation = 1;
+		s->object = object;
+		Handle handle = ((Handle)s->generation << 32) | index;
+		s->handle.store(handle, std::memory_order_release);
+		++priv->count;
+		return handle;
+	}
+
+	std::shared_ptr<void> ObjectTable::get(Handle handle) const
+	{
+		if (!handle)
+			return nullptr;
+		auto s = priv->slot((std::uint32_t)handle);
+		if (!s)
+			return nullptr;
+		std::shared_ptr<void> ret;
+		s->readers.fetch_add(1);
+		if (s->handle.load() == handle)
+			ret = s->object;
+		s->readers.fetch_sub(1, std::memory_order_release);
+		return ret;
+	}
+
+	bool ObjectTable::remove(Handle handle)
+	{
+		if (!handle)
+			return false;
+		std::shared_ptr<void> object;
+		{
+			std::lock_guard<std::mutex> lock(priv->mutex);
+			std::uint32_t index = (std::uint32_t)handle;
+			if (index >= priv->used)
+				return false;
+			auto s = priv->slot(index);
+			if (s->handle.load(std::memory_order_relaxed) != handle)
+				return false;
+			s->handle.store(0);
+			//the readers having seen the handle are waited for, the later ones do not touch the object; the store of the
+			//handle and this load pair with the increment and the load of get(), so both are sequentially consistent
+			while (s->readers.load())
+				std::this_thread::yield();
+			object = std::move(s->object);
+			priv->free.push_back(index);
+			--priv->count;
+		}
+		//the object is released out of the lock, its destructor may use the table
+		return true;
+	}
+
+	size_t ObjectTable::size() const
+	{
+		std::lock_guard<std::mutex> lock(priv->mutex);
+		return priv->count;
+	}
+
+	std::string ObjectTable::toString(Handle handle)
+	{
+		return std::to_string(handle);
+	}
+
+	ObjectTable::Handle ObjectTable::fromString(const std::string & str)
+	{
+		if (!str.length())
+			return 0;
+		Handle ret = 0;
+		for (char c : str)
+		{
+			if (c < '0' || c > '9')
+				return 0;
+			Handle digit = (Handle)(c - '0');
+			if (ret > (std::numeric_limits<Handle>::max() - digit) / 10)
+				return 0;
+			ret = ret * 10 + digit;
+		}
+		return ret;
+	}
+
+}
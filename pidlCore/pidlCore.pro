@@ -20,6 +20,10 @@ win64 {
     TEMPLATE_FILE = $_PRO_FILE_PWD_/include/pidlCore/_platform_win.h_
 }
 
+unix {
+    LIBS += -lpthread
+}
+
 platform.input = TEMPLATE_FILE
 platform.output = $$TARGET_FILE
 platform.variable_out = HEADERS
@@ -27,18 +31,30 @@ platform.commands = cp $$TEMPLATE_FILE $$TARGET_FILE
 QMAKE_EXTRA_COMPILERS += platform
 
 SOURCES += \
+    base64.cpp \
+    binarytools.cpp \
     datetime.cpp \
     errorcollector.cpp \
     exception.cpp \
-    jsontools.cpp
+    jsonsax.cpp \
+    instrumentation.cpp \
+    jsontools.cpp \
+    objecttable.cpp \
+    workerpool.cpp
 
 HEADERS += \
+    include/pidlCore/base64.h \
+    include/pidlCore/binarytools.h \
     include/pidlCore/config.h \
     include/pidlCore/datetime.h \
     include/pidlCore/errorcollector.h \
     include/pidlCore/exception.h \
+    include/pidlCore/instrumentation.h \
+    include/pidlCore/jsonsax.h \
     include/pidlCore/jsontools.h \
     include/pidlCore/nullable.h \
-    include/pidlCore/basictypes.h
+    include/pidlCore/basictypes.h \
+    include/pidlCore/objecttable.h \
+    include/pidlCore/workerpool.h
 
 
@@ -0,0 +1,91 @@
+
+#include "include/pidlCore/workerpool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PIDL {
+
+	struct WorkerPool::Priv
+	{
+		std::mutex mutex;
+		std::condition_variable task_posted;
+		std::condition_variable idle;
+		std::deque<Task> tasks;
+		size_t running = 0;
+		bool stopping = false;
+		std::vector<std::thread> threads;
+
+		void work()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			for (;;)
+			{
+				task_posted.wait(lock, [this] { return stopping || tasks.size(); });
+				if (!tasks.size())
+					return;
+
+				auto task = std::move(tasks.front());
+				tasks.pop_front();
+				++running;
+				lock.unlock();
+				try
+				{
+					task();
+				}
+				catch (...)
+				{
+					//the tasks report their own errors; the worker keeps running
+				}
+				lock.lock();
+				if (!--running && !tasks.size())
+					idle.notify_all();
+			}
+		}
+	};
+
+	WorkerPool::WorkerPool(size_t threads) : priv(new Priv)
+	{
+		if (!threads)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		for (size_t i = 0; i < threads; ++i)
+			priv->threads.emplace_back([this] { priv->work(); });
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(priv->mutex);
+			priv->stopping = true;
+		}
+		priv->task_posted.notify_all();
+		for (auto & t : priv->threads)
+			t.join();
+		delete priv;
+	}
+
+	size_t WorkerPool::size() const
+	{
+		return priv->threads.size();
+	}
+
+	void WorkerPool::post(const Task & task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(priv->mutex);
+			priv->tasks.push_back(task);
+		}
+		priv->task_posted.notify_one();
+	}
+
+	void WorkerPool::wait()
+	{
+		std::unique_lock<std::mutex> lock(priv->mutex);
+		priv->idle.wait(lock, [this] { return !priv->running && !priv->tasks.size(); });
+	}
+
+}
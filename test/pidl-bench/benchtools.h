@@ -0,0 +1,19 @@
+#ifndef __benchtools_h__
+#define __benchtools_h__
+
+#include <pidlCore/errorcollector.h>
+
+#include <iostream>
+#include <string>
+
+// the errors of the benchmarked operations are printed to stderr
+class BenchErrorCollector : public PIDL::ErrorCollector
+{
+protected:
+    virtual void append(long, const std::string & errorText) override
+    {
+        std::cerr << errorText << std::endl;
+    }
+};
+
+#endif //__benchtools_h__
@@ -0,0 +1,139 @@
+
+#include "bench.h"
+#include "benchtools.h"
+
+#include <pidlBackend/cppwriter.h>
+#include <pidlBackend/cswriter.h>
+#include <pidlBackend/json_cscodegen.h>
+#include <pidlBackend/json_stl_codegen.h>
+#include <pidlBackend/jsonreader.h>
+#include <pidlBackend/jsonwriter.h>
+#include <pidlBackend/operation.h>
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+
+    // a module of 'interfaces' interfaces, each with 'types' type definitions: structures referring
+    // to each other, generic aliases and typedef chains, so the generators walk every kind of type
+    std::string typeHeavyIDL(size_t interfaces, size_t types)
+    {
+        std::stringstream ss;
+        ss << "{\"nature\":\"module\",\"name\":\"Bench\",\"body\":[";
+        for (size_t i = 0; i < interfaces; ++i)
+        {
+            ss << (i ? "," : "") << "{\"nature\":\"interface\",\"name\":\"Intf" << i << "\",\"body\":[";
+            for (size_t t = 0; t < types; ++t)
+            {
+                ss << (t ? "," : "") << "{\"nature\":\"typedef\",\"name\":\"T" << t << "\",\"type\":";
+                switch (t % 4)
+                {
+                case 0:
+                    ss << "{\"name\":\"structure\",\"members\":[{\"name\":\"id\",\"type\":\"integer\"},{\"name\":\"label\",\"type\":\"string\"},"
+                       << "{\"name\":\"when\",\"type\":{\"name\":\"nullable\",\"type\":\"datetime\"}}"
+                       << (t ? ",{\"name\":\"prev\",\"type\":{\"name\":\"array\",\"type\":\"T" + std::to_string(t - 4) + "\"}}" : "") << "]}";
+                    break;
+                case 1:
+                    ss << "{\"name\":\"array\",\"type\":\"T" << t - 1 << "\"}";
+                    break;
+                case 2:
+                    ss << "{\"name\":\"tuple\",\"types\":[\"integer\",\"T" << t - 2 << "\",{\"name\":\"nullable\",\"type\":\"float\"}]}";
+                    break;
+                case 3:
+                    ss << "\"T" << t - 1 << "\"";
+                    break;
+                }
+                ss << "}";
+            }
+            ss << ",{\"nature\":\"function\",\"name\":\"func\",\"type\":\"T0\",\"arguments\":[{\"name\":\"a\",\"type\":\"T" << types - 1 << "\"}]}";
+            ss << "]}";
+        }
+        ss << "]}";
+        return ss.str();
+    }
+
+    // one interface with 'functions' functions
+    std::string functionHeavyIDL(size_t functions)
+    {
+        std::stringstream ss;
+        ss << "{\"nature\":\"interface\",\"name\":\"Intf\",\"body\":["
+           << "{\"nature\":\"typedef\",\"name\":\"Rec\",\"type\":{\"name\":\"structure\",\"members\":["
+           << "{\"name\":\"id\",\"type\":\"integer\"},{\"name\":\"label\",\"type\":\"string\"}]}}";
+        for (size_t f = 0; f < functions; ++f)
+            ss << ",{\"nature\":\"function\",\"name\":\"func" << f << "\",\"type\":\"Rec\",\"arguments\":["
+               << "{\"name\":\"a\",\"type\":\"integer\"},{\"name\":\"b\",\"type\":{\"name\":\"array\",\"type\":\"Rec\"}},"
+               << "{\"name\":\"o\",\"type\":\"string\",\"direction\":\"out\"}]}";
+        ss << "]}";
+        return ss.str();
+    }
+
+    // generates code from an already read IDL; the memoized read keeps parsing out of the timing
+    void registerWriter(const std::string & name, const std::shared_ptr<PIDL::Reader> & reader, const std::shared_ptr<PIDL::Read> & read,
+                        std::function<std::shared_ptr<PIDL::Writer>(const std::shared_ptr<std::ostream> &)> createWriter)
+    {
+        Bench::Registrar(name, [reader, read, createWriter](Bench::State & state) {
+            BenchErrorCollector ec;
+            if (!read->run(ec))
+                return;
+            while (state.keepRunning())
+            {
+                auto out = std::make_shared<std::stringstream>();
+                PIDL::Write(reader, read, createWriter(out)).run(ec);
+                Bench::doNotOptimize(out->tellp());
+            }
+        });
+    }
+
+    struct Registration
+    {
+        Registration()
+        {
+            const size_t interfaces = 100, types = 100;
+            auto suffix = "/" + std::to_string(interfaces * types);
+
+            std::shared_ptr<PIDL::Reader> reader = std::make_shared<PIDL::JSONReader>(typeHeavyIDL(interfaces, types));
+            auto read = std::make_shared<PIDL::Read>(reader);
+
+            auto cpp_codegen = std::make_shared<PIDL::JSON_STL_CodeGen>();
+            registerWriter("codegen/cpp_include" + suffix, reader, read, [cpp_codegen](const std::shared_ptr<std::ostream> & out) {
+                return std::make_shared<PIDL::CPPWriter>(PIDL::CPPWriter::Mode::Include, PIDL::CPPWriter::Role::Server, cpp_codegen, out, "bench.h");
+            });
+            registerWriter("codegen/cpp_source" + suffix, reader, read, [cpp_codegen](const std::shared_ptr<std::ostream> & out) {
+                return std::make_shared<PIDL::CPPWriter>(PIDL::CPPWriter::Mode::Source, PIDL::CPPWriter::Role::Server, cpp_codegen, out, "bench.h");
+            });
+
+            auto cs_codegen = std::make_shared<PIDL::JSON_CSCodeGen>();
+            registerWriter("codegen/cs" + suffix, reader, read, [cs_codegen](const std::shared_ptr<std::ostream> & out) {
+                return std::make_shared<PIDL::CSWriter>(PIDL::CSWriter::Role::Server, cs_codegen, out);
+            });
+
+            registerWriter("codegen/json" + suffix, reader, read, [](const std::shared_ptr<std::ostream> & out) {
+                return std::make_shared<PIDL::JSONWriter>(out);
+            });
+
+            // into a file, where flushing on every line costs a system call
+            const size_t functions = 10000;
+            std::shared_ptr<PIDL::Reader> f_reader = std::make_shared<PIDL::JSONReader>(functionHeavyIDL(functions));
+            auto f_read = std::make_shared<PIDL::Read>(f_reader);
+            Bench::Registrar("codegen/file/" + std::to_string(functions), [f_reader, f_read, cpp_codegen](Bench::State & state) {
+                BenchErrorCollector ec;
+                if (!f_read->run(ec))
+                    return;
+                const char * filename = "pidl-bench-codegen.tmp";
+                while (state.keepRunning())
+                {
+                    auto out = std::make_shared<std::ofstream>(filename, std::ios::binary);
+                    PIDL::Write(f_reader, f_read, std::make_shared<PIDL::CPPWriter>(PIDL::CPPWriter::Mode::Source, PIDL::CPPWriter::Role::Server, cpp_codegen, out, "bench.h")).run(ec);
+                    Bench::doNotOptimize(out->tellp());
+                }
+                std::remove(filename);
+            });
+        }
+    } registration;
+
+}
@@ -0,0 +1,125 @@
+
+#include "idlgen.h"
+
+#include <sstream>
+
+namespace IDLGen {
+
+    namespace {
+
+        void jsonStructure(std::ostream & o, size_t depth)
+        {
+            o << "{\"name\":\"structure\",\"members\":[{\"name\":\"id\",\"type\":\"integer\"},{\"name\":\"label\",\"type\":\"string\"},"
+              << "{\"name\":\"when\",\"type\":{\"name\":\"nullable\",\"type\":\"datetime\"}},{\"name\":\"tags\",\"type\":{\"name\":\"array\",\"type\":\"string\"}}";
+            if (depth)
+            {
+                o << ",{\"name\":\"next\",\"type\":";
+                jsonStructure(o, depth - 1);
+                o << "}";
+            }
+            o << "]}";
+        }
+
+        void jsonObject(std::ostream & o, size_t level, size_t nesting)
+        {
+            o << "{\"nature\":\"object\",\"name\":\"Obj" << level << "\",\"body\":["
+              << "{\"nature\":\"property\",\"name\":\"count\",\"type\":\"integer\"},"
+              << "{\"nature\":\"property\",\"name\":\"rec\",\"type\":\"Rec\",\"readonly\":true},"
+              << "{\"nature\":\"method\",\"name\":\"update\",\"type\":\"Rec\",\"arguments\":[{\"name\":\"a\",\"type\":\"integer\"},{\"name\":\"r\",\"type\":\"Recs\",\"direction\":\"in-out\"}]}";
+            if (level + 1 < nesting)
+            {
+                o << ",";
+                jsonObject(o, level + 1, nesting);
+                o << ",{\"nature\":\"method\",\"name\":\"child\",\"type\":\"Obj" << level + 1 << "\",\"arguments\":[]}";
+            }
+            o << "]}";
+        }
+
+        void xmlStructure(std::ostream & o, size_t depth)
+        {
+            o << "<type name=\"struct\"><members><member name=\"id\" type=\"integer\"/><member name=\"label\" type=\"string\"/>"
+              << "<member name=\"when\"><type name=\"nullable\" type=\"datetime\"/></member><member name=\"tags\"><type name=\"array\" type=\"string\"/></member>";
+            if (depth)
+            {
+                o << "<member name=\"next\">";
+                xmlStructure(o, depth - 1);
+                o << "</member>";
+            }
+            o << "</members></type>";
+        }
+
+        void xmlObject(std::ostream & o, size_t level, size_t nesting)
+        {
+            o << "<object name=\"Obj" << level << "\"><body>"
+              << "<property name=\"count\" type=\"integer\"/>"
+              << "<property name=\"rec\" type=\"Rec\" readonly=\"true\"/>"
+              << "<method name=\"update\" type=\"Rec\"><arguments><argument name=\"a\" type=\"integer\"/><argument name=\"r\" type=\"Recs\" direction=\"in-out\"/></arguments></method>";
+            if (level + 1 < nesting)
+            {
+                xmlObject(o, level + 1, nesting);
+                o << "<method name=\"child\" type=\"Obj" << level + 1 << "\"><arguments/></method>";
+            }
+            o << "</body></object>";
+        }
+
+    }
+
+    std::string Shape::name() const
+    {
+        return std::to_string(interfaces) + "x" + std::to_string(functions) + "/d" + std::to_string(depth) + "/n" + std::to_string(nesting);
+    }
+
+    std::string json(const Shape & shape)
+    {
+        std::stringstream ss;
+        ss << "{\"nature\":\"module\",\"name\":\"Bench\",\"info\":[{\"name\":\"_jsonPIDL\",\"value\":\"\"}],\"body\":[";
+        for (size_t i = 0; i < shape.interfaces; ++i)
+        {
+            ss << (i ? "," : "") << "{\"nature\":\"interface\",\"name\":\"Intf" << i << "\",\"body\":["
+               << "{\"nature\":\"typedef\",\"name\":\"Rec\",\"type\":";
+            jsonStructure(ss, shape.depth);
+            ss << "},{\"nature\":\"typedef\",\"name\":\"Recs\",\"type\":{\"name\":\"array\",\"type\":\"Rec\"}}";
+            if (shape.nesting)
+            {
+                ss << ",";
+                jsonObject(ss, 0, shape.nesting);
+                ss << ",{\"nature\":\"function\",\"name\":\"root\",\"type\":\"Obj0\",\"arguments\":[]}";
+            }
+            for (size_t f = 0; f < shape.functions; ++f)
+                ss << ",{\"nature\":\"function\",\"name\":\"func" << f << "\",\"type\":\"Rec\",\"arguments\":["
+                   << "{\"name\":\"a\",\"type\":\"integer\"},{\"name\":\"b\",\"type\":\"Recs\"},"
+                   << "{\"name\":\"t\",\"type\":{\"name\":\"tuple\",\"types\":[\"string\",\"float\",\"blob\"]}},"
+                   << "{\"name\":\"o\",\"type\":\"string\",\"direction\":\"out\"}]}";
+            ss << "]}";
+        }
+        ss << "]}";
+        return ss.str();
+    }
+
+    std::string xml(const Shape & shape)
+    {
+        std::stringstream ss;
+        ss << "<module name=\"Bench\"><info><_jsonPIDL/></info><body>";
+        for (size_t i = 0; i < shape.interfaces; ++i)
+        {
+            ss << "<interface name=\"Intf" << i << "\"><body>"
+               << "<typedef name=\"Rec\">";
+            xmlStructure(ss, shape.depth);
+            ss << "</typedef><typedef name=\"Recs\"><type name=\"array\" type=\"Rec\"/></typedef>";
+            if (shape.nesting)
+            {
+                xmlObject(ss, 0, shape.nesting);
+                ss << "<function name=\"root\" type=\"Obj0\"><arguments/></function>";
+            }
+            for (size_t f = 0; f < shape.functions; ++f)
+                ss << "<function name=\"func" << f << "\" type=\"Rec\"><arguments>"
+                   << "<argument name=\"a\" type=\"integer\"/><argument name=\"b\" type=\"Recs\"/>"
+                   << "<argument name=\"t\"><type name=\"tuple\"><types><type name=\"string\"/><type name=\"float\"/><type name=\"blob\"/></types></type></argument>"
+                   << "<argument name=\"o\" type=\"string\" direction=\"out\"/></arguments></function>";
+            ss << "</body></interface>";
+        }
+        ss << "</body></module>";
+        return ss.str();
+    }
+
+}
@@ -0,0 +1,29 @@
+#ifndef __idlgen_h__
+#define __idlgen_h__
+
+#include <cstddef>
+#include <string>
+
+namespace IDLGen {
+
+    // shape of a synthetic IDL: one module of 'interfaces' interfaces, each with
+    // - a structure 'Rec' with 'depth' levels of inline nested structures, and an array alias 'Recs' of it
+    // - 'functions' functions taking and returning them
+    // - a chain of 'nesting' objects, each holding properties, methods and the next object
+    struct Shape
+    {
+        size_t interfaces;
+        size_t functions;
+        size_t depth;
+        size_t nesting;
+
+        std::string name() const;
+    };
+
+    // the same IDL in both input formats; the module carries '_jsonPIDL' info, so completeInfo has work to do
+    std::string json(const Shape & shape);
+    std::string xml(const Shape & shape);
+
+}
+
+#endif //__idlgen_h__
@@ -0,0 +1,7 @@
+
+#include "bench.h"
+
+int main(int argc, char ** argv)
+{
+    return Bench::run(argc, argv);
+}
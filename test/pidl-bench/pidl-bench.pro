@@ -0,0 +1,28 @@
+include("../../global.pri")
+
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += main.cpp \
+    ../pidlCore-bench/bench.cpp \
+    read_bench.cpp \
+    codegen_bench.cpp \
+    idlgen.cpp \
+    stage_bench.cpp
+
+HEADERS += \
+    ../pidlCore-bench/bench.h \
+    benchtools.h \
+    idlgen.h
+
+INCLUDEPATH += ../pidlCore-bench
+
+LIBS += -L../../pidlBackend -lpidlBackend
+INCLUDEPATH += ../../pidlBackend/include
+
+LIBS += -L../../pidlCore -lpidlCore
+INCLUDEPATH += ../../pidlCore/include
+
+LIBS += -lpthread
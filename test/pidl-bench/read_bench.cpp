@@ -0,0 +1,83 @@
+
+#include "bench.h"
+#include "benchtools.h"
+
+#include <pidlBackend/cppwriter.h>
+#include <pidlBackend/json_stl_codegen.h>
+#include <pidlBackend/jsonreader.h>
+#include <pidlBackend/operation.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // a module of 'interfaces' interfaces, each with a structure and 'functions' functions using it
+    std::string largeIDL(size_t interfaces, size_t functions)
+    {
+        std::stringstream ss;
+        ss << "{\"nature\":\"module\",\"name\":\"Bench\",\"body\":[";
+        for (size_t i = 0; i < interfaces; ++i)
+        {
+            ss << (i ? "," : "") << "{\"nature\":\"interface\",\"name\":\"Intf" << i << "\",\"body\":["
+               << "{\"nature\":\"typedef\",\"name\":\"Rec\",\"type\":{\"name\":\"structure\",\"members\":["
+               << "{\"name\":\"id\",\"type\":\"integer\"},{\"name\":\"label\",\"type\":\"string\"},"
+               << "{\"name\":\"when\",\"type\":\"datetime\"},{\"name\":\"tags\",\"type\":{\"name\":\"array\",\"type\":\"string\"}}]}}";
+            for (size_t f = 0; f < functions; ++f)
+                ss << ",{\"nature\":\"function\",\"name\":\"func" << f << "\",\"type\":\"Rec\",\"arguments\":["
+                   << "{\"name\":\"a\",\"type\":\"integer\"},{\"name\":\"b\",\"type\":{\"name\":\"array\",\"type\":\"Rec\"}},"
+                   << "{\"name\":\"o\",\"type\":\"string\",\"direction\":\"out\"}]}";
+            ss << "]}";
+        }
+        ss << "]}";
+        return ss.str();
+    }
+
+    // one job: 'writers' writers sharing one read operation;
+    // 'invalidate' forces a re-read before every writer, like an unmemoized read
+    bool runJob(const std::string & idl, size_t writers, bool invalidate, PIDL::ErrorCollector & ec)
+    {
+        std::shared_ptr<PIDL::Reader> reader = std::make_shared<PIDL::JSONReader>(idl);
+        auto read = std::make_shared<PIDL::Read>(reader);
+        auto codegen = std::make_shared<PIDL::JSON_STL_CodeGen>();
+        for (size_t i = 0; i < writers; ++i)
+        {
+            auto out = std::make_shared<std::stringstream>();
+            auto writer = std::make_shared<PIDL::CPPWriter>(i % 2 ? PIDL::CPPWriter::Mode::Source : PIDL::CPPWriter::Mode::Include,
+                                                            PIDL::CPPWriter::Role::Server, codegen, out, "bench.h");
+            if (invalidate)
+                read->invalidate();
+            if (!PIDL::Write(reader, read, writer).run(ec))
+                return false;
+            Bench::doNotOptimize(out->tellp());
+        }
+        return true;
+    }
+
+    struct Registration
+    {
+        Registration()
+        {
+            auto idl = largeIDL(20, 20);
+            for (size_t writers : { 1, 10 })
+            {
+                auto suffix = "/" + std::to_string(writers);
+
+                Bench::Registrar("read/shared" + suffix, [idl, writers](Bench::State & state) {
+                    BenchErrorCollector ec;
+                    while (state.keepRunning())
+                        runJob(idl, writers, false, ec);
+                });
+
+                Bench::Registrar("read/reread" + suffix, [idl, writers](Bench::State & state) {
+                    BenchErrorCollector ec;
+                    while (state.keepRunning())
+                        runJob(idl, writers, true, ec);
+                });
+            }
+        }
+    } registration;
+
+}
@@ -0,0 +1,123 @@
+
+#include "bench.h"
+#include "benchtools.h"
+#include "idlgen.h"
+
+#include <pidlBackend/cppwriter.h>
+#include <pidlBackend/cswriter.h>
+#include <pidlBackend/json_cscodegen.h>
+#include <pidlBackend/json_stl_codegen.h>
+#include <pidlBackend/jsonreader.h>
+#include <pidlBackend/jsonwriter.h>
+#include <pidlBackend/xmlreader.h>
+
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+
+    // read() ends with completeInfo(); this exposes it, so that it can be timed on its own
+    class InfoReader : public PIDL::JSONReader
+    {
+    public:
+        using PIDL::JSONReader::JSONReader;
+        using PIDL::Reader::completeInfo;
+    };
+
+    typedef std::function<std::shared_ptr<PIDL::Writer>(const std::shared_ptr<std::ostream> &)> WriterFactory;
+
+    void registerWriter(const std::string & name, const std::string & idl, const WriterFactory & createWriter)
+    {
+        Bench::Registrar(name, [idl, createWriter](Bench::State & state) {
+            BenchErrorCollector ec;
+            PIDL::JSONReader reader(idl);
+            if (!reader.read(ec))
+                return;
+            size_t bytes = 0;
+            while (state.keepRunning())
+            {
+                auto out = std::make_shared<std::stringstream>();
+                createWriter(out)->write(&reader, ec);
+                bytes = (size_t)out->tellp();
+            }
+            state.setBytesProcessed(bytes);
+        });
+    }
+
+    void registerShape(const IDLGen::Shape & shape)
+    {
+        auto suffix = "/" + shape.name();
+        auto json = IDLGen::json(shape);
+        auto xml = IDLGen::xml(shape);
+
+        Bench::Registrar("stage/read_json" + suffix, [json](Bench::State & state) {
+            BenchErrorCollector ec;
+            state.setBytesProcessed(json.length());
+            while (state.keepRunning())
+            {
+                PIDL::JSONReader reader(json);
+                reader.read(ec);
+            }
+        });
+
+        Bench::Registrar("stage/read_xml" + suffix, [xml](Bench::State & state) {
+            BenchErrorCollector ec;
+            state.setBytesProcessed(xml.length());
+            while (state.keepRunning())
+            {
+                PIDL::XMLReader reader(xml);
+                reader.read(ec);
+            }
+        });
+
+        Bench::Registrar("stage/complete_info" + suffix, [json](Bench::State & state) {
+            BenchErrorCollector ec;
+            InfoReader reader(json);
+            if (!reader.read(ec))
+                return;
+            while (state.keepRunning())
+                reader.completeInfo(ec);
+        });
+
+        auto cpp_codegen = std::make_shared<PIDL::JSON_STL_CodeGen>();
+        const std::pair<const char *, PIDL::CPPWriter::Mode> cpp_modes[] = {
+            { "include", PIDL::CPPWriter::Mode::Include },
+            { "source", PIDL::CPPWriter::Mode::Source },
+            { "combo", PIDL::CPPWriter::Mode::Combo } };
+        const std::pair<const char *, PIDL::CPPWriter::Role> cpp_roles[] = {
+            { "server", PIDL::CPPWriter::Role::Server },
+            { "client", PIDL::CPPWriter::Role::Client } };
+        for (auto & mode : cpp_modes)
+            for (auto & role : cpp_roles)
+                registerWriter(std::string("stage/cpp_") + mode.first + "_" + role.first + suffix, json,
+                               [cpp_codegen, mode, role](const std::shared_ptr<std::ostream> & out) {
+                    return std::make_shared<PIDL::CPPWriter>(mode.second, role.second, cpp_codegen, out, "bench.h");
+                });
+
+        auto cs_codegen = std::make_shared<PIDL::JSON_CSCodeGen>();
+        const std::pair<const char *, PIDL::CSWriter::Role> cs_roles[] = {
+            { "server", PIDL::CSWriter::Role::Server },
+            { "client", PIDL::CSWriter::Role::Client } };
+        for (auto & role : cs_roles)
+            registerWriter(std::string("stage/cs_") + role.first + suffix, json,
+                           [cs_codegen, role](const std::shared_ptr<std::ostream> & out) {
+                return std::make_shared<PIDL::CSWriter>(role.second, cs_codegen, out);
+            });
+
+        registerWriter("stage/json" + suffix, json, [](const std::shared_ptr<std::ostream> & out) {
+            return std::make_shared<PIDL::JSONWriter>(out);
+        });
+    }
+
+    struct Registration
+    {
+        Registration()
+        {
+            registerShape({ 2, 10, 1, 1 });
+            registerShape({ 10, 100, 3, 3 });
+        }
+    } registration;
+
+}
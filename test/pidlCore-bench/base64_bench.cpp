@@ -0,0 +1,181 @@
+
+#include "bench.h"
+
+#include <pidlCore/base64.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+    // the byte-by-byte codec pidlCore used before PIDL::Base64, kept as the baseline
+    namespace legacy {
+
+        static const std::string base64_chars =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "abcdefghijklmnopqrstuvwxyz"
+            "0123456789+/";
+
+        static inline bool is_base64(char c) {
+            return (isalnum(c) || (c == '+') || (c == '/'));
+        }
+
+        std::string & encode(const std::vector<char> & bin, std::string & ret)
+        {
+            const char * bytes_to_encode = bin.data();
+            size_t in_len = bin.size();
+            int i = 0, j = 0;
+            char char_array_3[3];
+            char char_array_4[4];
+
+            while (in_len--) {
+                char_array_3[i++] = *(bytes_to_encode++);
+                if (i == 3) {
+                    char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
+                    char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
+                    char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
+                    char_array_4[3] = char_array_3[2] & 0x3f;
+                    for (i = 0; (i < 4); i++)
+                        ret += base64_chars[char_array_4[i]];
+                    i = 0;
+                }
+            }
+
+            if (i)
+            {
+                for (j = i; j < 3; j++)
+                    char_array_3[j] = '\0';
+                char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
+                char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
+                char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
+                char_array_4[3] = char_array_3[2] & 0x3f;
+                for (j = 0; (j < i + 1); j++)
+                    ret += base64_chars[char_array_4[j]];
+                while ((i++ < 3))
+                    ret += '=';
+            }
+            return ret;
+        }
+
+        std::vector<char> & decode(std::string const & encoded_string, std::vector<char> & ret)
+        {
+            size_t in_len = encoded_string.size();
+            size_t i = 0, j = 0;
+            int in_ = 0;
+            char char_array_4[4], char_array_3[3];
+
+            while (in_len-- && (encoded_string[in_] != '=') && is_base64(encoded_string[in_])) {
+                char_array_4[i++] = encoded_string[in_]; in_++;
+                if (i == 4) {
+                    for (i = 0; i < 4; i++)
+                        char_array_4[i] = static_cast<unsigned char>(base64_chars.find(char_array_4[i]));
+                    char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
+                    char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
+                    char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
+                    for (i = 0; (i < 3); i++)
+                        ret.push_back(char_array_3[i]);
+                    i = 0;
+                }
+            }
+
+            if (i) {
+                for (j = i; j < 4; j++)
+                    char_array_4[j] = 0;
+                for (j = 0; j < 4; j++)
+                    char_array_4[j] = static_cast<unsigned char>(base64_chars.find(char_array_4[j]));
+                char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
+                char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
+                char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
+                for (j = 0; (j < i - 1); j++) ret.push_back(char_array_3[j]);
+            }
+            return ret;
+        }
+    }
+
+    std::vector<char> randomBytes(size_t size)
+    {
+        std::mt19937 rng(static_cast<unsigned int>(size));
+        std::vector<char> ret(size);
+        for (auto & c : ret)
+            c = static_cast<char>(rng());
+        return ret;
+    }
+
+    const size_t sizes[] = { 64, 1024, 64 * 1024, 1024 * 1024 };
+
+    const struct
+    {
+        const char * name;
+        PIDL::Base64::Engine engine;
+    } engines[] = {
+        { "scalar", PIDL::Base64::Engine::Scalar },
+        { "sse41", PIDL::Base64::Engine::SSE41 },
+        { "avx2", PIDL::Base64::Engine::AVX2 }
+    };
+
+    struct Registration
+    {
+        Registration()
+        {
+            for (size_t size : sizes)
+            {
+                auto suffix = "/" + std::to_string(size);
+
+                Bench::Registrar("base64/encode/legacy" + suffix, [size](Bench::State & state) {
+                    auto in = randomBytes(size);
+                    state.setBytesProcessed(size);
+                    while (state.keepRunning())
+                    {
+                        std::string out;
+                        legacy::encode(in, out);
+                        Bench::doNotOptimize(out);
+                    }
+                });
+
+                Bench::Registrar("base64/decode/legacy" + suffix, [size](Bench::State & state) {
+                    std::string enc;
+                    PIDL::Base64::encode(randomBytes(size), enc);
+                    state.setBytesProcessed(size);
+                    while (state.keepRunning())
+                    {
+                        std::vector<char> out;
+                        legacy::decode(enc, out);
+                        Bench::doNotOptimize(out);
+                    }
+                });
+
+                for (auto & e : engines)
+                {
+                    if (!PIDL::Base64::isSupported(e.engine))
+                        continue;
+                    auto engine = e.engine;
+
+                    Bench::Registrar(std::string("base64/encode/") + e.name + suffix, [size, engine](Bench::State & state) {
+                        auto in = randomBytes(size);
+                        state.setBytesProcessed(size);
+                        while (state.keepRunning())
+                        {
+                            std::string out(PIDL::Base64::encodedLength(in.size()), '\0');
+                            PIDL::Base64::encode(engine, in.data(), in.size(), &out[0]);
+                            Bench::doNotOptimize(out);
+                        }
+                    });
+
+                    Bench::Registrar(std::string("base64/decode/") + e.name + suffix, [size, engine](Bench::State & state) {
+                        std::string enc;
+                        PIDL::Base64::encode(randomBytes(size), enc);
+                        state.setBytesProcessed(size);
+                        while (state.keepRunning())
+                        {
+                            std::vector<char> out(size);
+                            bool ok = PIDL::Base64::decode(engine, enc.data(), enc.length(), out.data());
+                            Bench::doNotOptimize(ok);
+                            Bench::doNotOptimize(out);
+                        }
+                    });
+                }
+            }
+        }
+    } registration;
+
+}
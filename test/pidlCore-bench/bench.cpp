@@ -0,0 +1,172 @@
+
+#include "bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+namespace {
+
+    std::atomic<size_t> allocation_counter(0);
+
+}
+
+// counts every allocation of the process; the array and nothrow forms end up here as well
+void * operator new(size_t size)
+{
+    allocation_counter.fetch_add(1, std::memory_order_relaxed);
+    if (void * p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept
+{
+    free(p);
+}
+
+namespace Bench {
+
+    namespace {
+
+        struct Entry
+        {
+            std::string name;
+            Function function;
+        };
+
+        std::vector<Entry> & registry()
+        {
+            static std::vector<Entry> entries;
+            return entries;
+        }
+
+        struct Result
+        {
+            std::string name;
+            size_t iterations;
+            double ns_per_op;
+            double mb_per_s; // 0 if the benchmark does not report processed bytes
+            double allocs_per_op;
+        };
+
+        // {"format":"pidl-bench/1","benchmarks":[{"name":...,"iterations":...,"ns_per_op":...,"mb_per_s":...,"allocs_per_op":...}, ...]}
+        bool writeJSON(const std::string & filename, const std::vector<Result> & results)
+        {
+            std::ofstream o(filename);
+            if (!o)
+                return false;
+            o << "{\"format\":\"pidl-bench/1\",\"benchmarks\":[";
+            bool is_first = true;
+            for (auto & r : results)
+            {
+                o << (is_first ? "" : ",") << std::endl << "  {\"name\":\"";
+                for (char c : r.name)
+                {
+                    if (c == '"' || c == '\\')
+                        o << '\\';
+                    o << c;
+                }
+                o << "\",\"iterations\":" << r.iterations
+                  << ",\"ns_per_op\":" << std::fixed << std::setprecision(1) << r.ns_per_op
+                  << ",\"mb_per_s\":" << std::setprecision(3) << r.mb_per_s
+                  << ",\"allocs_per_op\":" << std::setprecision(2) << r.allocs_per_op << "}";
+                is_first = false;
+            }
+            o << std::endl << "]}" << std::endl;
+            return (bool)o;
+        }
+
+    }
+
+    size_t allocations()
+    {
+        return allocation_counter.load(std::memory_order_relaxed);
+    }
+
+    State::State(size_t iterations) : _iterations(iterations), _left(iterations)
+    { }
+
+    Registrar::Registrar(const std::string & name, const Function & function)
+    {
+        registry().push_back({ name, function });
+    }
+
+    int run(int argc, char ** argv)
+    {
+        std::string filter, json;
+        double min_time = 0.2;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "-filter") == 0 && i + 1 < argc)
+                filter = argv[++i];
+            else if (strcmp(argv[i], "-min_time") == 0 && i + 1 < argc)
+                min_time = atof(argv[++i]);
+            else if (strcmp(argv[i], "-json") == 0 && i + 1 < argc)
+                json = argv[++i];
+            else
+            {
+                std::cerr << "invalid command line option: '" << argv[i] << "'" << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << std::left << std::setw(48) << "benchmark" << std::right
+                  << std::setw(14) << "iterations" << std::setw(14) << "ns/op" << std::setw(12) << "MB/s" << std::setw(12) << "allocs/op" << std::endl;
+
+        std::vector<Result> results;
+        bool failed = false;
+        for (auto & e : registry())
+        {
+            if (filter.length() && e.name.find(filter) == std::string::npos)
+                continue;
+
+            // grow the iteration count until a run takes long enough to be meaningful
+            size_t iterations = 1;
+            for (;;)
+            {
+                State state(iterations);
+                e.function(state);
+                if (!state.finished())
+                {
+                    std::cout << std::left << std::setw(48) << e.name << " FAILED: the measured loop was not run" << std::endl;
+                    failed = true;
+                    break;
+                }
+                double seconds = state.elapsed().count() / 1e9;
+                if (seconds >= min_time || iterations >= (size_t(1) << 40))
+                {
+                    double ns_per_op = state.elapsed().count() / double(iterations);
+                    double mb_per_s = state.bytesProcessed() ? state.bytesProcessed() * iterations / seconds / 1e6 : 0;
+                    double allocs_per_op = state.allocationsMade() / double(iterations);
+                    results.push_back({ e.name, iterations, ns_per_op, mb_per_s, allocs_per_op });
+                    std::cout << std::left << std::setw(48) << e.name << std::right
+                              << std::setw(14) << iterations << std::setw(14) << std::fixed << std::setprecision(1) << ns_per_op
+                              << std::setw(12);
+                    if (state.bytesProcessed())
+                        std::cout << std::setprecision(1) << mb_per_s;
+                    else
+                        std::cout << "";
+                    std::cout << std::setw(12) << std::setprecision(2) << allocs_per_op << std::endl;
+                    break;
+                }
+                size_t next = seconds > 0 ? size_t(iterations * (min_time * 1.4 / seconds)) : iterations * 10;
+                iterations = std::max(iterations * 2, std::min(next, iterations * 10));
+            }
+        }
+
+        if (json.length() && !writeJSON(json, results))
+        {
+            std::cerr << "unable to write '" << json << "'" << std::endl;
+            return 1;
+        }
+        return failed ? 1 : 0;
+    }
+
+}
@@ -0,0 +1,92 @@
+
+#ifndef __bench_h__
+#define __bench_h__
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace Bench {
+
+    // number of operator new calls made by the process so far
+    size_t allocations();
+
+    // Passed to every benchmark; the measured loop is 'while (state.keepRunning()) { ... }'.
+    // Setup before the loop is excluded from the measurement.
+    class State
+    {
+    public:
+        explicit State(size_t iterations);
+
+        bool keepRunning()
+        {
+            if (_left == _iterations)
+            {
+                _allocations_start = allocations();
+                _start = std::chrono::steady_clock::now();
+            }
+            if (_left)
+            {
+                --_left;
+                return true;
+            }
+            _end = std::chrono::steady_clock::now();
+            _allocations_end = allocations();
+            _finished = true;
+            return false;
+        }
+
+        size_t iterations() const { return _iterations; }
+
+        // false if the benchmark returned before finishing its measured loop
+        bool finished() const { return _finished; }
+
+        void setBytesProcessed(size_t bytes_per_iteration) { _bytes = bytes_per_iteration; }
+        size_t bytesProcessed() const { return _bytes; }
+
+        std::chrono::nanoseconds elapsed() const { return std::chrono::duration_cast<std::chrono::nanoseconds>(_end - _start); }
+
+        // heap allocations made by the measured loop
+        size_t allocationsMade() const { return _allocations_end - _allocations_start; }
+
+    private:
+        size_t _iterations;
+        size_t _left;
+        size_t _bytes = 0;
+        bool _finished = false;
+        size_t _allocations_start = 0, _allocations_end = 0;
+        std::chrono::steady_clock::time_point _start, _end;
+    };
+
+    typedef std::function<void(State &)> Function;
+
+    struct Registrar
+    {
+        Registrar(const std::string & name, const Function & function);
+    };
+
+    template<typename T>
+    inline void doNotOptimize(T const & value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void * sink;
+        sink = &value;
+#endif
+    }
+
+    // command line: [-filter <substring>] [-min_time <seconds>] [-json <results file>]
+    int run(int argc, char ** argv);
+
+}
+
+#define PIDL_BENCH__CONCAT2(a, b) a##b
+#define PIDL_BENCH__CONCAT(a, b) PIDL_BENCH__CONCAT2(a, b)
+
+#define PIDL_BENCHMARK(name) \
+    static void PIDL_BENCH__CONCAT(_bench_, __LINE__)(Bench::State & state); \
+    static Bench::Registrar PIDL_BENCH__CONCAT(_bench_registrar_, __LINE__)(name, PIDL_BENCH__CONCAT(_bench_, __LINE__)); \
+    static void PIDL_BENCH__CONCAT(_bench_, __LINE__)(Bench::State & state)
+
+#endif //__bench_h__
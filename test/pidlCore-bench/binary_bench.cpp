@@ -0,0 +1,120 @@
+
+#include "bench.h"
+
+#include <pidlCore/binarytools.h>
+#include <pidlCore/jsontools.h>
+
+#include <rapidjson/document.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+    // a representative record: id, name, timestamp, score, tags and a small payload
+    typedef std::tuple<long long, std::string, PIDL::DateTime, double, std::vector<std::string>, std::vector<char>> Record;
+
+    std::vector<Record> records(size_t count)
+    {
+        std::vector<Record> ret;
+        for (size_t i = 0; i < count; ++i)
+        {
+            PIDL::DateTime dt;
+            dt.year = 2019; dt.month = 7; dt.day = static_cast<short>(1 + i % 28);
+            dt.hour = 12; dt.minute = static_cast<short>(i % 60); dt.second = 30;
+            dt.nanosecond = 500000000;
+            dt.kind = PIDL::DateTime::UTC;
+            std::vector<char> payload(128);
+            for (size_t j = 0; j < payload.size(); ++j)
+                payload[j] = static_cast<char>(i + j);
+            ret.emplace_back(static_cast<long long>(i) * 1000003, "record #" + std::to_string(i), dt, i * 0.25,
+                             std::vector<std::string>{ "alpha", "beta", "gamma" }, payload);
+        }
+        return ret;
+    }
+
+    std::string toJSON(const std::vector<Record> & values)
+    {
+        PIDL::JSONTools::OutputBuffer buffer;
+        PIDL::JSONTools::Writer w(buffer.buffer());
+        PIDL::JSONTools::writeValue(w, values);
+        return std::string(buffer.data(), buffer.size());
+    }
+
+    PIDL::BinaryTools::Buffer toBinary(const std::vector<Record> & values)
+    {
+        PIDL::BinaryTools::Buffer ret;
+        PIDL::BinaryTools::Writer w(ret);
+        PIDL::BinaryTools::writeValue(w, values);
+        return ret;
+    }
+
+    const size_t counts[] = { 1, 100 };
+
+    struct Registration
+    {
+        Registration()
+        {
+            for (size_t count : counts)
+            {
+                auto suffix = "/" + std::to_string(count);
+
+                Bench::Registrar("marshalling/encode/json" + suffix, [count](Bench::State & state) {
+                    auto in = records(count);
+                    state.setBytesProcessed(toJSON(in).size());
+                    while (state.keepRunning())
+                    {
+                        PIDL::JSONTools::OutputBuffer buffer;
+                        PIDL::JSONTools::Writer w(buffer.buffer());
+                        PIDL::JSONTools::writeValue(w, in);
+                        Bench::doNotOptimize(buffer.size());
+                    }
+                });
+
+                Bench::Registrar("marshalling/encode/binary" + suffix, [count](Bench::State & state) {
+                    auto in = records(count);
+                    state.setBytesProcessed(toBinary(in).size());
+                    PIDL::BinaryTools::Buffer buffer;
+                    while (state.keepRunning())
+                    {
+                        buffer.clear();
+                        PIDL::BinaryTools::Writer w(buffer);
+                        PIDL::BinaryTools::writeValue(w, in);
+                        Bench::doNotOptimize(buffer);
+                    }
+                });
+
+                Bench::Registrar("marshalling/decode/json" + suffix, [count](Bench::State & state) {
+                    auto enc = toJSON(records(count));
+                    state.setBytesProcessed(enc.size());
+                    while (state.keepRunning())
+                    {
+                        rapidjson::Document doc;
+                        doc.Parse(enc.data(), enc.size());
+                        std::vector<Record> out(doc.Size());
+                        bool ok = true;
+                        for (rapidjson::SizeType i = 0; i < doc.Size(); ++i)
+                            ok = ok && PIDL::JSONTools::getValue(doc[i], out[i]);
+                        Bench::doNotOptimize(ok);
+                        Bench::doNotOptimize(out);
+                    }
+                });
+
+                Bench::Registrar("marshalling/decode/binary" + suffix, [count](Bench::State & state) {
+                    auto enc = toBinary(records(count));
+                    state.setBytesProcessed(enc.size());
+                    while (state.keepRunning())
+                    {
+                        PIDL::BinaryTools::Reader r(enc.data(), enc.size());
+                        std::vector<Record> out;
+                        bool ok = PIDL::BinaryTools::readValue(r, out);
+                        Bench::doNotOptimize(ok);
+                        Bench::doNotOptimize(out);
+                    }
+                });
+            }
+        }
+    } registration;
+
+}
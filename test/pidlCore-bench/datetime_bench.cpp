@@ -0,0 +1,119 @@
+#include "bench.h"
+
+#include <pidlCore/datetime.h>
+
+#include <string.h>
+#include <vector>
+
+namespace {
+
+    std::vector<PIDL::DateTime> dateTimes(size_t count, PIDL::DateTime::Kind kind)
+    {
+        std::vector<PIDL::DateTime> ret(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto & dt = ret[i];
+            dt.year = static_cast<short>(1990 + i % 40);
+            dt.month = static_cast<short>(1 + i % 12);
+            dt.day = static_cast<short>(1 + i % 28);
+            dt.hour = static_cast<short>(i % 24);
+            dt.minute = static_cast<short>(i % 60);
+            dt.second = static_cast<short>(i % 60);
+            dt.nanosecond = static_cast<int>(i * 1000);
+            dt.kind = kind;
+        }
+        return ret;
+    }
+
+    std::vector<std::chrono::system_clock::time_point> timepoints(size_t count)
+    {
+        std::vector<std::chrono::system_clock::time_point> ret(count);
+        for (size_t i = 0; i < count; ++i)
+            ret[i] = std::chrono::system_clock::time_point(std::chrono::seconds(631152000 + static_cast<long long>(i) * 1234567));
+        return ret;
+    }
+
+    struct Registration
+    {
+        Registration()
+        {
+            const size_t count = 1000;
+
+            // the libc calls the conversions were made by
+            Bench::Registrar("datetime/libc/mktime", [count](Bench::State & state) {
+                auto dts = dateTimes(count, PIDL::DateTime::Local);
+                size_t i = 0;
+                while (state.keepRunning())
+                {
+                    auto & dt = dts[i++ % count];
+                    tm tmp;
+                    memset(&tmp, 0, sizeof(tm));
+                    tmp.tm_year = dt.year - 1900; tmp.tm_mon = dt.month - 1; tmp.tm_mday = dt.day;
+                    tmp.tm_hour = dt.hour; tmp.tm_min = dt.minute; tmp.tm_sec = dt.second;
+                    tmp.tm_isdst = -1;
+                    Bench::doNotOptimize(mktime(&tmp));
+                }
+            });
+
+            Bench::Registrar("datetime/libc/localtime_r", [count](Bench::State & state) {
+                auto tps = timepoints(count);
+                size_t i = 0;
+                while (state.keepRunning())
+                {
+                    time_t t = std::chrono::duration_cast<std::chrono::seconds>(tps[i++ % count].time_since_epoch()).count();
+                    tm tmp;
+                    Bench::doNotOptimize(localtime_r(&t, &tmp));
+                }
+            });
+
+            for (auto kind : { PIDL::DateTime::UTC, PIDL::DateTime::Local })
+            {
+                auto name = std::string(kind == PIDL::DateTime::UTC ? "utc" : "local");
+
+                Bench::Registrar("datetime/to_timepoint/" + name, [count, kind](Bench::State & state) {
+                    auto dts = dateTimes(count, kind);
+                    size_t i = 0;
+                    while (state.keepRunning())
+                    {
+                        std::chrono::system_clock::time_point tp;
+                        Bench::doNotOptimize(PIDL::fromDateTime(dts[i++ % count], tp));
+                        Bench::doNotOptimize(tp);
+                    }
+                });
+
+                // per DateTime, to be compared with the above
+                Bench::Registrar("datetime/to_timepoints/" + name + "/" + std::to_string(count), [count, kind](Bench::State & state) {
+                    auto dts = dateTimes(count, kind);
+                    std::vector<std::chrono::system_clock::time_point> ret(count);
+                    while (state.keepRunning())
+                    {
+                        Bench::doNotOptimize(PIDL::toTimepoints(dts.data(), count, ret.data()));
+                        Bench::doNotOptimize(ret);
+                    }
+                });
+            }
+
+            Bench::Registrar("datetime/to_datetime", [count](Bench::State & state) {
+                auto tps = timepoints(count);
+                size_t i = 0;
+                while (state.keepRunning())
+                {
+                    PIDL::DateTime dt;
+                    Bench::doNotOptimize(PIDL::toDateTime(tps[i++ % count], dt));
+                    Bench::doNotOptimize(dt);
+                }
+            });
+
+            Bench::Registrar("datetime/to_datetimes/" + std::to_string(count), [count](Bench::State & state) {
+                auto tps = timepoints(count);
+                std::vector<PIDL::DateTime> ret(count);
+                while (state.keepRunning())
+                {
+                    Bench::doNotOptimize(PIDL::toDateTimes(tps.data(), count, ret.data()));
+                    Bench::doNotOptimize(ret);
+                }
+            });
+        }
+    } registration;
+
+}
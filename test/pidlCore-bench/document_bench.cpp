@@ -0,0 +1,58 @@
+
+#include "bench.h"
+
+#include <pidlCore/jsontools.h>
+
+#include <rapidjson/document.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+    // the document of a typical call: the envelope and a few arguments
+    void build(rapidjson::Document & doc, const std::vector<std::string> & tags)
+    {
+        doc.SetObject();
+        PIDL::JSONTools::addValue(doc, doc, "version", 2);
+        rapidjson::Value function(rapidjson::kObjectType);
+        PIDL::JSONTools::addValue(doc, function, "name", "function");
+        PIDL::JSONTools::addValue(doc, function, "variant", "ARG:in:a|in:b");
+        rapidjson::Value arguments(rapidjson::kObjectType);
+        PIDL::JSONTools::addValue(doc, arguments, "a", 42);
+        PIDL::JSONTools::addValue(doc, arguments, "b", tags);
+        PIDL::JSONTools::addValue(doc, function, "arguments", arguments);
+        PIDL::JSONTools::addValue(doc, doc, "function", function);
+    }
+
+    struct Registration
+    {
+        Registration()
+        {
+            for (size_t count : { 1, 100 })
+            {
+                auto suffix = "/" + std::to_string(count);
+                std::vector<std::string> tags(count, "tag of the call");
+
+                Bench::Registrar("document/new" + suffix, [tags](Bench::State & state) {
+                    while (state.keepRunning())
+                    {
+                        rapidjson::Document doc;
+                        build(doc, tags);
+                        Bench::doNotOptimize(doc);
+                    }
+                });
+
+                Bench::Registrar("document/pooled" + suffix, [tags](Bench::State & state) {
+                    while (state.keepRunning())
+                    {
+                        PIDL::JSONTools::PooledDocument doc;
+                        build(doc.document(), tags);
+                        Bench::doNotOptimize(doc.document());
+                    }
+                });
+            }
+        }
+    } registration;
+
+}
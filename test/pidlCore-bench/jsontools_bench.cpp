@@ -0,0 +1,334 @@
+#include "bench.h"
+
+#include <pidlCore/jsontools.h>
+#include <pidlCore/nullable.h>
+
+#include <rapidjson/document.h>
+#include <rapidjson/writer.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+    // the structure of a generated stub ('Rec' of the test IDLs), marshalled member by member
+    // the way JSON_STL_CodeGen emits it
+    struct Inner
+    {
+        long long x;
+        std::vector<long long> y;
+    };
+
+    struct Rec
+    {
+        long long id;
+        std::string label;
+        PIDL::Nullable<PIDL::DateTime> when;
+        bool ok;
+        std::vector<PIDL::Nullable<double>> nums;
+        std::tuple<long long, std::vector<std::string>, std::vector<char>> tup;
+        Inner inner;
+    };
+
+    rapidjson::Value createValue(rapidjson::Document & doc, const Inner & in)
+    {
+        rapidjson::Value v(rapidjson::kObjectType);
+        PIDL::JSONTools::addValue(doc, v, "x", in.x);
+        PIDL::JSONTools::addValue(doc, v, "y", in.y);
+        return v;
+    }
+
+    rapidjson::Value createValue(rapidjson::Document & doc, const Rec & in)
+    {
+        rapidjson::Value v(rapidjson::kObjectType);
+        PIDL::JSONTools::addValue(doc, v, "id", in.id);
+        PIDL::JSONTools::addValue(doc, v, "label", in.label);
+        PIDL::JSONTools::addValue(doc, v, "when", in.when);
+        PIDL::JSONTools::addValue(doc, v, "ok", in.ok);
+        PIDL::JSONTools::addValue(doc, v, "nums", in.nums);
+        PIDL::JSONTools::addValue(doc, v, "tup", in.tup);
+        auto inner = createValue(doc, in.inner);
+        PIDL::JSONTools::addValue(doc, v, "inner", inner);
+        return v;
+    }
+
+    void writeValue(PIDL::JSONTools::Writer & w, const Inner & in)
+    {
+        w.StartObject();
+        PIDL::JSONTools::writeValue(w, "x", in.x);
+        PIDL::JSONTools::writeValue(w, "y", in.y);
+        w.EndObject();
+    }
+
+    void writeValue(PIDL::JSONTools::Writer & w, const Rec & in)
+    {
+        w.StartObject();
+        PIDL::JSONTools::writeValue(w, "id", in.id);
+        PIDL::JSONTools::writeValue(w, "label", in.label);
+        PIDL::JSONTools::writeValue(w, "when", in.when);
+        PIDL::JSONTools::writeValue(w, "ok", in.ok);
+        PIDL::JSONTools::writeValue(w, "nums", in.nums);
+        PIDL::JSONTools::writeValue(w, "tup", in.tup);
+        w.Key("inner");
+        writeValue(w, in.inner);
+        w.EndObject();
+    }
+
+    bool getValue(const rapidjson::Value & v, Inner & ret)
+    {
+        return v.IsObject()
+            & PIDL::JSONTools::getValue(v, "x", ret.x)
+            & PIDL::JSONTools::getValue(v, "y", ret.y);
+    }
+
+    bool getValue(const rapidjson::Value & v, Rec & ret)
+    {
+        if (!v.IsObject())
+            return false;
+        const rapidjson::Value * tup, * inner;
+        return PIDL::JSONTools::getValue(v, "id", ret.id)
+            & PIDL::JSONTools::getValue(v, "label", ret.label)
+            & PIDL::JSONTools::getValue(v, "when", ret.when)
+            & PIDL::JSONTools::getValue(v, "ok", ret.ok)
+            & PIDL::JSONTools::getValue(v, "nums", ret.nums)
+            & (PIDL::JSONTools::getValue(v, "tup", tup) && PIDL::JSONTools::getValue(*tup, ret.tup))
+            & (PIDL::JSONTools::getValue(v, "inner", inner) && getValue(*inner, ret.inner));
+    }
+
+    std::vector<Rec> recs(size_t count)
+    {
+        std::vector<Rec> ret(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto & r = ret[i];
+            r.id = static_cast<long long>(i) * 1000003;
+            r.label = "record #" + std::to_string(i);
+            if (i % 2)
+            {
+                auto & dt = r.when.setNotNull();
+                dt.year = 2019; dt.month = 7; dt.day = static_cast<short>(1 + i % 28);
+                dt.hour = 12; dt.minute = static_cast<short>(i % 60); dt.second = 30;
+                dt.kind = PIDL::DateTime::UTC;
+            }
+            r.ok = i % 3 == 0;
+            r.nums.resize(4);
+            r.nums[1] = i * 0.5;
+            r.nums[3] = i * 0.25;
+            r.tup = std::make_tuple(static_cast<long long>(i), std::vector<std::string>{ "alpha", "beta" }, std::vector<char>(64, static_cast<char>(i)));
+            r.inner.x = static_cast<long long>(i);
+            r.inner.y = { 1, 2, 3 };
+        }
+        return ret;
+    }
+
+    // the document of a call carrying the records as its argument
+    void buildCall(rapidjson::Document & doc, const std::vector<Rec> & in)
+    {
+        doc.SetObject();
+        PIDL::JSONTools::addValue(doc, doc, "version", 2);
+        rapidjson::Value function(rapidjson::kObjectType);
+        PIDL::JSONTools::addValue(doc, function, "name", "func");
+        rapidjson::Value arguments(rapidjson::kObjectType);
+        PIDL::JSONTools::addValue(doc, arguments, "b", in);
+        PIDL::JSONTools::addValue(doc, function, "arguments", arguments);
+        PIDL::JSONTools::addValue(doc, doc, "function", function);
+    }
+
+    std::string toJSON(const std::vector<Rec> & in)
+    {
+        rapidjson::Document doc;
+        buildCall(doc, in);
+        PIDL::JSONTools::OutputBuffer buffer;
+        PIDL::JSONTools::Writer w(buffer.buffer());
+        doc.Accept(w);
+        return std::string(buffer.data(), buffer.size());
+    }
+
+    PIDL::DateTime dateTime()
+    {
+        PIDL::DateTime dt;
+        dt.year = 2019; dt.month = 7; dt.day = 14;
+        dt.hour = 12; dt.minute = 34; dt.second = 56;
+        dt.nanosecond = 500000000;
+        dt.kind = PIDL::DateTime::UTC;
+        return dt;
+    }
+
+    // get/<name>: converting the member 'v' of a document; add/<name>: adding it into a pooled document
+    template<typename T>
+    void registerGetAdd(const std::string & name, const T & value)
+    {
+        Bench::Registrar("jsontools/add/" + name, [value](Bench::State & state) {
+            while (state.keepRunning())
+            {
+                PIDL::JSONTools::PooledDocument doc;
+                auto & d = doc.document();
+                d.SetObject();
+                PIDL::JSONTools::addValue(d, d, "v", value);
+                Bench::doNotOptimize(d);
+            }
+        });
+
+        Bench::Registrar("jsontools/get/" + name, [value](Bench::State & state) {
+            rapidjson::Document doc;
+            doc.SetObject();
+            PIDL::JSONTools::addValue(doc, doc, "v", value);
+            const rapidjson::Value * v;
+            if (!PIDL::JSONTools::getValue(doc, "v", v))
+                return;
+            while (state.keepRunning())
+            {
+                T ret;
+                bool ok = PIDL::JSONTools::getValue(*v, ret);
+                Bench::doNotOptimize(ok);
+                Bench::doNotOptimize(ret);
+            }
+        });
+    }
+
+    // create/<name> in addition, for the types having createValue()
+    template<typename T>
+    void registerType(const std::string & name, const T & value)
+    {
+        Bench::Registrar("jsontools/create/" + name, [value](Bench::State & state) {
+            while (state.keepRunning())
+            {
+                PIDL::JSONTools::PooledDocument doc;
+                auto v = PIDL::JSONTools::createValue(doc.document(), value);
+                Bench::doNotOptimize(v);
+            }
+        });
+
+        registerGetAdd(name, value);
+    }
+
+    // the compact string form of DateTime, to be compared with create/get of 'datetime'
+    void registerCompactDateTime(const PIDL::DateTime & value)
+    {
+        Bench::Registrar("jsontools/create/datetime_compact", [value](Bench::State & state) {
+            while (state.keepRunning())
+            {
+                PIDL::JSONTools::PooledDocument doc;
+                auto v = PIDL::JSONTools::createCompactValue(doc.document(), value);
+                Bench::doNotOptimize(v);
+            }
+        });
+
+        Bench::Registrar("jsontools/get/datetime_compact", [value](Bench::State & state) {
+            rapidjson::Document doc;
+            auto v = PIDL::JSONTools::createCompactValue(doc, value);
+            while (state.keepRunning())
+            {
+                PIDL::DateTime ret;
+                bool ok = PIDL::JSONTools::getValue(v, ret);
+                Bench::doNotOptimize(ok);
+                Bench::doNotOptimize(ret);
+            }
+        });
+    }
+
+    struct Registration
+    {
+        Registration()
+        {
+            registerType("int", 123456);
+            registerType("long_long", 1234567890123LL);
+            registerType("double", 3.14159265358979);
+            registerType("datetime", dateTime());
+            registerCompactDateTime(dateTime());
+            registerType("tuple", std::make_tuple(42LL, std::string("label of the tuple"), 0.5));
+
+            for (size_t size : { 8, 256, 4096 })
+                registerType("string/" + std::to_string(size), std::string(size, 's'));
+
+            for (size_t size : { 16, 1024, 65536 })
+            {
+                std::vector<char> blob(size);
+                for (size_t i = 0; i < size; ++i)
+                    blob[i] = static_cast<char>(i * 7);
+                registerType("blob/" + std::to_string(size), blob);
+            }
+
+            for (size_t size : { 1, 100, 10000 })
+            {
+                std::vector<long long> values(size);
+                for (size_t i = 0; i < size; ++i)
+                    values[i] = static_cast<long long>(i) * 1000003;
+                registerType("vector_long_long/" + std::to_string(size), values);
+                registerType("vector_string/" + std::to_string(size), std::vector<std::string>(size, "element"));
+            }
+
+            PIDL::Nullable<std::string> nullable;
+            registerGetAdd("nullable_string/null", nullable);
+            nullable = std::string("value of the nullable");
+            registerGetAdd("nullable_string/set", nullable);
+#ifdef PIDL__HAS_OPTIONAL
+            std::optional<std::string> optional;
+            registerGetAdd("optional_string/null", optional);
+            optional = "value of the optional";
+            registerGetAdd("optional_string/set", optional);
+#endif
+
+            for (size_t count : { 1, 100 })
+            {
+                auto suffix = "/" + std::to_string(count);
+
+                Bench::Registrar("jsontools/struct/encode" + suffix, [count](Bench::State & state) {
+                    auto in = recs(count);
+                    state.setBytesProcessed(toJSON(in).size());
+                    while (state.keepRunning())
+                    {
+                        PIDL::JSONTools::PooledDocument doc;
+                        buildCall(doc.document(), in);
+                        PIDL::JSONTools::OutputBuffer buffer;
+                        PIDL::JSONTools::Writer w(buffer.buffer());
+                        doc.document().Accept(w);
+                        Bench::doNotOptimize(buffer.size());
+                    }
+                });
+
+                Bench::Registrar("jsontools/struct/encode_writer" + suffix, [count](Bench::State & state) {
+                    auto in = recs(count);
+                    state.setBytesProcessed(toJSON(in).size());
+                    while (state.keepRunning())
+                    {
+                        PIDL::JSONTools::OutputBuffer buffer;
+                        PIDL::JSONTools::Writer w(buffer.buffer());
+                        w.StartObject();
+                        PIDL::JSONTools::writeValue(w, "version", 2);
+                        w.Key("function");
+                        w.StartObject();
+                        PIDL::JSONTools::writeValue(w, "name", "func");
+                        w.Key("arguments");
+                        w.StartObject();
+                        PIDL::JSONTools::writeValue(w, "b", in);
+                        w.EndObject();
+                        w.EndObject();
+                        w.EndObject();
+                        Bench::doNotOptimize(buffer.size());
+                    }
+                });
+
+                Bench::Registrar("jsontools/struct/decode" + suffix, [count](Bench::State & state) {
+                    auto enc = toJSON(recs(count));
+                    state.setBytesProcessed(enc.size());
+                    while (state.keepRunning())
+                    {
+                        PIDL::JSONTools::PooledDocument doc;
+                        auto & d = doc.document();
+                        d.Parse(enc.data(), enc.size());
+                        const rapidjson::Value * function, * arguments;
+                        std::vector<Rec> out;
+                        bool ok = PIDL::JSONTools::getValue(d, "function", function)
+                            && PIDL::JSONTools::getValue(*function, "arguments", arguments)
+                            && PIDL::JSONTools::getValue(*arguments, "b", out);
+                        Bench::doNotOptimize(ok);
+                        Bench::doNotOptimize(out);
+                    }
+                });
+            }
+        }
+    } registration;
+
+}
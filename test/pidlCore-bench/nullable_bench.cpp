@@ -0,0 +1,174 @@
+
+#include "bench.h"
+
+#include <pidlCore/nullable.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+    // the heap allocating nullable pidlCore used before the in-place storage, kept as the baseline
+    namespace legacy {
+
+        template<typename T>
+        class AbstractNullable
+        {
+        public:
+            virtual inline ~AbstractNullable() { }
+
+            inline bool isNull() const { return ptr() == nullptr; }
+            inline operator bool () const { return ptr() != nullptr; }
+
+            inline T & operator * () { return *ptr(); }
+            inline const T & operator * () const { return *ptr(); }
+
+            virtual T * ptr() const = 0;
+        };
+
+        template <typename T>
+        class Nullable : public AbstractNullable<T>
+        {
+        public:
+            inline Nullable(const Nullable<T> & o) : val(o.val ? new T(*o.val) : nullptr)
+            { }
+
+            inline Nullable() : val(nullptr)
+            { }
+
+            virtual inline ~Nullable()
+            {
+                if(val)
+                    delete val;
+            }
+
+            void setNull()
+            {
+                if(val)
+                    delete val;
+                val = nullptr;
+            }
+
+            T & setNotNull()
+            {
+                if(val)
+                    delete val;
+                val = new T();
+                return *val;
+            }
+
+            Nullable<T> & operator = (const Nullable<T> & o)
+            {
+                if(o.val)
+                {
+                    if(val)
+                        *val = *o.val;
+                    else
+                        val = new T(*o.val);
+                }
+                else if(val)
+                {
+                    delete val;
+                    val = nullptr;
+                }
+                return *this;
+            }
+
+            virtual inline T * ptr() const override { return val; }
+
+        private:
+            T * val;
+        };
+
+    }
+
+    // the shape of a generated structure with nullable members
+    template<template<typename> class Nullable_T>
+    struct Record
+    {
+        long long id;
+        Nullable_T<long long> parent;
+        Nullable_T<double> weight;
+        Nullable_T<bool> flag;
+        Nullable_T<std::string> label;
+    };
+
+    template<template<typename> class Nullable_T>
+    void fill(std::vector<Record<Nullable_T>> & records)
+    {
+        long long i = 0;
+        for (auto & r : records)
+        {
+            r.id = i;
+            if (i % 2) r.parent.setNotNull() = i / 2; else r.parent.setNull();
+            if (i % 3) r.weight.setNotNull() = i * 0.5; else r.weight.setNull();
+            r.flag.setNotNull() = (i % 5) == 0;
+            if (i % 4) r.label.setNull(); else r.label.setNotNull() = "label";
+            ++i;
+        }
+    }
+
+    template<template<typename> class Nullable_T>
+    long long sum(const std::vector<Record<Nullable_T>> & records)
+    {
+        long long ret = 0;
+        for (auto & r : records)
+        {
+            if (!r.parent.isNull()) ret += *r.parent;
+            if (!r.weight.isNull()) ret += static_cast<long long>(*r.weight);
+            if (!r.flag.isNull() && *r.flag) ++ret;
+            if (!r.label.isNull()) ret += static_cast<long long>((*r.label).length());
+        }
+        return ret;
+    }
+
+    const size_t sizes[] = { 64, 4096, 256 * 1024 };
+
+    template<template<typename> class Nullable_T>
+    void registerFor(const std::string & name)
+    {
+        for (size_t size : sizes)
+        {
+            auto suffix = "/" + std::to_string(size);
+
+            Bench::Registrar("nullable/fill/" + name + suffix, [size](Bench::State & state) {
+                std::vector<Record<Nullable_T>> records(size);
+                state.setBytesProcessed(size * sizeof(Record<Nullable_T>));
+                while (state.keepRunning())
+                {
+                    fill(records);
+                    Bench::doNotOptimize(records.data());
+                }
+            });
+
+            Bench::Registrar("nullable/read/" + name + suffix, [size](Bench::State & state) {
+                std::vector<Record<Nullable_T>> records(size);
+                fill(records);
+                state.setBytesProcessed(size * sizeof(Record<Nullable_T>));
+                while (state.keepRunning())
+                    Bench::doNotOptimize(sum(records));
+            });
+
+            Bench::Registrar("nullable/copy/" + name + suffix, [size](Bench::State & state) {
+                std::vector<Record<Nullable_T>> records(size);
+                fill(records);
+                state.setBytesProcessed(size * sizeof(Record<Nullable_T>));
+                while (state.keepRunning())
+                {
+                    auto copy = records;
+                    Bench::doNotOptimize(copy.data());
+                }
+            });
+        }
+    }
+
+    struct Registration
+    {
+        Registration()
+        {
+            registerFor<legacy::Nullable>("legacy");
+            registerFor<PIDL::Nullable>("inline");
+        }
+    } registration;
+
+}
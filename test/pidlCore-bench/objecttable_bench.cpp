@@ -0,0 +1,66 @@
+#include "bench.h"
+
+#include <pidlCore/objecttable.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct Object
+    {
+        virtual ~Object() { }
+        long long value = 0;
+    };
+
+    struct Registration
+    {
+        Registration()
+        {
+            for (size_t count : { 1000, 100000, 500000 })
+            {
+                auto suffix = "/" + std::to_string(count);
+
+                // the usual '_get_object' of a server: the objects by their object data
+                Bench::Registrar("objecttable/get/map" + suffix, [count](Bench::State & state) {
+                    std::map<std::string, std::shared_ptr<Object>> objects;
+                    std::vector<std::string> keys;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        keys.push_back("object_" + std::to_string(i * 7919));
+                        objects[keys.back()] = std::make_shared<Object>();
+                    }
+                    size_t i = 0;
+                    while (state.keepRunning())
+                    {
+                        auto it = objects.find(keys[i++ % count]);
+                        Bench::doNotOptimize(it->second->value);
+                    }
+                });
+
+                Bench::Registrar("objecttable/get/table" + suffix, [count](Bench::State & state) {
+                    PIDL::ObjectTable objects;
+                    std::vector<std::string> keys;
+                    for (size_t i = 0; i < count; ++i)
+                        keys.push_back(PIDL::ObjectTable::toString(objects.add(std::make_shared<Object>())));
+                    size_t i = 0;
+                    while (state.keepRunning())
+                    {
+                        auto o = std::static_pointer_cast<Object>(objects.get(PIDL::ObjectTable::fromString(keys[i++ % count])));
+                        Bench::doNotOptimize(o->value);
+                    }
+                });
+            }
+
+            Bench::Registrar("objecttable/add_remove", [](Bench::State & state) {
+                PIDL::ObjectTable objects;
+                auto o = std::make_shared<Object>();
+                while (state.keepRunning())
+                    objects.remove(objects.add(o));
+            });
+        }
+    } registration;
+
+}
@@ -0,0 +1,24 @@
+include("../../global.pri")
+
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += main.cpp \
+    bench.cpp \
+    base64_bench.cpp \
+    binary_bench.cpp \
+    datetime_bench.cpp \
+    document_bench.cpp \
+    jsontools_bench.cpp \
+    nullable_bench.cpp \
+    objecttable_bench.cpp
+
+HEADERS += \
+    bench.h
+
+LIBS += -L../../pidlCore -lpidlCore
+INCLUDEPATH += ../../pidlCore/include
+
+LIBS += -lpthread
@@ -0,0 +1,133 @@
+
+#include "base64_test.h"
+
+#include <cppunit/config/SourcePrefix.h>
+
+#include <pidlCore/base64.h>
+#include <pidlCore/jsontools.h>
+
+#include <cstring>
+#include <random>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(Base64_Test);
+
+namespace {
+
+    const PIDL::Base64::Engine engines[] = { PIDL::Base64::Engine::Scalar, PIDL::Base64::Engine::SSE41, PIDL::Base64::Engine::AVX2 };
+
+    std::vector<char> randomBytes(size_t size, unsigned int seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<char> ret(size);
+        for(auto & c : ret)
+            c = static_cast<char>(rng());
+        return ret;
+    }
+
+}
+
+void Base64_Test::setUp()
+{
+}
+
+void Base64_Test::tearDown()
+{
+}
+
+void Base64_Test::known_vectors()
+{
+    const char * vectors[][2] = {
+        { "", "" },
+        { "f", "Zg==" },
+        { "fo", "Zm8=" },
+        { "foo", "Zm9v" },
+        { "foob", "Zm9vYg==" },
+        { "fooba", "Zm9vYmE=" },
+        { "foobar", "Zm9vYmFy" }
+    };
+
+    for(auto & v : vectors)
+    {
+        std::vector<char> in(v[0], v[0] + strlen(v[0]));
+        std::string enc;
+        CPPUNIT_ASSERT_EQUAL(std::string(v[1]), PIDL::Base64::encode(in, enc));
+
+        std::vector<char> dec;
+        CPPUNIT_ASSERT(PIDL::Base64::decode(enc, dec));
+        CPPUNIT_ASSERT(in == dec);
+    }
+}
+
+void Base64_Test::engines_roundtrip()
+{
+    for(size_t size = 0; size < 200; ++size)
+    {
+        auto in = randomBytes(size, static_cast<unsigned int>(size));
+
+        std::string ref(PIDL::Base64::encodedLength(size), '\0');
+        PIDL::Base64::encode(PIDL::Base64::Engine::Scalar, in.data(), size, &ref[0]);
+
+        for(auto engine : engines)
+        {
+            if(!PIDL::Base64::isSupported(engine))
+                continue;
+
+            std::string enc(PIDL::Base64::encodedLength(size), '\0');
+            PIDL::Base64::encode(engine, in.data(), size, &enc[0]);
+            CPPUNIT_ASSERT_EQUAL(ref, enc);
+
+            size_t dec_size;
+            CPPUNIT_ASSERT(PIDL::Base64::decodedLength(enc.data(), enc.length(), dec_size));
+            CPPUNIT_ASSERT_EQUAL(size, dec_size);
+            std::vector<char> dec(dec_size);
+            CPPUNIT_ASSERT(PIDL::Base64::decode(engine, enc.data(), enc.length(), dec.data()));
+            CPPUNIT_ASSERT(in == dec);
+        }
+    }
+}
+
+void Base64_Test::invalid_input()
+{
+    std::vector<char> dec;
+    CPPUNIT_ASSERT(!PIDL::Base64::decode(std::string("Zg="), dec));
+    CPPUNIT_ASSERT(!PIDL::Base64::decode(std::string("Zh=="), dec));
+    CPPUNIT_ASSERT(!PIDL::Base64::decode(std::string("Zm9="), dec));
+    CPPUNIT_ASSERT(!PIDL::Base64::decode(std::string("===="), dec));
+    CPPUNIT_ASSERT(!PIDL::Base64::decode(std::string("Z=g="), dec));
+
+    auto in = randomBytes(150, 42);
+    std::string enc;
+    PIDL::Base64::encode(in, enc);
+    for(auto engine : engines)
+    {
+        if(!PIDL::Base64::isSupported(engine))
+            continue;
+
+        std::vector<char> out(in.size());
+        for(size_t i = 0; i < enc.length(); ++i)
+        {
+            for(char c : { '!', '=', '\n', '\x80' })
+            {
+                auto tmp = enc;
+                tmp[i] = c;
+                CPPUNIT_ASSERT(!PIDL::Base64::decode(engine, tmp.data(), tmp.length(), out.data()));
+            }
+        }
+    }
+}
+
+void Base64_Test::json_blob()
+{
+    rapidjson::Document doc;
+    doc.SetObject();
+
+    auto in = randomBytes(1000, 7);
+    PIDL::JSONTools::addValue(doc, doc, "blob", in);
+
+    std::vector<char> out;
+    CPPUNIT_ASSERT(PIDL::JSONTools::getValue(doc, "blob", out));
+    CPPUNIT_ASSERT(in == out);
+
+    PIDL::JSONTools::addValue(doc, doc, "invalid", "not base64!");
+    CPPUNIT_ASSERT(!PIDL::JSONTools::getValue(doc, "invalid", out));
+}
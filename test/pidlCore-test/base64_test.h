@@ -0,0 +1,28 @@
+
+#ifndef __base64_test_h__
+#define __base64_test_h__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class Base64_Test : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(Base64_Test);
+    CPPUNIT_TEST(known_vectors);
+    CPPUNIT_TEST(engines_roundtrip);
+    CPPUNIT_TEST(invalid_input);
+    CPPUNIT_TEST(json_blob);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    virtual void setUp() override;
+
+    virtual void tearDown() override;
+
+protected:
+    void known_vectors();
+    void engines_roundtrip();
+    void invalid_input();
+    void json_blob();
+};
+
+#endif //__base64_test_h__
@@ -0,0 +1,247 @@
+
+#include "binary_test.h"
+
+#include <cppunit/config/SourcePrefix.h>
+
+#include <pidlCore/binarytools.h>
+#include <pidlCore/jsontools.h>
+
+#include <rapidjson/document.h>
+
+#include <climits>
+#include <string>
+#include <tuple>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(Binary_Test);
+
+namespace {
+
+    using PIDL::BinaryTools::Buffer;
+    using PIDL::BinaryTools::Reader;
+    using PIDL::BinaryTools::Writer;
+
+    template<typename T>
+    Buffer encode(const T & v)
+    {
+        Buffer ret;
+        Writer w(ret);
+        PIDL::BinaryTools::writeValue(w, v);
+        return ret;
+    }
+
+    // the whole buffer has to be consumed
+    template<typename T>
+    bool decode(const Buffer & b, T & ret)
+    {
+        Reader r(b.data(), b.size());
+        return PIDL::BinaryTools::readValue(r, ret) && r.atEnd();
+    }
+
+    Buffer bytes(std::initializer_list<unsigned char> l)
+    {
+        Buffer ret;
+        for(auto c : l)
+            ret.push_back(static_cast<char>(c));
+        return ret;
+    }
+
+    bool equals(const PIDL::DateTime & a, const PIDL::DateTime & b)
+    {
+        return a.year == b.year && a.month == b.month && a.day == b.day &&
+               a.hour == b.hour && a.minute == b.minute && a.second == b.second &&
+               a.nanosecond == b.nanosecond && a.kind == b.kind;
+    }
+
+    PIDL::DateTime dateTime()
+    {
+        PIDL::DateTime dt;
+        dt.year = 2019; dt.month = 7; dt.day = 31;
+        dt.hour = 23; dt.minute = 59; dt.second = 58;
+        dt.nanosecond = 123000000;
+        dt.kind = PIDL::DateTime::UTC;
+        return dt;
+    }
+
+}
+
+void Binary_Test::setUp()
+{
+}
+
+void Binary_Test::tearDown()
+{
+}
+
+void Binary_Test::varints()
+{
+    CPPUNIT_ASSERT(encode(0ULL) == bytes({ 0x00 }));
+    CPPUNIT_ASSERT(encode(127ULL) == bytes({ 0x7f }));
+    CPPUNIT_ASSERT(encode(300ULL) == bytes({ 0xac, 0x02 }));
+    CPPUNIT_ASSERT(encode(0LL) == bytes({ 0x00 }));
+    CPPUNIT_ASSERT(encode(-1LL) == bytes({ 0x01 }));
+    CPPUNIT_ASSERT(encode(1LL) == bytes({ 0x02 }));
+    CPPUNIT_ASSERT(encode(-64LL) == bytes({ 0x7f }));
+    CPPUNIT_ASSERT(encode(64LL) == bytes({ 0x80, 0x01 }));
+    CPPUNIT_ASSERT_EQUAL(size_t(10), encode(ULLONG_MAX).size());
+
+    for(long long v : { 0LL, 1LL, -1LL, 63LL, -64LL, 1LL << 40, -(1LL << 40), LLONG_MAX, LLONG_MIN })
+    {
+        long long ret;
+        CPPUNIT_ASSERT(decode(encode(v), ret));
+        CPPUNIT_ASSERT_EQUAL(v, ret);
+    }
+
+    for(unsigned long long v : { 0ULL, 127ULL, 128ULL, 1ULL << 63, ULLONG_MAX })
+    {
+        unsigned long long ret;
+        CPPUNIT_ASSERT(decode(encode(v), ret));
+        CPPUNIT_ASSERT_EQUAL(v, ret);
+    }
+}
+
+void Binary_Test::values()
+{
+    {
+        CPPUNIT_ASSERT(encode(1.0) == bytes({ 0, 0, 0, 0, 0, 0, 0xf0, 0x3f }));
+        double ret;
+        CPPUNIT_ASSERT(decode(encode(-2.5e-300), ret));
+        CPPUNIT_ASSERT_EQUAL(-2.5e-300, ret);
+    }
+    {
+        bool ret = false;
+        CPPUNIT_ASSERT(decode(encode(true), ret));
+        CPPUNIT_ASSERT(ret);
+    }
+    {
+        CPPUNIT_ASSERT(encode(std::string("abc")) == bytes({ 3, 'a', 'b', 'c' }));
+        std::string ret;
+        CPPUNIT_ASSERT(decode(encode(std::string("a\0b", 3)), ret));
+        CPPUNIT_ASSERT_EQUAL(std::string("a\0b", 3), ret);
+    }
+    {
+        // raw bytes, no base64
+        std::vector<char> blob = { 0, 1, char(0xff), char(0x80) };
+        CPPUNIT_ASSERT(encode(blob) == bytes({ 4, 0, 1, 0xff, 0x80 }));
+        std::vector<char> ret;
+        CPPUNIT_ASSERT(decode(encode(blob), ret));
+        CPPUNIT_ASSERT(blob == ret);
+    }
+    {
+        auto dt = dateTime();
+        PIDL::DateTime ret;
+        CPPUNIT_ASSERT(decode(encode(dt), ret));
+        CPPUNIT_ASSERT(equals(dt, ret));
+        CPPUNIT_ASSERT(encode(dt).size() <= 16);
+    }
+}
+
+void Binary_Test::containers()
+{
+    {
+        PIDL::Nullable<std::string> n;
+        CPPUNIT_ASSERT(encode(n) == bytes({ 0 }));
+        n = std::string("x");
+        CPPUNIT_ASSERT(encode(n) == bytes({ 1, 1, 'x' }));
+
+        PIDL::Nullable<std::string> ret;
+        CPPUNIT_ASSERT(decode(encode(n), ret));
+        CPPUNIT_ASSERT(!ret.isNull());
+        CPPUNIT_ASSERT_EQUAL(std::string("x"), *ret);
+        CPPUNIT_ASSERT(decode(bytes({ 0 }), ret));
+        CPPUNIT_ASSERT(ret.isNull());
+    }
+    {
+        std::vector<PIDL::Nullable<long long>> v(3);
+        v[0] = 5LL;
+        v[2] = -5LL;
+        CPPUNIT_ASSERT(encode(v) == bytes({ 3, 1, 10, 0, 1, 9 }));
+
+        std::vector<PIDL::Nullable<long long>> ret;
+        CPPUNIT_ASSERT(decode(encode(v), ret));
+        CPPUNIT_ASSERT_EQUAL(size_t(3), ret.size());
+        CPPUNIT_ASSERT_EQUAL(5LL, *ret[0]);
+        CPPUNIT_ASSERT(ret[1].isNull());
+        CPPUNIT_ASSERT_EQUAL(-5LL, *ret[2]);
+    }
+    {
+        auto t = std::make_tuple(42LL, std::string("t"), std::vector<std::string>{ "a", "bc" });
+        CPPUNIT_ASSERT(encode(t) == bytes({ 84, 1, 't', 2, 1, 'a', 2, 'b', 'c' }));
+        decltype(t) ret;
+        CPPUNIT_ASSERT(decode(encode(t), ret));
+        CPPUNIT_ASSERT(t == ret);
+    }
+}
+
+void Binary_Test::invalid_input()
+{
+    {
+        // truncated varint, then one that does not fit 64 bits
+        unsigned long long ret;
+        CPPUNIT_ASSERT(!decode(bytes({ 0x80 }), ret));
+        CPPUNIT_ASSERT(!decode(bytes({ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 }), ret));
+    }
+    {
+        std::string ret;
+        CPPUNIT_ASSERT(!decode(bytes({ 5, 'a', 'b' }), ret));
+    }
+    {
+        double ret;
+        CPPUNIT_ASSERT(!decode(bytes({ 0, 0, 0 }), ret));
+    }
+    {
+        bool ret;
+        CPPUNIT_ASSERT(!decode(bytes({ 2 }), ret));
+    }
+    {
+        int ret;
+        CPPUNIT_ASSERT(!decode(encode(1LL << 40), ret));
+    }
+    {
+        // the count must not exceed the data, so no huge allocation happens
+        std::vector<long long> ret;
+        CPPUNIT_ASSERT(!decode(bytes({ 0xff, 0xff, 0xff, 0xff, 0x0f, 0 }), ret));
+    }
+    {
+        auto b = encode(dateTime());
+        b.back() = 7;
+        PIDL::DateTime ret;
+        CPPUNIT_ASSERT(!decode(b, ret));
+        b.pop_back();
+        CPPUNIT_ASSERT(!decode(b, ret));
+    }
+}
+
+void Binary_Test::json_roundtrip()
+{
+    std::vector<char> blob(300);
+    for(size_t i = 0; i < blob.size(); ++i)
+        blob[i] = static_cast<char>(i * 7);
+    typedef std::tuple<long long, double, std::string, std::vector<char>, std::vector<long long>> Values;
+    Values in(-1234567890123LL, 0.1, "text \"quoted\"", blob, { 1, -2, 300 });
+
+    rapidjson::Document doc;
+    auto json_v = PIDL::JSONTools::createValue(doc, in);
+    Values from_json;
+    CPPUNIT_ASSERT(PIDL::JSONTools::getValue(json_v, from_json));
+
+    auto bin = encode(in);
+    Values from_binary;
+    CPPUNIT_ASSERT(decode(bin, from_binary));
+
+    CPPUNIT_ASSERT(from_json == in);
+    CPPUNIT_ASSERT(from_binary == from_json);
+
+    auto dt = dateTime();
+    PIDL::DateTime dt_json, dt_binary;
+    auto dt_v = PIDL::JSONTools::createValue(doc, dt);
+    CPPUNIT_ASSERT(PIDL::JSONTools::getValue(dt_v, dt_json));
+    CPPUNIT_ASSERT(decode(encode(dt), dt_binary));
+    CPPUNIT_ASSERT(equals(dt_json, dt_binary));
+
+    // the blob alone is base64 inflated by a third in json
+    PIDL::JSONTools::OutputBuffer json;
+    PIDL::JSONTools::Writer w(json.buffer());
+    PIDL::JSONTools::writeValue(w, in);
+    CPPUNIT_ASSERT(bin.size() < json.size() * 3 / 4);
+}
@@ -0,0 +1,30 @@
+
+#ifndef __binary_test_h__
+#define __binary_test_h__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class Binary_Test : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(Binary_Test);
+    CPPUNIT_TEST(varints);
+    CPPUNIT_TEST(values);
+    CPPUNIT_TEST(containers);
+    CPPUNIT_TEST(invalid_input);
+    CPPUNIT_TEST(json_roundtrip);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    virtual void setUp() override;
+
+    virtual void tearDown() override;
+
+protected:
+    void varints();
+    void values();
+    void containers();
+    void invalid_input();
+    void json_roundtrip();
+};
+
+#endif //__binary_test_h__
@@ -4,6 +4,8 @@
 #include <cppunit/config/SourcePrefix.h>
 
 #include <iostream>
+#include <string.h>
+#include <vector>
 
 #include <pidlCore/datetime.h>
 
@@ -106,3 +108,71 @@ void DateTime_Test::utc_test()
         CPPUNIT_ASSERT_EQUAL(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::seconds(1606905263)).count(), PIDL::toTimepoint(dt).time_since_epoch().count());
     }
 }
+
+void DateTime_Test::civil_test()
+{
+    CPPUNIT_ASSERT_EQUAL(0LL, PIDL::daysFromCivil(1970, 1, 1));
+    CPPUNIT_ASSERT_EQUAL(-1LL, PIDL::daysFromCivil(1969, 12, 31));
+    CPPUNIT_ASSERT_EQUAL(11017LL, PIDL::daysFromCivil(2000, 3, 1));
+    CPPUNIT_ASSERT_EQUAL(PIDL::daysFromCivil(2021, 1, 1), PIDL::daysFromCivil(2020, 13, 1));
+    CPPUNIT_ASSERT_EQUAL(PIDL::daysFromCivil(2019, 12, 1), PIDL::daysFromCivil(2020, 0, 1));
+
+    long long year;
+    int month, day;
+    for (long long days = -800000; days < 800000; days += 13)
+    {
+        PIDL::civilFromDays(days, year, month, day);
+        CPPUNIT_ASSERT(month >= 1 && month <= 12 && day >= 1 && day <= 31);
+        CPPUNIT_ASSERT_EQUAL(days, PIDL::daysFromCivil(year, month, day));
+    }
+}
+
+void DateTime_Test::batch_test()
+{
+    //hourly over two years, across the transitions of the local time zone
+    const long long start = 1577836800; //2020-01-01 00:00:00 UTC
+    std::vector<std::chrono::system_clock::time_point> tps;
+    for (long long t = start; t < start + 2 * 366 * 24 * 3600; t += 3600 + 7)
+        tps.push_back(std::chrono::system_clock::time_point(std::chrono::seconds(t)));
+
+    std::vector<PIDL::DateTime> dts(tps.size());
+    CPPUNIT_ASSERT(PIDL::toDateTimes(tps.data(), tps.size(), dts.data()));
+    for (size_t i = 0; i < tps.size(); ++i)
+    {
+        time_t t = std::chrono::duration_cast<std::chrono::seconds>(tps[i].time_since_epoch()).count();
+        tm expected;
+        localtime_r(&t, &expected);
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(expected.tm_year + 1900), dts[i].year);
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(expected.tm_mon + 1), dts[i].month);
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(expected.tm_mday), dts[i].day);
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(expected.tm_hour), dts[i].hour);
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(expected.tm_min), dts[i].minute);
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(expected.tm_sec), dts[i].second);
+    }
+
+    //the same as mktime, including the skipped and the repeated hours
+    std::vector<std::chrono::system_clock::time_point> ret(dts.size());
+    CPPUNIT_ASSERT(PIDL::toTimepoints(dts.data(), dts.size(), ret.data()));
+    for (size_t i = 0; i < dts.size(); ++i)
+    {
+        tm tmp;
+        memset(&tmp, 0, sizeof(tm));
+        tmp.tm_year = dts[i].year - 1900;
+        tmp.tm_mon = dts[i].month - 1;
+        tmp.tm_mday = dts[i].day;
+        tmp.tm_hour = dts[i].hour;
+        tmp.tm_min = dts[i].minute;
+        tmp.tm_sec = dts[i].second;
+        tmp.tm_isdst = -1;
+        CPPUNIT_ASSERT_EQUAL(static_cast<long long>(mktime(&tmp)),
+                             static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(ret[i].time_since_epoch()).count()));
+    }
+
+    PIDL::DateTime invalid;
+    invalid.month = 0;
+    invalid.kind = PIDL::DateTime::UTC;
+    dts.push_back(invalid);
+    ret.resize(dts.size());
+    CPPUNIT_ASSERT(!PIDL::toTimepoints(dts.data(), dts.size(), ret.data()));
+    CPPUNIT_ASSERT(ret[0] == tps[0]);
+}
@@ -11,6 +11,8 @@ class DateTime_Test : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST(chrono_test);
     CPPUNIT_TEST(local_test);
     CPPUNIT_TEST(utc_test);
+    CPPUNIT_TEST(civil_test);
+    CPPUNIT_TEST(batch_test);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -23,6 +25,8 @@ protected:
     void chrono_test();
     void local_test();
     void utc_test();
+    void civil_test();
+    void batch_test();
 };
 
 #endif //__datetime_test_h__
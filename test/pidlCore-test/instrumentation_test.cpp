@@ -0,0 +1,155 @@
+
+#include "instrumentation_test.h"
+
+#include <cppunit/config/SourcePrefix.h>
+
+#include <pidlCore/instrumentation.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(Instrumentation_Test);
+
+void Instrumentation_Test::setUp()
+{
+}
+
+void Instrumentation_Test::tearDown()
+{
+}
+
+void Instrumentation_Test::histogram()
+{
+    PIDL::Instrumentation::Histogram h;
+    for (unsigned long long v : { 0ULL, 1ULL, 2ULL, 3ULL, 4ULL, 1000ULL })
+        h.record(v);
+
+    auto s = h.snapshot();
+    CPPUNIT_ASSERT_EQUAL(6ULL, s.count);
+    CPPUNIT_ASSERT_EQUAL(1010ULL, s.sum);
+    CPPUNIT_ASSERT_EQUAL(1000ULL, s.max);
+    CPPUNIT_ASSERT_EQUAL((size_t)PIDL::Instrumentation::Histogram::BucketCount, s.buckets.size());
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.buckets[0]);  // 0
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.buckets[1]);  // 1
+    CPPUNIT_ASSERT_EQUAL(2ULL, s.buckets[2]);  // 2, 3
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.buckets[3]);  // 4
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.buckets[10]); // 1000
+
+    CPPUNIT_ASSERT_EQUAL(3ULL, s.quantile(0.5));
+    CPPUNIT_ASSERT_EQUAL(1000ULL, s.quantile(0.99));
+
+    h.reset();
+    CPPUNIT_ASSERT_EQUAL(0ULL, h.snapshot().count);
+    CPPUNIT_ASSERT_EQUAL(0ULL, h.snapshot().quantile(0.5));
+}
+
+void Instrumentation_Test::registry()
+{
+    PIDL::Instrumentation::Registry r;
+    auto f = r.function("Intf", "func", "ARG:in:a");
+    CPPUNIT_ASSERT(f == r.function("Intf", "func", "ARG:in:a"));
+    CPPUNIT_ASSERT(f != r.function("Intf", "func", "ARG:in:b"));
+    CPPUNIT_ASSERT(&f->registry() == &r);
+
+    f->callNs.record(100);
+    f->recordStatus(PIDL::InvokeStatus::Error);
+
+    auto s = r.snapshot();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, s.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("Intf"), s[0].scope);
+    CPPUNIT_ASSERT_EQUAL(std::string("func"), s[0].name);
+    CPPUNIT_ASSERT_EQUAL(std::string("ARG:in:a"), s[0].variant);
+    CPPUNIT_ASSERT_EQUAL(1ULL, s[0].callNs.count);
+    CPPUNIT_ASSERT_EQUAL(1ULL, s[0].status[(int)PIDL::InvokeStatus::Error]);
+
+    auto json = r.toJSON();
+    CPPUNIT_ASSERT(json.find("\"name\":\"func\",\"variant\":\"ARG:in:a\"") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"Error\":1") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"call_ns\":{\"count\":1,\"sum\":100,\"max\":100") != std::string::npos);
+
+    r.reset();
+    s = r.snapshot();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, s.size());
+    CPPUNIT_ASSERT_EQUAL(0ULL, s[0].callNs.count);
+    CPPUNIT_ASSERT_EQUAL(0ULL, s[0].status[(int)PIDL::InvokeStatus::Error]);
+}
+
+// the way a generated server function records: unmarshalling, call, marshalling, inside the payload scope of its entry point
+void Instrumentation_Test::call()
+{
+    PIDL::Instrumentation::Registry r;
+    auto f = r.function("Intf", "func", "");
+    {
+        PIDL::Instrumentation::Payload outer(1000);
+        {
+            PIDL::Instrumentation::Payload payload(100);
+            PIDL::Instrumentation::Call call(f);
+            call.unmarshalled();
+            call.called(PIDL::InvokeStatus::Ok);
+        }
+        outer.response(50);
+    }
+    {
+        PIDL::Instrumentation::Call call(f);
+    }
+
+    auto s = r.snapshot()[0];
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.status[(int)PIDL::InvokeStatus::Ok]);
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.status[(int)PIDL::InvokeStatus::MarshallingError]);
+    CPPUNIT_ASSERT_EQUAL(2ULL, s.unmarshalNs.count);
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.callNs.count);
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.marshalNs.count);
+    // only the outermost scope records
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.requestBytes.count);
+    CPPUNIT_ASSERT_EQUAL(1000ULL, s.requestBytes.sum);
+    CPPUNIT_ASSERT_EQUAL(1ULL, s.responseBytes.count);
+    CPPUNIT_ASSERT_EQUAL(50ULL, s.responseBytes.sum);
+}
+
+void Instrumentation_Test::disabled()
+{
+    PIDL::Instrumentation::Registry r;
+    r.setEnabled(false);
+    auto f = r.function("Intf", "func", "");
+    {
+        PIDL::Instrumentation::Payload payload(100);
+        PIDL::Instrumentation::Call call(f);
+        call.unmarshalled();
+        call.called(PIDL::InvokeStatus::Ok);
+    }
+    auto s = r.snapshot()[0];
+    CPPUNIT_ASSERT_EQUAL(0ULL, s.status[(int)PIDL::InvokeStatus::Ok]);
+    CPPUNIT_ASSERT_EQUAL(0ULL, s.unmarshalNs.count);
+    CPPUNIT_ASSERT_EQUAL(0ULL, s.requestBytes.count);
+}
+
+void Instrumentation_Test::concurrent()
+{
+    PIDL::Instrumentation::Registry r;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+        threads.emplace_back([&r, t] {
+            for (int i = 0; i < 1000; ++i)
+            {
+                PIDL::Instrumentation::Payload payload(t + 1);
+                PIDL::Instrumentation::Call call(r.function("Intf", t % 2 ? "odd" : "even", ""));
+                call.unmarshalled();
+                call.called(PIDL::InvokeStatus::Ok);
+            }
+        });
+    for (auto & t : threads)
+        t.join();
+
+    auto s = r.snapshot();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, s.size());
+    unsigned long long calls = 0, bytes = 0;
+    for (auto & f : s)
+    {
+        calls += f.status[(int)PIDL::InvokeStatus::Ok];
+        bytes += f.requestBytes.sum;
+        CPPUNIT_ASSERT_EQUAL(4000ULL, f.marshalNs.count);
+    }
+    CPPUNIT_ASSERT_EQUAL(8000ULL, calls);
+    CPPUNIT_ASSERT_EQUAL(36000ULL, bytes);
+}
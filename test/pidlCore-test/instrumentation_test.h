@@ -0,0 +1,29 @@
+#ifndef __instrumentation_test_h__
+#define __instrumentation_test_h__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class Instrumentation_Test : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(Instrumentation_Test);
+    CPPUNIT_TEST(histogram);
+    CPPUNIT_TEST(registry);
+    CPPUNIT_TEST(call);
+    CPPUNIT_TEST(disabled);
+    CPPUNIT_TEST(concurrent);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    virtual void setUp() override;
+
+    virtual void tearDown() override;
+
+protected:
+    void histogram();
+    void registry();
+    void call();
+    void disabled();
+    void concurrent();
+};
+
+#endif //__instrumentation_test_h__
@@ -6,6 +6,8 @@
 #include <iostream>
 
 #include <pidlCore/jsontools.h>
+#include <pidlCore/exception.h>
+#include <pidlCore/errorcollector.h>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(JSON_Test);
 
@@ -128,3 +130,240 @@ void JSON_Test::set_get_array()
         }
     }
 }
+
+void JSON_Test::writer()
+{
+    PIDL::DateTime dt;
+    dt.year = 2017; dt.month = 3; dt.day = 14;
+    dt.hour = 15; dt.minute = 9; dt.second = 26;
+    dt.nanosecond = 535000000;
+    dt.kind = PIDL::DateTime::UTC;
+
+    std::vector<int> nums = {-1, 0, 42};
+    std::tuple<std::string, double, bool> t(u8"tuskó", 2.5, true);
+    std::vector<char> b = {'b', 'l', 'o', 'b', '\0'};
+
+    rapidjson::Document doc;
+    doc.SetObject();
+    PIDL::JSONTools::addValue(doc, doc, "str", std::string("fejsze"));
+    PIDL::JSONTools::addValue(doc, doc, "ull", 18446744073709551615ull);
+    PIDL::JSONTools::addValue(doc, doc, "dt", dt);
+    PIDL::JSONTools::addValue(doc, doc, "nums", nums);
+    PIDL::JSONTools::addValue(doc, doc, "tuple", t);
+    PIDL::JSONTools::addValue(doc, doc, "blob", b);
+    PIDL::JSONTools::addNull(doc, doc, "null");
+
+    rapidjson::StringBuffer dom_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> dom_writer(dom_buffer);
+    doc.Accept(dom_writer);
+
+    PIDL::JSONTools::OutputBuffer buffer;
+    PIDL::JSONTools::Writer w(buffer.buffer());
+    w.StartObject();
+    PIDL::JSONTools::writeValue(w, "str", std::string("fejsze"));
+    PIDL::JSONTools::writeValue(w, "ull", 18446744073709551615ull);
+    PIDL::JSONTools::writeValue(w, "dt", dt);
+    PIDL::JSONTools::writeValue(w, "nums", nums);
+    PIDL::JSONTools::writeValue(w, "tuple", t);
+    PIDL::JSONTools::writeValue(w, "blob", b);
+    w.Key("null");
+    PIDL::JSONTools::writeNull(w);
+    w.EndObject();
+
+    CPPUNIT_ASSERT(w.IsComplete());
+    CPPUNIT_ASSERT_EQUAL(std::string(dom_buffer.GetString(), dom_buffer.GetSize()), std::string(buffer.data(), buffer.size()));
+
+    std::vector<PIDL::Nullable<int>> nullables(3);
+    nullables[0] = -1;
+    nullables[2] = 42;
+    buffer.buffer().Clear();
+    w.Reset(buffer.buffer());
+    PIDL::JSONTools::writeValue(w, nullables);
+    CPPUNIT_ASSERT_EQUAL(std::string("[-1,null,42]"), std::string(buffer.data(), buffer.size()));
+}
+
+void JSON_Test::output_buffer()
+{
+    {
+        PIDL::JSONTools::OutputBuffer buffer;
+        PIDL::JSONTools::Writer w(buffer.buffer());
+        PIDL::JSONTools::writeValue(w, std::string(1000, 'x'));
+        {
+            // nested use gets a buffer of its own
+            PIDL::JSONTools::OutputBuffer nested;
+            CPPUNIT_ASSERT(&nested.buffer() != &buffer.buffer());
+            CPPUNIT_ASSERT_EQUAL((size_t)0, nested.size());
+        }
+        CPPUNIT_ASSERT_EQUAL((size_t)1002, buffer.size());
+    }
+
+    // the memory of the released buffer is reused, starting empty
+    PIDL::JSONTools::OutputBuffer buffer;
+    CPPUNIT_ASSERT_EQUAL((size_t)0, buffer.size());
+    PIDL::JSONTools::Writer w(buffer.buffer());
+    PIDL::JSONTools::writeValue(w, 42);
+    CPPUNIT_ASSERT_EQUAL(std::string("42"), std::string(buffer.data(), buffer.size()));
+}
+
+void JSON_Test::pooled_document()
+{
+    rapidjson::Document * first;
+    {
+        PIDL::JSONTools::PooledDocument doc;
+        first = &doc.document();
+        doc.document().Parse("{\"a\":[1,2,3]}");
+        CPPUNIT_ASSERT(doc.document().IsObject());
+        {
+            // nested use gets a document of its own
+            PIDL::JSONTools::PooledDocument nested;
+            CPPUNIT_ASSERT(&nested.document() != first);
+        }
+    }
+
+    {
+        // the released document is reused, starting empty
+        PIDL::JSONTools::PooledDocument doc;
+        CPPUNIT_ASSERT(&doc.document() == first);
+        CPPUNIT_ASSERT(doc.document().IsNull());
+        doc.document().SetObject();
+        PIDL::JSONTools::addValue(doc.document(), doc.document(), "str", std::string("fejsze"));
+        std::string str;
+        CPPUNIT_ASSERT(PIDL::JSONTools::getValue(doc.document(), "str", str));
+        CPPUNIT_ASSERT_EQUAL(std::string("fejsze"), str);
+
+        // swapped away from its allocator, so it is not given back
+        rapidjson::Document other;
+        doc.document().Swap(other);
+    }
+
+    PIDL::JSONTools::PooledDocument doc;
+    CPPUNIT_ASSERT(doc.document().IsNull());
+}
+
+
+void JSON_Test::batch_result()
+{
+    std::list<PIDL::Exception::Error> errors = { { 5, "fejsze" } };
+
+    PIDL::JSONTools::OutputBuffer buffer;
+    PIDL::JSONTools::Writer w(buffer.buffer());
+    w.StartArray();
+    PIDL::JSONTools::Batch::writeResult(w, PIDL::InvokeStatus::Ok, "{\"retval\":42}", 13, errors);
+    PIDL::JSONTools::Batch::writeResult(w, PIDL::InvokeStatus::Ok, nullptr, 0, errors);
+    PIDL::JSONTools::Batch::writeResult(w, PIDL::InvokeStatus::Error, nullptr, 0, errors);
+    w.EndArray();
+
+    rapidjson::Document written;
+    written.Parse(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT(written.IsArray());
+
+    rapidjson::Document doc;
+    rapidjson::Value built(rapidjson::kArrayType);
+    rapidjson::Value response(rapidjson::kObjectType);
+    PIDL::JSONTools::addValue(doc, response, "retval", 42);
+    PIDL::JSONTools::Batch::addResult(doc, built, PIDL::InvokeStatus::Ok, response, errors);
+    rapidjson::Value empty;
+    PIDL::JSONTools::Batch::addResult(doc, built, PIDL::InvokeStatus::Ok, empty, errors);
+    rapidjson::Value unused;
+    PIDL::JSONTools::Batch::addResult(doc, built, PIDL::InvokeStatus::Error, unused, errors);
+
+    for (auto * results : { static_cast<const rapidjson::Value *>(&written), static_cast<const rapidjson::Value *>(&built) })
+    {
+        CPPUNIT_ASSERT_EQUAL((rapidjson::SizeType)3, results->Size());
+
+        PIDL::ExceptionErrorCollector<PIDL::ErrorCollector> ec;
+        auto r = PIDL::JSONTools::Batch::getResult((*results)[0], ec);
+        CPPUNIT_ASSERT(r);
+        int retval;
+        CPPUNIT_ASSERT(PIDL::JSONTools::getValue(*r, "retval", retval));
+        CPPUNIT_ASSERT_EQUAL(42, retval);
+
+        r = PIDL::JSONTools::Batch::getResult((*results)[1], ec);
+        CPPUNIT_ASSERT(r);
+        CPPUNIT_ASSERT(r->IsNull());
+        CPPUNIT_ASSERT(ec.errors().empty());
+
+        // the errors of the server are followed by the one of the status
+        CPPUNIT_ASSERT(!PIDL::JSONTools::Batch::getResult((*results)[2], ec));
+        CPPUNIT_ASSERT_EQUAL((size_t)2, ec.errors().size());
+        CPPUNIT_ASSERT_EQUAL(5l, ec.errors().front().first);
+        CPPUNIT_ASSERT_EQUAL(std::string("fejsze"), ec.errors().front().second);
+        CPPUNIT_ASSERT_EQUAL((long)PIDL::InvokeStatus::Error, ec.errors().back().first);
+    }
+
+    PIDL::ExceptionErrorCollector<PIDL::ErrorCollector> ec;
+    CPPUNIT_ASSERT(!PIDL::JSONTools::Batch::getResult(rapidjson::Value(rapidjson::kObjectType), ec));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, ec.errors().size());
+}
+
+void JSON_Test::equals()
+{
+    rapidjson::Document doc;
+    doc.SetObject();
+    PIDL::JSONTools::addValue(doc, doc, "object_data", "state of the object");
+    PIDL::JSONTools::addValue(doc, doc, "number", 42);
+
+    CPPUNIT_ASSERT(PIDL::JSONTools::equals(doc, "object_data", "state of the object"));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::equals(doc, "object_data", "state"));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::equals(doc, "object_data", "state of the objecT"));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::equals(doc, "number", "42"));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::equals(doc, "missing", ""));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::equals(rapidjson::Value(), "object_data", ""));
+}
+
+void JSON_Test::compact_datetime()
+{
+    PIDL::DateTime dt;
+    dt.year = 2020; dt.month = 8; dt.day = 2;
+    dt.hour = 10; dt.minute = 34; dt.second = 23;
+    dt.nanosecond = 5000007;
+    dt.kind = PIDL::DateTime::UTC;
+
+    char buffer[PIDL::JSONTools::compactDateTimeMaxLength];
+    CPPUNIT_ASSERT_EQUAL(std::string("2020-08-02T10:34:23.005000007Z"), std::string(buffer, PIDL::JSONTools::formatDateTime(dt, buffer)));
+
+    rapidjson::Document doc;
+    doc.SetObject();
+    auto v = PIDL::JSONTools::createCompactValue(doc, dt);
+    CPPUNIT_ASSERT(v.IsString());
+    PIDL::DateTime ret;
+    CPPUNIT_ASSERT(PIDL::JSONTools::getValue(v, ret));
+    CPPUNIT_ASSERT_EQUAL(dt.year, ret.year);
+    CPPUNIT_ASSERT_EQUAL(dt.month, ret.month);
+    CPPUNIT_ASSERT_EQUAL(dt.day, ret.day);
+    CPPUNIT_ASSERT_EQUAL(dt.hour, ret.hour);
+    CPPUNIT_ASSERT_EQUAL(dt.minute, ret.minute);
+    CPPUNIT_ASSERT_EQUAL(dt.second, ret.second);
+    CPPUNIT_ASSERT_EQUAL(dt.nanosecond, ret.nanosecond);
+    CPPUNIT_ASSERT(ret.kind == PIDL::DateTime::UTC);
+
+    // the object form is still accepted
+    v = PIDL::JSONTools::createValue(doc, dt);
+    CPPUNIT_ASSERT(v.IsObject());
+    CPPUNIT_ASSERT(PIDL::JSONTools::getValue(v, ret));
+    CPPUNIT_ASSERT_EQUAL(dt.nanosecond, ret.nanosecond);
+
+    CPPUNIT_ASSERT(PIDL::JSONTools::parseDateTime("1999-12-31T23:59:58.5L", 22, ret));
+    CPPUNIT_ASSERT_EQUAL(500000000, ret.nanosecond);
+    CPPUNIT_ASSERT(ret.kind == PIDL::DateTime::Local);
+    CPPUNIT_ASSERT(PIDL::JSONTools::parseDateTime("1999-12-31T23:59:58", 19, ret));
+    CPPUNIT_ASSERT_EQUAL(0, ret.nanosecond);
+    CPPUNIT_ASSERT(ret.kind == PIDL::DateTime::None);
+
+    CPPUNIT_ASSERT(!PIDL::JSONTools::parseDateTime("1999-12-31 23:59:58", 19, ret));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::parseDateTime("1999-12-31T23:59:58.", 20, ret));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::parseDateTime("1999-12-31T23:59:58.1234567890", 30, ret));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::parseDateTime("1999-12-31T23:59:58+01:00", 25, ret));
+    CPPUNIT_ASSERT(!PIDL::JSONTools::parseDateTime("1999-12-31T23:59", 16, ret));
+
+    // out of the layout: the object form is written
+    dt.year = -1;
+    CPPUNIT_ASSERT_EQUAL((size_t)0, PIDL::JSONTools::formatDateTime(dt, buffer));
+    CPPUNIT_ASSERT(PIDL::JSONTools::createCompactValue(doc, dt).IsObject());
+
+    PIDL::JSONTools::OutputBuffer out;
+    PIDL::JSONTools::Writer w(out.buffer());
+    dt.year = 2020; dt.nanosecond = 0; dt.kind = PIDL::DateTime::None;
+    PIDL::JSONTools::writeCompactValue(w, dt);
+    CPPUNIT_ASSERT_EQUAL(std::string("\"2020-08-02T10:34:23\""), std::string(out.data(), out.size()));
+}
@@ -10,6 +10,12 @@ class JSON_Test : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST(double_as_int);
     CPPUNIT_TEST(neg_int);
     CPPUNIT_TEST(set_get_array);
+    CPPUNIT_TEST(writer);
+    CPPUNIT_TEST(output_buffer);
+    CPPUNIT_TEST(pooled_document);
+    CPPUNIT_TEST(batch_result);
+    CPPUNIT_TEST(equals);
+    CPPUNIT_TEST(compact_datetime);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -21,6 +27,12 @@ protected:
     void double_as_int();
     void neg_int();
     void set_get_array();
+    void writer();
+    void output_buffer();
+    void pooled_document();
+    void batch_result();
+    void equals();
+    void compact_datetime();
 };
 
 #endif //__json_test_h__
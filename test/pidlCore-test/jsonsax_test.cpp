@@ -0,0 +1,314 @@
+#include "jsonsax_test.h"
+
+#include <cppunit/config/SourcePrefix.h>
+
+#include <pidlCore/jsonsax.h>
+#include <pidlCore/exception.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(JSONSAX_Test);
+
+namespace {
+
+    typedef PIDL::ExceptionErrorCollector<PIDL::ErrorCollector> ErrorCollector;
+
+    template<typename T>
+    bool parse(const char * json, T & ret)
+    {
+        ErrorCollector ec;
+        return PIDL::JSONTools::SAX::parse(json, strlen(json), ret, ec);
+    }
+
+    struct Point
+    {
+        int x;
+        int y;
+        PIDL::Nullable<std::string> label;
+    };
+
+    // the shape of the code generated for structures
+    struct Context
+    {
+        template<typename T> PIDL::JSONTools::SAX::Slot _slot(T & ret) { return PIDL::JSONTools::SAX::slot(ret, this); }
+
+        PIDL::JSONTools::SAX::Slot _slot(Point & ret)
+        {
+            static const PIDL::JSONTools::SAX::StructureBinder<Point, Context> binder("Point", 3, &Context::_member);
+            return binder.slot(ret, this);
+        }
+
+        PIDL::JSONTools::SAX::Slot _member(Point & ret, const char * key, rapidjson::SizeType length, size_t & index)
+        {
+            if (PIDL::JSONTools::SAX::isKey(key, length, "x", 1)) { index = 0; return _slot(ret.x); }
+            if (PIDL::JSONTools::SAX::isKey(key, length, "y", 1)) { index = 1; return _slot(ret.y); }
+            if (PIDL::JSONTools::SAX::isKey(key, length, "label", 5)) { index = 2; return _slot(ret.label); }
+            return PIDL::JSONTools::SAX::Slot::skip();
+        }
+    };
+
+}
+
+void JSONSAX_Test::setUp()
+{
+}
+
+void JSONSAX_Test::tearDown()
+{
+}
+
+void JSONSAX_Test::primitives()
+{
+    {
+        int tmp_i;
+        CPPUNIT_ASSERT(parse("42", tmp_i));
+        CPPUNIT_ASSERT_EQUAL(42, tmp_i);
+        CPPUNIT_ASSERT(parse("-56.42", tmp_i));
+        CPPUNIT_ASSERT_EQUAL(-56, tmp_i);
+        CPPUNIT_ASSERT(!parse("\"42\"", tmp_i));
+        CPPUNIT_ASSERT(!parse("null", tmp_i));
+    }
+
+    {
+        unsigned int tmp_ui;
+        CPPUNIT_ASSERT(parse("42.56", tmp_ui));
+        CPPUNIT_ASSERT_EQUAL(42u, tmp_ui);
+        CPPUNIT_ASSERT(!parse("-42", tmp_ui));
+    }
+
+    {
+        long long tmp_ll;
+        CPPUNIT_ASSERT(parse("-9223372036854775807", tmp_ll));
+        CPPUNIT_ASSERT_EQUAL(-9223372036854775807ll, tmp_ll);
+
+        unsigned long long tmp_ull;
+        CPPUNIT_ASSERT(parse("18446744073709551615", tmp_ull));
+        CPPUNIT_ASSERT_EQUAL(18446744073709551615ull, tmp_ull);
+        CPPUNIT_ASSERT(!parse("-1", tmp_ull));
+    }
+
+    {
+        double tmp_d;
+        CPPUNIT_ASSERT(parse("42", tmp_d));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(42.0, tmp_d, 0.001);
+
+        bool tmp_b;
+        CPPUNIT_ASSERT(parse("true", tmp_b));
+        CPPUNIT_ASSERT(tmp_b);
+        CPPUNIT_ASSERT(!parse("1", tmp_b));
+
+        std::string tmp_s;
+        CPPUNIT_ASSERT(parse("\"a\\\"b\"", tmp_s));
+        CPPUNIT_ASSERT_EQUAL(std::string("a\"b"), tmp_s);
+    }
+
+    {
+        std::vector<char> blob;
+        CPPUNIT_ASSERT(parse("\"Zm9vYmFy\"", blob));
+        CPPUNIT_ASSERT_EQUAL(std::string("foobar"), std::string(blob.data(), blob.size()));
+        CPPUNIT_ASSERT(!parse("\"Zm9vYmF\"", blob));
+    }
+
+    {
+        int tmp_i;
+        CPPUNIT_ASSERT(!parse("42 43", tmp_i));
+        CPPUNIT_ASSERT(!parse("{", tmp_i));
+    }
+}
+
+void JSONSAX_Test::containers()
+{
+    {
+        std::vector<int> arr;
+        CPPUNIT_ASSERT(parse("[1, 2, 3]", arr));
+        CPPUNIT_ASSERT_EQUAL((size_t)3, arr.size());
+        CPPUNIT_ASSERT_EQUAL(3, arr[2]);
+        CPPUNIT_ASSERT(!parse("[1, \"2\"]", arr));
+        CPPUNIT_ASSERT(!parse("{}", arr));
+    }
+
+    {
+        std::vector<PIDL::Nullable<std::vector<int>>> arr;
+        CPPUNIT_ASSERT(parse("[null, [], [4, 5]]", arr));
+        CPPUNIT_ASSERT_EQUAL((size_t)3, arr.size());
+        CPPUNIT_ASSERT(arr[0].isNull());
+        CPPUNIT_ASSERT(arr[1]->empty());
+        CPPUNIT_ASSERT_EQUAL(5, (*arr[2])[1]);
+    }
+
+    {
+        std::tuple<int, std::string, std::vector<double>> t;
+        CPPUNIT_ASSERT(parse("[1, \"two\", [3.5]]", t));
+        CPPUNIT_ASSERT_EQUAL(1, std::get<0>(t));
+        CPPUNIT_ASSERT_EQUAL(std::string("two"), std::get<1>(t));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, std::get<2>(t)[0], 0.001);
+        CPPUNIT_ASSERT(!parse("[1, \"two\"]", t));
+    }
+
+    {
+        PIDL::DateTime dt;
+        CPPUNIT_ASSERT(parse("{\"year\": 2020, \"month\": 8, \"day\": 2, \"hour\": 10, \"minute\": 34, \"second\": 23, \"millisecond\": 5, \"kind\": \"utc\"}", dt));
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(2020), dt.year);
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(23), dt.second);
+        CPPUNIT_ASSERT_EQUAL(5000000, dt.nanosecond);
+        CPPUNIT_ASSERT(dt.kind == PIDL::DateTime::UTC);
+
+        CPPUNIT_ASSERT(parse("{\"nanosecond\": 7, \"millisecond\": 5, \"year\": 2020, \"month\": 8, \"day\": 2, \"hour\": 10, \"minute\": 34, \"second\": 23}", dt));
+        CPPUNIT_ASSERT_EQUAL(7, dt.nanosecond);
+        CPPUNIT_ASSERT(dt.kind == PIDL::DateTime::None);
+
+        CPPUNIT_ASSERT(!parse("{\"year\": 2020, \"month\": 8, \"day\": 2, \"hour\": 10, \"minute\": 34}", dt));
+
+        CPPUNIT_ASSERT(parse("\"2020-08-02T10:34:23.000000007L\"", dt));
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(8), dt.month);
+        CPPUNIT_ASSERT_EQUAL(7, dt.nanosecond);
+        CPPUNIT_ASSERT(dt.kind == PIDL::DateTime::Local);
+
+        CPPUNIT_ASSERT(!parse("\"2020-08-02\"", dt));
+        CPPUNIT_ASSERT(!parse("20200802", dt));
+    }
+}
+
+void JSONSAX_Test::structure()
+{
+    Context ctx;
+    ErrorCollector ec;
+
+    std::vector<Point> points;
+    const char * json = "[{\"x\": 1, \"y\": 2, \"label\": \"a\"}, {\"label\": null, \"extra\": {\"z\": [1]}, \"y\": 4, \"x\": 3}]";
+    CPPUNIT_ASSERT(PIDL::JSONTools::SAX::parse(json, strlen(json), ctx._slot(points), ec));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, points.size());
+    CPPUNIT_ASSERT_EQUAL(2, points[0].y);
+    CPPUNIT_ASSERT_EQUAL(std::string("a"), *points[0].label);
+    CPPUNIT_ASSERT_EQUAL(3, points[1].x);
+    CPPUNIT_ASSERT(points[1].label.isNull());
+
+    Point p;
+    const char * incomplete = "{\"x\": 1, \"x\": 1, \"label\": null}";
+    CPPUNIT_ASSERT(!PIDL::JSONTools::SAX::parse(incomplete, strlen(incomplete), ctx._slot(p), ec));
+    CPPUNIT_ASSERT(!ec.errors().empty());
+
+    // a repeated member does not stand in for a missing one above the 64th either
+    std::vector<std::string> names;
+    std::vector<int> values(70);
+    std::vector<PIDL::JSONTools::SAX::Member> members;
+    for (size_t i = 0; i < values.size(); ++i)
+        names.push_back("m" + std::to_string(i));
+    for (size_t i = 0; i < values.size(); ++i)
+        members.push_back({ names[i].c_str(), (rapidjson::SizeType)names[i].length(), ctx._slot(values[i]) });
+    PIDL::JSONTools::SAX::Members binder(members.data(), members.size());
+
+    std::string all = "{", duplicated = "{";
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        all += (i ? ", \"" : "\"") + names[i] + "\": " + std::to_string(i);
+        duplicated += (i ? ", \"" : "\"") + names[i == 69 ? 68 : i] + "\": " + std::to_string(i);
+    }
+    all += "}";
+    duplicated += "}";
+    CPPUNIT_ASSERT(PIDL::JSONTools::SAX::parse(all.data(), all.length(), binder.slot(), ec));
+    CPPUNIT_ASSERT_EQUAL(69, values[69]);
+    CPPUNIT_ASSERT(!PIDL::JSONTools::SAX::parse(duplicated.data(), duplicated.length(), binder.slot(), ec));
+}
+
+void JSONSAX_Test::request()
+{
+    Context ctx;
+
+    const char * json = "{\"version\": 2, \"function\": {\"name\": \"move\", \"variant\": \"v1\", \"arguments\": {\"to\": {\"x\": 5, \"y\": 6, \"label\": null}, \"steps\": [1, 2]}}}";
+    PIDL::JSONTools::SAX::Request rq(json, strlen(json));
+    CPPUNIT_ASSERT(rq.isFunctionCall());
+    CPPUNIT_ASSERT_EQUAL(2, rq.version());
+    CPPUNIT_ASSERT_EQUAL(std::string("move"), rq.name());
+    CPPUNIT_ASSERT_EQUAL(std::string("v1"), rq.variant());
+
+    Point _arg_to;
+    std::vector<int> _arg_steps;
+    PIDL::JSONTools::SAX::Member args[] = {
+        { "to", 2, ctx._slot(_arg_to) },
+        { "steps", 5, ctx._slot(_arg_steps) }
+    };
+    ErrorCollector ec;
+    CPPUNIT_ASSERT(rq.readArguments(args, 2, ec));
+    CPPUNIT_ASSERT_EQUAL(6, _arg_to.y);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, _arg_steps.size());
+
+    {
+        const char * no_args = "{\"version\": 2, \"function\": {\"name\": \"ping\"}}";
+        PIDL::JSONTools::SAX::Request rq(no_args, strlen(no_args));
+        CPPUNIT_ASSERT(rq.isFunctionCall());
+        CPPUNIT_ASSERT(rq.variant().empty());
+        CPPUNIT_ASSERT(rq.readArguments(nullptr, 0, ec));
+        CPPUNIT_ASSERT(!rq.readArguments(args, 2, ec));
+        CPPUNIT_ASSERT(!rq.isFallback());
+    }
+
+    {
+        const char * by_id = "{\"version\": 2, \"function\": {\"id\": 3, \"arguments\": {\"to\": {\"x\": 1, \"y\": 2, \"label\": \"a\"}, \"steps\": []}}}";
+        PIDL::JSONTools::SAX::Request rq(by_id, strlen(by_id));
+        CPPUNIT_ASSERT(rq.isFunctionCall());
+        CPPUNIT_ASSERT(rq.hasId());
+        CPPUNIT_ASSERT_EQUAL(3, rq.id());
+        CPPUNIT_ASSERT(rq.name().empty());
+        CPPUNIT_ASSERT(rq.readArguments(args, 2, ec));
+        CPPUNIT_ASSERT_EQUAL(2, _arg_to.y);
+    }
+    CPPUNIT_ASSERT(!rq.hasId());
+
+    {
+        const char * invalid = "{\"version\": 2, \"function\": {\"name\": \"move\", \"arguments\": {\"to\": {\"x\": 5, \"y\": 6, \"label\": null}, \"steps\": 1}}}";
+        PIDL::JSONTools::SAX::Request rq(invalid, strlen(invalid));
+        CPPUNIT_ASSERT(rq.isFunctionCall());
+        CPPUNIT_ASSERT(!rq.readArguments(args, 2, ec));
+        CPPUNIT_ASSERT(!rq.isFallback());
+    }
+
+    {
+        const char * missing = "{\"version\": 2, \"function\": {\"name\": \"move\", \"arguments\": {\"steps\": []}}}";
+        PIDL::JSONTools::SAX::Request rq(missing, strlen(missing));
+        ErrorCollector ec;
+        CPPUNIT_ASSERT(!rq.readArguments(args, 2, ec));
+        CPPUNIT_ASSERT(!rq.isFallback());
+        CPPUNIT_ASSERT_EQUAL(std::string("value 'to' is not found"), ec.errors().front().second);
+    }
+}
+
+void JSONSAX_Test::request_fallback()
+{
+    ErrorCollector ec;
+    std::vector<int> _arg_steps;
+    PIDL::JSONTools::SAX::Member args[] = {
+        { "steps", 5, PIDL::JSONTools::SAX::slot(_arg_steps, (PIDL::JSONTools::SAX::DefaultContext*)nullptr) }
+    };
+
+    const char * not_canonical[] = {
+        "{\"function\": {\"name\": \"f\", \"arguments\": {\"steps\": []}}, \"version\": 2}",
+        "{\"version\": 2, \"function\": {\"arguments\": {\"steps\": []}, \"name\": \"f\"}}",
+        "{\"version\": 2, \"object_call\": {\"object_data\": \"1\"}}",
+        "{\"version\": 2, \"function\": {\"name\": \"f\", \"variant\": null, \"arguments\": {\"steps\": []}}}",
+        "[1, 2]",
+        "{\"version\": 2, \"function\": {\"name\": \"f\"",
+    };
+    for (auto json : not_canonical)
+    {
+        PIDL::JSONTools::SAX::Request rq(json, strlen(json));
+        CPPUNIT_ASSERT(!rq.isFunctionCall());
+        CPPUNIT_ASSERT(!rq.readArguments(args, 1, ec));
+        CPPUNIT_ASSERT(rq.isFallback());
+    }
+
+    const char * trailing[] = {
+        "{\"version\": 2, \"function\": {\"name\": \"f\", \"arguments\": {\"steps\": []}, \"variant\": \"\"}}",
+        "{\"version\": 2, \"function\": {\"name\": \"f\", \"arguments\": {\"steps\": []}}, \"extra\": 1}",
+        "{\"version\": 2, \"function\": {\"name\": \"f\", \"arguments\": {\"steps\": []}}}}",
+    };
+    for (auto json : trailing)
+    {
+        PIDL::JSONTools::SAX::Request rq(json, strlen(json));
+        CPPUNIT_ASSERT(rq.isFunctionCall());
+        CPPUNIT_ASSERT(!rq.readArguments(args, 1, ec));
+        CPPUNIT_ASSERT(rq.isFallback());
+    }
+}
@@ -0,0 +1,30 @@
+
+#ifndef __jsonsax_test_h__
+#define __jsonsax_test_h__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class JSONSAX_Test : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(JSONSAX_Test);
+    CPPUNIT_TEST(primitives);
+    CPPUNIT_TEST(containers);
+    CPPUNIT_TEST(structure);
+    CPPUNIT_TEST(request);
+    CPPUNIT_TEST(request_fallback);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    virtual void setUp() override;
+
+    virtual void tearDown() override;
+
+protected:
+    void primitives();
+    void containers();
+    void structure();
+    void request();
+    void request_fallback();
+};
+
+#endif //__jsonsax_test_h__
@@ -14,7 +14,9 @@
 
 #include <memory>
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include <cppunit/XmlOutputterHook.h>
 #include <cppunit/tools/XmlDocument.h>
@@ -25,6 +27,10 @@
 
 int main(int argc, char ** argv)
 {
+	//the expectations of DateTime_Test are of this zone; it is set before any conversion, as the local zone is cached
+	setenv("TZ", "Europe/Budapest", 1);
+	tzset();
+
 	std::unique_ptr<std::ostream> _outputter_stream_obj;
 	std::ostream * outputter_stream = &std::cout;
 	
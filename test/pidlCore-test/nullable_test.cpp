@@ -0,0 +1,179 @@
+#include "nullable_test.h"
+
+#include <cppunit/config/SourcePrefix.h>
+
+#include <pidlCore/nullable.h>
+#include <pidlCore/jsontools.h>
+
+#include <rapidjson/document.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(Nullable_Test);
+
+namespace {
+
+    // counts the living instances to catch leaked or doubly destroyed values
+    struct Counted
+    {
+        static int alive;
+
+        Counted(int v = 0) : value(v) { ++alive; }
+        Counted(const Counted & o) : value(o.value) { ++alive; }
+        Counted(Counted && o) : value(o.value) { o.value = -1; ++alive; }
+        ~Counted() { --alive; }
+
+        Counted & operator = (const Counted & o) { value = o.value; return *this; }
+        Counted & operator = (Counted && o) { value = o.value; o.value = -1; return *this; }
+
+        int value;
+    };
+
+    int Counted::alive = 0;
+
+    struct Record
+    {
+        long long id;
+        PIDL::Nullable<std::string> label;
+        PIDL::Nullable<double> weight;
+    };
+
+}
+
+void Nullable_Test::setUp()
+{
+}
+
+void Nullable_Test::tearDown()
+{
+}
+
+void Nullable_Test::value_semantics()
+{
+    static_assert(!std::is_polymorphic<PIDL::Nullable<int>>::value, "Nullable must not carry a vtable");
+    static_assert(sizeof(PIDL::Nullable<long long>) <= 2 * sizeof(long long), "Nullable must store the value in place");
+
+    PIDL::Nullable<std::string> n;
+    CPPUNIT_ASSERT(n.isNull());
+    CPPUNIT_ASSERT(!n);
+    CPPUNIT_ASSERT(n.ptr() == nullptr);
+
+    n = std::string("abc");
+    CPPUNIT_ASSERT(!n.isNull());
+    CPPUNIT_ASSERT_EQUAL(std::string("abc"), *n);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), n->length());
+
+    // setNotNull() always hands out a default constructed value
+    CPPUNIT_ASSERT(n.setNotNull().empty());
+    CPPUNIT_ASSERT(!n.isNull());
+
+    CPPUNIT_ASSERT_EQUAL(std::string("xxxx"), n.emplace(4, 'x'));
+
+    PIDL::Nullable<std::string> copy(n);
+    CPPUNIT_ASSERT_EQUAL(std::string("xxxx"), copy.ref());
+    copy.ref() += "y";
+    CPPUNIT_ASSERT_EQUAL(std::string("xxxx"), *n);
+
+    PIDL::Nullable<std::string> moved(std::move(copy));
+    CPPUNIT_ASSERT_EQUAL(std::string("xxxxy"), *moved);
+
+    moved = PIDL::Nullable<std::string>();
+    CPPUNIT_ASSERT(moved.isNull());
+
+    moved = n;
+    CPPUNIT_ASSERT_EQUAL(std::string("xxxx"), *moved);
+
+    const std::string str("from pointer");
+    CPPUNIT_ASSERT_EQUAL(str, *PIDL::Nullable<std::string>(&str));
+    CPPUNIT_ASSERT(PIDL::Nullable<std::string>(static_cast<const std::string *>(nullptr)).isNull());
+
+    n.setNull();
+    CPPUNIT_ASSERT(n.isNull());
+    n.setNull();
+    CPPUNIT_ASSERT(n.isNull());
+}
+
+void Nullable_Test::lifetime()
+{
+    CPPUNIT_ASSERT_EQUAL(0, Counted::alive);
+    {
+        PIDL::Nullable<Counted> a;
+        CPPUNIT_ASSERT_EQUAL(0, Counted::alive);
+
+        a = Counted(1);
+        CPPUNIT_ASSERT_EQUAL(1, Counted::alive);
+
+        a = Counted(2);
+        CPPUNIT_ASSERT_EQUAL(1, Counted::alive);
+        CPPUNIT_ASSERT_EQUAL(2, a->value);
+
+        PIDL::Nullable<Counted> b(a);
+        CPPUNIT_ASSERT_EQUAL(2, Counted::alive);
+
+        PIDL::Nullable<Counted> c(std::move(b));
+        CPPUNIT_ASSERT_EQUAL(3, Counted::alive);
+        CPPUNIT_ASSERT_EQUAL(2, c->value);
+
+        b.setNull();
+        CPPUNIT_ASSERT_EQUAL(2, Counted::alive);
+
+        c = b;
+        CPPUNIT_ASSERT_EQUAL(1, Counted::alive);
+
+        c.emplace(5);
+        CPPUNIT_ASSERT_EQUAL(2, Counted::alive);
+
+        std::vector<PIDL::Nullable<Counted>> v(100);
+        CPPUNIT_ASSERT_EQUAL(2, Counted::alive);
+        for (size_t i = 0; i < v.size(); i += 2)
+            v[i].emplace(static_cast<int>(i));
+        CPPUNIT_ASSERT_EQUAL(52, Counted::alive);
+        v.resize(1000);
+        CPPUNIT_ASSERT_EQUAL(52, Counted::alive);
+        CPPUNIT_ASSERT_EQUAL(98, v[98]->value);
+        CPPUNIT_ASSERT(v[99].isNull());
+    }
+    CPPUNIT_ASSERT_EQUAL(0, Counted::alive);
+}
+
+void Nullable_Test::const_ref()
+{
+    PIDL::Nullable<int> n;
+    PIDL::NullableConstRef<int> r(n);
+    CPPUNIT_ASSERT(r.isNull());
+
+    n = 42;
+    r = n;
+    CPPUNIT_ASSERT(!r.isNull());
+    CPPUNIT_ASSERT_EQUAL(42, *r);
+
+    int i = 7;
+    r = i;
+    CPPUNIT_ASSERT_EQUAL(7, r.ref());
+
+    r = static_cast<int *>(nullptr);
+    CPPUNIT_ASSERT(!r);
+}
+
+void Nullable_Test::json()
+{
+    rapidjson::Document doc;
+    doc.Parse("{\"id\":1,\"label\":\"abc\",\"weight\":null}");
+    CPPUNIT_ASSERT(!doc.HasParseError());
+
+    Record rec;
+    CPPUNIT_ASSERT(PIDL::JSONTools::getValue(doc["label"], rec.label));
+    CPPUNIT_ASSERT(PIDL::JSONTools::getValue(doc["weight"], rec.weight));
+    CPPUNIT_ASSERT_EQUAL(std::string("abc"), *rec.label);
+    CPPUNIT_ASSERT(rec.weight.isNull());
+
+    rapidjson::Document out;
+    out.SetObject();
+    PIDL::JSONTools::addValue(out, out, "label", rec.label);
+    PIDL::JSONTools::addValue(out, out, "weight", rec.weight);
+    CPPUNIT_ASSERT(out["label"].IsString());
+    CPPUNIT_ASSERT_EQUAL(std::string("abc"), std::string(out["label"].GetString()));
+    CPPUNIT_ASSERT(out["weight"].IsNull());
+}
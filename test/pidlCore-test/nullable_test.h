@@ -0,0 +1,27 @@
+#ifndef __nullable_test_h__
+#define __nullable_test_h__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class Nullable_Test : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(Nullable_Test);
+    CPPUNIT_TEST(value_semantics);
+    CPPUNIT_TEST(lifetime);
+    CPPUNIT_TEST(const_ref);
+    CPPUNIT_TEST(json);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    virtual void setUp() override;
+
+    virtual void tearDown() override;
+
+protected:
+    void value_semantics();
+    void lifetime();
+    void const_ref();
+    void json();
+};
+
+#endif //__nullable_test_h__
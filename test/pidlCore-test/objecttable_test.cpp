@@ -0,0 +1,165 @@
+
+#include "objecttable_test.h"
+
+#include <cppunit/config/SourcePrefix.h>
+
+#include <pidlCore/objecttable.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ObjectTable_Test);
+
+void ObjectTable_Test::setUp()
+{
+}
+
+void ObjectTable_Test::tearDown()
+{
+}
+
+void ObjectTable_Test::add_get_remove()
+{
+    PIDL::ObjectTable table;
+    CPPUNIT_ASSERT(!table.get(0));
+
+    // more than the first chunk of slots
+    std::vector<std::pair<PIDL::ObjectTable::Handle, std::shared_ptr<int>>> objects;
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto o = std::make_shared<int>(i);
+        auto h = table.add(o);
+        CPPUNIT_ASSERT(h != 0);
+        objects.push_back(std::make_pair(h, o));
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)10000, table.size());
+
+    for (auto & o : objects)
+        CPPUNIT_ASSERT(table.get(o.first) == o.second);
+
+    std::weak_ptr<int> w = objects[5].second;
+    auto h = objects[5].first;
+    objects[5].second.reset();
+    CPPUNIT_ASSERT(table.remove(h));
+    CPPUNIT_ASSERT(w.expired());
+    CPPUNIT_ASSERT(!table.get(h));
+    CPPUNIT_ASSERT(!table.remove(h));
+    CPPUNIT_ASSERT_EQUAL((size_t)9999, table.size());
+}
+
+void ObjectTable_Test::stale_handles()
+{
+    PIDL::ObjectTable table;
+    auto h1 = table.add(std::make_shared<int>(1));
+    CPPUNIT_ASSERT(table.remove(h1));
+
+    // the slot is reused with a new generation
+    auto o2 = std::make_shared<int>(2);
+    auto h2 = table.add(o2);
+    CPPUNIT_ASSERT(h1 != h2);
+    CPPUNIT_ASSERT_EQUAL((std::uint32_t)h1, (std::uint32_t)h2);
+    CPPUNIT_ASSERT(!table.get(h1));
+    CPPUNIT_ASSERT(!table.remove(h1));
+    CPPUNIT_ASSERT(table.get(h2) == o2);
+
+    // never allocated slots
+    CPPUNIT_ASSERT(!table.get(h2 + 1));
+    CPPUNIT_ASSERT(!table.get(0xffffffffull));
+    CPPUNIT_ASSERT(!table.remove(0xffffffffull));
+}
+
+void ObjectTable_Test::handle_text()
+{
+    PIDL::ObjectTable table;
+    auto h = table.add(std::make_shared<int>(1));
+    CPPUNIT_ASSERT_EQUAL(h, PIDL::ObjectTable::fromString(PIDL::ObjectTable::toString(h)));
+    CPPUNIT_ASSERT_EQUAL((PIDL::ObjectTable::Handle)18446744073709551615ull, PIDL::ObjectTable::fromString("18446744073709551615"));
+
+    CPPUNIT_ASSERT_EQUAL((PIDL::ObjectTable::Handle)0, PIDL::ObjectTable::fromString(""));
+    CPPUNIT_ASSERT_EQUAL((PIDL::ObjectTable::Handle)0, PIDL::ObjectTable::fromString("12a"));
+    CPPUNIT_ASSERT_EQUAL((PIDL::ObjectTable::Handle)0, PIDL::ObjectTable::fromString("-1"));
+    CPPUNIT_ASSERT_EQUAL((PIDL::ObjectTable::Handle)0, PIDL::ObjectTable::fromString("18446744073709551616"));
+}
+
+// lookups of live objects while others are added and removed
+void ObjectTable_Test::concurrent_access()
+{
+    PIDL::ObjectTable table;
+    std::vector<std::pair<PIDL::ObjectTable::Handle, int>> live;
+    for (int i = 0; i < 1000; ++i)
+        live.push_back(std::make_pair(table.add(std::make_shared<int>(i)), i));
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> failed(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+        readers.emplace_back([&] {
+            while (!stop)
+                for (auto & l : live)
+                {
+                    auto o = std::static_pointer_cast<int>(table.get(l.first));
+                    if (!o || *o != l.second)
+                        ++failed;
+                }
+        });
+
+    std::thread writer([&] {
+        for (int i = 0; i < 20000; ++i)
+        {
+            auto h = table.add(std::make_shared<int>(-1));
+            if (!table.remove(h) || table.get(h))
+                ++failed;
+        }
+        stop = true;
+    });
+
+    writer.join();
+    for (auto & t : readers)
+        t.join();
+    CPPUNIT_ASSERT_EQUAL(0, failed.load());
+    CPPUNIT_ASSERT_EQUAL((size_t)1000, table.size());
+}
+
+void ObjectTable_Test::concurrent_reuse()
+{
+    PIDL::ObjectTable table;
+    std::atomic<PIDL::ObjectTable::Handle> current(table.add(std::make_shared<int>(1)));
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> failed(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+        readers.emplace_back([&] {
+            while (!stop)
+            {
+                auto h = current.load();
+                auto o = std::static_pointer_cast<int>(table.get(h));
+                //the object of a handle is the one added with it, whenever the handle resolves
+                if (o && (PIDL::ObjectTable::Handle)*o != h >> 32)
+                    ++failed;
+            }
+        });
+
+    //the same slot is reused by every add()
+    std::thread writer([&] {
+        for (int i = 0; i < 20000; ++i)
+        {
+            auto h = current.load();
+            if (!table.remove(h))
+                ++failed;
+            auto o = std::make_shared<int>(0);
+            *o = (int)(((h >> 32) + 1) & 0xffffffff);
+            current = table.add(o);
+        }
+        stop = true;
+    });
+
+    writer.join();
+    for (auto & t : readers)
+        t.join();
+    CPPUNIT_ASSERT_EQUAL(0, failed.load());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, table.size());
+}
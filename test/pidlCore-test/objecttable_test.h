@@ -0,0 +1,29 @@
+#ifndef __objecttable_test_h__
+#define __objecttable_test_h__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class ObjectTable_Test : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(ObjectTable_Test);
+    CPPUNIT_TEST(add_get_remove);
+    CPPUNIT_TEST(stale_handles);
+    CPPUNIT_TEST(handle_text);
+    CPPUNIT_TEST(concurrent_access);
+    CPPUNIT_TEST(concurrent_reuse);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    virtual void setUp() override;
+
+    virtual void tearDown() override;
+
+protected:
+    void add_get_remove();
+    void stale_handles();
+    void handle_text();
+    void concurrent_access();
+    void concurrent_reuse();
+};
+
+#endif //__objecttable_test_h__
@@ -11,11 +11,31 @@ CONFIG -= qt
 
 SOURCES += main.cpp \
            datetime_test.cpp \
-    json_test.cpp
+    json_test.cpp \
+    base64_test.cpp \
+    jsonsax_test.cpp \
+    nullable_test.cpp \
+    binary_test.cpp \
+    workerpool_test.cpp \
+    instrumentation_test.cpp \
+    objecttable_test.cpp
 
 HEADERS += \
            datetime_test.h \
-    json_test.h
+    json_test.h \
+    base64_test.h \
+    jsonsax_test.h \
+    nullable_test.h \
+    binary_test.h \
+    workerpool_test.h \
+    instrumentation_test.h \
+    objecttable_test.h \
+    pooltest_server.h
+
+OTHER_FILES += \
+    pooltest.json \
+    pooltest_job.json \
+    pooltest_server.cpp
 
 LIBS += -L../../pidlCore -lpidlCore
 INCLUDEPATH += ../../pidlCore/include
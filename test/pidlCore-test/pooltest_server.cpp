@@ -0,0 +1,572 @@
+#include <map>
+#include <functional>
+#include <cstring>
+#include <vector>
+#include <tuple>
+#include <string>
+#include <memory>
+#include <pidlCore/datetime.h>
+#include <pidlCore/exception.h>
+#include <pidlCore/nullable.h>
+#include <pidlCore/jsontools.h>
+#include <pidlCore/basictypes.h>
+#include <pidlCore/errorcollector.h>
+#include <functional>
+#include <pidlCore/workerpool.h>
+
+struct PoolTest::_Priv
+{
+	_Priv(PoolTest * _that_) : _that(_that_), _intf(_that_)
+	{
+	}
+
+	~_Priv()
+	{
+	}
+
+	PoolTest * _that;
+
+	PoolTest * _intf;
+
+	//private members
+
+	_invoke_status _callFunction(const std::string & name, const std::string & variant, const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)
+	{
+		switch (name.length())
+		{
+		case 3:
+			if (memcmp(name.data(), "add", 3) == 0)
+			{
+				if (!variant.length() || (variant.length() == 13 && memcmp(variant.data(), "ARG:in:a|in:b", 13) == 0))
+					return _function_add_0(root, ret, ec);
+				ec << "variant '" + variant + "' of function '" + name + "'is not found";
+				return _invoke_status::NotImplemented;
+			}
+			break;
+		case 4:
+			if (memcmp(name.data(), "fail", 4) == 0)
+			{
+				if (!variant.length() || (variant.length() == 8 && memcmp(variant.data(), "ARG:in:a", 8) == 0))
+					return _function_fail_0(root, ret, ec);
+				ec << "variant '" + variant + "' of function '" + name + "'is not found";
+				return _invoke_status::NotImplemented;
+			}
+			break;
+		case 7:
+			if (memcmp(name.data(), "counter", 7) == 0)
+			{
+				if (!variant.length() || (variant.length() == 8 && memcmp(variant.data(), "ARG:void", 8) == 0))
+					return _function_counter_0(root, ret, ec);
+				ec << "variant '" + variant + "' of function '" + name + "'is not found";
+				return _invoke_status::NotImplemented;
+			}
+			break;
+		case 15:
+			if (memcmp(name.data(), "_dispose_object", 15) == 0)
+			{
+				if (!variant.length())
+					return _function__dispose_object(root, ret, ec);
+				ec << "variant '" + variant + "' of function '" + name + "'is not found";
+				return _invoke_status::NotImplemented;
+			}
+			break;
+		}
+		ec << "function '" + name + "'is not found";
+		return _invoke_status::NotImplemented;
+	}
+
+	template<class F> _invoke_status _callFunction(F && func, _error_collector & ec)
+	{
+		try
+		{
+			func();
+		}
+		catch (exception & e)
+		{
+			e.get(ec); 
+			return _invoke_status::Error;
+		}
+		catch (std::exception & e)
+		{
+			ec.add((long)_invoke_status::FatalError, std::string() + "unhandled exception: '" + e.what() + "'");
+			return _invoke_status::FatalError;
+		}
+		catch (...)
+		{
+			ec.add((long)_invoke_status::FatalError, "unknown unhandled exception");
+			return _invoke_status::FatalError;
+		}
+		return _invoke_status::Ok;
+	}
+
+	_invoke_status _function_add_0(const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)
+	{
+		auto _intf_p = this;
+		long long _arg_a;
+		long long _arg_b;
+		rapidjson::Value * aa;
+		if (!_intf_p->_getValue(r, "arguments", rapidjson::kObjectType, aa, ec))
+			return _invoke_status::MarshallingError;
+		if (
+			!_intf_p->_getValue(*aa, "a", _arg_a, ec)
+			| !_intf_p->_getValue(*aa, "b", _arg_b, ec)
+		)
+			return _invoke_status::MarshallingError;
+		long long retval;
+		auto stat = _callFunction([&](){retval = _that->add(_arg_a, _arg_b); }, ec);
+		if (stat != _invoke_status::Ok)
+			return stat;
+		ret.SetObject();
+		_intf_p->_addValue(ret, ret, "retval", retval);
+		return _invoke_status::Ok;
+	}
+
+	_invoke_status _function_fail_0(const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)
+	{
+		auto _intf_p = this;
+		long long _arg_a;
+		rapidjson::Value * aa;
+		if (!_intf_p->_getValue(r, "arguments", rapidjson::kObjectType, aa, ec))
+			return _invoke_status::MarshallingError;
+		if (
+			!_intf_p->_getValue(*aa, "a", _arg_a, ec)
+		)
+			return _invoke_status::MarshallingError;
+		long long retval;
+		auto stat = _callFunction([&](){retval = _that->fail(_arg_a); }, ec);
+		if (stat != _invoke_status::Ok)
+			return stat;
+		ret.SetObject();
+		_intf_p->_addValue(ret, ret, "retval", retval);
+		return _invoke_status::Ok;
+	}
+
+	_invoke_status _function_counter_0(const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)
+	{
+		auto _intf_p = this;
+		(void)r;
+		ptr<PoolTest::Counter> retval;
+		auto stat = _callFunction([&](){retval = _that->counter(); }, ec);
+		if (stat != _invoke_status::Ok)
+			return stat;
+		ret.SetObject();
+		_intf_p->_addValue(ret, ret, "retval", retval);
+		return _invoke_status::Ok;
+	}
+
+	_invoke_status _function__dispose_object(const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)
+	{
+		auto _intf_p = this;
+		(void)ret;
+		std::string _arg_object_data;
+		nullable<string> _arg_comment;
+		rapidjson::Value * aa;
+		if (!_intf_p->_getValue(r, "arguments", rapidjson::kObjectType, aa, ec))
+			return _invoke_status::MarshallingError;
+		if (!_intf_p->_getValue(*aa, "object_data", _arg_object_data, ec))
+			return _invoke_status::MarshallingError;
+		return  _callFunction([&]() { _that->_dispose_object(_arg_object_data); }, ec);
+	}
+
+	//marshalers
+	bool _getValue(const rapidjson::Value & v, const char * name, rapidjson::Type type, rapidjson::Value *& ret, _error_collector & ec)
+	{
+		if (!PIDL::JSONTools::getValue(v, name, ret))
+		{ ec << std::string() + "value '" + name + "' is not found"; return false; }
+		if (v.GetType() != type)
+		{ ec << std::string() + "value '" + name + "' is invalid"; return false; }
+		return true;
+	}
+
+	template<typename T> bool _getValue(const rapidjson::Value & v, T & ret, _error_collector & ec)
+	{
+		if (!PIDL::JSONTools::getValue(v, ret))
+		{ ec << "value is invalid"; return false; }
+		return true;
+	}
+
+	template<typename T> bool _getValue(const rapidjson::Value & r, const char * name, T & ret, _error_collector & ec)
+	{
+		rapidjson::Value * v;
+		if (!PIDL::JSONTools::getValue(r, name, v) || v->IsNull())
+		{ ec << std::string() + "value '" + name + "' is not found or null"; return false; }
+		return _getValue(*v, ret, ec);
+	}
+
+	template<typename T> bool _getValue(const rapidjson::Value & r, const char * name, ptr<T> & ret, _error_collector & ec)
+	{
+		rapidjson::Value * v;
+		if (!PIDL::JSONTools::getValue(r, name, v))
+		{ ec << std::string() + "value '" + name + "' is not found or null"; return false; }
+		if(v->IsNull())
+		{ ret.reset(); return true; }
+		return _getValue(*v, ret, ec);
+	}
+
+	template<typename T> bool _getValue(const rapidjson::Value & v, nullable<T> & ret, _error_collector & ec)
+	{
+		if (v.IsNull())
+		{ ret.setNull(); return true; }
+		return _getValue(v, ret.setNotNull(), ec);
+	}
+
+	template<typename T> bool _getValue(const rapidjson::Value & r, const char * name, nullable<T> & ret, _error_collector & ec)
+	{
+		rapidjson::Value * v;
+		if (!PIDL::JSONTools::getValue(r, name, v))
+		{ ec << std::string() + "value '" + name + "' is not found"; return false; }
+		return _getValue(*v, ret, ec);
+	}
+
+	template <typename T> bool _getValue(const rapidjson::Value & v, array<T> & ret, _error_collector & ec)
+	{
+		if (!v.IsArray())
+		{ ec << "value is not array"; return false; }
+		ret.resize(v.Size());
+		size_t i(0);
+		bool has_error = false;
+		for (auto it = v.Begin(); it != v.End(); ++it)
+			if (!_getValue(*it, ret[i++], ec)) has_error = true;
+		return !has_error;
+	}
+
+	template <typename T> bool _getValue(const rapidjson::Value & r, const char * name, array<T> & ret, _error_collector & ec)
+	{
+		rapidjson::Value * v;
+		if (!PIDL::JSONTools::getValue(r, name, v))
+		{ ec << std::string() + "value '" + name + "' is not found"; return false; }
+		return _getValue(*v, ret, ec);
+	}
+
+	bool _getValue(const rapidjson::Value & v, blob & ret, _error_collector & ec)
+	{
+		return _getValue<blob>(v, ret, ec);
+	}
+
+	bool _getValue(const rapidjson::Value & r, const char * name, blob & ret, _error_collector & ec)
+	{
+		return _getValue<blob>(r, name, ret, ec);
+	}
+
+	struct _tuple_getValue_functor
+	{
+		_tuple_getValue_functor(_Priv * priv_, const rapidjson::Value & r_, bool & has_error_, _error_collector & ec_) : priv(priv_), r(r_), has_error(has_error_), ec(ec_) { }
+		_Priv * priv;
+		const rapidjson::Value & r;
+		bool & has_error;
+		_error_collector & ec;
+		rapidjson::SizeType idx = 0;
+		template<typename T> void operator () (T && v)
+		{ if (!priv->_getValue(r[idx++], v, ec)) has_error = true; }
+	};
+
+	template<typename ...T> bool _getValue(const rapidjson::Value & v, tuple<T...> & ret, _error_collector & ec)
+	{
+		bool has_error = false;
+		PIDL::JSONTools::for_each_in_tuple(ret, _tuple_getValue_functor(this, v, has_error, ec));
+		if (has_error) ec << "invalid marshalling when tuple value";
+		return !has_error;
+	}
+
+	template<typename ...T> bool _getValue(const rapidjson::Value & r, const char * name, tuple<T...> & ret, _error_collector & ec)
+	{
+		rapidjson::Value * v;
+		if (!PIDL::JSONTools::getValue(r, name, v))
+		{ ec << std::string() + "value '" + name + "' is not found"; return false; }
+		return _getValue(*v, ret, ec);
+	}
+
+	bool _getValue(const rapidjson::Value & v, ptr<PoolTest::Counter> & ret, _error_collector & ec)
+	{
+		nullable<std::string> object_data;
+		if (!PIDL::JSONTools::getValue(v, object_data))
+		{ ec << "value is invalid"; return false; }
+		if (!object_data)
+		{ ret.reset(); return true; }
+		return (bool)(ret = _intf->_get_object<PoolTest::Counter>(*object_data, ec));
+	}
+
+	bool _getValue(const rapidjson::Value & r, const char * name, ptr<PoolTest::Counter> & ret, _error_collector & ec)
+	{
+		rapidjson::Value * v; 
+		if (!PIDL::JSONTools::getValue(r, name, v))
+		{ ec << std::string() + "value '" + name + "' is not found or null"; return false; }
+		if (v->IsNull())
+		{ ret = nullptr; return true; }
+		return _getValue(*v, ret, ec);
+	}
+
+	rapidjson::Value _createValue(rapidjson::Document & doc, const ptr<PoolTest::Counter> & in)
+	{ return in ? PIDL::JSONTools::createValue(doc, in->_data()) : rapidjson::Value(rapidjson::kNullType); }
+
+	template<typename T> rapidjson::Value _createValue(rapidjson::Document & doc, const T & t)
+	{ return PIDL::JSONTools::createValue(doc, t); }
+
+	template<typename T> rapidjson::Value _createValue(rapidjson::Document & doc, const array<T> & values)
+	{
+		rapidjson::Value v(rapidjson::kArrayType);
+		for (auto & _v : values)
+		{ auto tmp = _createValue(doc, _v); v.PushBack(tmp, doc.GetAllocator()); }
+		return v;
+	}
+
+	template<typename T> rapidjson::Value _createValue(rapidjson::Document & doc, const nullable<T> & value)
+	{
+		if (!value) return rapidjson::Value(rapidjson::kNullType);
+		return _createValue(doc, *value);
+	}
+
+	rapidjson::Value _createValue(rapidjson::Document & doc, const blob & data)
+	{ return PIDL::JSONTools::createValue(doc, data); }
+
+	template<typename T> void _addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const T & v)
+	{ auto tmp = _createValue(doc, v); PIDL::JSONTools::addValue(doc, r, name, tmp); }
+
+	template<typename T> void _addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const array<T> & values)
+	{ auto tmp = _createValue<T>(doc, values); PIDL::JSONTools::addValue(doc, r, name, tmp); }
+
+	void _addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const blob & data)
+	{ PIDL::JSONTools::addValue(doc, r, name, data); }
+
+	template<typename T> void _addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const nullable_const_ref<T> & v)
+	{
+		if (!v) PIDL::JSONTools::addNull(doc, r, name);
+		else _addValue(doc, r, name, *v);
+	}
+
+	template<typename T> void _addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const nullable<T> & v)
+	{
+		if (!v) PIDL::JSONTools::addNull(doc, r, name);
+		else _addValue(doc, r, name, *v);
+	}
+
+	struct _tuple_createValue_functor
+	{
+		_tuple_createValue_functor(_Priv * priv_, rapidjson::Document & doc_, rapidjson::Value & r_) : priv(priv_), doc(doc_), r(r_) { }
+		_Priv * priv;
+		rapidjson::Document & doc;
+		rapidjson::Value & r;
+		template<typename T> void operator () (T && v)
+		{ r.PushBack(priv->_createValue(doc, v), doc.GetAllocator()); }
+	};
+	template<typename ...T> rapidjson::Value _createValue(rapidjson::Document & doc, const tuple<T...> & values)
+	{
+		rapidjson::Value v(rapidjson::kArrayType);
+		PIDL::JSONTools::for_each_in_tuple(values, _tuple_createValue_functor(this, doc, v));
+		return v;
+	}
+
+	template<typename ...T> void _addValue(rapidjson::Document & doc, rapidjson::Value & r, const char * name, const tuple<T...> & values)
+	{ auto tmp = _createValue(doc, values); PIDL::JSONTools::addValue(doc, r, name, tmp); }
+
+};
+
+_invoke_status PoolTest::_invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)
+{
+	auto * _p = _priv;
+
+	int version;
+	if (!PIDL::JSONTools::getValue(root, "version", version))
+	{ ec << "could not detect mashalling version"; return _invoke_status::MarshallingError; }
+
+	if (version != 2)
+	{ ec << "unsupported mashalling version detected"; return _invoke_status::NotSupportedMarshallingVersion; }
+
+	rapidjson::Value * v;
+	if (PIDL::JSONTools::getValue(root, "function", v) && v->IsObject())
+	{
+		std::string name, variant;
+		if (!_p->_getValue(*v, "name", name, ec))
+			return _invoke_status::MarshallingError;
+		PIDL::JSONTools::getValue(*v, "variant", variant);
+		ec.clear();
+		return _p->_callFunction(name, variant, *v, ret, ec);
+	}
+	else if (PIDL::JSONTools::getValue(root, "object_call", v) && v->IsObject())
+	{
+		std::string object_data;
+		if (!_p->_getValue(*v, "object_data", object_data, ec))
+			return _invoke_status::MarshallingError;
+		auto obj = _get_object(object_data, ec);
+		if (!obj)
+			return _invoke_status::Error;
+		return obj->_invoke(*v, ret, ec);
+	}
+	return _invoke_status::MarshallingError;
+}
+
+void PoolTest::_invoke(PIDL::WorkerPool & pool, const std::string & request, const std::function<void(_invoke_status status, const std::string & response, const std::list<PIDL::Exception::Error> & errors)> & done)
+{
+	pool.post([this, request, done]() {
+		PIDL::ExceptionErrorCollector<_error_collector> ec;
+		_invoke_status status;
+		std::string response;
+		try
+		{
+			PIDL::JSONTools::PooledDocument root_pooled;
+			rapidjson::Document & root = root_pooled.document();
+			root.Parse(request.data(), request.length());
+			if (root.HasParseError())
+			{
+				ec << std::string() + "could not parse request: " + PIDL::JSONTools::getErrorText(root.GetParseError());
+				status = _invoke_status::MarshallingError;
+			}
+			else
+			{
+				PIDL::JSONTools::OutputBuffer buffer;
+				PIDL::JSONTools::Writer w(buffer.buffer());
+				PIDL::JSONTools::PooledDocument ret_pooled;
+				rapidjson::Document & ret = ret_pooled.document();
+				status = _invoke(root, ret, ec);
+				if (!ret.IsNull())
+					ret.Accept(w);
+				response.assign(buffer.data(), buffer.size());
+			}
+		}
+		catch (exception & e)
+		{
+			e.get(ec);
+			status = _invoke_status::FatalError;
+			response.clear();
+		}
+		catch (std::exception & e)
+		{
+			ec.add((long)_invoke_status::FatalError, std::string() + "unhandled exception: '" + e.what() + "'");
+			status = _invoke_status::FatalError;
+			response.clear();
+		}
+		catch (...)
+		{
+			ec.add((long)_invoke_status::FatalError, "unknown unhandled exception");
+			status = _invoke_status::FatalError;
+			response.clear();
+		}
+		done(status, response, ec.errors());
+	});
+}
+
+struct PoolTest::Counter::_Priv
+{
+	_Priv(Counter * _that_, PoolTest * _intf_): _that(_that_), _intf(_intf_)
+	{
+	}
+
+	~_Priv()
+	{
+	}
+
+	Counter * _that;
+	PoolTest *  _intf;
+	//private members
+
+	_invoke_status _callFunction(const std::string & name, const std::string & variant, const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)
+	{
+		switch (name.length())
+		{
+		case 5:
+			if (memcmp(name.data(), "value", 5) == 0)
+			{
+				if (!variant.length() || (variant.length() == 8 && memcmp(variant.data(), "ARG:void", 8) == 0))
+					return _function_value_0(root, ret, ec);
+				ec << "variant '" + variant + "' of function '" + name + "'is not found";
+				return _invoke_status::NotImplemented;
+			}
+			break;
+		}
+		ec << "function '" + name + "'is not found";
+		return _invoke_status::NotImplemented;
+	}
+
+	template<class F> _invoke_status _callFunction(F && func, _error_collector & ec)
+	{
+		try
+		{
+			func();
+		}
+		catch (exception & e)
+		{
+			e.get(ec); 
+			return _invoke_status::Error;
+		}
+		catch (std::exception & e)
+		{
+			ec.add((long)_invoke_status::FatalError, std::string() + "unhandled exception: '" + e.what() + "'");
+			return _invoke_status::FatalError;
+		}
+		catch (...)
+		{
+			ec.add((long)_invoke_status::FatalError, "unknown unhandled exception");
+			return _invoke_status::FatalError;
+		}
+		return _invoke_status::Ok;
+	}
+
+	_invoke_status _function_value_0(const rapidjson::Value & r, rapidjson::Document & ret, _error_collector & ec)
+	{
+		auto _intf_p = _intf->_priv;
+		(void)r;
+		long long retval;
+		auto stat = _callFunction([&](){retval = _that->value(); }, ec);
+		if (stat != _invoke_status::Ok)
+			return stat;
+		ret.SetObject();
+		_intf_p->_addValue(ret, ret, "retval", retval);
+		return _invoke_status::Ok;
+	}
+
+};
+
+_invoke_status PoolTest::Counter::_invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec)
+{
+	auto * _p = _priv;
+	auto * _intf_p = _p->_intf->_priv;
+
+	rapidjson::Value * v;
+	if (_intf_p->_getValue(root, "method", rapidjson::kObjectType, v, ec))
+	{
+		std::string name, variant;
+		if (!_intf_p->_getValue(*v, "name", name, ec))
+			return _invoke_status::MarshallingError;
+		PIDL::JSONTools::getValue(*v, "variant", variant);
+		ec.clear();
+		auto stat = _p->_callFunction(name, variant, *v, ret, ec);
+		_intf_p->_addValue(ret, ret, "object_data", _data());
+		return stat;
+	}
+	else if (_intf_p->_getValue(root, "property_get", rapidjson::kObjectType, v, ec))
+	{
+		std::string name;
+		if (!_intf_p->_getValue(*v, "name", name, ec))
+			return _invoke_status::MarshallingError;
+		ec.clear();
+		auto stat = _p->_callFunction(name, "get", *v, ret, ec);
+		_intf_p->_addValue(ret, ret, "object_data", _data());
+		return stat;
+	}
+	else if (_intf_p->_getValue(root, "property_set", rapidjson::kObjectType, v, ec))
+	{
+		std::string name;
+		if (!_intf_p->_getValue(*v, "name", name, ec))
+			return _invoke_status::MarshallingError;
+		ec.clear();
+		auto stat = _p->_callFunction(name, "set", *v, ret, ec);
+		if (!ret.IsObject()) ret.SetObject();
+		_intf_p->_addValue(ret, ret, "object_data", _data());
+		return stat;
+	}
+
+	return _invoke_status::MarshallingError;
+}
+
+PoolTest::Counter::~Counter()
+{ delete _priv; }
+
+PoolTest::Counter::Counter(PoolTest * intf) : _priv(new _Priv(this, intf))
+{ }
+
+PoolTest::~PoolTest()
+{ delete _priv; }
+
+PoolTest::PoolTest() : _priv(new _Priv(this))
+{ }
+
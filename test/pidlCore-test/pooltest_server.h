@@ -0,0 +1,64 @@
+#ifndef __pooltest_server_h__
+#define __pooltest_server_h__
+#include <vector>
+#include <tuple>
+#include <string>
+#include <memory>
+#include <pidlCore/datetime.h>
+#include <pidlCore/exception.h>
+#include <pidlCore/nullable.h>
+#include <pidlCore/jsontools.h>
+#include <pidlCore/basictypes.h>
+#include <pidlCore/errorcollector.h>
+#include <functional>
+#include <pidlCore/workerpool.h>
+
+class PoolTest
+{
+	struct _Priv;
+	_Priv * _priv;
+public:
+	_invoke_status _invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec);
+	void _invoke(PIDL::WorkerPool & pool, const std::string & request, const std::function<void(_invoke_status status, const std::string & response, const std::list<PIDL::Exception::Error> & errors)> & done);
+	class _Object
+	{
+	public:
+		typedef ptr<_Object> Ptr;
+		virtual ~_Object() = default;
+		virtual _invoke_status _invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec) = 0;
+		virtual std::string _data() = 0;
+	};
+
+	class Counter;
+	class Counter : public _Object
+	{
+		struct _Priv;
+		_Priv * _priv;
+	public:
+		typedef ptr<Counter> Ptr;
+		_invoke_status _invoke(const rapidjson::Value & root, rapidjson::Document & ret, _error_collector & ec);
+		virtual long long value() = 0;
+		virtual ~Counter();
+	protected:
+		Counter(PoolTest * intf);
+	};
+
+	virtual long long add(const long long & a, const long long & b) = 0;
+	virtual long long fail(const long long & a) = 0;
+	virtual ptr<PoolTest::Counter> counter() = 0;
+	virtual ~PoolTest();
+protected:
+	PoolTest();
+	virtual ptr<_Object> _get_object(const std::string & object_data, _error_collector & ec) = 0;
+	template<class Object_T> ptr<Object_T> _get_object(const std::string & object_data, _error_collector & ec)
+	{
+		auto o = _get_object(object_data, ec);
+		if (!o) return nullptr;
+		auto ret = std::dynamic_pointer_cast<Object_T, _Object>(o);
+		if (!ret) ec.add(-1, "unexpected: invalid object type for data '" + object_data + "'");
+		return ret;
+	}
+	virtual void _dispose_object(const std::string & object_data) = 0;
+};
+
+#endif // __pooltest_server_h__
@@ -0,0 +1,205 @@
+
+#include "workerpool_test.h"
+
+#include <cppunit/config/SourcePrefix.h>
+
+#include <pidlCore/workerpool.h>
+#include <pidlCore/jsontools.h>
+#include <pidlCore/basictypes.h>
+#include <pidlCore/datetime.h>
+#include <pidlCore/errorcollector.h>
+#include <pidlCore/exception.h>
+#include <pidlCore/nullable.h>
+
+#include <rapidjson/document.h>
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// pooltest_server.h and pooltest_server.cpp are generated from pooltest.json by 'pidl -file pooltest_job.json'
+namespace pooltest {
+    typedef std::string string;
+    typedef PIDL::DateTime datetime;
+    typedef std::vector<char> blob;
+    template<typename T> using nullable = PIDL::Nullable<T>;
+    template<typename T> using nullable_const_ref = PIDL::NullableConstRef<T>;
+    template<typename T> using array = std::vector<T>;
+    template<typename... T> using tuple = std::tuple<T...>;
+    template<typename T> using ptr = std::shared_ptr<T>;
+    typedef PIDL::InvokeStatus _invoke_status;
+    typedef PIDL::ErrorCollector _error_collector;
+    typedef PIDL::Exception exception;
+#include "pooltest_server.h"
+#include "pooltest_server.cpp"
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(WorkerPool_Test);
+
+void WorkerPool_Test::setUp()
+{
+}
+
+void WorkerPool_Test::tearDown()
+{
+}
+
+void WorkerPool_Test::runs_all()
+{
+    PIDL::WorkerPool pool(4);
+    CPPUNIT_ASSERT_EQUAL((size_t)4, pool.size());
+
+    // posted from many threads at once
+    std::atomic<int> done(0);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 8; ++t)
+        producers.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i)
+                pool.post([&] { ++done; });
+        });
+    for (auto & t : producers)
+        t.join();
+
+    pool.wait();
+    CPPUNIT_ASSERT_EQUAL(8000, done.load());
+
+    pool.post([&] { done = 0; });
+    pool.wait();
+    CPPUNIT_ASSERT_EQUAL(0, done.load());
+}
+
+void WorkerPool_Test::drains_on_destruction()
+{
+    std::atomic<int> done(0);
+    {
+        PIDL::WorkerPool pool(2);
+        for (int i = 0; i < 100; ++i)
+            pool.post([&] { std::this_thread::yield(); ++done; });
+    }
+    CPPUNIT_ASSERT_EQUAL(100, done.load());
+}
+
+// the way a generated server uses the pool: every task decodes a request and encodes a response with the per-thread buffers
+void WorkerPool_Test::concurrent_marshalling()
+{
+    typedef std::tuple<long long, std::string, std::vector<char>> Values;
+
+    PIDL::WorkerPool pool(8);
+    std::atomic<int> failed(0);
+    for (int i = 0; i < 2000; ++i)
+        pool.post([i, &failed] {
+            Values in(i, std::string(i % 100, 'x'), std::vector<char>(i % 50, static_cast<char>(i)));
+
+            PIDL::JSONTools::OutputBuffer request;
+            PIDL::JSONTools::Writer w(request.buffer());
+            PIDL::JSONTools::writeValue(w, in);
+
+            PIDL::JSONTools::PooledDocument doc;
+            doc.document().Parse(request.data(), request.size());
+            Values out;
+            if (doc.document().HasParseError() || !PIDL::JSONTools::getValue(doc.document(), out) || out != in)
+                ++failed;
+        });
+    pool.wait();
+    CPPUNIT_ASSERT_EQUAL(0, failed.load());
+}
+
+void WorkerPool_Test::throwing_task()
+{
+    PIDL::WorkerPool pool(2);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 10; ++i)
+        pool.post([&] { ++done; throw std::runtime_error("task failed"); });
+    pool.wait();
+    CPPUNIT_ASSERT_EQUAL(10, done.load());
+
+    // the workers are still running
+    pool.post([&] { ++done; });
+    pool.wait();
+    CPPUNIT_ASSERT_EQUAL(11, done.load());
+}
+
+namespace {
+    struct PoolTestServer : public pooltest::PoolTest
+    {
+        struct CounterImpl : public Counter
+        {
+            CounterImpl(PoolTest * intf) : Counter(intf) { }
+            long long value() override { return 42; }
+            std::string _data() override { return "c1"; }
+        };
+
+        PoolTestServer() : counter_(std::make_shared<CounterImpl>(this)) { }
+
+        long long add(const long long & a, const long long & b) override { return a + b; }
+        long long fail(const long long &) override { throw std::runtime_error("fail"); }
+        std::shared_ptr<Counter> counter() override { return counter_; }
+
+        std::shared_ptr<_Object> _get_object(const std::string & object_data, PIDL::ErrorCollector &) override
+        {
+            if (object_data != "c1")
+                throw std::runtime_error("unknown object '" + object_data + "'");
+            return counter_;
+        }
+        void _dispose_object(const std::string &) override { }
+
+        std::shared_ptr<CounterImpl> counter_;
+    };
+}
+
+// many threads post to one generated server through the pooled '_invoke'; 'done' runs once for every request, whatever the implementation throws
+void WorkerPool_Test::generated_server()
+{
+    static const char * requests[] = {
+        "{\"version\":2,\"function\":{\"name\":\"add\",\"arguments\":{\"a\":1,\"b\":2}}}",
+        "{\"version\":2,\"function\":{\"name\":\"fail\",\"arguments\":{\"a\":1}}}",
+        "{\"version\":2,\"object_call\":{\"object_data\":\"c1\",\"method\":{\"name\":\"value\",\"arguments\":{}}}}",
+        "{\"version\":2,\"object_call\":{\"object_data\":\"c2\",\"method\":{\"name\":\"value\",\"arguments\":{}}}}",
+        "{\"version\":2,",
+    };
+    static const PIDL::InvokeStatus expected[] = {
+        PIDL::InvokeStatus::Ok,
+        PIDL::InvokeStatus::FatalError,
+        PIDL::InvokeStatus::Ok,
+        PIDL::InvokeStatus::FatalError,
+        PIDL::InvokeStatus::MarshallingError,
+    };
+    enum { requestCount = sizeof(requests) / sizeof(requests[0]), threadCount = 8, iterations = 200 };
+
+    PoolTestServer server;
+    PIDL::WorkerPool pool(4);
+    std::vector<std::atomic<int>> done(threadCount * iterations);
+    for (auto & d : done)
+        d = 0;
+    std::atomic<int> unexpected(0);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threadCount; ++t)
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < iterations; ++i)
+            {
+                int id = t * iterations + i;
+                int r = id % requestCount;
+                server._invoke(pool, requests[r], [&, id, r](PIDL::InvokeStatus status, const std::string & response, const std::list<PIDL::Exception::Error> & errors) {
+                    ++done[id];
+                    if (status != expected[r] || (status == PIDL::InvokeStatus::Ok) != errors.empty() || (status == PIDL::InvokeStatus::Ok) == response.empty())
+                        ++unexpected;
+                });
+            }
+        });
+    for (auto & p : producers)
+        p.join();
+    pool.wait();
+
+    for (auto & d : done)
+        CPPUNIT_ASSERT_EQUAL(1, d.load());
+    CPPUNIT_ASSERT_EQUAL(0, unexpected.load());
+}
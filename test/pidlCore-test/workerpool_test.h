@@ -0,0 +1,29 @@
+#ifndef __workerpool_test_h__
+#define __workerpool_test_h__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class WorkerPool_Test : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(WorkerPool_Test);
+    CPPUNIT_TEST(runs_all);
+    CPPUNIT_TEST(drains_on_destruction);
+    CPPUNIT_TEST(concurrent_marshalling);
+    CPPUNIT_TEST(throwing_task);
+    CPPUNIT_TEST(generated_server);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    virtual void setUp() override;
+
+    virtual void tearDown() override;
+
+protected:
+    void runs_all();
+    void drains_on_destruction();
+    void concurrent_marshalling();
+    void throwing_task();
+    void generated_server();
+};
+
+#endif //__workerpool_test_h__
@@ -4,4 +4,6 @@ CONFIG += ordered
 
 SUBDIRS += \
     pidlCore-test \
+    pidlCore-bench \
+    pidl-bench \
 